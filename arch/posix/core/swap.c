@@ -17,6 +17,8 @@
 #include <kernel_structs.h>
 #include "posix_core.h"
 #include "irq.h"
+#include <kernel_internal.h>
+#include <tracing.h>
 
 /**
  *
@@ -52,6 +54,8 @@ unsigned int __swap(unsigned int key)
 #if CONFIG_KERNEL_EVENT_LOGGER_CONTEXT_SWITCH
 	_sys_k_event_logger_context_switch();
 #endif
+	sys_trace_thread_switch(_kernel.current, _kernel.ready_q.cache);
+	_thread_runtime_switch();
 
 	posix_thread_status_t *ready_thread_ptr =
 		(posix_thread_status_t *)
@@ -19,6 +19,7 @@
 #include "sw_isr_table.h"
 #include "soc.h"
 #include "logging/kernel_event_logger.h"
+#include "tracing.h"
 
 typedef void (*normal_irq_f_ptr)(void *);
 typedef int (*direct_irq_f_ptr)(void);
@@ -36,6 +37,7 @@ static inline void vector_to_irq(int irq_nbr, int *may_swap)
 	 */
 	/* _int_latency_start(); */
 	_sys_k_event_logger_interrupt();
+	sys_trace_isr_enter(irq_nbr);
 
 	if (irq_vector_table[irq_nbr].func == NULL) { /* LCOV_EXCL_BR_LINE */
 		/* LCOV_EXCL_START */
@@ -56,6 +58,7 @@ static inline void vector_to_irq(int irq_nbr, int *may_swap)
 			*may_swap = 1;
 		}
 	}
+	sys_trace_isr_exit();
 	/* _int_latency_stop(); */
 }
 
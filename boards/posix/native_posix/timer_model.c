@@ -12,6 +12,7 @@
  */
 
 #include <stdint.h>
+#include <time.h>
 #include "hw_models_top.h"
 #include "irq_ctrl.h"
 #include "board_soc.h"
@@ -29,8 +30,6 @@ static u64_t tick_p; /* Period of the ticker */
 static s64_t silent_ticks;
 
 #if (CONFIG_NATIVE_POSIX_SLOWDOWN_TO_REAL_TIME)
-#include <time.h>
-
 static u64_t Boot_time;
 static struct timespec tv;
 #endif
@@ -59,6 +58,21 @@ void hwtimer_cleanup(void)
 
 }
 
+/**
+ * Return the host time in microseconds
+ *
+ * Unlike the simulated time, it advances while Zephyr code runs, so it
+ * measures how long the code takes to execute.
+ */
+u64_t hwtimer_get_host_time(void)
+{
+	struct timespec host_tv;
+
+	clock_gettime(CLOCK_MONOTONIC, &host_tv);
+
+	return host_tv.tv_sec * 1000000ULL + host_tv.tv_nsec / 1000;
+}
+
 /**
  * Enable the HW timer tick interrupts with a period <period> in micoseconds
  */
@@ -91,7 +105,11 @@ static void hwtimer_tick_timer_reached(void)
 	}
 #endif
 
-	hw_timer_tick_timer += tick_p;
+	if (tick_p) {
+		hw_timer_tick_timer += tick_p;
+	} else {
+		hw_timer_tick_timer = NEVER;
+	}
 	hwtimer_update_timer();
 
 	if (silent_ticks > 0) {
@@ -141,6 +159,18 @@ void hwtimer_wake_in_time(u64_t time)
  * The kernel wants to skip the next sys_ticks tick interrupts
  * If sys_ticks == 0, the next interrupt will be raised.
  */
+/*
+ * Stop the periodic ticks, and raise a single tick interrupt at the
+ * absolute time @a time instead (NEVER to only stop the ticks)
+ */
+void hwtimer_set_oneshot(u64_t time)
+{
+	tick_p = 0;
+	hw_timer_tick_timer = time;
+	hwtimer_update_timer();
+	hwm_find_next_timer();
+}
+
 void hwtimer_set_silent_ticks(s64_t sys_ticks)
 {
 	silent_ticks = sys_ticks;
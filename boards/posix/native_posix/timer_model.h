@@ -19,7 +19,9 @@ void hwtimer_timer_reached(void);
 void hwtimer_wake_in_time(u64_t time);
 void hwtimer_set_silent_ticks(s64_t sys_ticks);
 void hwtimer_enable(u64_t period);
+void hwtimer_set_oneshot(u64_t time);
 s64_t hwtimer_get_pending_silent_ticks(void);
+u64_t hwtimer_get_host_time(void);
 
 #ifdef __cplusplus
 }
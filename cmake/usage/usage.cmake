@@ -52,6 +52,7 @@ message("  debug        - Build and debug an application using GDB")
 message("  debugserver  - Build and start a GDB server (port 1234 for Qemu targets)")
 message("  ram_report   - Build and create RAM usage report")
 message("  rom_report   - Build and create ROM usage report")
+message("  stack_report - Build and report worst-case stack depths (CONFIG_STACK_USAGE)")
 message("  usage        - Display this text")
 message("")
 message("Supported Boards:")
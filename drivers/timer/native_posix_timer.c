@@ -21,7 +21,19 @@
 #include "posix_soc_if.h"
 
 static u64_t tick_period; /* System tick period in number of hw cycles */
+
+#ifdef CONFIG_TICKLESS_KERNEL
+/*
+ * The timer is programmed for a single interrupt, on the tick boundary of
+ * the next kernel timeout. The hw time starts at 0 on boot, so the ticks
+ * elapsed since boot are always known exactly, with no rounding error
+ * accumulating every time the timer is reprogrammed.
+ */
+static u32_t programmed_ticks;
+static u64_t programmed_base; /* tick the current program counts from */
+#else
 static s64_t silent_ticks;
+#endif
 
 /**
  * Return the current HW cycle counter
@@ -32,7 +44,82 @@ u32_t _timer_cycle_get_32(void)
 	return hwm_get_time();
 }
 
-#ifdef CONFIG_TICKLESS_IDLE
+#ifdef CONFIG_TICKLESS_KERNEL
+u64_t _get_elapsed_clock_time(void)
+{
+	return hwm_get_time() / tick_period;
+}
+
+u32_t _get_program_time(void)
+{
+	return programmed_ticks;
+}
+
+u32_t _get_elapsed_program_time(void)
+{
+	if (!programmed_ticks) {
+		return 0;
+	}
+
+	return (u32_t)(_get_elapsed_clock_time() - programmed_base);
+}
+
+u32_t _get_remaining_program_time(void)
+{
+	u32_t elapsed = _get_elapsed_program_time();
+
+	if (!programmed_ticks || elapsed >= programmed_ticks) {
+		return 0;
+	}
+
+	return programmed_ticks - elapsed;
+}
+
+/*
+ * Program the timer to expire @a time ticks after the tick the current
+ * program counts from, or after the current tick if no program is
+ * running. 0 cancels the program.
+ */
+void _set_time(u32_t time)
+{
+	u64_t now = _get_elapsed_clock_time();
+	u64_t expiry;
+
+	if (!time) {
+		programmed_ticks = 0;
+		hwtimer_set_oneshot(NEVER);
+		return;
+	}
+
+	if (!programmed_ticks) {
+		programmed_base = now;
+	}
+	programmed_ticks = time;
+
+	/* never program a tick that is already over */
+	expiry = max(programmed_base + time, now + 1);
+	hwtimer_set_oneshot(expiry * tick_period);
+}
+
+void _enable_sys_clock(void)
+{
+	/* the hw time always runs, there is nothing to enable */
+}
+
+/*
+ * The timer is always programmed for the next timeout already, and is not
+ * interrupting anyhow until then
+ */
+void _timer_idle_enter(s32_t sys_ticks)
+{
+	ARG_UNUSED(sys_ticks);
+}
+
+void _timer_idle_exit(void)
+{
+}
+
+#elif defined(CONFIG_TICKLESS_IDLE)
 
 /*
  * Do not raise another ticker interrupt until the sys_ticks'th one
@@ -82,7 +169,7 @@ void _timer_idle_exit(void)
 	silent_ticks = 0;
 	hwtimer_set_silent_ticks(0);
 }
-#endif
+#endif /* CONFIG_TICKLESS_KERNEL */
 
 /**
  * Interrupt handler for the timer interrupt
@@ -91,8 +178,22 @@ void _timer_idle_exit(void)
 static void sp_timer_isr(void *arg)
 {
 	ARG_UNUSED(arg);
+#ifdef CONFIG_TICKLESS_KERNEL
+	if (!programmed_ticks) {
+		return;
+	}
+
+	_sys_idle_elapsed_ticks = _get_elapsed_clock_time() - programmed_base;
+
+	/*
+	 * Clear the program before announcing the elapsed ticks, so that
+	 * the timeouts added while they are handled count from this tick
+	 */
+	programmed_ticks = 0;
+#else
 	_sys_idle_elapsed_ticks = silent_ticks + 1;
 	silent_ticks = 0;
+#endif
 	_sys_clock_tick_announce();
 }
 
@@ -105,7 +206,12 @@ int _sys_clock_driver_init(struct device *device)
 
 	tick_period = sys_clock_us_per_tick;
 
+#ifdef CONFIG_TICKLESS_KERNEL
+	/* keeping track of time costs nothing, the clock APIs always work */
+	_sys_clock_always_on = 1;
+#else
 	hwtimer_enable(tick_period);
+#endif
 
 	IRQ_CONNECT(TIMER_TICK_IRQ, 1, sp_timer_isr, 0, 0);
 	irq_enable(TIMER_TICK_IRQ);
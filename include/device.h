@@ -205,6 +205,35 @@ static const int _INIT_LEVEL_APPLICATION = 1;
  */
 #define DEVICE_DECLARE(name) static struct device DEVICE_NAME_GET(name)
 
+/**
+ * @def DEVICE_INIT_INDEPENDENT
+ *
+ * @brief Declare that a device can be initialized concurrently
+ *
+ * @details With CONFIG_DEVICE_INIT_PARALLEL, the devices of the POST_KERNEL
+ * and APPLICATION levels declared independent are initialized by worker
+ * threads, concurrently with each other and with the other devices of their
+ * level. They are all initialized before the next level starts. This saves
+ * boot time when their init functions wait for the hardware.
+ *
+ * A device may be declared independent if its init function does not use
+ * the other devices of its level, and if the init functions of the other
+ * devices of its level do not use it. Its init function must be able to
+ * run in a thread, concurrently with the init functions of other drivers.
+ *
+ * @param name The same as dev_name provided to DEVICE_INIT()
+ */
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+#define DEVICE_INIT_INDEPENDENT(name)					\
+	static struct device * const _CONCAT(__device_independent_, name) \
+	__used __attribute__((__section__(".device_independent." #name))) = \
+		DEVICE_GET(name)
+#else
+#define DEVICE_INIT_INDEPENDENT(name)					\
+	static struct device * const _CONCAT(__device_independent_, name) \
+	__unused = DEVICE_GET(name)
+#endif
+
 struct device;
 
 
@@ -231,11 +260,16 @@ struct device_config {
  * @param driver_api pointer to structure containing the API functions for
  * the device type. This pointer is filled in by the driver at init time.
  * @param driver_data driver instance data. For driver use only
+ * @param init_cycles hardware cycles spent in the init function, with
+ * CONFIG_DEVICE_INIT_STATS
  */
 struct device {
 	struct device_config *config;
 	const void *driver_api;
 	void *driver_data;
+#ifdef CONFIG_DEVICE_INIT_STATS
+	u32_t init_cycles;
+#endif
 };
 
 void _sys_device_do_config_level(int level);
@@ -254,6 +288,20 @@ void _sys_device_do_config_level(int level);
  */
 struct device *device_get_binding(const char *name);
 
+/**
+ * @brief Gets the device structure list array and device count
+ *
+ * Called by the Power Manager application to get the list of
+ * device structures associated with the devices in the system.
+ * The PM app would use this list to create its own sorted list
+ * based on the order it wishes to suspend or resume the devices.
+ * The devices are listed in the order they are initialized.
+ *
+ * @param device_list Pointer to receive the device list array
+ * @param device_count Pointer to receive the device count
+ */
+void device_list_get(struct device **device_list, int *device_count);
+
 /**
  * @brief Device Power Management APIs
  * @defgroup device_power_management_api Device Power Management APIs
@@ -385,19 +433,6 @@ static inline int device_get_power_state(struct device *device,
 						 device_power_state);
 }
 
-/**
- * @brief Gets the device structure list array and device count
- *
- * Called by the Power Manager application to get the list of
- * device structures associated with the devices in the system.
- * The PM app would use this list to create its own sorted list
- * based on the order it wishes to suspend or resume the devices.
- *
- * @param device_list Pointer to receive the device list array
- * @param device_count Pointer to receive the device count
- */
-void device_list_get(struct device **device_list, int *device_count);
-
 /**
  * @brief Check if any device is in the middle of a transaction
  *
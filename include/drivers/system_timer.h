@@ -45,6 +45,13 @@ extern void _timer_idle_exit(void);
 
 extern void _nano_sys_clock_tick_announce(s32_t ticks);
 #ifdef CONFIG_TICKLESS_KERNEL
+/*
+ * The timer is programmed with _set_time() to announce the ticks elapsed
+ * after @a time ticks.  While a program is running, times given to
+ * _set_time() count from the start of that program, as the timeouts of the
+ * kernel are relative to the last announced tick: the elapsed program time
+ * is added to new timeouts for that reason.
+ */
 extern void _set_time(u32_t time);
 extern u32_t _get_program_time(void);
 extern u32_t _get_remaining_program_time(void);
@@ -35,6 +35,7 @@
 #include <misc/printk.h>
 #include <arch/cpu.h>
 #include <misc/rb.h>
+#include <spinlock.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -379,11 +380,24 @@ struct _timeout;
 typedef void (*_timeout_func_t)(struct _timeout *t);
 
 struct _timeout {
-	sys_dnode_t node;
+	/* this timeout's entry in the timeout queue */
+	union {
+		sys_dnode_t node;
+#ifdef CONFIG_TIMEOUT_QUEUE_FAST
+		struct rbnode node_rb;
+#endif
+	};
 	struct k_thread *thread;
 	sys_dlist_t *wait_q;
 	s32_t delta_ticks_from_prev;
 	_timeout_func_t func;
+#ifdef CONFIG_TIMEOUT_QUEUE_FAST
+	/* absolute tick at which the timeout expires */
+	u32_t expiry;
+
+	/* tie-breaker keeping same-tick timeouts in FIFO order */
+	u32_t order_key;
+#endif
 };
 
 extern s32_t _timeout_remaining_get(struct _timeout *timeout);
@@ -426,12 +440,10 @@ struct _thread_base {
 		struct rbnode qnode_rb;
 	};
 
-#ifdef CONFIG_WAITQ_FAST
-	/* wait queue on which the thread is pended (needed only for
-	 * trees, not dumb lists)
+	/* wait queue on which the thread is pended, to remove it from a
+	 * tree and to requeue it when its priority changes
 	 */
 	_wait_q_t *pended_on;
-#endif
 
 	/* user facing 'thread options'; values defined in include/kernel.h */
 	u8_t user_options;
@@ -514,6 +526,17 @@ struct _mem_domain_info {
 	struct k_mem_domain *mem_domain;
 };
 
+#ifdef CONFIG_OBJECT_VALIDATION_CACHE
+struct _thread_obj_cache {
+	/* generation of the validations cached */
+	u32_t gen;
+	struct {
+		void *obj;
+		struct _k_object *ko;
+	} entries[CONFIG_OBJECT_VALIDATION_CACHE_SIZE];
+};
+#endif /* CONFIG_OBJECT_VALIDATION_CACHE */
+
 #endif /* CONFIG_USERSPACE */
 
 /**
@@ -561,11 +584,23 @@ struct k_thread {
 	struct _thread_stack_info stack_info;
 #endif /* CONFIG_THREAD_STACK_INFO */
 
+#if defined(CONFIG_THREAD_RUNTIME_STATS)
+	/** hardware cycles spent running, up to the last switch out */
+	u64_t runtime_cycles;
+#endif
+
+	/** mutex the thread is waiting on, for priority inheritance */
+	struct k_mutex *pended_mutex;
+
 #if defined(CONFIG_USERSPACE)
 	/** memory domain info of the thread */
 	struct _mem_domain_info mem_domain_info;
 	/** Base address of thread stack */
 	k_thread_stack_t *stack_obj;
+#ifdef CONFIG_OBJECT_VALIDATION_CACHE
+	/** kernel objects the thread was last granted access to */
+	struct _thread_obj_cache obj_cache;
+#endif
 #endif /* CONFIG_USERSPACE */
 
 #if defined(CONFIG_USE_SWITCH)
@@ -643,6 +678,56 @@ __deprecated extern void k_call_stacks_analyze(void);
  */
 extern void k_thread_foreach(k_thread_user_cb_t user_cb, void *user_data);
 
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+/**
+ * @brief Get the time a thread spent running.
+ *
+ * The time spent in interrupts is accounted to the thread they
+ * interrupted.
+ *
+ * @param thread ID of thread.
+ *
+ * @note CONFIG_THREAD_RUNTIME_STATS must be set for this function to be
+ * available.
+ *
+ * @return Number of hardware cycles @a thread spent running since it was
+ * created.
+ */
+extern u64_t k_thread_runtime_get(k_tid_t thread);
+
+/**
+ * @brief Get the time the CPU spent idle.
+ *
+ * @note CONFIG_THREAD_RUNTIME_STATS must be set for this function to be
+ * available.
+ *
+ * @return Number of hardware cycles the idle threads spent running since
+ * boot, summed over all the CPUs.
+ */
+extern u64_t k_cpu_idle_runtime_get(void);
+#endif
+
+/**
+ * @brief Get the unused stack space of a thread.
+ *
+ * The stack of a thread is filled with a known pattern when the thread is
+ * created. The space where the pattern is left intact has never been used,
+ * so it gives the high watermark of the stack usage of the thread since it
+ * was created.
+ *
+ * @param thread ID of thread.
+ * @param unused_ptr Address of area to store the number of stack bytes
+ *        never used.
+ *
+ * @note CONFIG_INIT_STACKS and CONFIG_THREAD_STACK_INFO must be set for this
+ * function to be supported.
+ *
+ * @retval 0 Unused stack space stored.
+ * @retval -ENOTSUP Stack usage is not tracked.
+ */
+__syscall int k_thread_stack_space_get(const struct k_thread *thread,
+				       size_t *unused_ptr);
+
 /** @} */
 
 /**
@@ -823,6 +908,20 @@ void k_thread_system_pool_assign(struct k_thread *thread);
  */
 __syscall void k_sleep(s32_t duration);
 
+/**
+ * @brief Put the current thread to sleep, with microsecond resolution.
+ *
+ * This routine puts the current thread to sleep for @a duration
+ * microseconds. The duration is rounded up to the next system clock tick:
+ * a tickless kernel with a small CONFIG_TICKLESS_KERNEL_TIME_UNIT_IN_MICRO_SECS
+ * is needed to actually sleep for less than a millisecond.
+ *
+ * @param duration Number of microseconds to sleep.
+ *
+ * @return N/A
+ */
+__syscall void k_usleep(s32_t duration);
+
 /**
  * @brief Cause the current thread to busy wait.
  *
@@ -1359,6 +1458,14 @@ static ALWAYS_INLINE s32_t _ms_to_ticks(s32_t ms)
 }
 #endif
 
+/* rounds up, so that a non-zero duration never becomes 0 ticks */
+static inline s32_t _us_to_ticks(s32_t us)
+{
+	s64_t us_ticks_per_sec = (s64_t)us * sys_clock_ticks_per_sec;
+
+	return (s32_t)ceiling_fraction(us_ticks_per_sec, USEC_PER_SEC);
+}
+
 /* added tick needed to account for tick in progress */
 #ifdef CONFIG_TICKLESS_KERNEL
 #define _TICK_ALIGN 0
@@ -1516,6 +1623,24 @@ extern void k_timer_init(struct k_timer *timer,
 __syscall void k_timer_start(struct k_timer *timer,
 			     s32_t duration, s32_t period);
 
+/**
+ * @brief Start a timer, with microsecond resolution.
+ *
+ * This routine is the same as k_timer_start(), but the duration and period
+ * are given in microseconds. They are rounded up to the next system clock
+ * tick: a tickless kernel with a small
+ * CONFIG_TICKLESS_KERNEL_TIME_UNIT_IN_MICRO_SECS is needed for the timer
+ * to actually expire with a sub-millisecond resolution.
+ *
+ * @param timer     Address of timer.
+ * @param duration  Initial timer duration (in microseconds).
+ * @param period    Timer period (in microseconds).
+ *
+ * @return N/A
+ */
+__syscall void k_timer_start_us(struct k_timer *timer,
+				s32_t duration, s32_t period);
+
 /**
  * @brief Stop a timer.
  *
@@ -1920,6 +2045,25 @@ extern void k_queue_append_list(struct k_queue *queue, void *head, void *tail);
  */
 extern void k_queue_merge_slist(struct k_queue *queue, sys_slist_t *list);
 
+/**
+ * @brief Atomically append an array of elements to a queue.
+ *
+ * This routine adds @a n data items to the end of @a queue in one
+ * operation, in the order of the @a items array. The first 32 bits of each
+ * data item are reserved for the kernel's use. The queue is locked once and
+ * waiting threads are signaled once for the whole batch, rather than for
+ * each item as k_queue_append() would.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param queue Address of the queue.
+ * @param items Array of the addresses of the data items.
+ * @param n Number of data items in @a items.
+ *
+ * @return N/A
+ */
+extern void k_queue_append_batch(struct k_queue *queue, void **items, int n);
+
 /**
  * @brief Get an element from a queue.
  *
@@ -1937,6 +2081,30 @@ extern void k_queue_merge_slist(struct k_queue *queue, sys_slist_t *list);
  */
 __syscall void *k_queue_get(struct k_queue *queue, s32_t timeout);
 
+/**
+ * @brief Get several elements from a queue.
+ *
+ * This routine removes up to @a max data items from the head of @a queue in
+ * one operation, and stores their addresses in @a items in queue order. If
+ * the queue is empty, the routine waits for a first data item and returns
+ * it along with any item queued with it. The first 32 bits of the data
+ * items are reserved for the kernel's use.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param queue Address of the queue.
+ * @param items Array receiving the addresses of the data items.
+ * @param max Size of the @a items array, at least 1.
+ * @param timeout Waiting period to obtain a first data item (in
+ *                milliseconds), or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of data items obtained; 0 if returned without waiting,
+ * or waiting period timed out.
+ */
+__syscall int k_queue_get_batch(struct k_queue *queue, void **items, int max,
+				s32_t timeout);
+
 /**
  * @brief Remove an element from a queue.
  *
@@ -2154,6 +2322,24 @@ struct k_fifo {
 #define k_fifo_put_slist(fifo, list) \
 	k_queue_merge_slist((struct k_queue *) fifo, list)
 
+/**
+ * @brief Atomically add an array of elements to a FIFO queue.
+ *
+ * This routine adds @a n data items to @a fifo in one operation, in the
+ * order of the @a items array. The first 32 bits of each data item are
+ * reserved for the kernel's use.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param fifo Address of the FIFO queue.
+ * @param items Array of the addresses of the data items.
+ * @param n Number of data items in @a items.
+ *
+ * @return N/A
+ */
+#define k_fifo_put_batch(fifo, items, n) \
+	k_queue_append_batch((struct k_queue *) fifo, items, n)
+
 /**
  * @brief Get an element from a FIFO queue.
  *
@@ -2173,6 +2359,28 @@ struct k_fifo {
 #define k_fifo_get(fifo, timeout) \
 	k_queue_get((struct k_queue *) fifo, timeout)
 
+/**
+ * @brief Get several elements from a FIFO queue.
+ *
+ * This routine removes up to @a max data items from @a fifo in a "first in,
+ * first out" manner, waiting for a first one if @a fifo is empty. The first
+ * 32 bits of the data items are reserved for the kernel's use.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param fifo Address of the FIFO queue.
+ * @param items Array receiving the addresses of the data items.
+ * @param max Size of the @a items array, at least 1.
+ * @param timeout Waiting period to obtain a first data item (in
+ *                milliseconds), or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of data items obtained; 0 if returned without waiting,
+ * or waiting period timed out.
+ */
+#define k_fifo_get_batch(fifo, items, max, timeout) \
+	k_queue_get_batch((struct k_queue *) fifo, items, max, timeout)
+
 /**
  * @brief Query a FIFO queue to see if it has data available.
  *
@@ -2525,6 +2733,9 @@ struct k_work {
 	void *_reserved;		/* Used by k_queue implementation. */
 	k_work_handler_t handler;
 	atomic_t flags[1];
+#ifdef CONFIG_WORK_ITEM_PRIORITY
+	int prio;
+#endif
 };
 
 struct k_delayed_work {
@@ -2580,9 +2791,45 @@ static inline void k_work_init(struct k_work *work, k_work_handler_t handler)
 {
 	atomic_clear_bit(work->flags, K_WORK_STATE_PENDING);
 	work->handler = handler;
+#ifdef CONFIG_WORK_ITEM_PRIORITY
+	work->prio = 0;
+#endif
 	_k_object_init(work);
 }
 
+#if defined(CONFIG_WORK_ITEM_PRIORITY) || defined(__DOXYGEN__)
+/**
+ * @brief Set the priority of a work item.
+ *
+ * This routine sets the priority of work item @a work. A work item
+ * submitted to a workqueue is processed before the pending work items of
+ * a lower priority, and after those of the same or a higher priority.
+ * As for threads, a lower value means a higher priority. Work items have
+ * priority 0 once initialized.
+ *
+ * The priority of a pending work item must not be changed.
+ *
+ * @param work Address of work item.
+ * @param prio Priority of the work item.
+ *
+ * @return N/A
+ */
+static inline void k_work_priority_set(struct k_work *work, int prio)
+{
+	work->prio = prio;
+}
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+extern void _k_work_q_insert(struct k_work_q *work_q, struct k_work *work);
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+#endif /* CONFIG_WORK_ITEM_PRIORITY */
+
 /**
  * @brief Submit a work item.
  *
@@ -2609,7 +2856,11 @@ static inline void k_work_submit_to_queue(struct k_work_q *work_q,
 					  struct k_work *work)
 {
 	if (!atomic_test_and_set_bit(work->flags, K_WORK_STATE_PENDING)) {
+#ifdef CONFIG_WORK_ITEM_PRIORITY
+		_k_work_q_insert(work_q, work);
+#else
 		k_queue_append(&work_q->queue, work);
+#endif
 	}
 }
 
@@ -2652,6 +2903,71 @@ extern void k_work_q_start(struct k_work_q *work_q,
 			   k_thread_stack_t *stack,
 			   size_t stack_size, int prio);
 
+/**
+ * @brief Largest batch of work items a workqueue can process at once.
+ */
+#define K_WORK_Q_BATCH_MAX 8
+
+/**
+ * @brief Start a workqueue processing work items in batches.
+ *
+ * This routine starts workqueue @a work_q like k_work_q_start(), but its
+ * thread takes up to @a batch pending work items from the queue at once,
+ * and only yields once they have all been processed. This lowers the
+ * overhead of each work item on a busy workqueue.
+ *
+ * A work item taken in a batch is considered to be processed: its delayed
+ * work can no longer be cancelled, even if its handler has not been called
+ * yet. Such workqueues are thus meant for work items which are not
+ * cancelled, such as network packets.
+ *
+ * @param work_q Address of workqueue.
+ * @param stack Pointer to work queue thread's stack space, as defined by
+ *		K_THREAD_STACK_DEFINE()
+ * @param stack_size Size of the work queue thread's stack (in bytes), which
+ *		should either be the same constant passed to
+ *		K_THREAD_STACK_DEFINE() or the value of K_THREAD_STACK_SIZEOF().
+ * @param prio Priority of the work queue's thread.
+ * @param batch Largest number of work items processed at once, from 1 to
+ *		K_WORK_Q_BATCH_MAX.
+ *
+ * @return N/A
+ */
+extern void k_work_q_start_batch(struct k_work_q *work_q,
+				 k_thread_stack_t *stack,
+				 size_t stack_size, int prio, int batch);
+
+/**
+ * @brief Add a thread to a workqueue.
+ *
+ * This routine spawns another work processing thread for workqueue
+ * @a work_q, which must have been started already, turning it into a
+ * workqueue pool. The threads of a pool share its queue: a work item is
+ * processed by whichever thread is available first, so that a work item
+ * which blocks for a long time only delays the work items behind it when
+ * all the threads are busy.
+ *
+ * Unlike with a single thread, the handlers of the work items of a pool
+ * can run concurrently. This includes a work item resubmitted while its
+ * handler is running, which can then be processed by another thread
+ * before the handler returns.
+ *
+ * @param work_q Address of workqueue.
+ * @param thread Address of the thread object of the new thread.
+ * @param stack Pointer to the new thread's stack space, as defined by
+ *		K_THREAD_STACK_DEFINE()
+ * @param stack_size Size of the new thread's stack (in bytes), which
+ *		should either be the same constant passed to
+ *		K_THREAD_STACK_DEFINE() or the value of K_THREAD_STACK_SIZEOF().
+ * @param prio Priority of the new thread.
+ *
+ * @return N/A
+ */
+extern void k_work_q_add_worker(struct k_work_q *work_q,
+				struct k_thread *thread,
+				k_thread_stack_t *stack,
+				size_t stack_size, int prio);
+
 /**
  * @brief Initialize a delayed work item.
  *
@@ -3063,6 +3379,67 @@ static inline unsigned int _impl_k_sem_count_get(struct k_sem *sem)
 
 /** @} */
 
+/**
+ * @defgroup syscall_batch_apis System Call Batching APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Operation types of a system call batch.
+ */
+enum k_syscall_op_type {
+	K_SYSCALL_OP_SEM_GIVE,		/**< k_sem_give(obj) */
+	K_SYSCALL_OP_SEM_TAKE,		/**< k_sem_take(obj, timeout) */
+	K_SYSCALL_OP_SEM_RESET,		/**< k_sem_reset(obj) */
+	K_SYSCALL_OP_QUEUE_APPEND,	/**< k_queue_alloc_append(obj, data) */
+	K_SYSCALL_OP_QUEUE_PREPEND,	/**< k_queue_alloc_prepend(obj, data) */
+	K_SYSCALL_OP_QUEUE_GET,		/**< data = k_queue_get(obj, timeout) */
+	K_SYSCALL_OP_QUEUE_CANCEL_WAIT,	/**< k_queue_cancel_wait(obj) */
+};
+
+/**
+ * @brief Operation of a system call batch.
+ */
+struct k_syscall_op {
+	/** Type of the operation, from enum k_syscall_op_type */
+	u32_t type;
+	/** Semaphore or queue operated on */
+	void *obj;
+	/** Data item to queue, or data item obtained */
+	void *data;
+	/** Waiting period of the operations that can wait */
+	s32_t timeout;
+	/**
+	 * Result of the operation: 0, or the error returned by the
+	 * operation, -EAGAIN when no data item was obtained from a queue
+	 */
+	int result;
+};
+
+/**
+ * @brief Perform several semaphore and queue operations.
+ *
+ * This routine performs the operations of @a ops in order, as the
+ * routines named by their types would, and stores the result of each
+ * operation in its @a result field, and the data item obtained by a
+ * K_SYSCALL_OP_QUEUE_GET operation in its @a data field. The batch stops
+ * at the first operation that fails.
+ *
+ * A user mode thread performs the whole batch in a single system call,
+ * instead of making a system call per operation. It must have access to
+ * all the objects operated on.
+ *
+ * @param ops Array of operations.
+ * @param num_ops Number of operations in @a ops.
+ *
+ * @return Number of operations performed successfully; @a num_ops if all
+ * operations succeeded.
+ */
+__syscall int k_syscall_batch(struct k_syscall_op *ops, int num_ops);
+
+/** @} */
+
 /**
  * @defgroup alert_apis Alert APIs
  * @ingroup kernel_apis
@@ -3253,6 +3630,10 @@ struct k_msgq {
 
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
+#define K_MSGQ_FLAG_PUT_CLAIMED	BIT(1)
+#define K_MSGQ_FLAG_GET_CLAIMED	BIT(2)
+#define K_MSGQ_FLAG_PUT_WAITING	BIT(3)
+#define K_MSGQ_FLAG_GET_WAITING	BIT(4)
 
 /**
  * @brief Message Queue Attributes
@@ -3356,6 +3737,7 @@ void k_msgq_cleanup(struct k_msgq *q);
  * @retval 0 Message sent.
  * @retval -ENOMSG Returned without waiting or queue purged.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A message is claimed for writing with k_msgq_put_claim().
  * @req K-MSGQ-002
  */
 __syscall int k_msgq_put(struct k_msgq *q, void *data, s32_t timeout);
@@ -3376,10 +3758,82 @@ __syscall int k_msgq_put(struct k_msgq *q, void *data, s32_t timeout);
  * @retval 0 Message received.
  * @retval -ENOMSG Returned without waiting.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A message is claimed for reading with k_msgq_get_claim().
  * @req K-MSGQ-002
  */
 __syscall int k_msgq_get(struct k_msgq *q, void *data, s32_t timeout);
 
+/**
+ * @brief Claim a message in a message queue for writing in place.
+ *
+ * This routine returns the address of the next free message of message
+ * queue @a q, to be filled by the caller before calling k_msgq_put_commit().
+ * This avoids copying the message into the queue, as k_msgq_put() does.
+ *
+ * Only one message can be claimed for writing at once: while it is, or while
+ * a thread waits to claim it, other threads sending to the queue get -EBUSY.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param q Address of the message queue.
+ * @param msg Address where the address of the claimed message is stored.
+ * @param timeout Waiting period for a free message (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message claimed.
+ * @retval -EBUSY A message is already claimed for writing, or the queue is
+ *                full and other threads are waiting to send.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+extern int k_msgq_put_claim(struct k_msgq *q, void **msg, s32_t timeout);
+
+/**
+ * @brief Send a message claimed with k_msgq_put_claim().
+ *
+ * @param q Address of the message queue.
+ *
+ * @return N/A
+ */
+extern void k_msgq_put_commit(struct k_msgq *q);
+
+/**
+ * @brief Claim a message of a message queue for reading in place.
+ *
+ * This routine returns the address of the first message of message queue
+ * @a q, which stays in the queue buffer until k_msgq_get_commit() is called.
+ * This avoids copying the message out of the queue, as k_msgq_get() does.
+ *
+ * Only one message can be claimed for reading at once: while it is, or while
+ * a thread waits to claim it, other threads receiving from the queue get
+ * -EBUSY. Purging the queue releases the claimed message.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param q Address of the message queue.
+ * @param msg Address where the address of the claimed message is stored.
+ * @param timeout Waiting period for a message (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message claimed.
+ * @retval -EBUSY A message is already claimed for reading, or the queue is
+ *                empty and other threads are waiting to receive.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+extern int k_msgq_get_claim(struct k_msgq *q, void **msg, s32_t timeout);
+
+/**
+ * @brief Release a message claimed with k_msgq_get_claim().
+ *
+ * The message is removed from the queue, making room for a new message.
+ *
+ * @param q Address of the message queue.
+ *
+ * @return N/A
+ */
+extern void k_msgq_get_commit(struct k_msgq *q);
+
 /**
  * @brief Purge a message queue.
  *
@@ -3423,7 +3877,10 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *q, struct k_msgq_attrs *attrs);
 
 static inline u32_t _impl_k_msgq_num_free_get(struct k_msgq *q)
 {
-	return q->max_msgs - q->used_msgs;
+	/* claimed messages are neither free nor in the queue */
+	return q->max_msgs - q->used_msgs -
+		!!(q->flags & K_MSGQ_FLAG_PUT_CLAIMED) -
+		!!(q->flags & K_MSGQ_FLAG_GET_CLAIMED);
 }
 
 /**
@@ -3696,6 +4153,8 @@ struct k_pipe {
  * @cond INTERNAL_HIDDEN
  */
 #define K_PIPE_FLAG_ALLOC	BIT(0)	/** Buffer was allocated */
+#define K_PIPE_FLAG_PUT_CLAIMED	BIT(1)	/** Buffer space claimed to write */
+#define K_PIPE_FLAG_GET_CLAIMED	BIT(2)	/** Buffer data claimed to read */
 
 #define _K_PIPE_INITIALIZER(obj, pipe_buffer, pipe_buffer_size)        \
 	{                                                             \
@@ -3800,6 +4259,8 @@ __syscall int k_pipe_alloc_init(struct k_pipe *pipe, size_t size);
  * @retval -EIO Returned without waiting; zero data bytes were written.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were written.
+ * @retval -EBUSY Buffer space is claimed with k_pipe_put_claim(); zero
+ *                data bytes were written.
  * @req K-PIPE-002
  */
 __syscall int k_pipe_put(struct k_pipe *pipe, void *data,
@@ -3824,6 +4285,8 @@ __syscall int k_pipe_put(struct k_pipe *pipe, void *data,
  * @retval -EIO Returned without waiting; zero data bytes were read.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were read.
+ * @retval -EBUSY Data is claimed with k_pipe_get_claim(); zero data bytes
+ *                were read.
  * @req K-PIPE-002
  */
 __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
@@ -3848,12 +4311,98 @@ __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 extern void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 			     size_t size, struct k_sem *sem);
 
+/**
+ * @brief Claim buffer space of a pipe for writing in place.
+ *
+ * This routine returns contiguous free space of the buffer of @a pipe, to be
+ * filled by the caller before calling k_pipe_put_commit(). This avoids
+ * copying the data into the pipe, as k_pipe_put() does. The data is only
+ * copied when the commit finds readers waiting for it.
+ *
+ * Only one thread can claim space at once: meanwhile, other threads writing
+ * to the pipe get -EBUSY, and memory blocks written with k_pipe_block_put()
+ * wait for the space to be committed.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address where the address of the claimed space is stored.
+ * @param size Address of the size of the space to claim (in bytes), where
+ *             the size of the claimed space is stored: it can be less, down
+ *             to one byte, when less contiguous space is free.
+ * @param timeout Waiting period for free space (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Space claimed.
+ * @retval -EIO Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Space is already claimed.
+ * @retval -EINVAL The pipe has no buffer.
+ */
+extern int k_pipe_put_claim(struct k_pipe *pipe, void **data, size_t *size,
+			    s32_t timeout);
+
+/**
+ * @brief Write data to a pipe in space claimed with k_pipe_put_claim().
+ *
+ * @param pipe Address of the pipe.
+ * @param bytes Number of bytes written, at most the size claimed.
+ *
+ * @return N/A
+ */
+extern void k_pipe_put_commit(struct k_pipe *pipe, size_t bytes);
+
+/**
+ * @brief Claim data of a pipe for reading in place.
+ *
+ * This routine returns contiguous data of the buffer of @a pipe, which stays
+ * in the pipe until k_pipe_get_commit() is called. This avoids copying the
+ * data out of the pipe, as k_pipe_get() does.
+ *
+ * Only one thread can claim data at once: meanwhile, other threads reading
+ * from the pipe get -EBUSY.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address where the address of the claimed data is stored.
+ * @param size Address of the size of the data to claim (in bytes), where
+ *             the size of the claimed data is stored: it can be less, down
+ *             to one byte, when less contiguous data is available.
+ * @param timeout Waiting period for data (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Data claimed.
+ * @retval -EIO Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Data is already claimed.
+ * @retval -EINVAL The pipe has no buffer.
+ */
+extern int k_pipe_get_claim(struct k_pipe *pipe, void **data, size_t *size,
+			    s32_t timeout);
+
+/**
+ * @brief Read data of a pipe claimed with k_pipe_get_claim().
+ *
+ * The data read is removed from the pipe, making room for new data.
+ *
+ * @param pipe Address of the pipe.
+ * @param bytes Number of bytes read, at most the size claimed.
+ *
+ * @return N/A
+ */
+extern void k_pipe_get_commit(struct k_pipe *pipe, size_t bytes);
+
 /** @} */
 
 /**
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+struct _k_mem_slab_magazine {
+	struct k_spinlock lock;
+	u32_t count;
+	char *blocks[CONFIG_MEM_SLAB_MAGAZINE_SIZE];
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	u32_t num_blocks;
@@ -3862,6 +4411,21 @@ struct k_mem_slab {
 	char *free_list;
 	u32_t num_used;
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	/* blocks cached for each CPU, counted in num_used */
+	struct _k_mem_slab_magazine magazines[CONFIG_MP_NUM_CPUS];
+
+	/* set while a thread may be waiting for a block: frees must
+	 * then go to the slab instead of a magazine
+	 */
+	int waiters;
+#endif
+
+#ifdef CONFIG_MEM_SLAB_STATS
+	u32_t max_used;
+	u32_t failures;
+#endif
+
 	_OBJECT_TRACING_NEXT_PTR(k_mem_slab);
 };
 
@@ -3987,7 +4551,18 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline u32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	u32_t cached = 0;
+	int i;
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cached += slab->magazines[i].count;
+	}
+
+	return slab->num_used - cached;
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -4003,9 +4578,42 @@ static inline u32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline u32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
+}
+
+#ifdef CONFIG_MEM_SLAB_STATS
+/**
+ * @brief Get the high water mark of used blocks in a memory slab.
+ *
+ * This routine gets the largest number of memory blocks that were
+ * allocated at the same time in @a slab. With CONFIG_MEM_SLAB_MAGAZINE,
+ * blocks cached by the CPUs count as allocated.
+ *
+ * @param slab Address of the memory slab.
+ *
+ * @return Largest number of allocated memory blocks.
+ */
+static inline u32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
+{
+	return slab->max_used;
 }
 
+/**
+ * @brief Get the number of failed allocations from a memory slab.
+ *
+ * This routine gets the number of k_mem_slab_alloc() calls on @a slab
+ * that returned without a memory block.
+ *
+ * @param slab Address of the memory slab.
+ *
+ * @return Number of failed allocations.
+ */
+static inline u32_t k_mem_slab_num_failures_get(struct k_mem_slab *slab)
+{
+	return slab->failures;
+}
+#endif
+
 /** @} */
 
 /**
@@ -4061,6 +4669,37 @@ struct k_mem_pool {
 		} \
 	}
 
+/**
+ * @brief Statically define and initialize a TLSF memory pool.
+ *
+ * The memory pool's buffer is @a size bytes long and is aligned to a
+ * @a align -byte boundary. Blocks of any size are carved out of it by a
+ * Two-Level Segregated Fit allocator: requests are rounded up by at most
+ * 1/2^CONFIG_SYS_MEM_POOL_TLSF_SL_LOG2 of their size, plus a two word
+ * header, and allocating or freeing a block takes bounded time. The
+ * allocator bookkeeping is kept at the start of the buffer. The buffer
+ * can be at most 4 MB long.
+ *
+ * The pool is used with the same APIs as pools defined with
+ * K_MEM_POOL_DEFINE(). It requires CONFIG_SYS_MEM_POOL_TLSF.
+ *
+ * @param name Name of the memory pool.
+ * @param size Size of the pool's buffer (in bytes).
+ * @param align Alignment of the pool's buffer (power of 2).
+ */
+#define K_MEM_POOL_TLSF_DEFINE(name, size, align)			\
+	char __aligned(align) _mpool_buf_##name[_ALIGN4(size)];		\
+	struct k_mem_pool name __in_section(_k_mem_pool, static, name) = { \
+		.base = {						\
+			.buf = _mpool_buf_##name,			\
+			.max_sz = _ALIGN4(size),			\
+			.n_max = 1,					\
+			.n_levels = 0,					\
+			.levels = NULL,					\
+			.flags = SYS_MEM_POOL_KERNEL | SYS_MEM_POOL_TLSF \
+		} \
+	}
+
 /**
  * @brief Allocate memory from a memory pool.
  *
@@ -4120,6 +4759,23 @@ extern void k_mem_pool_free(struct k_mem_block *block);
  */
 extern void k_mem_pool_free_id(struct k_mem_block_id *id);
 
+#ifdef CONFIG_MEM_POOL_STATS
+/**
+ * @brief Get the usage statistics of a memory pool.
+ *
+ * This routine gets the bytes currently taken by allocated blocks in
+ * @a pool, their high water mark, the number of failed allocations and
+ * the size of the largest block that can currently be allocated.
+ *
+ * @param pool Address of the memory pool.
+ * @param stats Statistics output.
+ *
+ * @return N/A
+ */
+extern void k_mem_pool_stats_get(struct k_mem_pool *pool,
+				 struct sys_mem_pool_stats *stats);
+#endif
+
 /**
  * @}
  */
@@ -4185,6 +4841,7 @@ extern void *k_calloc(size_t nmemb, size_t size);
 
 /* private - implementation data created as needed, per-type */
 struct _poller {
+	/* polling thread, NULL for the poller of a poll set */
 	struct k_thread *thread;
 };
 
@@ -4293,6 +4950,9 @@ struct k_poll_event {
 	/* PRIVATE - DO NOT TOUCH */
 	sys_dnode_t _node;
 
+	/* PRIVATE - DO NOT TOUCH */
+	sys_dnode_t _ready_node;
+
 	/* PRIVATE - DO NOT TOUCH */
 	struct _poller *poller;
 
@@ -4469,6 +5129,104 @@ __syscall void k_poll_signal_check(struct k_poll_signal *signal,
 
 __syscall int k_poll_signal(struct k_poll_signal *signal, int result);
 
+/* public - poll set object */
+struct k_poll_set {
+	/* PRIVATE - DO NOT TOUCH */
+	struct _poller poller;
+	_wait_q_t wait_q;
+	sys_dlist_t ready;
+};
+
+#define K_POLL_SET_INITIALIZER(obj) \
+	{ \
+	.poller = { .thread = NULL }, \
+	.wait_q = _WAIT_Q_INIT(&obj.wait_q), \
+	.ready = SYS_DLIST_STATIC_INIT(&obj.ready), \
+	}
+
+/**
+ * @brief Statically define and initialize a poll set.
+ *
+ * The poll set can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct k_poll_set <name>; @endcode
+ *
+ * @param name Name of the poll set.
+ */
+#define K_POLL_SET_DEFINE(name) \
+	struct k_poll_set name = K_POLL_SET_INITIALIZER(name)
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * A poll set keeps poll events registered on their objects between waits,
+ * like a persistent k_poll() event array: the cost of adding or removing an
+ * event is paid once, and waiting on the set only costs as much as the
+ * number of ready events, whatever the number of events in the set.
+ *
+ * @param set Address of the poll set.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add a poll event to a poll set.
+ *
+ * The event, initialized with k_poll_event_init(), stays registered on its
+ * object until it is removed from the set: it must not be passed to
+ * k_poll() or added to another set in the meantime. Its state is updated
+ * when it is reported ready by k_poll_set_wait().
+ *
+ * @param set Address of the poll set.
+ * @param event Address of the event.
+ *
+ * @retval 0 Event added.
+ * @retval -EBUSY The event is already registered.
+ */
+extern int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove a poll event from a poll set.
+ *
+ * @param set Address of the poll set.
+ * @param event Address of the event.
+ *
+ * @retval 0 Event removed.
+ * @retval -EINVAL The event is not in the poll set.
+ */
+extern int k_poll_set_remove(struct k_poll_set *set,
+			     struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to be ready.
+ *
+ * This routine waits until at least one event of poll set @a set is ready,
+ * and stores the addresses of up to @a max ready events in @a events. The
+ * events are level triggered: an event is reported by every wait for as
+ * long as its condition is met, e.g. as long as its queue holds data or its
+ * poll signal is not reset. When more than @a max events are ready, the
+ * events reported are rotated between waits.
+ *
+ * As with k_poll(), the objects are not given to the waiting thread, and
+ * threads pending on the objects have precedence over it.
+ *
+ * @param set Address of the poll set.
+ * @param events Array storing the addresses of the ready events.
+ * @param max Size of the @a events array.
+ * @param timeout Waiting period for an event to be ready (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of ready events stored in @a events, 0 with K_NO_WAIT if
+ * no event is ready.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINTR The wait was cancelled with k_queue_cancel_wait() on the
+ *                queue of an event.
+ */
+extern int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+			   int max, s32_t timeout);
+
 /**
  * @internal
  */
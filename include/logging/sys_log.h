@@ -35,6 +35,96 @@ extern "C" {
  * @defgroup system_log System Log
  * @{
  */
+#if defined(CONFIG_SYS_LOG_DEFERRED)
+#include <stdint.h>
+#include <zephyr/types.h>
+#include <misc/util.h>
+
+/**
+ * @brief Largest number of arguments of a deferred log message.
+ *
+ * This includes the four arguments of the message layout (domain, level
+ * tag, function name and color) and the color reset at its end.
+ */
+#define SYS_LOG_DEFERRED_MAX_ARGS 32
+
+/**
+ * @brief Set the log level applied at runtime.
+ *
+ * Deferred log messages of a level above @a level are discarded by the
+ * caller, in addition to the messages filtered out at build time by
+ * SYS_LOG_LEVEL. All the messages pass by default.
+ *
+ * @param level Log level, from SYS_LOG_LEVEL_OFF to SYS_LOG_LEVEL_DEBUG.
+ */
+void sys_log_runtime_level_set(int level);
+
+/**
+ * @brief Get the number of deferred log messages dropped.
+ *
+ * A deferred log message is dropped when the log buffer is full.
+ *
+ * @return Number of messages dropped since boot.
+ */
+u32_t sys_log_dropped_get(void);
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+extern int _sys_log_runtime_level;
+void _sys_log_deferred(int level, const char *fmt, const uintptr_t *args,
+		       int nargs);
+
+#define _SYS_LOG_NARGS(...) _SYS_LOG_NARGS_(__VA_ARGS__, 32, 31, 30, \
+	29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, \
+	13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+#define _SYS_LOG_NARGS_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, \
+	_12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, \
+	_24, _25, _26, _27, _28, _29, _30, _31, _32, N, ...) N
+
+/* Cast each argument to uintptr_t */
+#define _SYS_LOG_A1(a) (uintptr_t)(a)
+#define _SYS_LOG_A2(a, ...) (uintptr_t)(a), _SYS_LOG_A1(__VA_ARGS__)
+#define _SYS_LOG_A3(a, ...) (uintptr_t)(a), _SYS_LOG_A2(__VA_ARGS__)
+#define _SYS_LOG_A4(a, ...) (uintptr_t)(a), _SYS_LOG_A3(__VA_ARGS__)
+#define _SYS_LOG_A5(a, ...) (uintptr_t)(a), _SYS_LOG_A4(__VA_ARGS__)
+#define _SYS_LOG_A6(a, ...) (uintptr_t)(a), _SYS_LOG_A5(__VA_ARGS__)
+#define _SYS_LOG_A7(a, ...) (uintptr_t)(a), _SYS_LOG_A6(__VA_ARGS__)
+#define _SYS_LOG_A8(a, ...) (uintptr_t)(a), _SYS_LOG_A7(__VA_ARGS__)
+#define _SYS_LOG_A9(a, ...) (uintptr_t)(a), _SYS_LOG_A8(__VA_ARGS__)
+#define _SYS_LOG_A10(a, ...) (uintptr_t)(a), _SYS_LOG_A9(__VA_ARGS__)
+#define _SYS_LOG_A11(a, ...) (uintptr_t)(a), _SYS_LOG_A10(__VA_ARGS__)
+#define _SYS_LOG_A12(a, ...) (uintptr_t)(a), _SYS_LOG_A11(__VA_ARGS__)
+#define _SYS_LOG_A13(a, ...) (uintptr_t)(a), _SYS_LOG_A12(__VA_ARGS__)
+#define _SYS_LOG_A14(a, ...) (uintptr_t)(a), _SYS_LOG_A13(__VA_ARGS__)
+#define _SYS_LOG_A15(a, ...) (uintptr_t)(a), _SYS_LOG_A14(__VA_ARGS__)
+#define _SYS_LOG_A16(a, ...) (uintptr_t)(a), _SYS_LOG_A15(__VA_ARGS__)
+#define _SYS_LOG_A17(a, ...) (uintptr_t)(a), _SYS_LOG_A16(__VA_ARGS__)
+#define _SYS_LOG_A18(a, ...) (uintptr_t)(a), _SYS_LOG_A17(__VA_ARGS__)
+#define _SYS_LOG_A19(a, ...) (uintptr_t)(a), _SYS_LOG_A18(__VA_ARGS__)
+#define _SYS_LOG_A20(a, ...) (uintptr_t)(a), _SYS_LOG_A19(__VA_ARGS__)
+#define _SYS_LOG_A21(a, ...) (uintptr_t)(a), _SYS_LOG_A20(__VA_ARGS__)
+#define _SYS_LOG_A22(a, ...) (uintptr_t)(a), _SYS_LOG_A21(__VA_ARGS__)
+#define _SYS_LOG_A23(a, ...) (uintptr_t)(a), _SYS_LOG_A22(__VA_ARGS__)
+#define _SYS_LOG_A24(a, ...) (uintptr_t)(a), _SYS_LOG_A23(__VA_ARGS__)
+#define _SYS_LOG_A25(a, ...) (uintptr_t)(a), _SYS_LOG_A24(__VA_ARGS__)
+#define _SYS_LOG_A26(a, ...) (uintptr_t)(a), _SYS_LOG_A25(__VA_ARGS__)
+#define _SYS_LOG_A27(a, ...) (uintptr_t)(a), _SYS_LOG_A26(__VA_ARGS__)
+#define _SYS_LOG_A28(a, ...) (uintptr_t)(a), _SYS_LOG_A27(__VA_ARGS__)
+#define _SYS_LOG_A29(a, ...) (uintptr_t)(a), _SYS_LOG_A28(__VA_ARGS__)
+#define _SYS_LOG_A30(a, ...) (uintptr_t)(a), _SYS_LOG_A29(__VA_ARGS__)
+#define _SYS_LOG_A31(a, ...) (uintptr_t)(a), _SYS_LOG_A30(__VA_ARGS__)
+#define _SYS_LOG_A32(a, ...) (uintptr_t)(a), _SYS_LOG_A31(__VA_ARGS__)
+
+#define _SYS_LOG_ARGS_(n, ...) _SYS_LOG_A##n(__VA_ARGS__)
+#define _SYS_LOG_ARGS(n, ...) _SYS_LOG_ARGS_(n, __VA_ARGS__)
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+#endif /* CONFIG_SYS_LOG_DEFERRED */
+
 #if defined(CONFIG_SYS_LOG) && (SYS_LOG_LEVEL > SYS_LOG_LEVEL_OFF)
 
 extern void (*syslog_hook)(const char *fmt, ...);
@@ -94,30 +184,56 @@ void syslog_hook_install(void (*hook)(const char *, ...));
 
 /* [domain] [level] function: */
 #define LOG_LAYOUT "[%s]%s %s: %s"
-#define LOG_BACKEND_CALL(log_lv, log_color, log_format, color_off, ...)	\
+#if defined(CONFIG_SYS_LOG_DEFERRED)
+/* The arguments are copied to the log buffer, prefixed by a timestamp,
+ * and formatted later on by the logging thread.
+ */
+#define LOG_BACKEND_CALL(level, log_lv, log_color, log_format, color_off, \
+			 ...)						\
+	do {								\
+		if ((level) <= _sys_log_runtime_level) {		\
+			uintptr_t _log_args[] = {			\
+				_SYS_LOG_ARGS(_SYS_LOG_NARGS(		\
+					SYS_LOG_DOMAIN, log_lv,		\
+					__func__, log_color,		\
+					##__VA_ARGS__, color_off),	\
+				SYS_LOG_DOMAIN, log_lv, __func__,	\
+				log_color, ##__VA_ARGS__, color_off)	\
+			};						\
+			_sys_log_deferred(level, "[%010u] " LOG_LAYOUT	\
+				log_format "%s" SYS_LOG_NL, _log_args,	\
+				ARRAY_SIZE(_log_args));			\
+		}							\
+	} while (0)
+#else
+#define LOG_BACKEND_CALL(level, log_lv, log_color, log_format, color_off, \
+			 ...)						\
 	SYS_LOG_BACKEND_FN(LOG_LAYOUT log_format "%s" SYS_LOG_NL,	\
 	SYS_LOG_DOMAIN, log_lv, __func__, log_color, ##__VA_ARGS__, color_off)
+#endif /* CONFIG_SYS_LOG_DEFERRED */
 
-#define LOG_NO_COLOR(log_lv, log_format, ...)				\
-	LOG_BACKEND_CALL(log_lv, "", log_format, "", ##__VA_ARGS__)
-#define LOG_COLOR(log_lv, log_color, log_format, ...)			\
-	LOG_BACKEND_CALL(log_lv, log_color, log_format,			\
+#define LOG_NO_COLOR(level, log_lv, log_format, ...)			\
+	LOG_BACKEND_CALL(level, log_lv, "", log_format, "", ##__VA_ARGS__)
+#define LOG_COLOR(level, log_lv, log_color, log_format, ...)		\
+	LOG_BACKEND_CALL(level, log_lv, log_color, log_format,		\
 	SYS_LOG_COLOR_OFF, ##__VA_ARGS__)
 
-#define SYS_LOG_ERR(...) LOG_COLOR(SYS_LOG_TAG_ERR, SYS_LOG_COLOR_RED,	\
-	##__VA_ARGS__)
+#define SYS_LOG_ERR(...) LOG_COLOR(SYS_LOG_LEVEL_ERROR, SYS_LOG_TAG_ERR, \
+	SYS_LOG_COLOR_RED, ##__VA_ARGS__)
 
 #if (SYS_LOG_LEVEL >= SYS_LOG_LEVEL_WARNING)
-#define SYS_LOG_WRN(...) LOG_COLOR(SYS_LOG_TAG_WRN,			\
+#define SYS_LOG_WRN(...) LOG_COLOR(SYS_LOG_LEVEL_WARNING, SYS_LOG_TAG_WRN, \
 	SYS_LOG_COLOR_YELLOW, ##__VA_ARGS__)
 #endif
 
 #if (SYS_LOG_LEVEL >= SYS_LOG_LEVEL_INFO)
-#define SYS_LOG_INF(...) LOG_NO_COLOR(SYS_LOG_TAG_INF, ##__VA_ARGS__)
+#define SYS_LOG_INF(...) LOG_NO_COLOR(SYS_LOG_LEVEL_INFO, SYS_LOG_TAG_INF, \
+	##__VA_ARGS__)
 #endif
 
 #if (SYS_LOG_LEVEL == SYS_LOG_LEVEL_DEBUG)
-#define SYS_LOG_DBG(...) LOG_NO_COLOR(SYS_LOG_TAG_DBG, ##__VA_ARGS__)
+#define SYS_LOG_DBG(...) LOG_NO_COLOR(SYS_LOG_LEVEL_DEBUG, SYS_LOG_TAG_DBG, \
+	##__VA_ARGS__)
 #endif
 
 #else
@@ -64,6 +64,38 @@ struct sys_mem_pool_block {
 		.mutex = kmutex,					\
 	}
 
+/**
+ * @brief Statically define a TLSF system memory pool
+ *
+ * The memory pool's buffer is @a size bytes long and is aligned to a
+ * @a align -byte boundary. Blocks of any size are carved out of it by a
+ * Two-Level Segregated Fit allocator, see K_MEM_POOL_TLSF_DEFINE().
+ *
+ * This pool will not be in an initialized state. You will still need to
+ * run sys_mem_pool_init() on it before using any other APIs.
+ *
+ * @param name Name of the memory pool.
+ * @param kmutex Pointer to an initialized k_mutex object, used for
+ *		 synchronization, declared with K_MUTEX_DEFINE().
+ * @param size Size of the pool's buffer (in bytes).
+ * @param align Alignment of the pool's buffer (power of 2).
+ * @param section Destination binary section for pool data
+ */
+#define SYS_MEM_POOL_TLSF_DEFINE(name, kmutex, size, align, section)	\
+	char __aligned(align) _GENERIC_SECTION(section)			\
+		_mpool_buf_##name[_ALIGN4(size)];			\
+	_GENERIC_SECTION(section) struct sys_mem_pool name = {		\
+		.base = {						\
+			.buf = _mpool_buf_##name,			\
+			.max_sz = _ALIGN4(size),			\
+			.n_max = 1,					\
+			.n_levels = 0,					\
+			.levels = NULL,					\
+			.flags = SYS_MEM_POOL_USER | SYS_MEM_POOL_TLSF	\
+		},							\
+		.mutex = kmutex,					\
+	}
+
 /**
  * @brief Initialize a memory pool
  *
@@ -99,4 +131,19 @@ void *sys_mem_pool_alloc(struct sys_mem_pool *p, size_t size);
  */
 void sys_mem_pool_free(void *ptr);
 
+#ifdef CONFIG_MEM_POOL_STATS
+/**
+ * @brief Get the usage statistics of a memory pool
+ *
+ * Get the bytes currently taken by allocated blocks in the pool, their
+ * high water mark, the number of failed allocations and the size of the
+ * largest block that can currently be allocated.
+ *
+ * @param p Address of the memory pool
+ * @param stats Statistics output
+ */
+void sys_mem_pool_stats_get(struct sys_mem_pool *p,
+			    struct sys_mem_pool_stats *stats);
+#endif
+
 #endif
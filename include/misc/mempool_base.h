@@ -9,6 +9,7 @@
 
 #include <zephyr/types.h>
 #include <stddef.h>
+#include <atomic.h>
 
 /*
  * Definitions and macros used by both the IRQ-safe k_mem_pool and user-mode
@@ -25,6 +26,7 @@ struct sys_mem_pool_lvl {
 
 #define SYS_MEM_POOL_KERNEL	0
 #define SYS_MEM_POOL_USER	1
+#define SYS_MEM_POOL_TLSF	2
 
 struct sys_mem_pool_base {
 	void *buf;
@@ -34,6 +36,28 @@ struct sys_mem_pool_base {
 	u8_t max_inline_level;
 	struct sys_mem_pool_lvl *levels;
 	u8_t flags;
+#ifdef CONFIG_MEM_POOL_STATS
+	atomic_t used_bytes;
+	atomic_t peak_bytes;
+	atomic_t failures;
+#endif
+};
+
+/**
+ * @brief Memory pool usage statistics
+ *
+ * Sizes are in bytes of the pool buffer, so include the rounding of
+ * requests up to a block size.
+ */
+struct sys_mem_pool_stats {
+	/** Bytes taken by allocated blocks */
+	u32_t used_bytes;
+	/** Largest value of used_bytes so far */
+	u32_t peak_bytes;
+	/** Number of allocations that failed */
+	u32_t failures;
+	/** Size of the largest block that can be allocated */
+	u32_t max_free_block;
 };
 
 #define _ALIGN4(n) ((((n)+3)/4)*4)
@@ -107,4 +131,52 @@ int _sys_mem_pool_block_alloc(struct sys_mem_pool_base *p, size_t size,
 void _sys_mem_pool_block_free(struct sys_mem_pool_base *p, u32_t level,
 			      u32_t block);
 
+#ifdef CONFIG_MEM_POOL_STATS
+void _sys_mem_pool_base_stats_get(struct sys_mem_pool_base *p,
+				  struct sys_mem_pool_stats *stats);
+
+static inline void _sys_mem_pool_stats_alloc(struct sys_mem_pool_base *p,
+					     size_t bytes)
+{
+	atomic_val_t used = atomic_add(&p->used_bytes, bytes) + bytes;
+	atomic_val_t peak;
+
+	do {
+		peak = atomic_get(&p->peak_bytes);
+		if (used <= peak) {
+			break;
+		}
+	} while (!atomic_cas(&p->peak_bytes, peak, used));
+}
+
+static inline void _sys_mem_pool_stats_free(struct sys_mem_pool_base *p,
+					    size_t bytes)
+{
+	atomic_sub(&p->used_bytes, bytes);
+}
+
+static inline void _sys_mem_pool_stats_failure(struct sys_mem_pool_base *p)
+{
+	atomic_inc(&p->failures);
+}
+#else
+#define _sys_mem_pool_stats_alloc(p, bytes) do { } while (0)
+#define _sys_mem_pool_stats_free(p, bytes) do { } while (0)
+#define _sys_mem_pool_stats_failure(p) do { } while (0)
+#endif
+
+/* Two-Level Segregated Fit backend, used instead of the buddy allocator
+ * for pools flagged SYS_MEM_POOL_TLSF.  Such pools have a single buffer
+ * of max_sz bytes which also holds the allocator bookkeeping.
+ */
+void _sys_mem_pool_tlsf_init(struct sys_mem_pool_base *p);
+
+int _sys_mem_pool_tlsf_alloc(struct sys_mem_pool_base *p, size_t size,
+			     u32_t *level_p, u32_t *block_p, void **data_p);
+
+void _sys_mem_pool_tlsf_free(struct sys_mem_pool_base *p, u32_t level,
+			     u32_t block);
+
+size_t _sys_mem_pool_tlsf_max_free(struct sys_mem_pool_base *p);
+
 #endif /* SYS_MEMPOOL_BASE_H */
@@ -275,6 +275,11 @@ struct net_context {
 		struct k_fifo recv_q;
 		struct k_fifo accept_q;
 	};
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	/** Signal raised once the peer closed the connection */
+	struct k_poll_signal eof_signal;
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
 #endif /* CONFIG_NET_SOCKETS */
 };
 
@@ -779,6 +784,8 @@ int net_context_update_recv_wnd(struct net_context *context,
 
 enum net_context_option {
 	NET_OPT_PRIORITY = 1,
+	NET_OPT_TCP_NODELAY = 2,
+	NET_OPT_TCP_CORK = 3,
 };
 
 /**
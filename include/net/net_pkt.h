@@ -1107,6 +1107,20 @@ bool net_pkt_compact(struct net_pkt *pkt);
 u16_t net_pkt_append(struct net_pkt *pkt, u16_t len, const u8_t *data,
 		     s32_t timeout);
 
+/**
+ * @brief Get the length of data that can still be appended to a packet
+ *
+ * @details For a packet of a network context, net_pkt_append() adds at
+ * most this much data, which the MTU and, for TCP, the MSS of the peer
+ * leave room for.
+ *
+ * @param pkt Network packet.
+ *
+ * @return Length of data that can be appended, UINT16_MAX if the packet
+ *         has no network context.
+ */
+u16_t net_pkt_append_room(struct net_pkt *pkt);
+
 /**
  * @brief Append all data to fragment list of a packet (or fail)
  *
@@ -41,8 +41,52 @@ struct zsock_pollfd {
 #define ZSOCK_POLLOUT 4
 
 #define ZSOCK_MSG_PEEK 0x02
+#define ZSOCK_MSG_TRUNC 0x20
 #define ZSOCK_MSG_DONTWAIT 0x40
 
+/* Values are compatible with Linux */
+#define ZSOCK_TCP_NODELAY 1
+#define ZSOCK_TCP_CORK 3
+
+struct zsock_iovec {
+	void *iov_base;
+	size_t iov_len;
+};
+
+struct zsock_msghdr {
+	void *msg_name;
+	socklen_t msg_namelen;
+	struct zsock_iovec *msg_iov;
+	int msg_iovlen;
+	void *msg_control;
+	socklen_t msg_controllen;
+	int msg_flags;
+};
+
+struct net_buf;
+
+/* Values are compatible with Linux */
+#define ZSOCK_EPOLLIN 0x001
+#define ZSOCK_EPOLLOUT 0x004
+#define ZSOCK_EPOLLERR 0x008
+#define ZSOCK_EPOLLHUP 0x010
+
+#define ZSOCK_EPOLL_CTL_ADD 1
+#define ZSOCK_EPOLL_CTL_DEL 2
+#define ZSOCK_EPOLL_CTL_MOD 3
+
+union zsock_epoll_data {
+	void *ptr;
+	int fd;
+	u32_t u32;
+	u64_t u64;
+};
+
+struct zsock_epoll_event {
+	u32_t events;
+	union zsock_epoll_data data;
+};
+
 struct zsock_addrinfo {
 	struct zsock_addrinfo *ai_next;
 	int ai_flags;
@@ -69,8 +113,47 @@ ssize_t zsock_sendto(int sock, const void *buf, size_t len, int flags,
 		     const struct sockaddr *dest_addr, socklen_t addrlen);
 ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 		       struct sockaddr *src_addr, socklen_t *addrlen);
+ssize_t zsock_sendmsg(int sock, const struct zsock_msghdr *msg, int flags);
+ssize_t zsock_recvmsg(int sock, struct zsock_msghdr *msg, int flags);
+/* Zero-copy receive: the fragments holding the data received are handed
+ * over to the caller, which walks them and gives them back with
+ * zsock_recv_zc_release(). The user data of the first fragment is
+ * reserved until then. ZSOCK_MSG_PEEK is not supported.
+ */
+ssize_t zsock_recv_zc(int sock, struct net_buf **frags, int flags,
+		      struct sockaddr *src_addr, socklen_t *addrlen);
+void zsock_recv_zc_release(int sock, struct net_buf *frags);
+/* Zero-copy send: the caller fills fragments allocated with
+ * zsock_alloc_send_buf(), chained with net_buf_frag_add(), and the
+ * socket takes ownership of them, whether the send succeeds or not.
+ * On a stream socket, a chain longer than a segment is sent in several
+ * packets and the length of those sent is returned.
+ */
+struct net_buf *zsock_alloc_send_buf(int sock, int flags);
+ssize_t zsock_sendto_zc(int sock, struct net_buf *frags, int flags,
+			const struct sockaddr *dest_addr, socklen_t addrlen);
 int zsock_fcntl(int sock, int cmd, int flags);
+/* Only the IPPROTO_TCP level options TCP_NODELAY and TCP_CORK, of int
+ * type, are supported.
+ */
+int zsock_setsockopt(int sock, int level, int optname,
+		     const void *optval, socklen_t optlen);
+int zsock_getsockopt(int sock, int level, int optname,
+		     void *optval, socklen_t *optlen);
 int zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout);
+/* Initialize a poll event ready when the socket is readable, as with
+ * ZSOCK_POLLIN, to be added to a k_poll_set or passed to k_poll()
+ */
+int zsock_poll_event_init(struct k_poll_event *event, int sock);
+/* An epoll instance keeps the sockets registered between waits, and a
+ * wait only costs as much as the number of sockets ready. It is closed
+ * with zsock_close().
+ */
+int zsock_epoll_create(int size);
+int zsock_epoll_ctl(int epfd, int op, int sock,
+		    struct zsock_epoll_event *event);
+int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+		     int maxevents, int timeout);
 int zsock_inet_pton(sa_family_t family, const char *src, void *dst);
 int zsock_getaddrinfo(const char *host, const char *service,
 		      const struct zsock_addrinfo *hints,
@@ -134,6 +217,35 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline ssize_t sendmsg(int sock, const struct zsock_msghdr *msg,
+			      int flags)
+{
+	return zsock_sendmsg(sock, msg, flags);
+}
+
+static inline ssize_t recvmsg(int sock, struct zsock_msghdr *msg, int flags)
+{
+	return zsock_recvmsg(sock, msg, flags);
+}
+
+#define iovec zsock_iovec
+#define msghdr zsock_msghdr
+
+static inline int setsockopt(int sock, int level, int optname,
+			     const void *optval, socklen_t optlen)
+{
+	return zsock_setsockopt(sock, level, optname, optval, optlen);
+}
+
+static inline int getsockopt(int sock, int level, int optname,
+			     void *optval, socklen_t *optlen)
+{
+	return zsock_getsockopt(sock, level, optname, optval, optlen);
+}
+
+#define TCP_NODELAY ZSOCK_TCP_NODELAY
+#define TCP_CORK ZSOCK_TCP_CORK
+
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
 	return zsock_poll(fds, nfds, timeout);
@@ -144,8 +256,36 @@ static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 #define POLLOUT ZSOCK_POLLOUT
 
 #define MSG_PEEK ZSOCK_MSG_PEEK
+#define MSG_TRUNC ZSOCK_MSG_TRUNC
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 
+static inline int epoll_create(int size)
+{
+	return zsock_epoll_create(size);
+}
+
+static inline int epoll_ctl(int epfd, int op, int sock,
+			    struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, sock, event);
+}
+
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+#define epoll_data zsock_epoll_data
+#define epoll_event zsock_epoll_event
+#define EPOLLIN ZSOCK_EPOLLIN
+#define EPOLLOUT ZSOCK_EPOLLOUT
+#define EPOLLERR ZSOCK_EPOLLERR
+#define EPOLLHUP ZSOCK_EPOLLHUP
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+
 static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 			      size_t size)
 {
@@ -200,6 +200,250 @@ int sys_ring_buf_put(struct ring_buf *buf, u16_t type, u8_t value,
 int sys_ring_buf_get(struct ring_buf *buf, u16_t *type, u8_t *value,
 		     u32_t *data, u8_t *size32);
 
+/**
+ * @}
+ */
+
+/**
+ * @brief A structure to represent a byte ring buffer
+ *
+ * The indexes run freely and are only reduced modulo the size, a power of
+ * 2, when accessing the buffer: the ring buffer holds tail - head bytes.
+ */
+struct byte_ring {
+	atomic_t head;	/**< Index of the oldest byte, moved by the consumer */
+	atomic_t tail;	/**< End of the bytes given to the consumer */
+	atomic_t claim;	/**< End of the bytes claimed by MPSC producers */
+	atomic_t pending; /**< MPSC producers between claim and commit */
+	u32_t size;	/**< Size of buf in bytes, a power of 2 */
+	u8_t *buf;	/**< Memory region for stored bytes */
+};
+
+/**
+ * @defgroup byte_ring_apis Byte Ring Buffer APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize a byte ring buffer.
+ *
+ * This macro establishes a byte ring buffer holding 2^pow bytes, where
+ * @a pow is the specified ring buffer size exponent.
+ *
+ * The ring buffer can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct byte_ring <name>; @endcode
+ *
+ * @param name Name of the ring buffer.
+ * @param pow Ring buffer size exponent.
+ */
+#define SYS_BYTE_RING_DECLARE_POW2(name, pow) \
+	static u8_t _byte_ring_data_##name[1 << (pow)]; \
+	struct byte_ring name = { \
+		.size = (1 << (pow)), \
+		.buf = _byte_ring_data_##name \
+	};
+
+/**
+ * @brief Initialize a byte ring buffer.
+ *
+ * This routine initializes a byte ring buffer, prior to its first use. It
+ * is only used for ring buffers not defined using
+ * SYS_BYTE_RING_DECLARE_POW2.
+ *
+ * @param ring Address of ring buffer.
+ * @param size Ring buffer size (in bytes), a power of 2.
+ * @param data Ring buffer data area (typically u8_t data[size]).
+ */
+static inline void sys_byte_ring_init(struct byte_ring *ring, u32_t size,
+				      u8_t *data)
+{
+	__ASSERT(is_power_of_two(size), "size must be a power of 2");
+
+	atomic_clear(&ring->head);
+	atomic_clear(&ring->tail);
+	atomic_clear(&ring->claim);
+	atomic_clear(&ring->pending);
+	ring->size = size;
+	ring->buf = data;
+}
+
+/**
+ * @brief Get the number of bytes available to the consumer.
+ *
+ * @param ring Address of ring buffer.
+ *
+ * @return Number of bytes in the ring buffer.
+ */
+static inline u32_t sys_byte_ring_used_get(struct byte_ring *ring)
+{
+	return (u32_t)atomic_get(&ring->tail) - (u32_t)atomic_get(&ring->head);
+}
+
+/**
+ * @brief Determine if a byte ring buffer is empty.
+ *
+ * @param ring Address of ring buffer.
+ *
+ * @return 1 if the ring buffer is empty, or 0 if not.
+ */
+static inline int sys_byte_ring_is_empty(struct byte_ring *ring)
+{
+	return sys_byte_ring_used_get(ring) == 0;
+}
+
+/**
+ * @brief Determine free space in a byte ring buffer.
+ *
+ * @param ring Address of ring buffer.
+ *
+ * @return Ring buffer free space (in bytes).
+ */
+static inline u32_t sys_byte_ring_space_get(struct byte_ring *ring)
+{
+	return ring->size - ((u32_t)atomic_get(&ring->claim) -
+			     (u32_t)atomic_get(&ring->head));
+}
+
+/**
+ * @brief Claim contiguous space in a byte ring buffer.
+ *
+ * This routine gives the producer direct access to free space of ring
+ * buffer @a ring, to write up to @a size bytes in place. Less space is
+ * returned if the free space is smaller, or if it wraps around the end of
+ * the buffer. The bytes written are handed to the consumer with
+ * sys_byte_ring_put_commit().
+ *
+ * @warning
+ * The single-producer routines must not be used concurrently: use the
+ * MPSC routines if there are several producers. The single producer and
+ * the single consumer can run concurrently without any locking.
+ *
+ * @param ring Address of ring buffer.
+ * @param data Area to store the address of the claimed space.
+ * @param size Number of bytes wanted.
+ *
+ * @return Number of bytes claimed, 0 if the ring buffer is full.
+ */
+u32_t sys_byte_ring_put_claim(struct byte_ring *ring, u8_t **data,
+			      u32_t size);
+
+/**
+ * @brief Hand bytes written in claimed space over to the consumer.
+ *
+ * @param ring Address of ring buffer.
+ * @param size Number of bytes written, at most the space claimed.
+ *
+ * @retval 0 Bytes were committed.
+ * @retval -EINVAL @a size is larger than the free space.
+ */
+int sys_byte_ring_put_commit(struct byte_ring *ring, u32_t size);
+
+/**
+ * @brief Write bytes to a byte ring buffer.
+ *
+ * This routine copies as many bytes of @a data as fit in ring buffer
+ * @a ring, using the single-producer routines.
+ *
+ * @param ring Address of ring buffer.
+ * @param data Address of the bytes.
+ * @param size Number of bytes.
+ *
+ * @return Number of bytes written.
+ */
+u32_t sys_byte_ring_put(struct byte_ring *ring, const u8_t *data,
+			u32_t size);
+
+/**
+ * @brief Claim contiguous space in a byte ring buffer with several
+ * producers.
+ *
+ * This routine works like sys_byte_ring_put_claim(), but can be called
+ * concurrently by several producers, from threads or ISRs, without any
+ * locking. A successful claim must be followed by
+ * sys_byte_ring_mpsc_put_commit() once the space is entirely written:
+ * the consumer only sees the bytes claimed by all producers when every
+ * one of them has committed, so the time between a claim and its commit
+ * should be kept short.
+ *
+ * @param ring Address of ring buffer.
+ * @param data Area to store the address of the claimed space.
+ * @param size Number of bytes wanted.
+ *
+ * @return Number of bytes claimed, 0 if the ring buffer is full.
+ */
+u32_t sys_byte_ring_mpsc_put_claim(struct byte_ring *ring, u8_t **data,
+				   u32_t size);
+
+/**
+ * @brief Hand space claimed by a producer over to the consumer.
+ *
+ * @param ring Address of ring buffer.
+ */
+void sys_byte_ring_mpsc_put_commit(struct byte_ring *ring);
+
+/**
+ * @brief Write bytes to a byte ring buffer with several producers.
+ *
+ * This routine copies as many bytes of @a data as fit in ring buffer
+ * @a ring, using the MPSC routines. The bytes of another producer can be
+ * found in the middle of @a data when it wraps around the end of the
+ * buffer.
+ *
+ * @param ring Address of ring buffer.
+ * @param data Address of the bytes.
+ * @param size Number of bytes.
+ *
+ * @return Number of bytes written.
+ */
+u32_t sys_byte_ring_mpsc_put(struct byte_ring *ring, const u8_t *data,
+			     u32_t size);
+
+/**
+ * @brief Peek at contiguous bytes of a byte ring buffer.
+ *
+ * This routine gives the single consumer direct access to the oldest
+ * bytes of ring buffer @a ring, up to @a size bytes. Fewer bytes are
+ * returned if the ring buffer holds less, or if they wrap around the end
+ * of the buffer. The bytes stay in the ring buffer until they are
+ * released with sys_byte_ring_consume().
+ *
+ * @param ring Address of ring buffer.
+ * @param data Area to store the address of the bytes.
+ * @param size Number of bytes wanted.
+ *
+ * @return Number of bytes available at @a data, 0 if the ring buffer is
+ * empty.
+ */
+u32_t sys_byte_ring_peek(struct byte_ring *ring, u8_t **data, u32_t size);
+
+/**
+ * @brief Release the oldest bytes of a byte ring buffer.
+ *
+ * @param ring Address of ring buffer.
+ * @param size Number of bytes to release.
+ *
+ * @retval 0 Bytes were released.
+ * @retval -EINVAL @a size is larger than the bytes in the ring buffer.
+ */
+int sys_byte_ring_consume(struct byte_ring *ring, u32_t size);
+
+/**
+ * @brief Read bytes from a byte ring buffer.
+ *
+ * This routine copies up to @a size of the oldest bytes of ring buffer
+ * @a ring to @a data, and releases them.
+ *
+ * @param ring Address of ring buffer.
+ * @param data Area to store the bytes.
+ * @param size Size of the area.
+ *
+ * @return Number of bytes read.
+ */
+u32_t sys_byte_ring_get(struct byte_ring *ring, u8_t *data, u32_t size);
+
 /**
  * @}
  */
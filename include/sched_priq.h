@@ -10,7 +10,7 @@
 #include <misc/dlist.h>
 #include <misc/rb.h>
 
-/* Two abstractions are defined here for "thread priority queues".
+/* Three abstractions are defined here for "thread priority queues".
  *
  * One is a "dumb" list implementation appropriate for systems with
  * small numbers of threads and sensitive to code size.  It is stored
@@ -25,10 +25,21 @@
  * much better O(logN) scaling in the presence of large number of
  * threads.
  *
- * Each can be used for either the wait_q or system ready queue,
- * configurable at build time.
+ * The last is the classic multi-queue: one list per priority and a
+ * bitmask of the non-empty lists, giving constant time insertion,
+ * removal and selection of the best thread at the cost of a list head
+ * per priority.  It can only be used for the ready queue: wait queues
+ * are far too numerous to afford the RAM.
+ *
+ * The first two can be used for either the wait_q or system ready
+ * queue, configurable at build time.
  */
 
+#define K_NUM_PRIORITIES \
+	(CONFIG_NUM_COOP_PRIORITIES + CONFIG_NUM_PREEMPT_PRIORITIES + 1)
+
+#define K_NUM_PRIO_BITMAPS ((K_NUM_PRIORITIES + 31) >> 5)
+
 struct k_thread;
 
 struct k_thread *_priq_dumb_best(sys_dlist_t *pq);
@@ -44,4 +55,13 @@ void _priq_rb_add(struct _priq_rb *pq, struct k_thread *thread);
 void _priq_rb_remove(struct _priq_rb *pq, struct k_thread *thread);
 struct k_thread *_priq_rb_best(struct _priq_rb *pq);
 
+struct _priq_mq {
+	sys_dlist_t queues[K_NUM_PRIORITIES];
+	u32_t bitmask[K_NUM_PRIO_BITMAPS];
+};
+
+void _priq_mq_add(struct _priq_mq *pq, struct k_thread *thread);
+void _priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread);
+struct k_thread *_priq_mq_best(struct _priq_mq *pq);
+
 #endif /* _sched_priq__h_ */
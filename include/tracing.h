@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Kernel event tracing
+ *
+ * The kernel reports its events through the sys_trace_*() hooks. When
+ * tracing is enabled, each event is stored as a fixed size binary record
+ * and streamed to the tracing backend, to be converted by
+ * scripts/trace2json.py for timeline viewing.
+ */
+
+#ifndef __TRACING_H__
+#define __TRACING_H__
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Kernel Event Tracing
+ * @defgroup tracing_apis Kernel Event Tracing APIs
+ * @{
+ */
+
+/** Magic number starting a trace stream, in the byte order of the target */
+#define SYS_TRACE_MAGIC 0x5a545243
+
+/** Version of the trace stream format */
+#define SYS_TRACE_VERSION 1
+
+/**
+ * @brief Trace event identifiers
+ */
+enum sys_trace_event_id {
+	SYS_TRACE_ID_DROPPED = 1,	/**< arg: number of events lost */
+	SYS_TRACE_ID_THREAD_CREATE,	/**< arg: thread, data: priority */
+	SYS_TRACE_ID_THREAD_SWITCHED_OUT, /**< arg: thread */
+	SYS_TRACE_ID_THREAD_SWITCHED_IN, /**< arg: thread */
+	SYS_TRACE_ID_ISR_ENTER,		/**< data: interrupt number */
+	SYS_TRACE_ID_ISR_EXIT,
+	SYS_TRACE_ID_SEM_GIVE,		/**< arg: semaphore */
+	SYS_TRACE_ID_SEM_TAKE,		/**< arg: semaphore */
+	SYS_TRACE_ID_MUTEX_LOCK,	/**< arg: mutex */
+	SYS_TRACE_ID_MUTEX_UNLOCK,	/**< arg: mutex */
+	SYS_TRACE_ID_QUEUE_PUT,		/**< arg: queue */
+	SYS_TRACE_ID_QUEUE_GET,		/**< arg: queue */
+	SYS_TRACE_ID_MEM_SLAB_ALLOC,	/**< arg: memory slab */
+	SYS_TRACE_ID_MEM_SLAB_FREE,	/**< arg: memory slab */
+	SYS_TRACE_ID_MEM_POOL_ALLOC,	/**< arg: memory pool */
+	SYS_TRACE_ID_MEM_POOL_FREE,	/**< arg: memory pool */
+	SYS_TRACE_ID_TIMER_EXPIRY,	/**< arg: timer */
+};
+
+/**
+ * @brief Header starting a trace stream
+ */
+struct sys_trace_header {
+	u32_t magic;		/**< SYS_TRACE_MAGIC */
+	u8_t version;		/**< SYS_TRACE_VERSION */
+	u8_t event_size;	/**< Size of an event record in bytes */
+	u16_t reserved;
+	u32_t cycles_per_sec;	/**< Frequency of the event timestamps */
+	u32_t reserved2;
+};
+
+/**
+ * @brief Event record of a trace stream
+ *
+ * Kernel objects are identified by the low 32 bits of their address.
+ */
+struct sys_trace_event {
+	u32_t timestamp;	/**< Hardware cycle count */
+	u8_t id;		/**< Event identifier */
+	u8_t cpu;		/**< CPU the event happened on */
+	u16_t data;		/**< Event specific data */
+	u32_t thread;		/**< Current thread */
+	u32_t arg;		/**< Event specific argument */
+};
+
+/**
+ * @brief Get the number of trace events dropped.
+ *
+ * Events are dropped when the trace buffer is full, because the backend
+ * does not keep up with the events.
+ *
+ * @return Number of events dropped since boot.
+ */
+u32_t sys_trace_dropped_get(void);
+
+#ifdef CONFIG_TRACING_BACKEND_RAM
+/** Trace stream recorded by the RAM backend */
+extern u8_t tracing_ram_buf[CONFIG_TRACING_BACKEND_RAM_SIZE];
+
+/** Number of bytes of the trace stream in tracing_ram_buf */
+extern volatile u32_t tracing_ram_len;
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+#ifdef CONFIG_TRACING
+struct k_thread;
+
+void _sys_trace_event(u8_t id, u16_t data, const void *arg);
+void _sys_trace_thread_switch(struct k_thread *from, struct k_thread *to);
+void _sys_trace_isr_enter(int irq);
+void _sys_trace_isr_exit(void);
+
+#define sys_trace_thread_create(thread, prio) \
+	_sys_trace_event(SYS_TRACE_ID_THREAD_CREATE, prio, thread)
+#define sys_trace_thread_switch(from, to) _sys_trace_thread_switch(from, to)
+#define sys_trace_isr_enter(irq) _sys_trace_isr_enter(irq)
+#define sys_trace_isr_exit() _sys_trace_isr_exit()
+#define sys_trace_sem_give(sem) \
+	_sys_trace_event(SYS_TRACE_ID_SEM_GIVE, 0, sem)
+#define sys_trace_sem_take(sem) \
+	_sys_trace_event(SYS_TRACE_ID_SEM_TAKE, 0, sem)
+#define sys_trace_mutex_lock(mutex) \
+	_sys_trace_event(SYS_TRACE_ID_MUTEX_LOCK, 0, mutex)
+#define sys_trace_mutex_unlock(mutex) \
+	_sys_trace_event(SYS_TRACE_ID_MUTEX_UNLOCK, 0, mutex)
+#define sys_trace_queue_put(queue) \
+	_sys_trace_event(SYS_TRACE_ID_QUEUE_PUT, 0, queue)
+#define sys_trace_queue_get(queue) \
+	_sys_trace_event(SYS_TRACE_ID_QUEUE_GET, 0, queue)
+#define sys_trace_mem_slab_alloc(slab) \
+	_sys_trace_event(SYS_TRACE_ID_MEM_SLAB_ALLOC, 0, slab)
+#define sys_trace_mem_slab_free(slab) \
+	_sys_trace_event(SYS_TRACE_ID_MEM_SLAB_FREE, 0, slab)
+#define sys_trace_mem_pool_alloc(pool) \
+	_sys_trace_event(SYS_TRACE_ID_MEM_POOL_ALLOC, 0, pool)
+#define sys_trace_mem_pool_free(pool) \
+	_sys_trace_event(SYS_TRACE_ID_MEM_POOL_FREE, 0, pool)
+#define sys_trace_timer_expiry(timer) \
+	_sys_trace_event(SYS_TRACE_ID_TIMER_EXPIRY, 0, timer)
+#else
+#define sys_trace_thread_create(thread, prio) do { } while ((0))
+#define sys_trace_thread_switch(from, to) do { } while ((0))
+#define sys_trace_isr_enter(irq) do { } while ((0))
+#define sys_trace_isr_exit() do { } while ((0))
+#define sys_trace_sem_give(sem) do { } while ((0))
+#define sys_trace_sem_take(sem) do { } while ((0))
+#define sys_trace_mutex_lock(mutex) do { } while ((0))
+#define sys_trace_mutex_unlock(mutex) do { } while ((0))
+#define sys_trace_queue_put(queue) do { } while ((0))
+#define sys_trace_queue_get(queue) do { } while ((0))
+#define sys_trace_mem_slab_alloc(slab) do { } while ((0))
+#define sys_trace_mem_slab_free(slab) do { } while ((0))
+#define sys_trace_mem_pool_alloc(pool) do { } while ((0))
+#define sys_trace_mem_pool_free(pool) do { } while ((0))
+#define sys_trace_timer_expiry(timer) do { } while ((0))
+#endif /* CONFIG_TRACING */
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TRACING_H__ */
@@ -6,7 +6,9 @@
 
 #include <errno.h>
 #include <string.h>
+#include <kernel.h>
 #include <device.h>
+#include <init.h>
 #include <misc/util.h>
 #include <atomic.h>
 
@@ -32,6 +34,125 @@ extern u32_t __device_busy_end[];
 #define DEVICE_BUSY_SIZE (__device_busy_end - __device_busy_start)
 #endif
 
+static void device_init(struct device *info)
+{
+	struct device_config *device = info->config;
+#ifdef CONFIG_DEVICE_INIT_STATS
+	u32_t start = k_cycle_get_32();
+#endif
+
+	device->init(info);
+#ifdef CONFIG_DEVICE_INIT_STATS
+	info->init_cycles = k_cycle_get_32() - start;
+#endif
+	_k_object_init(info);
+}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+extern struct device * const __device_independent_start[];
+extern struct device * const __device_independent_end[];
+
+#define INIT_THREADS CONFIG_DEVICE_INIT_PARALLEL_THREADS
+
+static K_THREAD_STACK_ARRAY_DEFINE(init_stacks, INIT_THREADS,
+				   CONFIG_DEVICE_INIT_PARALLEL_STACK_SIZE);
+static struct k_thread init_threads[INIT_THREADS];
+static K_SEM_DEFINE(init_done, 0, INIT_THREADS);
+
+/* devices of the level initialized, scanned in turn by the init threads */
+static struct device *init_level_start, *init_level_end;
+static atomic_t init_next;
+
+static bool device_is_independent(struct device *info)
+{
+	struct device * const *dev;
+
+	for (dev = __device_independent_start; dev < __device_independent_end;
+	     dev++) {
+		if (*dev == info) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void init_thread_entry(void *p1, void *p2, void *p3)
+{
+	struct device *info;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		info = init_level_start + atomic_inc(&init_next);
+		if (info >= init_level_end) {
+			break;
+		}
+
+		if (device_is_independent(info)) {
+			device_init(info);
+		}
+	}
+
+	k_sem_give(&init_done);
+}
+
+/* Start the threads initializing the independent devices of a level */
+static int init_threads_start(int level)
+{
+	struct device *info;
+	int count = 0;
+	int prio, i;
+
+	/* Threads can not be created before the kernel is up */
+	if (level < _SYS_INIT_LEVEL_POST_KERNEL) {
+		return 0;
+	}
+
+	for (info = config_levels[level]; info < config_levels[level+1];
+	     info++) {
+		if (device_is_independent(info)) {
+			count++;
+		}
+	}
+	count = min(count, INIT_THREADS);
+
+	init_level_start = config_levels[level];
+	init_level_end = config_levels[level+1];
+	atomic_set(&init_next, 0);
+
+	prio = k_thread_priority_get(k_current_get());
+	for (i = 0; i < count; i++) {
+		k_thread_create(&init_threads[i], init_stacks[i],
+				K_THREAD_STACK_SIZEOF(init_stacks[i]),
+				init_thread_entry, NULL, NULL, NULL,
+				prio, 0, K_NO_WAIT);
+	}
+
+	return count;
+}
+
+static void init_threads_join(int count)
+{
+	int i;
+
+	for (i = 0; i < count; i++) {
+		k_sem_take(&init_done, K_FOREVER);
+	}
+
+	/* Make sure the threads exited before they are created again */
+	for (i = 0; i < count; i++) {
+		k_thread_abort(&init_threads[i]);
+	}
+}
+#else
+#define device_is_independent(info) false
+#define init_threads_start(level) 0
+#define init_threads_join(count) ARG_UNUSED(count)
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
 /**
  * @brief Execute all the device initialization functions at a given level
  *
@@ -41,19 +162,27 @@ extern u32_t __device_busy_end[];
  * they need to be invoked, with symbols indicating where one level leaves
  * off and the next one begins.
  *
+ * With CONFIG_DEVICE_INIT_PARALLEL, the devices declared independent are
+ * initialized by threads, concurrently with the other devices of the level,
+ * which is complete once all of them are initialized.
+ *
  * @param level init level to run.
  */
 void _sys_device_do_config_level(int level)
 {
 	struct device *info;
+	int threads = init_threads_start(level);
 
 	for (info = config_levels[level]; info < config_levels[level+1];
 								info++) {
-		struct device_config *device = info->config;
+		if (threads && device_is_independent(info)) {
+			continue;
+		}
 
-		device->init(info);
-		_k_object_init(info);
+		device_init(info);
 	}
+
+	init_threads_join(threads);
 }
 
 struct device *device_get_binding(const char *name)
@@ -84,13 +213,6 @@ struct device *device_get_binding(const char *name)
 	return NULL;
 }
 
-#ifdef CONFIG_DEVICE_POWER_MANAGEMENT
-int device_pm_control_nop(struct device *unused_device,
-		       u32_t unused_ctrl_command, void *unused_context)
-{
-	return 0;
-}
-
 void device_list_get(struct device **device_list, int *device_count)
 {
 
@@ -98,6 +220,13 @@ void device_list_get(struct device **device_list, int *device_count)
 	*device_count = __device_init_end - __device_init_start;
 }
 
+#ifdef CONFIG_DEVICE_POWER_MANAGEMENT
+int device_pm_control_nop(struct device *unused_device,
+		       u32_t unused_ctrl_command, void *unused_context)
+{
+	return 0;
+}
+
 
 int device_any_busy_check(void)
 {
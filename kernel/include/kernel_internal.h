@@ -187,10 +187,31 @@ extern void _thread_monitor_exit(struct k_thread *thread);
 	} while (0)
 #endif /* CONFIG_THREAD_MONITOR */
 
+/* account the time the current thread ran, called by the context switch
+ * code of the architecture before it switches to another thread
+ */
+#if defined(CONFIG_THREAD_RUNTIME_STATS)
+extern void _thread_runtime_switch(void);
+#else
+#define _thread_runtime_switch() do { } while ((0))
+#endif
+
 extern void smp_init(void);
 
 extern void smp_timer_init(void);
 
+#ifdef CONFIG_SCHED_IPI_SUPPORTED
+/**
+ * @brief Interrupt the other CPUs so they reschedule
+ *
+ * Implemented by architectures selecting CONFIG_SCHED_IPI_SUPPORTED.
+ * Sends an inter-processor interrupt to all the other CPUs, which are
+ * expected to pick the next thread to run on return from it, as they
+ * do on return from any other interrupt.
+ */
+extern void _arch_sched_ipi(void);
+#endif
+
 #ifdef CONFIG_NEWLIB_LIBC
 /**
  * @brief Fetch dimentions of newlib heap area for _sbrk()
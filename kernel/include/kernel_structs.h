@@ -13,14 +13,10 @@
 #include <atomic.h>
 #include <misc/dlist.h>
 #include <misc/rb.h>
+#include <spinlock.h>
 #include <string.h>
 #endif
 
-#define K_NUM_PRIORITIES \
-	(CONFIG_NUM_COOP_PRIORITIES + CONFIG_NUM_PREEMPT_PRIORITIES + 1)
-
-#define K_NUM_PRIO_BITMAPS ((K_NUM_PRIORITIES + 31) >> 5)
-
 /*
  * Bitmask definitions for the struct k_thread.thread_state field.
  *
@@ -74,10 +70,17 @@ struct _ready_q {
 	struct k_thread *cache;
 #endif
 
-#ifdef CONFIG_SCHED_DUMB
+#if defined(CONFIG_SCHED_DUMB)
 	sys_dlist_t runq;
-#else
+#elif defined(CONFIG_SCHED_SCALABLE)
 	struct _priq_rb runq;
+#elif defined(CONFIG_SCHED_MULTIQ)
+	struct _priq_mq runq;
+#endif
+
+#ifdef CONFIG_SCHED_CPU_QUEUES
+	/* protects runq when each CPU has its own ready queue */
+	struct k_spinlock lock;
 #endif
 };
 
@@ -97,10 +100,29 @@ struct _cpu {
 	struct k_thread *idle_thread;
 
 	int id;
+
+#ifdef CONFIG_SCHED_CPU_QUEUES
+	/* threads ready to run on this CPU */
+	struct _ready_q ready_q;
+#endif
 };
 
 typedef struct _cpu _cpu_t;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_FAST
+struct _timeout_rbq {
+	/* timeouts, sorted by absolute expiry tick */
+	struct rbtree tree;
+
+	/* ticks announced to the queue so far: the expiry time base */
+	u32_t ticks;
+
+	u32_t next_order_key;
+};
+
+extern int _timeout_rb_lessthan(struct rbnode *a, struct rbnode *b);
+#endif
+
 struct _kernel {
 	/* For compatibility with pre-SMP code, union the first CPU
 	 * record with the legacy fields so code can continue to use
@@ -124,8 +146,12 @@ struct _kernel {
 
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 	/* queue of timeouts */
+#ifdef CONFIG_TIMEOUT_QUEUE_FAST
+	struct _timeout_rbq timeout_q;
+#else
 	sys_dlist_t timeout_q;
 #endif
+#endif
 
 #ifdef CONFIG_SYS_POWER_MANAGEMENT
 	s32_t idle; /* Number of ticks for kernel idling */
@@ -240,6 +266,10 @@ static ALWAYS_INLINE void _new_thread_init(struct k_thread *thread,
 	thread->stack_info.start = (u32_t)pStack;
 	thread->stack_info.size = (u32_t)stackSize;
 #endif /* CONFIG_THREAD_STACK_INFO */
+
+#if defined(CONFIG_THREAD_RUNTIME_STATS)
+	thread->runtime_cycles = 0;
+#endif
 }
 
 #if defined(CONFIG_THREAD_MONITOR)
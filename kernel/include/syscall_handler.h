@@ -278,10 +278,33 @@ static inline int _obj_validation_check(struct _k_object *ko,
 	return ret;
 }
 
+#ifdef CONFIG_OBJECT_VALIDATION_CACHE
+/**
+ * Ensure a system object is valid for the current thread, using its cache
+ *
+ * Same as _k_object_validate() on the metadata of @a obj, but the lookup
+ * and the permission check are skipped if the current thread was already
+ * granted access to @a obj, since permissions were last revoked. Errors are
+ * dumped as with _dump_object_error().
+ *
+ * @param obj Untrusted kernel object pointer
+ * @param otype Expected type of the kernel object, or K_OBJ_ANY
+ * @param init Expected initialization state of the kernel object
+ * @return See _k_object_validate()
+ */
+extern int _k_object_validate_cached(void *obj, enum k_objects otype,
+				     enum _obj_init_check init);
+
+#define Z_SYSCALL_IS_OBJ(ptr, type, init) \
+	Z_SYSCALL_VERIFY_MSG( \
+	    !_k_object_validate_cached((void *)ptr, type, init), \
+	    "access denied")
+#else
 #define Z_SYSCALL_IS_OBJ(ptr, type, init) \
 	Z_SYSCALL_VERIFY_MSG( \
 	    !_obj_validation_check(_k_object_find((void *)ptr), (void *)ptr, \
 				   type, init), "access denied")
+#endif /* CONFIG_OBJECT_VALIDATION_CACHE */
 
 /**
  * @brief Runtime check driver object pointer for presence of operation
@@ -15,6 +15,7 @@
  */
 
 #include <misc/dlist.h>
+#include <misc/rb.h>
 #include <drivers/system_timer.h>
 
 #ifdef __cplusplus
@@ -124,6 +125,18 @@ static inline int _abort_timeout(struct _timeout *timeout)
 		return _INACTIVE;
 	}
 
+#ifdef CONFIG_TIMEOUT_QUEUE_FAST
+	if (timeout->delta_ticks_from_prev == _EXPIRED) {
+		/* already moved to the local expired queue */
+		sys_dlist_remove(&timeout->node);
+	} else {
+		rb_remove(&_timeout_q.tree, &timeout->node_rb);
+
+		if (!_timeout_q.tree.root) {
+			_timeout_q.next_order_key = 0;
+		}
+	}
+#else
 	if (!sys_dlist_is_tail(&_timeout_q, &timeout->node)) {
 		sys_dnode_t *next_node =
 			sys_dlist_peek_next(&_timeout_q, &timeout->node);
@@ -132,6 +145,7 @@ static inline int _abort_timeout(struct _timeout *timeout)
 		next->delta_ticks_from_prev += timeout->delta_ticks_from_prev;
 	}
 	sys_dlist_remove(&timeout->node);
+#endif
 	timeout->delta_ticks_from_prev = _INACTIVE;
 
 	return 0;
@@ -164,6 +178,14 @@ static inline void _dump_timeout_q(void)
 #ifdef CONFIG_KERNEL_DEBUG
 	struct _timeout *timeout;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_FAST
+	K_DEBUG("_timeout_q: %p, root: %p, ticks: %u\n",
+		&_timeout_q, _timeout_q.tree.root, _timeout_q.ticks);
+
+	RB_FOR_EACH_CONTAINER(&_timeout_q.tree, timeout, node_rb) {
+		_dump_timeout(timeout, 1);
+	}
+#else
 	K_DEBUG("_timeout_q: %p, head: %p, tail: %p\n",
 		&_timeout_q, _timeout_q.head, _timeout_q.tail);
 
@@ -171,8 +193,43 @@ static inline void _dump_timeout_q(void)
 		_dump_timeout(timeout, 1);
 	}
 #endif
+#endif
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_FAST
+/*
+ * Insert a timeout in the balanced tree, keyed by absolute expiry tick.
+ * Timeouts expiring on the same tick are ordered by insertion, so they are
+ * processed in the order they were added.
+ *
+ * Must be called with interrupts locked.
+ */
+static inline void _timeout_rbq_insert(struct _timeout *timeout, s32_t ticks)
+{
+	struct _timeout *t;
+
+	timeout->expiry = _timeout_q.ticks + ticks;
+	timeout->order_key = _timeout_q.next_order_key++;
+
+	/* Renumber at wraparound, like the scheduler priority queues do */
+	if (!_timeout_q.next_order_key) {
+		RB_FOR_EACH_CONTAINER(&_timeout_q.tree, t, node_rb) {
+			t->order_key = _timeout_q.next_order_key++;
+		}
+	}
+
+	rb_insert(&_timeout_q.tree, &timeout->node_rb);
 }
 
+/* ticks left before the timeout expires, relative to the last announce */
+static inline s32_t _timeout_rbq_remaining(struct _timeout *timeout)
+{
+	s32_t remaining = (s32_t)(timeout->expiry - _timeout_q.ticks);
+
+	return remaining > 0 ? remaining : 0;
+}
+#endif
+
 /*
  * Add timeout to timeout queue. Record waiting thread and wait queue if any.
  *
@@ -190,6 +247,10 @@ static inline void _dump_timeout_q(void)
  * they were queued. This could be changed at the cost of potential longer
  * interrupt latency.
  *
+ * With CONFIG_TIMEOUT_QUEUE_FAST, the timeout is instead inserted in a
+ * balanced tree in O(logN) time, and timeouts expiring on the same tick are
+ * processed in the order they were queued.
+ *
  * Must be called with interrupts locked.
  */
 
@@ -219,7 +280,6 @@ static inline void _add_timeout(struct k_thread *thread,
 	}
 
 	s32_t *delta = &timeout->delta_ticks_from_prev;
-	struct _timeout *in_q;
 
 #ifdef CONFIG_TICKLESS_KERNEL
 	/*
@@ -237,6 +297,11 @@ static inline void _add_timeout(struct k_thread *thread,
 	}
 	adjusted_timeout = *delta;
 #endif
+#ifdef CONFIG_TIMEOUT_QUEUE_FAST
+	_timeout_rbq_insert(timeout, *delta);
+#else
+	struct _timeout *in_q;
+
 	SYS_DLIST_FOR_EACH_CONTAINER(&_timeout_q, in_q, node) {
 		if (*delta <= in_q->delta_ticks_from_prev) {
 			in_q->delta_ticks_from_prev -= *delta;
@@ -251,6 +316,7 @@ static inline void _add_timeout(struct k_thread *thread,
 	sys_dlist_append(&_timeout_q, &timeout->node);
 
 inserted:
+#endif
 	K_DEBUG("after adding timeout %p\n", timeout);
 	_dump_timeout(timeout, 0);
 	_dump_timeout_q();
@@ -281,10 +347,17 @@ static inline void _add_thread_timeout(struct k_thread *thread,
 
 static inline s32_t _get_next_timeout_expiry(void)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_FAST
+	struct rbnode *n = rb_get_min(&_timeout_q.tree);
+
+	return n ? _timeout_rbq_remaining(CONTAINER_OF(n, struct _timeout,
+						       node_rb)) : K_FOREVER;
+#else
 	struct _timeout *t = (struct _timeout *)
 			     sys_dlist_peek_head(&_timeout_q);
 
 	return t ? t->delta_ticks_from_prev : K_FOREVER;
+#endif
 }
 
 #ifdef __cplusplus
@@ -117,7 +117,15 @@ k_tid_t const _idle_thread3 = (k_tid_t)&_idle_thread3_s;
 K_THREAD_STACK_DEFINE(_interrupt_stack3, CONFIG_ISR_STACK_SIZE);
 #endif
 
-#ifdef CONFIG_SYS_CLOCK_EXISTS
+#if defined(CONFIG_TIMEOUT_QUEUE_FAST)
+	#define initialize_timeouts() do { \
+		_timeout_q = (struct _timeout_rbq) { \
+			.tree = { \
+				.lessthan_fn = _timeout_rb_lessthan, \
+			} \
+		}; \
+	} while ((0))
+#elif defined(CONFIG_SYS_CLOCK_EXISTS)
 	#define initialize_timeouts() do { \
 		sys_dlist_init(&_timeout_q); \
 	} while ((0))
@@ -13,6 +13,7 @@
 #include <misc/dlist.h>
 #include <ksched.h>
 #include <init.h>
+#include <tracing.h>
 
 extern struct k_mem_slab _k_mem_slab_list_start[];
 extern struct k_mem_slab _k_mem_slab_list_end[];
@@ -76,33 +77,204 @@ void k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->block_size = block_size;
 	slab->buffer = buffer;
 	slab->num_used = 0;
+#ifdef CONFIG_MEM_SLAB_STATS
+	slab->max_used = 0;
+	slab->failures = 0;
+#endif
 	create_free_list(slab);
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		slab->magazines[i].count = 0;
+	}
+	slab->waiters = 0;
+#endif
 	_waitq_init(&slab->wait_q);
 	SYS_TRACING_OBJ_INIT(k_mem_slab, slab);
 
 	_k_object_init(slab);
 }
 
+#ifdef CONFIG_MEM_SLAB_STATS
+/* Must be called with irq_lock() held. */
+static inline void update_max_used(struct k_mem_slab *slab)
+{
+	if (slab->num_used > slab->max_used) {
+		slab->max_used = slab->num_used;
+	}
+}
+
+static inline void count_failure(struct k_mem_slab *slab)
+{
+	slab->failures++;
+}
+#else
+#define update_max_used(slab) do { } while (0)
+#define count_failure(slab) do { } while (0)
+#endif
+
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+/* Number of blocks moved at once between a magazine and the slab */
+#define MAGAZINE_BATCH ((CONFIG_MEM_SLAB_MAGAZINE_SIZE + 1) / 2)
+
+/*
+ * Each CPU has a magazine of free blocks in every slab: blocks are
+ * allocated from and freed to it without taking the global interrupt
+ * lock.  The magazine lock only masks interrupts on the local CPU, and
+ * under SMP it is only contended when a thread about to block on an
+ * empty slab reclaims the blocks cached by every CPU.
+ *
+ * Lock ordering: irq_lock() first, then a magazine lock.
+ */
+static inline struct _k_mem_slab_magazine *cpu_magazine(
+	struct k_mem_slab *slab)
+{
+	/* A stale CPU id after a migration is harmless: the magazine of
+	 * the other CPU is locked all the same.
+	 */
+	return &slab->magazines[_current_cpu->id];
+}
+
+static int magazine_alloc(struct k_mem_slab *slab, void **mem)
+{
+	struct _k_mem_slab_magazine *mag = cpu_magazine(slab);
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+	int result = -ENOMEM;
+
+	if (mag->count) {
+		*mem = mag->blocks[--mag->count];
+		result = 0;
+	}
+
+	k_spin_unlock(&mag->lock, key);
+
+	return result;
+}
+
+static int magazine_free(struct k_mem_slab *slab, void **mem)
+{
+	struct _k_mem_slab_magazine *mag = cpu_magazine(slab);
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+	int result = -ENOMEM;
+
+	if (!slab->waiters && mag->count < CONFIG_MEM_SLAB_MAGAZINE_SIZE) {
+		mag->blocks[mag->count++] = *mem;
+		result = 0;
+	}
+
+	k_spin_unlock(&mag->lock, key);
+
+	return result;
+}
+
+/* Refill the magazine of the current CPU from the slab free list.
+ * Must be called with irq_lock() held.
+ */
+static void magazine_refill(struct k_mem_slab *slab)
+{
+	struct _k_mem_slab_magazine *mag = cpu_magazine(slab);
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+
+	while (mag->count < MAGAZINE_BATCH && slab->free_list != NULL) {
+		mag->blocks[mag->count++] = slab->free_list;
+		slab->free_list = *(char **)(slab->free_list);
+		slab->num_used++;
+	}
+	update_max_used(slab);
+
+	k_spin_unlock(&mag->lock, key);
+}
+
+/* Move blocks from a magazine back to the slab free list, leaving at
+ * most @a keep blocks in it.  Must be called with irq_lock() held.
+ */
+static void magazine_flush(struct k_mem_slab *slab,
+			   struct _k_mem_slab_magazine *mag, u32_t keep)
+{
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+
+	while (mag->count > keep) {
+		char *block = mag->blocks[--mag->count];
+
+		*(char **)block = slab->free_list;
+		slab->free_list = block;
+		slab->num_used--;
+	}
+
+	k_spin_unlock(&mag->lock, key);
+}
+
+/* Give the blocks cached by all CPUs back to the slab, before the
+ * current thread waits for one.  Setting the waiters flag first
+ * guarantees that no block is freed to a magazine after it has been
+ * flushed.  Must be called with irq_lock() held.
+ */
+static void magazine_reclaim(struct k_mem_slab *slab)
+{
+	int i;
+
+	slab->waiters = 1;
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		magazine_flush(slab, &slab->magazines[i], 0);
+	}
+}
+
+/* Must be called with irq_lock() held. */
+static void update_waiters(struct k_mem_slab *slab)
+{
+	slab->waiters = _waitq_head(&slab->wait_q) != NULL;
+}
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
 {
-	unsigned int key = irq_lock();
+	unsigned int key;
 	int result;
 
+	sys_trace_mem_slab_alloc(slab);
+
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	if (magazine_alloc(slab, mem) == 0) {
+		return 0;
+	}
+#endif
+
+	key = irq_lock();
+
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	if (slab->free_list == NULL) {
+		magazine_reclaim(slab);
+	}
+#endif
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
 		slab->free_list = *(char **)(slab->free_list);
 		slab->num_used++;
+		update_max_used(slab);
 		result = 0;
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+		magazine_refill(slab);
+		update_waiters(slab);
+#endif
 	} else if (timeout == K_NO_WAIT) {
 		/* don't wait for a free block to become available */
 		*mem = NULL;
 		result = -ENOMEM;
+		count_failure(slab);
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+		update_waiters(slab);
+#endif
 	} else {
 		/* wait for a free block or timeout */
 		result = _pend_current_thread(key, &slab->wait_q, timeout);
 		if (result == 0) {
 			*mem = _current->base.swap_data;
+		} else {
+			key = irq_lock();
+			count_failure(slab);
+			irq_unlock(key);
 		}
 		return result;
 	}
@@ -114,17 +286,37 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
-	int key = irq_lock();
-	struct k_thread *pending_thread = _unpend_first_thread(&slab->wait_q);
+	int key;
+	struct k_thread *pending_thread;
+
+	sys_trace_mem_slab_free(slab);
+
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	if (magazine_free(slab, mem) == 0) {
+		return;
+	}
+#endif
+
+	key = irq_lock();
+	pending_thread = _unpend_first_thread(&slab->wait_q);
 
 	if (pending_thread) {
 		_set_thread_return_value_with_data(pending_thread, 0, *mem);
 		_ready_thread(pending_thread);
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+		update_waiters(slab);
+#endif
 		_reschedule(key);
 	} else {
 		**(char ***)mem = slab->free_list;
 		slab->free_list = *(char **)mem;
 		slab->num_used--;
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+		/* the magazine of the current CPU is likely full */
+		magazine_flush(slab, cpu_magazine(slab),
+			       CONFIG_MEM_SLAB_MAGAZINE_SIZE - MAGAZINE_BATCH);
+		update_waiters(slab);
+#endif
 		irq_unlock(key);
 	}
 }
@@ -10,6 +10,7 @@
 #include <init.h>
 #include <string.h>
 #include <misc/__assert.h>
+#include <tracing.h>
 
 /* Linker-defined symbols bound the static pool structs */
 extern struct k_mem_pool _k_mem_pool_list_start[];
@@ -55,6 +56,8 @@ int k_mem_pool_alloc(struct k_mem_pool *p, struct k_mem_block *block,
 
 	__ASSERT(!(_is_in_isr() && timeout != K_NO_WAIT), "");
 
+	sys_trace_mem_pool_alloc(p);
+
 	if (timeout > 0) {
 		end = _tick_get() + _ms_to_ticks(timeout);
 	}
@@ -88,6 +91,9 @@ int k_mem_pool_alloc(struct k_mem_pool *p, struct k_mem_block *block,
 
 		if (ret == 0 || timeout == K_NO_WAIT ||
 		    (ret && ret != -ENOMEM)) {
+			if (ret) {
+				_sys_mem_pool_stats_failure(&p->base);
+			}
 			return ret;
 		}
 
@@ -102,6 +108,8 @@ int k_mem_pool_alloc(struct k_mem_pool *p, struct k_mem_block *block,
 		}
 	}
 
+	_sys_mem_pool_stats_failure(&p->base);
+
 	return -EAGAIN;
 }
 
@@ -110,6 +118,8 @@ void k_mem_pool_free_id(struct k_mem_block_id *id)
 	int key, need_sched = 0;
 	struct k_mem_pool *p = get_pool(id->pool);
 
+	sys_trace_mem_pool_free(p);
+
 	_sys_mem_pool_block_free(&p->base, id->level, id->block);
 
 	/* Wake up anyone blocked on this pool and let them repeat
@@ -131,6 +141,14 @@ void k_mem_pool_free(struct k_mem_block *block)
 	k_mem_pool_free_id(&block->id);
 }
 
+#ifdef CONFIG_MEM_POOL_STATS
+void k_mem_pool_stats_get(struct k_mem_pool *pool,
+			  struct sys_mem_pool_stats *stats)
+{
+	_sys_mem_pool_base_stats_get(&pool->base, stats);
+}
+#endif
+
 void *k_mem_pool_malloc(struct k_mem_pool *pool, size_t size)
 {
 	struct k_mem_block block;
@@ -174,7 +192,11 @@ void k_free(void *ptr)
  * that has the address of the associated memory pool struct.
  */
 
+#ifdef CONFIG_HEAP_MEM_POOL_TLSF
+K_MEM_POOL_TLSF_DEFINE(_heap_mem_pool, CONFIG_HEAP_MEM_POOL_SIZE, 4);
+#else
 K_MEM_POOL_DEFINE(_heap_mem_pool, 64, CONFIG_HEAP_MEM_POOL_SIZE, 1, 4);
+#endif
 #define _HEAP_MEM_POOL (&_heap_mem_pool)
 
 void *k_malloc(size_t size)
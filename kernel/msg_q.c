@@ -108,36 +108,109 @@ void k_msgq_cleanup(struct k_msgq *q)
 }
 
 
-int _impl_k_msgq_put(struct k_msgq *q, void *data, s32_t timeout)
+static inline char *next_msg(struct k_msgq *q, char *msg)
 {
-	__ASSERT(!_is_in_isr() || timeout == K_NO_WAIT, "");
+	msg += q->msg_size;
+	return msg == q->buffer_end ? q->buffer_start : msg;
+}
 
-	unsigned int key = irq_lock();
+static inline char *prev_msg(struct k_msgq *q, char *msg)
+{
+	if (msg == q->buffer_start) {
+		msg = q->buffer_end;
+	}
+	return msg - q->msg_size;
+}
+
+/*
+ * Send the message at @a data, handing it to the first waiting thread if
+ * any, which can only be a receiver. A thread waiting to claim a message
+ * gets it in place, any other receiver gets a copy.
+ *
+ * Must be called with interrupts locked, unlocks them.
+ */
+static int msgq_push(struct k_msgq *q, unsigned int key, void *data)
+{
 	struct k_thread *pending_thread;
-	int result;
 
-	if (q->used_msgs < q->max_msgs) {
-		/* message queue isn't full */
-		pending_thread = _unpend_first_thread(&q->wait_q);
+	pending_thread = _unpend_first_thread(&q->wait_q);
+	if (pending_thread && pending_thread->base.swap_data) {
+		/* give message to waiting thread */
+		memcpy(pending_thread->base.swap_data, data, q->msg_size);
+	} else {
+		/* put message in queue */
+		if (data != q->write_ptr) {
+			memcpy(q->write_ptr, data, q->msg_size);
+		}
+		q->write_ptr = next_msg(q, q->write_ptr);
+
 		if (pending_thread) {
-			/* give message to waiting thread */
-			memcpy(pending_thread->base.swap_data, data,
-			       q->msg_size);
-			/* wake up waiting thread */
-			_set_thread_return_value(pending_thread, 0);
-			_ready_thread(pending_thread);
-			_reschedule(key);
-			return 0;
+			/* the queue is empty: the message is the first one */
+			q->read_ptr = q->write_ptr;
+			q->flags &= ~K_MSGQ_FLAG_GET_WAITING;
+			q->flags |= K_MSGQ_FLAG_GET_CLAIMED;
 		} else {
-			/* put message in queue */
-			memcpy(q->write_ptr, data, q->msg_size);
-			q->write_ptr += q->msg_size;
-			if (q->write_ptr == q->buffer_end) {
-				q->write_ptr = q->buffer_start;
-			}
 			q->used_msgs++;
 		}
-		result = 0;
+	}
+
+	if (!pending_thread) {
+		irq_unlock(key);
+		return 0;
+	}
+
+	/* wake up waiting thread */
+	_set_thread_return_value(pending_thread, 0);
+	_ready_thread(pending_thread);
+	_reschedule(key);
+	return 0;
+}
+
+/*
+ * Handle the first thread waiting to send, if any, now that a message is
+ * free. A thread waiting to claim a message gets the free one.
+ *
+ * Must be called with interrupts locked, unlocks them.
+ */
+static void msgq_refill(struct k_msgq *q, unsigned int key)
+{
+	struct k_thread *pending_thread;
+
+	pending_thread = _unpend_first_thread(&q->wait_q);
+	if (!pending_thread) {
+		irq_unlock(key);
+		return;
+	}
+
+	if (pending_thread->base.swap_data) {
+		/* add thread's message to queue */
+		memcpy(q->write_ptr, pending_thread->base.swap_data,
+		       q->msg_size);
+		q->write_ptr = next_msg(q, q->write_ptr);
+		q->used_msgs++;
+	} else {
+		q->flags &= ~K_MSGQ_FLAG_PUT_WAITING;
+		q->flags |= K_MSGQ_FLAG_PUT_CLAIMED;
+	}
+
+	/* wake up waiting thread */
+	_set_thread_return_value(pending_thread, 0);
+	_ready_thread(pending_thread);
+	_reschedule(key);
+}
+
+int _impl_k_msgq_put(struct k_msgq *q, void *data, s32_t timeout)
+{
+	__ASSERT(!_is_in_isr() || timeout == K_NO_WAIT, "");
+
+	unsigned int key = irq_lock();
+	int result;
+
+	if (q->flags & (K_MSGQ_FLAG_PUT_CLAIMED | K_MSGQ_FLAG_PUT_WAITING)) {
+		result = -EBUSY;
+	} else if (_impl_k_msgq_num_free_get(q) > 0) {
+		/* message queue isn't full */
+		return msgq_push(q, key, data);
 	} else if (timeout == K_NO_WAIT) {
 		/* don't wait for message space to become available */
 		result = -ENOMSG;
@@ -188,37 +261,19 @@ int _impl_k_msgq_get(struct k_msgq *q, void *data, s32_t timeout)
 	__ASSERT(!_is_in_isr() || timeout == K_NO_WAIT, "");
 
 	unsigned int key = irq_lock();
-	struct k_thread *pending_thread;
 	int result;
 
-	if (q->used_msgs > 0) {
+	if (q->flags & (K_MSGQ_FLAG_GET_CLAIMED | K_MSGQ_FLAG_GET_WAITING)) {
+		result = -EBUSY;
+	} else if (q->used_msgs > 0) {
 		/* take first available message from queue */
 		memcpy(data, q->read_ptr, q->msg_size);
-		q->read_ptr += q->msg_size;
-		if (q->read_ptr == q->buffer_end) {
-			q->read_ptr = q->buffer_start;
-		}
+		q->read_ptr = next_msg(q, q->read_ptr);
 		q->used_msgs--;
 
 		/* handle first thread waiting to write (if any) */
-		pending_thread = _unpend_first_thread(&q->wait_q);
-		if (pending_thread) {
-			/* add thread's message to queue */
-			memcpy(q->write_ptr, pending_thread->base.swap_data,
-			       q->msg_size);
-			q->write_ptr += q->msg_size;
-			if (q->write_ptr == q->buffer_end) {
-				q->write_ptr = q->buffer_start;
-			}
-			q->used_msgs++;
-
-			/* wake up waiting thread */
-			_set_thread_return_value(pending_thread, 0);
-			_ready_thread(pending_thread);
-			_reschedule(key);
-			return 0;
-		}
-		result = 0;
+		msgq_refill(q, key);
+		return 0;
 	} else if (timeout == K_NO_WAIT) {
 		/* don't wait for a message to become available */
 		result = -ENOMSG;
@@ -245,6 +300,117 @@ Z_SYSCALL_HANDLER(k_msgq_get, msgq_p, data, timeout)
 }
 #endif
 
+/*
+ * Messages are claimed in place. A claimed message is out of the queue, but
+ * its buffer stays reserved until the claim is committed, so that the queue
+ * has one message less room meanwhile. Operations at the end of the queue a
+ * message is claimed at, or waited for, fail with -EBUSY: the threads
+ * waiting on a queue thus remain either all senders, when the queue is
+ * full, or all receivers, when it is empty, as without claims.
+ *
+ * A thread waiting to claim a message pends without a message buffer, and
+ * is granted its claim by the thread giving it a message or room.
+ */
+int k_msgq_put_claim(struct k_msgq *q, void **msg, s32_t timeout)
+{
+	__ASSERT(!_is_in_isr() || timeout == K_NO_WAIT, "");
+
+	unsigned int key = irq_lock();
+	int result;
+
+	if (q->flags & (K_MSGQ_FLAG_PUT_CLAIMED | K_MSGQ_FLAG_PUT_WAITING)) {
+		result = -EBUSY;
+	} else if (_impl_k_msgq_num_free_get(q) > 0) {
+		q->flags |= K_MSGQ_FLAG_PUT_CLAIMED;
+		*msg = q->write_ptr;
+		result = 0;
+	} else if (timeout == K_NO_WAIT) {
+		result = -ENOMSG;
+	} else if (_waitq_head(&q->wait_q)) {
+		/* other senders are waiting for room */
+		result = -EBUSY;
+	} else {
+		q->flags |= K_MSGQ_FLAG_PUT_WAITING;
+		_current->base.swap_data = NULL;
+
+		result = _pend_current_thread(key, &q->wait_q, timeout);
+
+		key = irq_lock();
+		if (result == 0) {
+			*msg = q->write_ptr;
+		} else {
+			q->flags &= ~K_MSGQ_FLAG_PUT_WAITING;
+		}
+	}
+
+	irq_unlock(key);
+
+	return result;
+}
+
+void k_msgq_put_commit(struct k_msgq *q)
+{
+	unsigned int key = irq_lock();
+
+	__ASSERT(q->flags & K_MSGQ_FLAG_PUT_CLAIMED, "no message claimed");
+
+	q->flags &= ~K_MSGQ_FLAG_PUT_CLAIMED;
+	(void)msgq_push(q, key, q->write_ptr);
+}
+
+int k_msgq_get_claim(struct k_msgq *q, void **msg, s32_t timeout)
+{
+	__ASSERT(!_is_in_isr() || timeout == K_NO_WAIT, "");
+
+	unsigned int key = irq_lock();
+	int result;
+
+	if (q->flags & (K_MSGQ_FLAG_GET_CLAIMED | K_MSGQ_FLAG_GET_WAITING)) {
+		result = -EBUSY;
+	} else if (q->used_msgs > 0) {
+		q->flags |= K_MSGQ_FLAG_GET_CLAIMED;
+		*msg = q->read_ptr;
+		q->read_ptr = next_msg(q, q->read_ptr);
+		q->used_msgs--;
+		result = 0;
+	} else if (timeout == K_NO_WAIT) {
+		result = -ENOMSG;
+	} else if (_waitq_head(&q->wait_q)) {
+		/* other receivers are waiting for a message */
+		result = -EBUSY;
+	} else {
+		q->flags |= K_MSGQ_FLAG_GET_WAITING;
+		_current->base.swap_data = NULL;
+
+		result = _pend_current_thread(key, &q->wait_q, timeout);
+
+		key = irq_lock();
+		if (result == 0) {
+			*msg = prev_msg(q, q->read_ptr);
+		} else {
+			q->flags &= ~K_MSGQ_FLAG_GET_WAITING;
+		}
+	}
+
+	irq_unlock(key);
+
+	return result;
+}
+
+void k_msgq_get_commit(struct k_msgq *q)
+{
+	unsigned int key = irq_lock();
+
+	/* the claim is dropped if the queue was purged */
+	if (!(q->flags & K_MSGQ_FLAG_GET_CLAIMED)) {
+		irq_unlock(key);
+		return;
+	}
+
+	q->flags &= ~K_MSGQ_FLAG_GET_CLAIMED;
+	msgq_refill(q, key);
+}
+
 void _impl_k_msgq_purge(struct k_msgq *q)
 {
 	unsigned int key = irq_lock();
@@ -258,6 +424,7 @@ void _impl_k_msgq_purge(struct k_msgq *q)
 
 	q->used_msgs = 0;
 	q->read_ptr = q->write_ptr;
+	q->flags &= ~K_MSGQ_FLAG_GET_CLAIMED;
 
 	_reschedule(key);
 }
@@ -13,6 +13,15 @@
  * level of the owning thread to match the priority level of the highest
  * priority thread waiting on the mutex.
  *
+ * The inheritance is transitive: when the owning thread is itself waiting on
+ * another mutex, the owner of that mutex is boosted too, and so on up to
+ * CONFIG_MUTEX_PRIORITY_INHERITANCE_DEPTH owners. Since wait queues are kept
+ * sorted when the priority of a waiting thread changes, a boosted owner is
+ * also first in line for the mutex it is waiting on. When a thread stops
+ * waiting because of a timeout, only the owner of the mutex it was waiting on
+ * gets its priority lowered again; owners further along the chain keep their
+ * boost until they release their mutex.
+ *
  * Each mutex that contributes to priority inheritance must be released in the
  * reverse order in which it was acquired.  Furthermore each subsequent mutex
  * that contributes to raising the owning thread's priority level must be
@@ -36,6 +45,7 @@
 #include <errno.h>
 #include <init.h>
 #include <syscall_handler.h>
+#include <tracing.h>
 
 #define RECORD_STATE_CHANGE(mutex) do { } while ((0))
 #define RECORD_CONFLICT(mutex) do { } while ((0))
@@ -113,10 +123,44 @@ static void adjust_owner_prio(struct k_mutex *mutex, int new_prio)
 	}
 }
 
+/*
+ * Boost the owner of a mutex to the priority of a thread about to wait on it,
+ * then the owners of the mutexes each boosted owner is waiting on. The walk
+ * stops at an owner already running at that priority or higher, and after
+ * CONFIG_MUTEX_PRIORITY_INHERITANCE_DEPTH owners, which also ends it on
+ * deadlocks. Called with interrupts locked.
+ */
+static void inherit_prio(struct k_mutex *mutex, int prio)
+{
+	int depth;
+
+	for (depth = 0; depth < CONFIG_MUTEX_PRIORITY_INHERITANCE_DEPTH;
+	     depth++) {
+		struct k_thread *owner = mutex->owner;
+		int new_prio = new_prio_for_inheritance(prio, owner->base.prio);
+
+		if (!_is_prio_higher(new_prio, owner->base.prio)) {
+			break;
+		}
+
+		K_DEBUG("adjusting prio up on mutex %p\n", mutex);
+
+		adjust_owner_prio(mutex, new_prio);
+
+		mutex = owner->pended_mutex;
+		if (!mutex || !_is_thread_pending(owner)) {
+			break;
+		}
+		prio = new_prio;
+	}
+}
+
 int _impl_k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 {
 	int new_prio, key;
 
+	sys_trace_mutex_lock(mutex);
+
 	_sched_lock();
 
 	if (likely(mutex->lock_count == 0 || mutex->owner == _current)) {
@@ -146,19 +190,16 @@ int _impl_k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 		return -EBUSY;
 	}
 
-	new_prio = new_prio_for_inheritance(_current->base.prio,
-					    mutex->owner->base.prio);
-
 	key = irq_lock();
 
-	K_DEBUG("adjusting prio up on mutex %p\n", mutex);
+	inherit_prio(mutex, _current->base.prio);
 
-	if (_is_prio_higher(new_prio, mutex->owner->base.prio)) {
-		adjust_owner_prio(mutex, new_prio);
-	}
+	_current->pended_mutex = mutex;
 
 	int got_mutex = _pend_current_thread(key, &mutex->wait_q, timeout);
 
+	_current->pended_mutex = NULL;
+
 	K_DEBUG("on mutex %p got_mutex value: %d\n", mutex, got_mutex);
 
 	K_DEBUG("%p got mutex %p (y/n): %c\n", _current, mutex,
@@ -205,6 +246,8 @@ void _impl_k_mutex_unlock(struct k_mutex *mutex)
 	__ASSERT(mutex->lock_count > 0, "");
 	__ASSERT(mutex->owner == _current, "");
 
+	sys_trace_mutex_unlock(mutex);
+
 	_sched_lock();
 
 	RECORD_STATE_CHANGE();
@@ -226,6 +269,10 @@ void _impl_k_mutex_unlock(struct k_mutex *mutex)
 
 	mutex->owner = new_owner;
 
+	if (new_owner) {
+		new_owner->pended_mutex = NULL;
+	}
+
 	K_DEBUG("new owner of mutex %p: %p (prio: %d)\n",
 		mutex, new_owner, new_owner ? new_owner->base.prio : -1000);
 
@@ -21,6 +21,8 @@
 #include <syscall_handler.h>
 #include <misc/__assert.h>
 
+s64_t _tick_get(void);
+
 struct k_pipe_desc {
 	unsigned char *buffer;           /* Position in src/dest buffer */
 	size_t bytes_to_xfer;            /* # bytes left to transfer */
@@ -107,6 +109,7 @@ static int init_pipes_module(struct device *dev)
 	for (int i = 0; i < CONFIG_NUM_PIPE_ASYNC_MSGS; i++) {
 		async_msg[i].thread.thread_state = _THREAD_DUMMY;
 		async_msg[i].thread.swap_data = &async_msg[i].desc;
+		_init_thread_timeout(&async_msg[i].thread);
 		k_stack_push(&pipe_async_msgs, (u32_t)&async_msg[i]);
 	}
 #endif /* CONFIG_NUM_PIPE_ASYNC_MSGS > 0 */
@@ -444,6 +447,23 @@ int _k_pipe_put_internal(struct k_pipe *pipe, struct k_pipe_async *async_desc,
 
 	key = irq_lock();
 
+	if (pipe->flags & K_PIPE_FLAG_PUT_CLAIMED) {
+#if (CONFIG_NUM_PIPE_ASYNC_MSGS > 0)
+		if (async_desc != NULL) {
+			/* Written once the claimed space is committed */
+			async_desc->desc.buffer = data;
+			async_desc->desc.bytes_to_xfer = bytes_to_write;
+			_pend_thread((struct k_thread *) &async_desc->thread,
+				     &pipe->wait_q.writers, K_FOREVER);
+			irq_unlock(key);
+			return 0;
+		}
+#endif
+		irq_unlock(key);
+		*bytes_written = 0;
+		return -EBUSY;
+	}
+
 	/*
 	 * Create a list of "working readers" into which the data will be
 	 * directly copied.
@@ -531,6 +551,10 @@ int _k_pipe_put_internal(struct k_pipe *pipe, struct k_pipe_async *async_desc,
 
 #if (CONFIG_NUM_PIPE_ASYNC_MSGS > 0)
 	if (async_desc != NULL) {
+		async_desc->desc.buffer = data + num_bytes_written;
+		async_desc->desc.bytes_to_xfer =
+			bytes_to_write - num_bytes_written;
+
 		/*
 		 * Lock interrupts and unlock the scheduler before
 		 * manipulating the writers wait_q.
@@ -574,6 +598,8 @@ int _impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 	struct k_thread    *writer;
 	struct k_pipe_desc *desc;
 	sys_dlist_t    xfer_list;
+	_wait_q_t      *writers = &pipe->wait_q.writers;
+	_wait_q_t      no_writers;
 	unsigned int   key;
 	size_t         num_bytes_read = 0;
 	size_t         bytes_copied;
@@ -583,12 +609,27 @@ int _impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 
 	key = irq_lock();
 
+	if (pipe->flags & K_PIPE_FLAG_GET_CLAIMED) {
+		irq_unlock(key);
+		*bytes_read = 0;
+		return -EBUSY;
+	}
+
+	/*
+	 * The writers waiting for claimed space to be committed would be
+	 * copied into it: leave them to k_pipe_put_commit().
+	 */
+	if (pipe->flags & K_PIPE_FLAG_PUT_CLAIMED) {
+		_waitq_init(&no_writers);
+		writers = &no_writers;
+	}
+
 	/*
 	 * Create a list of "working readers" into which the data will be
 	 * directly copied.
 	 */
 
-	if (!pipe_xfer_prepare(&xfer_list, &writer, &pipe->wait_q.writers,
+	if (!pipe_xfer_prepare(&xfer_list, &writer, writers,
 				pipe->bytes_used, bytes_to_read,
 				min_xfer, timeout)) {
 		irq_unlock(key);
@@ -777,3 +818,270 @@ void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 				    bytes_to_write, K_FOREVER);
 }
 #endif
+
+/**
+ * @brief Claim contiguous space or data of the pipe's circular buffer
+ *
+ * The space claimed is not counted in the bytes used until committed, the
+ * data claimed remains counted until committed. Other writers, respectively
+ * readers, are refused meanwhile.
+ *
+ * A thread waiting for a claim pends as a writer or reader of no data: it is
+ * readied by the next transfer in the other direction, and tries again.
+ */
+static int pipe_claim(struct k_pipe *pipe, u8_t flag, void **data,
+		       size_t *size, s32_t timeout)
+{
+	struct k_pipe_desc pipe_desc = { .buffer = NULL, .bytes_to_xfer = 0 };
+	unsigned int key;
+	s64_t end = 0;
+	int rc = -EIO;
+
+	__ASSERT(!_is_in_isr() || timeout == K_NO_WAIT, "");
+	__ASSERT(*size > 0, "");
+
+	if (!pipe->size) {
+		return -EINVAL;
+	}
+
+	if (timeout > 0) {
+		end = _tick_get() + _ms_to_ticks(timeout);
+	}
+
+	while (1) {
+		key = irq_lock();
+
+		if (pipe->flags & flag) {
+			irq_unlock(key);
+			return -EBUSY;
+		}
+
+		if (flag == K_PIPE_FLAG_PUT_CLAIMED &&
+		    pipe->bytes_used < pipe->size) {
+			if (pipe->bytes_used == 0) {
+				/* make all the buffer contiguous */
+				pipe->read_index = 0;
+				pipe->write_index = 0;
+			}
+
+			*data = pipe->buffer + pipe->write_index;
+			*size = min(*size,
+				    min(pipe->size - pipe->bytes_used,
+					pipe->size - pipe->write_index));
+			break;
+		}
+
+		if (flag == K_PIPE_FLAG_GET_CLAIMED && pipe->bytes_used > 0) {
+			*data = pipe->buffer + pipe->read_index;
+			*size = min(*size,
+				    min(pipe->bytes_used,
+					pipe->size - pipe->read_index));
+			break;
+		}
+
+		if (timeout == K_NO_WAIT) {
+			irq_unlock(key);
+			return rc;
+		}
+
+		_current->base.swap_data = &pipe_desc;
+		_pend_current_thread(key, flag == K_PIPE_FLAG_PUT_CLAIMED ?
+				     &pipe->wait_q.writers :
+				     &pipe->wait_q.readers, timeout);
+
+		if (timeout != K_FOREVER) {
+			timeout = __ticks_to_ms(end - _tick_get());
+			if (timeout <= 0) {
+				timeout = K_NO_WAIT;
+				rc = -EAGAIN;
+			}
+		}
+	}
+
+	pipe->flags |= flag;
+	irq_unlock(key);
+
+	return 0;
+}
+
+int k_pipe_put_claim(struct k_pipe *pipe, void **data, size_t *size,
+		     s32_t timeout)
+{
+	return pipe_claim(pipe, K_PIPE_FLAG_PUT_CLAIMED, data, size, timeout);
+}
+
+#if (CONFIG_NUM_PIPE_ASYNC_MSGS > 0)
+/* Write the data of the asynchronous writers that waited for a claim */
+static void pipe_async_resume(struct k_pipe *pipe)
+{
+	struct k_pipe_async *async_desc;
+	struct k_thread *thread;
+	size_t bytes_written;
+	unsigned int key;
+
+	while (1) {
+		key = irq_lock();
+
+		thread = _waitq_head(&pipe->wait_q.writers);
+		if (!thread || !(thread->base.thread_state & _THREAD_DUMMY) ||
+		    pipe->bytes_used == pipe->size) {
+			irq_unlock(key);
+			return;
+		}
+
+		_unpend_thread(thread);
+		irq_unlock(key);
+
+		async_desc = (struct k_pipe_async *)thread;
+		(void)_k_pipe_put_internal(pipe, async_desc,
+					   async_desc->desc.buffer,
+					   async_desc->desc.bytes_to_xfer,
+					   &bytes_written,
+					   async_desc->desc.bytes_to_xfer,
+					   K_FOREVER);
+	}
+}
+#else
+#define pipe_async_resume(pipe) do { } while (0)
+#endif
+
+void k_pipe_put_commit(struct k_pipe *pipe, size_t bytes)
+{
+	struct k_thread    *reader;
+	struct k_thread    *thread;
+	struct k_pipe_desc *desc;
+	sys_dlist_t    xfer_list;
+	unsigned int   key;
+	size_t         bytes_copied;
+
+	key = irq_lock();
+
+	__ASSERT(pipe->flags & K_PIPE_FLAG_PUT_CLAIMED, "no space claimed");
+	__ASSERT(bytes <= pipe->size - pipe->bytes_used &&
+		 bytes <= pipe->size - pipe->write_index, "");
+
+	pipe->flags &= ~K_PIPE_FLAG_PUT_CLAIMED;
+	pipe->bytes_used += bytes;
+	pipe->write_index += bytes;
+	if (pipe->write_index == pipe->size) {
+		pipe->write_index = 0;
+	}
+
+	if (!_waitq_head(&pipe->wait_q.readers)) {
+		irq_unlock(key);
+		pipe_async_resume(pipe);
+		return;
+	}
+
+	/*
+	 * The buffer was empty: copy the data to the waiting readers, as
+	 * k_pipe_get() does from waiting writers.
+	 */
+
+	(void)pipe_xfer_prepare(&xfer_list, &reader, &pipe->wait_q.readers,
+				0, pipe->bytes_used, 0, K_FOREVER);
+
+	_sched_lock();
+	irq_unlock(key);
+
+	thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	while (thread) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer         += bytes_copied;
+		desc->bytes_to_xfer  -= bytes_copied;
+
+		/* The thread's read request has been satisfied. Ready it. */
+		pipe_thread_ready(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (reader) {
+		desc = (struct k_pipe_desc *)reader->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer         += bytes_copied;
+		desc->bytes_to_xfer  -= bytes_copied;
+	}
+
+	k_sched_unlock();
+
+	pipe_async_resume(pipe);
+}
+
+int k_pipe_get_claim(struct k_pipe *pipe, void **data, size_t *size,
+		     s32_t timeout)
+{
+	return pipe_claim(pipe, K_PIPE_FLAG_GET_CLAIMED, data, size, timeout);
+}
+
+void k_pipe_get_commit(struct k_pipe *pipe, size_t bytes)
+{
+	struct k_thread    *writer;
+	struct k_thread    *thread;
+	struct k_pipe_desc *desc;
+	sys_dlist_t    xfer_list;
+	unsigned int   key;
+	size_t         bytes_copied;
+
+	key = irq_lock();
+
+	__ASSERT(pipe->flags & K_PIPE_FLAG_GET_CLAIMED, "no data claimed");
+	__ASSERT(bytes <= pipe->bytes_used &&
+		 bytes <= pipe->size - pipe->read_index, "");
+
+	pipe->flags &= ~K_PIPE_FLAG_GET_CLAIMED;
+	pipe->bytes_used -= bytes;
+	pipe->read_index += bytes;
+	if (pipe->read_index == pipe->size) {
+		pipe->read_index = 0;
+	}
+
+	if (!_waitq_head(&pipe->wait_q.writers) ||
+	    (pipe->flags & K_PIPE_FLAG_PUT_CLAIMED)) {
+		irq_unlock(key);
+		return;
+	}
+
+	/*
+	 * The buffer was full: copy the data of the waiting writers to the
+	 * room made, as k_pipe_get() does.
+	 */
+
+	(void)pipe_xfer_prepare(&xfer_list, &writer, &pipe->wait_q.writers,
+				0, pipe->size - pipe->bytes_used, 0,
+				K_FOREVER);
+
+	_sched_lock();
+	irq_unlock(key);
+
+	thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	while (thread) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer         += bytes_copied;
+		desc->bytes_to_xfer  -= bytes_copied;
+
+		/* Write request has been satsified */
+		pipe_thread_ready(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (writer) {
+		desc = (struct k_pipe_desc *)writer->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer         += bytes_copied;
+		desc->bytes_to_xfer  -= bytes_copied;
+	}
+
+	k_sched_unlock();
+}
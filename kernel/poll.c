@@ -24,6 +24,8 @@
 #include <misc/dlist.h>
 #include <misc/__assert.h>
 
+s64_t _tick_get(void);
+
 void k_poll_event_init(struct k_poll_event *event, u32_t type,
 		       int mode, void *obj)
 {
@@ -91,20 +93,38 @@ static inline int is_condition_met(struct k_poll_event *event, u32_t *state)
 	return 0;
 }
 
+/* the poller of a poll set has no thread */
+static inline int is_poll_set_event(struct k_poll_event *event)
+{
+	return !event->poller->thread;
+}
+
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct _poller *poller)
 {
 	struct k_poll_event *pending;
 
+	/*
+	 * The events of poll sets are all signaled, so they come first.
+	 * The events of k_poll() follow in thread priority order, only the
+	 * first one being signaled.
+	 */
+	if (!poller->thread) {
+		sys_dlist_prepend(events, &event->_node);
+		return;
+	}
+
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if (!pending || _is_t1_higher_prio_than_t2(pending->poller->thread,
-						   poller->thread)) {
+	if (!pending || is_poll_set_event(pending) ||
+	    _is_t1_higher_prio_than_t2(pending->poller->thread,
+				       poller->thread)) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (_is_t1_higher_prio_than_t2(poller->thread,
+		if (!is_poll_set_event(pending) &&
+		    _is_t1_higher_prio_than_t2(poller->thread,
 					       pending->poller->thread)) {
 			sys_dlist_insert_before(events, &pending->_node,
 						&event->_node);
@@ -374,13 +394,181 @@ ready_event:
 	return 0;
 }
 
+/* must be called with interrupts locked */
+static void signal_poll_set_event(struct k_poll_event *event, u32_t state)
+{
+	struct k_poll_set *set = CONTAINER_OF(event->poller,
+					      struct k_poll_set, poller);
+	struct k_thread *thread;
+
+	if (state != K_POLL_STATE_NOT_READY) {
+		/* The events of the set are ready as long as their state
+		 * is set, until a wait finds their condition no longer met
+		 */
+		if (event->state == K_POLL_STATE_NOT_READY) {
+			sys_dlist_append(&set->ready, &event->_ready_node);
+		}
+		event->state |= state;
+	}
+
+	thread = _unpend_first_thread(&set->wait_q);
+	if (thread) {
+		_set_thread_return_value(thread,
+				state == K_POLL_STATE_NOT_READY ? -EINTR : 0);
+		_ready_thread(thread);
+	}
+}
+
+/*
+ * Signal all the poll set events and the first k_poll() event of an object,
+ * the k_poll() event being removed from the object, must be called with
+ * interrupts locked
+ */
+static int signal_poll_events(sys_dlist_t *events, u32_t state)
+{
+	struct k_poll_event *poll_event, *next;
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(events, poll_event, next, _node) {
+		if (is_poll_set_event(poll_event)) {
+			signal_poll_set_event(poll_event, state);
+			continue;
+		}
+
+		sys_dlist_remove(&poll_event->_node);
+		return signal_poll_event(poll_event, state);
+	}
+
+	return 0;
+}
+
 void _handle_obj_poll_events(sys_dlist_t *events, u32_t state)
 {
-	struct k_poll_event *poll_event;
+	(void) signal_poll_events(events, state);
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.thread = NULL;
+	_waitq_init(&set->wait_q);
+	sys_dlist_init(&set->ready);
+}
+
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	unsigned int key = irq_lock();
+	u32_t state;
+
+	if (event->poller) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	event->state = K_POLL_STATE_NOT_READY;
+	register_event(event, &set->poller);
+
+	if (is_condition_met(event, &state)) {
+		signal_poll_set_event(event, state);
+		_reschedule(key);
+	} else {
+		irq_unlock(key);
+	}
+
+	return 0;
+}
+
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	unsigned int key = irq_lock();
+
+	if (event->poller != &set->poller) {
+		irq_unlock(key);
+		return -EINVAL;
+	}
+
+	clear_event_registration(event);
+
+	if (event->state != K_POLL_STATE_NOT_READY) {
+		sys_dlist_remove(&event->_ready_node);
+		event->state = K_POLL_STATE_NOT_READY;
+	}
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+/*
+ * Report up to @a max events of the ready list whose condition is still met,
+ * moving them to the end of the list so that all the ready events get
+ * reported in turn, and drop the others, must be called with interrupts
+ * locked
+ */
+static int poll_set_collect(struct k_poll_set *set,
+			    struct k_poll_event **events, int max)
+{
+	sys_dnode_t *node, *last = sys_dlist_peek_tail(&set->ready);
+	struct k_poll_event *event;
+	u32_t state;
+	int n = 0;
+
+	while (n < max && (node = sys_dlist_get(&set->ready))) {
+		event = CONTAINER_OF(node, struct k_poll_event, _ready_node);
+
+		if (is_condition_met(event, &state)) {
+			event->state = state;
+			events[n++] = event;
+			sys_dlist_append(&set->ready, node);
+		} else {
+			event->state = K_POLL_STATE_NOT_READY;
+		}
 
-	poll_event = (struct k_poll_event *)sys_dlist_get(events);
-	if (poll_event) {
-		(void) signal_poll_event(poll_event, state);
+		if (node == last) {
+			break;
+		}
+	}
+
+	return n;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int max, s32_t timeout)
+{
+	__ASSERT(!_is_in_isr(), "");
+	__ASSERT(max > 0, "invalid event count\n");
+
+	s64_t end = 0;
+	unsigned int key;
+	int n, rc = 0;
+
+	if (timeout > 0) {
+		end = _tick_get() + _ms_to_ticks(timeout);
+	}
+
+	while (1) {
+		key = irq_lock();
+
+		n = poll_set_collect(set, events, max);
+		if (n || timeout == K_NO_WAIT) {
+			irq_unlock(key);
+			return n ? n : rc;
+		}
+
+		rc = _pend_current_thread(key, &set->wait_q, timeout);
+		if (rc) {
+			return rc;
+		}
+
+		/*
+		 * The events signaled may have been consumed since, wait again
+		 * for the rest of the waiting period
+		 */
+		if (timeout != K_FOREVER) {
+			timeout = __ticks_to_ms(end - _tick_get());
+			if (timeout <= 0) {
+				timeout = K_NO_WAIT;
+				rc = -EAGAIN;
+			}
+		}
 	}
 }
 
@@ -424,18 +612,17 @@ Z_SYSCALL_HANDLER(k_poll_signal_check, signal, signaled, result)
 int _impl_k_poll_signal(struct k_poll_signal *signal, int result)
 {
 	unsigned int key = irq_lock();
-	struct k_poll_event *poll_event;
 
 	signal->result = result;
 	signal->signaled = 1;
 
-	poll_event = (struct k_poll_event *)sys_dlist_get(&signal->poll_events);
-	if (!poll_event) {
+	if (sys_dlist_is_empty(&signal->poll_events)) {
 		irq_unlock(key);
 		return 0;
 	}
 
-	int rc = signal_poll_event(poll_event, K_POLL_STATE_SIGNALED);
+	int rc = signal_poll_events(&signal->poll_events,
+				    K_POLL_STATE_SIGNALED);
 
 	_reschedule(key);
 	return rc;
@@ -21,6 +21,7 @@
 #include <misc/sflist.h>
 #include <init.h>
 #include <syscall_handler.h>
+#include <tracing.h>
 
 extern struct k_queue _k_queue_list_start[];
 extern struct k_queue _k_queue_list_end[];
@@ -146,6 +147,8 @@ static int queue_insert(struct k_queue *queue, void *prev, void *data,
 			bool alloc)
 {
 	unsigned int key = irq_lock();
+
+	sys_trace_queue_put(queue);
 #if !defined(CONFIG_POLL)
 	struct k_thread *first_pending_thread;
 
@@ -233,6 +236,8 @@ void k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 	__ASSERT(head && tail, "invalid head or tail");
 
 	unsigned int key = irq_lock();
+
+	sys_trace_queue_put(queue);
 #if !defined(CONFIG_POLL)
 	struct k_thread *thread;
 
@@ -270,6 +275,37 @@ void k_queue_merge_slist(struct k_queue *queue, sys_slist_t *list)
 	sys_slist_init(list);
 }
 
+void k_queue_append_batch(struct k_queue *queue, void **items, int n)
+{
+	__ASSERT(n >= 0, "invalid item count");
+
+	unsigned int key = irq_lock();
+	int i = 0;
+
+	sys_trace_queue_put(queue);
+#if !defined(CONFIG_POLL)
+	struct k_thread *thread;
+
+	/* Hand items over to the waiters first, then queue the rest */
+	while (i < n && ((thread = _unpend_first_thread(&queue->wait_q)))) {
+		prepare_thread_to_run(thread, items[i++]);
+	}
+#endif /* !CONFIG_POLL */
+
+	for (; i < n; i++) {
+		sys_sfnode_init(items[i], 0x0);
+		sys_sflist_append(&queue->data_q, items[i]);
+	}
+
+#if defined(CONFIG_POLL)
+	if (n) {
+		handle_poll_events(queue, K_POLL_STATE_DATA_AVAILABLE);
+	}
+#endif /* CONFIG_POLL */
+
+	_reschedule(key);
+}
+
 #if defined(CONFIG_POLL)
 static void *k_queue_poll(struct k_queue *queue, s32_t timeout)
 {
@@ -311,6 +347,8 @@ void *_impl_k_queue_get(struct k_queue *queue, s32_t timeout)
 
 	key = irq_lock();
 
+	sys_trace_queue_get(queue);
+
 	if (likely(!sys_sflist_is_empty(&queue->data_q))) {
 		sys_sfnode_t *node;
 
@@ -337,6 +375,63 @@ void *_impl_k_queue_get(struct k_queue *queue, s32_t timeout)
 #endif /* CONFIG_POLL */
 }
 
+/* Must be called with interrupts locked */
+static int queue_drain(struct k_queue *queue, void **items, int max)
+{
+	int n = 0;
+
+	while (n < max && !sys_sflist_is_empty(&queue->data_q)) {
+		sys_sfnode_t *node = sys_sflist_get_not_empty(&queue->data_q);
+
+		items[n++] = z_queue_node_peek(node, true);
+	}
+
+	return n;
+}
+
+int _impl_k_queue_get_batch(struct k_queue *queue, void **items, int max,
+			    s32_t timeout)
+{
+	unsigned int key;
+	int n;
+
+	__ASSERT(max > 0, "invalid item count");
+
+	key = irq_lock();
+	n = queue_drain(queue, items, max);
+	irq_unlock(key);
+
+	if (n || timeout == K_NO_WAIT) {
+		sys_trace_queue_get(queue);
+		return n;
+	}
+
+	/* Wait for a first item, then take those queued along with it */
+	items[0] = _impl_k_queue_get(queue, timeout);
+	if (!items[0]) {
+		return 0;
+	}
+
+	key = irq_lock();
+	n = 1 + queue_drain(queue, items + 1, max - 1);
+	irq_unlock(key);
+
+	return n;
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_queue_get_batch, queue, items, max, timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(queue, K_OBJ_QUEUE));
+	Z_OOPS(Z_SYSCALL_VERIFY_MSG((int)max > 0, "invalid item count %d",
+				    (int)max));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(items, max, sizeof(void *)));
+
+	return _impl_k_queue_get_batch((struct k_queue *)queue,
+				       (void **)items, max, timeout);
+}
+#endif
+
 #ifdef CONFIG_USERSPACE
 Z_SYSCALL_HANDLER(k_queue_get, queue, timeout_p)
 {
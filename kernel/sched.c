@@ -10,16 +10,34 @@
 #include <wait_q.h>
 #include <kswap.h>
 #include <kernel_arch_func.h>
+#include <kernel_internal.h>
 #include <syscall_handler.h>
 
-#ifdef CONFIG_SCHED_DUMB
+#if defined(CONFIG_SCHED_DUMB)
 #define _priq_run_add		_priq_dumb_add
 #define _priq_run_remove	_priq_dumb_remove
 #define _priq_run_best		_priq_dumb_best
-#else
+#elif defined(CONFIG_SCHED_SCALABLE)
 #define _priq_run_add		_priq_rb_add
 #define _priq_run_remove	_priq_rb_remove
 #define _priq_run_best		_priq_rb_best
+#elif defined(CONFIG_SCHED_MULTIQ)
+#define _priq_run_add		_priq_mq_add
+#define _priq_run_remove	_priq_mq_remove
+#define _priq_run_best		_priq_mq_best
+#endif
+
+#if defined(CONFIG_SCHED_DUMB)
+#define _RUNQ_FOR_EACH(rq, thread_ptr) \
+	SYS_DLIST_FOR_EACH_CONTAINER(&(rq)->runq, thread_ptr, base.qnode_dlist)
+#elif defined(CONFIG_SCHED_SCALABLE)
+#define _RUNQ_FOR_EACH(rq, thread_ptr) \
+	RB_FOR_EACH_CONTAINER(&(rq)->runq.tree, thread_ptr, base.qnode_rb)
+#elif defined(CONFIG_SCHED_MULTIQ)
+#define _RUNQ_FOR_EACH(rq, thread_ptr) \
+	for (int _prio_idx = 0; _prio_idx < K_NUM_PRIORITIES; _prio_idx++) \
+		SYS_DLIST_FOR_EACH_CONTAINER(&(rq)->runq.queues[_prio_idx], \
+					     thread_ptr, base.qnode_dlist)
 #endif
 
 #ifdef CONFIG_WAITQ_FAST
@@ -82,8 +100,10 @@ static inline int _is_idle(struct k_thread *thread)
 s32_t _ms_to_ticks(s32_t ms)
 {
 	s64_t ms_ticks_per_sec = (s64_t)ms * sys_clock_ticks_per_sec;
+	s64_t ticks = ceiling_fraction(ms_ticks_per_sec, MSEC_PER_SEC);
 
-	return (s32_t)ceiling_fraction(ms_ticks_per_sec, MSEC_PER_SEC);
+	/* sub-millisecond tickless time units overflow long timeouts */
+	return (s32_t)min(ticks, INT32_MAX);
 }
 #endif
 
@@ -112,6 +132,195 @@ int _is_t1_higher_prio_than_t2(struct k_thread *t1, struct k_thread *t2)
 	return 0;
 }
 
+#ifdef CONFIG_SCHED_CPU_QUEUES
+#ifdef CONFIG_SCHED_IPI_SUPPORTED
+#define _sched_ipi() _arch_sched_ipi()
+#else
+#define _sched_ipi() do { } while (0)
+#endif
+
+static inline _ready_q_t *cpu_ready_q(int cpu)
+{
+	return &_kernel.cpus[cpu].ready_q;
+}
+
+/* Lock the ready queue of the CPU a thread is assigned to.  The
+ * assignment can change while we spin if another CPU steals the
+ * thread, so it is checked again once the lock is held.  When
+ * sched_lock is needed too, it is taken first.
+ */
+static _ready_q_t *lock_thread_ready_q(struct k_thread *thread,
+					    k_spinlock_key_t *key)
+{
+	_ready_q_t *rq;
+
+	while (1) {
+		rq = cpu_ready_q(thread->base.cpu);
+		*key = k_spin_lock(&rq->lock);
+
+		if (rq == cpu_ready_q(thread->base.cpu)) {
+			return rq;
+		}
+
+		k_spin_unlock(&rq->lock, *key);
+	}
+}
+
+static int is_running_elsewhere(struct k_thread *thread, int cpu)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (i != cpu && _kernel.cpus[i].current == thread) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/* Best thread in a ready queue that can be run on a given CPU: a
+ * yielding or time sliced thread sits in the queue while it is
+ * still running, it must not be picked up by another CPU.
+ * Must be called with the queue locked.
+ */
+static struct k_thread *ready_q_best(_ready_q_t *rq, int cpu)
+{
+	struct k_thread *t;
+
+	_RUNQ_FOR_EACH(rq, t) {
+		if (!is_running_elsewhere(t, cpu)) {
+			return t;
+		}
+	}
+
+	return NULL;
+}
+
+/* Select the CPU whose queue a newly ready thread goes to.  Prefer
+ * the CPU it last ran on, which is likely to still have its data
+ * cached, unless that CPU is busy with something more important and
+ * another one is idle.  This peeks at the other CPUs without locking:
+ * a stale answer only costs a migration later.
+ */
+static int pick_cpu(struct k_thread *thread)
+{
+	int cpu = thread->base.cpu;
+	struct k_thread *cur = _kernel.cpus[cpu].current;
+	int i;
+
+	if (!cur || _is_idle(cur) || _is_t1_higher_prio_than_t2(thread, cur)) {
+		return cpu;
+	}
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cur = _kernel.cpus[i].current;
+
+		if (!cur || _is_idle(cur)) {
+			return i;
+		}
+	}
+
+	return cpu;
+}
+
+/* Work stealing: migrate the best thread queued on another CPU to the
+ * ready queue of @cpu.  Both queues are locked, always in CPU index
+ * order, while the thread moves so that it is never seen outside of a
+ * queue while marked as queued.
+ */
+static void steal(int cpu)
+{
+	_ready_q_t *mine = cpu_ready_q(cpu);
+	struct k_thread *best = NULL, *t;
+	k_spinlock_key_t key, key2;
+	int i, victim = -1;
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (i == cpu) {
+			continue;
+		}
+
+		key = k_spin_lock(&cpu_ready_q(i)->lock);
+		t = ready_q_best(cpu_ready_q(i), cpu);
+		if (t && (!best || _is_t1_higher_prio_than_t2(t, best))) {
+			best = t;
+			victim = i;
+		}
+		k_spin_unlock(&cpu_ready_q(i)->lock, key);
+	}
+
+	if (victim < 0) {
+		return;
+	}
+
+	_ready_q_t *first = cpu_ready_q(min(cpu, victim));
+	_ready_q_t *second = cpu_ready_q(max(cpu, victim));
+
+	key = k_spin_lock(&first->lock);
+	key2 = k_spin_lock(&second->lock);
+
+	/* Things may have changed while the victim was unlocked */
+	t = ready_q_best(cpu_ready_q(victim), cpu);
+	if (t) {
+		_priq_run_remove(&cpu_ready_q(victim)->runq, t);
+		t->base.cpu = cpu;
+		_priq_run_add(&mine->runq, t);
+	}
+
+	k_spin_unlock(&second->lock, key2);
+	k_spin_unlock(&first->lock, key);
+}
+
+static struct k_thread *next_up(void)
+{
+	int cpu = _current_cpu->id;
+	_ready_q_t *rq = cpu_ready_q(cpu);
+	int active = !_is_thread_prevented_from_running(_current);
+	int queued = _is_thread_queued(_current);
+	k_spinlock_key_t key;
+	struct k_thread *th;
+
+	key = k_spin_lock(&rq->lock);
+	th = ready_q_best(rq, cpu);
+
+	if (!th) {
+		k_spin_unlock(&rq->lock, key);
+		steal(cpu);
+		key = k_spin_lock(&rq->lock);
+		th = ready_q_best(rq, cpu);
+	}
+
+	/* Idle thread if nothing else */
+	if (!th) {
+		th = _current_cpu->idle_thread;
+	}
+
+	/* Stay with current unless it's already been put back in the
+	 * queue and something better is available (c.f. timeslicing,
+	 * yield)
+	 */
+	if (active && !queued && !_is_t1_higher_prio_than_t2(th, _current)
+	    && !is_metairq(th)) {
+		th = _current;
+	}
+
+	/* Put _current back into the queue if it is being preempted */
+	if (th != _current && active && !queued && !_is_idle(_current)) {
+		_priq_run_add(&rq->runq, _current);
+		_mark_thread_as_queued(_current);
+	}
+
+	if (_is_thread_queued(th) && !_is_idle(th)) {
+		_priq_run_remove(&rq->runq, th);
+		_mark_thread_as_not_queued(th);
+	}
+
+	k_spin_unlock(&rq->lock, key);
+
+	return th;
+}
+#else
 static struct k_thread *next_up(void)
 {
 #ifndef CONFIG_SMP
@@ -162,6 +371,7 @@ static struct k_thread *next_up(void)
 	return th;
 #endif
 }
+#endif /* CONFIG_SCHED_CPU_QUEUES */
 
 static void update_cache(int preempt_ok)
 {
@@ -180,6 +390,53 @@ static void update_cache(int preempt_ok)
 #endif
 }
 
+#ifdef CONFIG_SCHED_CPU_QUEUES
+void _add_thread_to_ready_q(struct k_thread *thread)
+{
+	int cpu = pick_cpu(thread);
+	_ready_q_t *rq = cpu_ready_q(cpu);
+
+	LOCKED(&rq->lock) {
+		thread->base.cpu = cpu;
+		_priq_run_add(&rq->runq, thread);
+		_mark_thread_as_queued(thread);
+	}
+
+	/* Let the target CPU reschedule now rather than on its next
+	 * interrupt
+	 */
+	if (cpu != _current_cpu->id) {
+		_sched_ipi();
+	}
+}
+
+void _move_thread_to_end_of_prio_q(struct k_thread *thread)
+{
+	k_spinlock_key_t key;
+	_ready_q_t *rq = lock_thread_ready_q(thread, &key);
+
+	if (_is_thread_queued(thread)) {
+		_priq_run_remove(&rq->runq, thread);
+	}
+	_priq_run_add(&rq->runq, thread);
+	_mark_thread_as_queued(thread);
+
+	k_spin_unlock(&rq->lock, key);
+}
+
+void _remove_thread_from_ready_q(struct k_thread *thread)
+{
+	k_spinlock_key_t key;
+	_ready_q_t *rq = lock_thread_ready_q(thread, &key);
+
+	if (_is_thread_queued(thread)) {
+		_priq_run_remove(&rq->runq, thread);
+		_mark_thread_as_not_queued(thread);
+	}
+
+	k_spin_unlock(&rq->lock, key);
+}
+#else
 void _add_thread_to_ready_q(struct k_thread *thread)
 {
 	LOCKED(&sched_lock) {
@@ -209,6 +466,7 @@ void _remove_thread_from_ready_q(struct k_thread *thread)
 		}
 	}
 }
+#endif /* CONFIG_SCHED_CPU_QUEUES */
 
 static void pend(struct k_thread *thread, _wait_q_t *wait_q, s32_t timeout)
 {
@@ -227,10 +485,8 @@ static void pend(struct k_thread *thread, _wait_q_t *wait_q, s32_t timeout)
 		irq_unlock(key);
 	}
 
+	thread->base.pended_on = wait_q;
 	if (wait_q) {
-#ifdef CONFIG_WAITQ_FAST
-		thread->base.pended_on = wait_q;
-#endif
 		_priq_wait_add(&wait_q->waitq, thread);
 	}
 
@@ -247,14 +503,9 @@ void _pend_thread(struct k_thread *thread, _wait_q_t *wait_q, s32_t timeout)
 
 static _wait_q_t *pended_on(struct k_thread *thread)
 {
-#ifdef CONFIG_WAITQ_FAST
 	__ASSERT_NO_MSG(thread->base.pended_on);
 
 	return thread->base.pended_on;
-#else
-	ARG_UNUSED(thread);
-	return NULL;
-#endif
 }
 
 struct k_thread *_find_first_thread_to_unpend(_wait_q_t *wait_q,
@@ -276,11 +527,8 @@ void _unpend_thread_no_timeout(struct k_thread *thread)
 	LOCKED(&sched_lock) {
 		_priq_wait_remove(&pended_on(thread)->waitq, thread);
 		_mark_thread_as_not_pending(thread);
+		thread->base.pended_on = NULL;
 	}
-
-#if defined(CONFIG_ASSERT) && defined(CONFIG_WAITQ_FAST)
-	thread->base.pended_on = NULL;
-#endif
 }
 
 int _pend_current_thread(int key, _wait_q_t *wait_q, s32_t timeout)
@@ -306,6 +554,22 @@ void _unpend_thread(struct k_thread *thread)
 	_abort_thread_timeout(thread);
 }
 
+/* A thread pended on a wait queue is requeued at its new priority, wait
+ * queues are sorted on insertion only. Called with sched_lock held.
+ */
+static void pended_thread_priority_set(struct k_thread *thread, int prio)
+{
+	_wait_q_t *wait_q = thread->base.pended_on;
+
+	if (_is_thread_pending(thread) && wait_q) {
+		_priq_wait_remove(&wait_q->waitq, thread);
+		thread->base.prio = prio;
+		_priq_wait_add(&wait_q->waitq, thread);
+	} else {
+		thread->base.prio = prio;
+	}
+}
+
 /* FIXME: this API is glitchy when used in SMP.  If the thread is
  * currently scheduled on the other CPU, it will silently set it's
  * priority but nothing will cause a reschedule until the next
@@ -317,6 +581,29 @@ void _thread_priority_set(struct k_thread *thread, int prio)
 {
 	int need_sched = 0;
 
+#ifdef CONFIG_SCHED_CPU_QUEUES
+	k_spinlock_key_t key, rq_key;
+	_ready_q_t *rq;
+
+	/* Both locks: the thread must not be queued or pended while its
+	 * priority changes.
+	 */
+	key = k_spin_lock(&sched_lock);
+	rq = lock_thread_ready_q(thread, &rq_key);
+
+	need_sched = _is_thread_ready(thread);
+
+	if (_is_thread_queued(thread)) {
+		_priq_run_remove(&rq->runq, thread);
+		thread->base.prio = prio;
+		_priq_run_add(&rq->runq, thread);
+	} else {
+		pended_thread_priority_set(thread, prio);
+	}
+
+	k_spin_unlock(&rq->lock, rq_key);
+	k_spin_unlock(&sched_lock, key);
+#else
 	LOCKED(&sched_lock) {
 		need_sched = _is_thread_ready(thread);
 
@@ -326,11 +613,16 @@ void _thread_priority_set(struct k_thread *thread, int prio)
 			_priq_run_add(&_kernel.ready_q.runq, thread);
 			update_cache(1);
 		} else {
-			thread->base.prio = prio;
+			pended_thread_priority_set(thread, prio);
 		}
 	}
+#endif
 
-	if (need_sched) {
+	/* A thread holding the scheduler lock, like a mutex owner lowering
+	 * its priority before handing the mutex over, reschedules when it
+	 * releases the lock.
+	 */
+	if (need_sched && _current->base.sched_locked == 0) {
 		_reschedule(irq_lock());
 	}
 }
@@ -374,6 +666,10 @@ void k_sched_unlock(void)
 #ifdef CONFIG_SMP
 struct k_thread *_get_next_ready_thread(void)
 {
+#ifdef CONFIG_SCHED_CPU_QUEUES
+	/* next_up() locks the per-CPU ready queues itself */
+	return next_up();
+#else
 	struct k_thread *ret = 0;
 
 	LOCKED(&sched_lock) {
@@ -381,6 +677,7 @@ struct k_thread *_get_next_ready_thread(void)
 	}
 
 	return ret;
+#endif
 }
 #endif
 
@@ -486,9 +783,70 @@ struct k_thread *_priq_rb_best(struct _priq_rb *pq)
 	return CONTAINER_OF(n, struct k_thread, base.qnode_rb);
 }
 
+#ifdef CONFIG_SCHED_MULTIQ
+static inline int _priq_mq_idx(struct k_thread *thread)
+{
+	return thread->base.prio - K_HIGHEST_THREAD_PRIO;
+}
+
+void _priq_mq_add(struct _priq_mq *pq, struct k_thread *thread)
+{
+	int idx = _priq_mq_idx(thread);
+
+	__ASSERT_NO_MSG(!_is_idle(thread));
+
+	sys_dlist_append(&pq->queues[idx], &thread->base.qnode_dlist);
+	pq->bitmask[idx >> 5] |= BIT(idx & 0x1f);
+}
+
+void _priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread)
+{
+	int idx = _priq_mq_idx(thread);
+
+	__ASSERT_NO_MSG(!_is_idle(thread));
+
+	sys_dlist_remove(&thread->base.qnode_dlist);
+	if (sys_dlist_is_empty(&pq->queues[idx])) {
+		pq->bitmask[idx >> 5] &= ~BIT(idx & 0x1f);
+	}
+}
+
+struct k_thread *_priq_mq_best(struct _priq_mq *pq)
+{
+	int i;
+
+	/* Lower index is higher priority: the first bit set in the
+	 * first non-empty bitmap is the best non-empty list.
+	 */
+	for (i = 0; i < K_NUM_PRIO_BITMAPS; i++) {
+		if (pq->bitmask[i]) {
+			int idx = (i << 5) + find_lsb_set(pq->bitmask[i]) - 1;
+
+			return CONTAINER_OF(sys_dlist_peek_head(&pq->queues[idx]),
+					    struct k_thread, base.qnode_dlist);
+		}
+	}
+
+	return NULL;
+}
+
+static void _priq_mq_init(struct _priq_mq *pq)
+{
+	int i;
+
+	for (i = 0; i < K_NUM_PRIORITIES; i++) {
+		sys_dlist_init(&pq->queues[i]);
+	}
+
+	for (i = 0; i < K_NUM_PRIO_BITMAPS; i++) {
+		pq->bitmask[i] = 0;
+	}
+}
+#endif
+
 #ifdef CONFIG_TIMESLICING
 extern s32_t _time_slice_duration;    /* Measured in ms */
-extern s32_t _time_slice_elapsed;     /* Measured in ms */
+extern s32_t _time_slice_elapsed;     /* Measured in ticks */
 extern int _time_slice_prio_ceiling;
 
 void k_sched_time_slice_set(s32_t duration_in_ms, int prio)
@@ -501,21 +859,28 @@ void k_sched_time_slice_set(s32_t duration_in_ms, int prio)
 	_time_slice_prio_ceiling = prio;
 }
 
-int _is_thread_time_slicing(struct k_thread *thread)
+/* Whether thread, running or about to be switched in, is time sliced */
+static int time_slicing(struct k_thread *thread)
 {
 	int ret = 0;
 
-	/* Should fix API.  Doesn't make sense for non-running threads
-	 * to call this
-	 */
-	__ASSERT_NO_MSG(thread == _current);
-
 	if (_time_slice_duration <= 0 || !_is_preempt(thread) ||
 	    _is_prio_higher(thread->base.prio, _time_slice_prio_ceiling)) {
 		return 0;
 	}
 
 
+#ifdef CONFIG_SCHED_CPU_QUEUES
+	_ready_q_t *rq = cpu_ready_q(_current_cpu->id);
+
+	LOCKED(&rq->lock) {
+		struct k_thread *next = ready_q_best(rq, _current_cpu->id);
+
+		if (next) {
+			ret = thread->base.prio == next->base.prio;
+		}
+	}
+#else
 	LOCKED(&sched_lock) {
 		struct k_thread *next = _priq_run_best(&_kernel.ready_q.runq);
 
@@ -523,28 +888,38 @@ int _is_thread_time_slicing(struct k_thread *thread)
 			ret = thread->base.prio == next->base.prio;
 		}
 	}
+#endif
 
 	return ret;
 }
 
+int _is_thread_time_slicing(struct k_thread *thread)
+{
+	/* Should fix API.  Doesn't make sense for non-running threads
+	 * to call this
+	 */
+	__ASSERT_NO_MSG(thread == _current);
+
+	return time_slicing(thread);
+}
+
 /* Must be called with interrupts locked */
 /* Should be called only immediately before a thread switch */
 void _update_time_slice_before_swap(void)
 {
 #ifdef CONFIG_TICKLESS_KERNEL
-	if (!_is_thread_time_slicing(_get_next_ready_thread())) {
+	if (!time_slicing(_get_next_ready_thread())) {
 		return;
 	}
 
+	u32_t slice = _ms_to_ticks(_time_slice_duration);
 	u32_t remaining = _get_remaining_program_time();
 
-	if (!remaining || (_time_slice_duration < remaining)) {
-		_set_time(_time_slice_duration);
-	} else {
-		/* Account previous elapsed time and reprogram
-		 * timer with remaining time
+	if (!remaining || (slice < remaining)) {
+		/* The program time counts from the last announced tick,
+		 * the new time slice starts now.
 		 */
-		_set_time(remaining);
+		_set_time(slice + _get_elapsed_program_time());
 	}
 
 #endif
@@ -569,14 +944,34 @@ int _unpend_all(_wait_q_t *waitq)
 
 void _sched_init(void)
 {
-#ifdef CONFIG_SCHED_DUMB
+#ifdef CONFIG_SCHED_CPU_QUEUES
+	int i;
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+#if defined(CONFIG_SCHED_DUMB)
+		sys_dlist_init(&cpu_ready_q(i)->runq);
+#elif defined(CONFIG_SCHED_SCALABLE)
+		cpu_ready_q(i)->runq = (struct _priq_rb) {
+			.tree = {
+				.lessthan_fn = _priq_rb_lessthan,
+			}
+		};
+#elif defined(CONFIG_SCHED_MULTIQ)
+		_priq_mq_init(&cpu_ready_q(i)->runq);
+#endif
+	}
+#endif
+
+#if defined(CONFIG_SCHED_DUMB)
 	sys_dlist_init(&_kernel.ready_q.runq);
-#else
+#elif defined(CONFIG_SCHED_SCALABLE)
 	_kernel.ready_q.runq = (struct _priq_rb) {
 		.tree = {
 			.lessthan_fn = _priq_rb_lessthan,
 		}
 	};
+#elif defined(CONFIG_SCHED_MULTIQ)
+	_priq_mq_init(&_kernel.ready_q.runq);
 #endif
 }
 
@@ -626,6 +1021,18 @@ void _impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 {
 	struct k_thread *th = tid;
 
+#ifdef CONFIG_SCHED_CPU_QUEUES
+	k_spinlock_key_t key;
+	_ready_q_t *rq = lock_thread_ready_q(th, &key);
+
+	th->base.prio_deadline = k_cycle_get_32() + deadline;
+	if (_is_thread_queued(th)) {
+		_priq_run_remove(&rq->runq, th);
+		_priq_run_add(&rq->runq, th);
+	}
+
+	k_spin_unlock(&rq->lock, key);
+#else
 	LOCKED(&sched_lock) {
 		th->base.prio_deadline = k_cycle_get_32() + deadline;
 		if (_is_thread_queued(th)) {
@@ -633,6 +1040,7 @@ void _impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 			_priq_run_add(&_kernel.ready_q.runq, th);
 		}
 	}
+#endif
 }
 
 #ifdef CONFIG_USERSPACE
@@ -656,11 +1064,15 @@ void _impl_k_yield(void)
 	__ASSERT(!_is_in_isr(), "");
 
 	if (!_is_idle(_current)) {
+#ifdef CONFIG_SCHED_CPU_QUEUES
+		_move_thread_to_end_of_prio_q(_current);
+#else
 		LOCKED(&sched_lock) {
 			_priq_run_remove(&_kernel.ready_q.runq, _current);
 			_priq_run_add(&_kernel.ready_q.runq, _current);
 			update_cache(1);
 		}
+#endif
 	}
 
 	if (_get_next_ready_thread() != _current) {
@@ -672,6 +1084,18 @@ void _impl_k_yield(void)
 Z_SYSCALL_HANDLER0_SIMPLE_VOID(k_yield);
 #endif
 
+#ifdef CONFIG_MULTITHREADING
+static void sleep_ticks(s32_t ticks)
+{
+	unsigned int key = irq_lock();
+
+	_remove_thread_from_ready_q(_current);
+	_add_thread_timeout(_current, NULL, ticks);
+
+	_Swap(key);
+}
+#endif
+
 void _impl_k_sleep(s32_t duration)
 {
 #ifdef CONFIG_MULTITHREADING
@@ -679,12 +1103,11 @@ void _impl_k_sleep(s32_t duration)
 	 * populated
 	 */
 	volatile s32_t ticks;
-	unsigned int key;
 
 	__ASSERT(!_is_in_isr(), "");
 	__ASSERT(duration != K_FOREVER, "");
 
-	K_DEBUG("thread %p for %d ns\n", _current, duration);
+	K_DEBUG("thread %p for %d ms\n", _current, duration);
 
 	/* wait of 0 ms is treated as a 'yield' */
 	if (duration == 0) {
@@ -693,12 +1116,27 @@ void _impl_k_sleep(s32_t duration)
 	}
 
 	ticks = _TICK_ALIGN + _ms_to_ticks(duration);
-	key = irq_lock();
+	sleep_ticks(ticks);
+#endif
+}
 
-	_remove_thread_from_ready_q(_current);
-	_add_thread_timeout(_current, NULL, ticks);
+void _impl_k_usleep(s32_t duration)
+{
+#ifdef CONFIG_MULTITHREADING
+	volatile s32_t ticks;
 
-	_Swap(key);
+	__ASSERT(!_is_in_isr(), "");
+	__ASSERT(duration >= 0, "");
+
+	K_DEBUG("thread %p for %d us\n", _current, duration);
+
+	if (duration == 0) {
+		k_yield();
+		return;
+	}
+
+	ticks = _TICK_ALIGN + _us_to_ticks(duration);
+	sleep_ticks(ticks);
 #endif
 }
 
@@ -714,6 +1152,15 @@ Z_SYSCALL_HANDLER(k_sleep, duration)
 
 	return 0;
 }
+
+Z_SYSCALL_HANDLER(k_usleep, duration)
+{
+	Z_OOPS(Z_SYSCALL_VERIFY_MSG((s32_t)duration >= 0,
+				    "negative sleep duration"));
+	_impl_k_usleep(duration);
+
+	return 0;
+}
 #endif
 
 void _impl_k_wakeup(k_tid_t thread)
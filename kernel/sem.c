@@ -27,6 +27,7 @@
 #include <ksched.h>
 #include <init.h>
 #include <syscall_handler.h>
+#include <tracing.h>
 
 extern struct k_sem _k_sem_list_start[];
 extern struct k_sem _k_sem_list_end[];
@@ -134,6 +135,7 @@ void _impl_k_sem_give(struct k_sem *sem)
 {
 	unsigned int key = irq_lock();
 
+	sys_trace_sem_give(sem);
 	do_sem_give(sem);
 	_reschedule(key);
 }
@@ -148,6 +150,8 @@ int _impl_k_sem_take(struct k_sem *sem, s32_t timeout)
 
 	unsigned int key = irq_lock();
 
+	sys_trace_sem_take(sem);
+
 	if (likely(sem->count > 0)) {
 		sem->count--;
 		irq_unlock(key);
@@ -169,6 +169,76 @@ u32_t k_uptime_delta_32(s64_t *reftime)
 
 volatile int _handling_timeouts;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_FAST
+int _timeout_rb_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	struct _timeout *ta, *tb;
+	s32_t diff;
+
+	ta = CONTAINER_OF(a, struct _timeout, node_rb);
+	tb = CONTAINER_OF(b, struct _timeout, node_rb);
+
+	/* expiries are compared as a difference to survive wraparound */
+	diff = (s32_t)(ta->expiry - tb->expiry);
+	if (diff) {
+		return diff < 0;
+	}
+
+	return ta->order_key < tb->order_key ? 1 : 0;
+}
+
+/*
+ * Same as below, but the timeouts are kept in a balanced tree keyed by
+ * absolute expiry tick: advance the time base of the queue, then pop
+ * timeouts off the front of the tree until one that has not expired yet is
+ * found.
+ */
+static inline void handle_timeouts(s32_t ticks)
+{
+	sys_dlist_t expired;
+	unsigned int key;
+	struct rbnode *n;
+
+	/* init before locking interrupts */
+	sys_dlist_init(&expired);
+
+	key = irq_lock();
+
+	_timeout_q.ticks += ticks;
+
+	K_DEBUG("ticks: %u, root: %p\n", _timeout_q.ticks,
+		_timeout_q.tree.root);
+
+	_handling_timeouts = 1;
+
+	while ((n = rb_get_min(&_timeout_q.tree))) {
+		struct _timeout *timeout =
+			CONTAINER_OF(n, struct _timeout, node_rb);
+
+		if ((s32_t)(timeout->expiry - _timeout_q.ticks) > 0) {
+			break;
+		}
+
+		rb_remove(&_timeout_q.tree, n);
+		sys_dlist_append(&expired, &timeout->node);
+
+		timeout->delta_ticks_from_prev = _EXPIRED;
+
+		irq_unlock(key);
+		key = irq_lock();
+	}
+
+	if (!_timeout_q.tree.root) {
+		_timeout_q.next_order_key = 0;
+	}
+
+	irq_unlock(key);
+
+	_handle_expired_timeouts(&expired);
+
+	_handling_timeouts = 0;
+}
+#else
 static inline void handle_timeouts(s32_t ticks)
 {
 	sys_dlist_t expired;
@@ -257,6 +327,7 @@ static inline void handle_timeouts(s32_t ticks)
 
 	_handling_timeouts = 0;
 }
+#endif /* CONFIG_TIMEOUT_QUEUE_FAST */
 #else
 	#define handle_timeouts(ticks) do { } while ((0))
 #endif
@@ -285,8 +356,9 @@ static void handle_time_slicing(s32_t ticks)
 		return;
 	}
 
-	_time_slice_elapsed += __ticks_to_ms(ticks);
-	if (_time_slice_elapsed >= _time_slice_duration) {
+	/* counted in ticks, which may be much shorter than a millisecond */
+	_time_slice_elapsed += ticks;
+	if (_time_slice_elapsed >= _ms_to_ticks(_time_slice_duration)) {
 
 		unsigned int key;
 
@@ -297,8 +369,7 @@ static void handle_time_slicing(s32_t ticks)
 		irq_unlock(key);
 	}
 #ifdef CONFIG_TICKLESS_KERNEL
-	next_ts =
-	    _ms_to_ticks(_time_slice_duration - _time_slice_elapsed);
+	next_ts = _ms_to_ticks(_time_slice_duration) - _time_slice_elapsed;
 #endif
 }
 #else
@@ -343,8 +414,9 @@ void _nano_sys_clock_tick_announce(s32_t ticks)
 	u32_t next_to = _get_next_timeout_expiry();
 
 	next_to = next_to == K_FOREVER ? 0 : next_to;
-	next_to = !next_to || (next_ts
-			       && next_to) > next_ts ? next_ts : next_to;
+	if (next_ts && (!next_to || next_ts < next_to)) {
+		next_to = next_ts;
+	}
 
 	u32_t remaining = _get_remaining_program_time();
 
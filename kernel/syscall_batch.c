@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Batched semaphore and queue operations.
+ *
+ * k_syscall_batch() performs a list of operations in a single system call,
+ * each operation being validated and performed as the system call it stands
+ * for would.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <syscall_handler.h>
+
+static int syscall_op(struct k_syscall_op *op)
+{
+	switch (op->type) {
+	case K_SYSCALL_OP_SEM_GIVE:
+		_impl_k_sem_give(op->obj);
+		return 0;
+	case K_SYSCALL_OP_SEM_TAKE:
+		return _impl_k_sem_take(op->obj, op->timeout);
+	case K_SYSCALL_OP_SEM_RESET:
+		_impl_k_sem_reset(op->obj);
+		return 0;
+	case K_SYSCALL_OP_QUEUE_APPEND:
+		return _impl_k_queue_alloc_append(op->obj, op->data);
+	case K_SYSCALL_OP_QUEUE_PREPEND:
+		return _impl_k_queue_alloc_prepend(op->obj, op->data);
+	case K_SYSCALL_OP_QUEUE_GET:
+		op->data = _impl_k_queue_get(op->obj, op->timeout);
+		return op->data ? 0 : -EAGAIN;
+	case K_SYSCALL_OP_QUEUE_CANCEL_WAIT:
+		_impl_k_queue_cancel_wait(op->obj);
+		return 0;
+	default:
+		__ASSERT(0, "invalid operation type %u", op->type);
+		return -EINVAL;
+	}
+}
+
+int _impl_k_syscall_batch(struct k_syscall_op *ops, int num_ops)
+{
+	int i;
+
+	for (i = 0; i < num_ops; i++) {
+		ops[i].result = syscall_op(&ops[i]);
+		if (ops[i].result) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+#ifdef CONFIG_USERSPACE
+static enum k_objects syscall_op_otype(u32_t type)
+{
+	switch (type) {
+	case K_SYSCALL_OP_SEM_GIVE:
+	case K_SYSCALL_OP_SEM_TAKE:
+	case K_SYSCALL_OP_SEM_RESET:
+		return K_OBJ_SEM;
+	default:
+		return K_OBJ_QUEUE;
+	}
+}
+
+Z_SYSCALL_HANDLER(k_syscall_batch, ops_p, num_ops)
+{
+	struct k_syscall_op *ops = (struct k_syscall_op *)ops_p;
+	struct k_syscall_op op;
+	int i;
+
+	Z_OOPS(Z_SYSCALL_VERIFY_MSG((int)num_ops >= 0,
+				    "invalid operation count %d",
+				    (int)num_ops));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(ops, num_ops, sizeof(*ops)));
+
+	for (i = 0; i < num_ops; i++) {
+		/* Other user threads may change the operations meanwhile */
+		op = ops[i];
+
+		Z_OOPS(Z_SYSCALL_VERIFY_MSG(op.type <=
+					    K_SYSCALL_OP_QUEUE_CANCEL_WAIT,
+					    "invalid operation type %u",
+					    op.type));
+		Z_OOPS(Z_SYSCALL_OBJ(op.obj, syscall_op_otype(op.type)));
+
+		op.result = syscall_op(&op);
+		ops[i].result = op.result;
+		ops[i].data = op.data;
+		if (op.result) {
+			break;
+		}
+	}
+
+	return i;
+}
+#endif /* CONFIG_USERSPACE */
@@ -18,6 +18,15 @@ K_THREAD_STACK_DEFINE(sys_work_q_stack, CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
 
 struct k_work_q k_sys_work_q;
 
+#if CONFIG_SYSTEM_WORKQUEUE_THREADS > 1
+#define SYS_WORK_Q_WORKERS (CONFIG_SYSTEM_WORKQUEUE_THREADS - 1)
+
+static K_THREAD_STACK_ARRAY_DEFINE(sys_work_q_worker_stacks,
+				   SYS_WORK_Q_WORKERS,
+				   CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
+static struct k_thread sys_work_q_workers[SYS_WORK_Q_WORKERS];
+#endif
+
 static int k_sys_work_q_init(struct device *dev)
 {
 	ARG_UNUSED(dev);
@@ -27,6 +36,16 @@ static int k_sys_work_q_init(struct device *dev)
 		       K_THREAD_STACK_SIZEOF(sys_work_q_stack),
 		       CONFIG_SYSTEM_WORKQUEUE_PRIORITY);
 
+#if CONFIG_SYSTEM_WORKQUEUE_THREADS > 1
+	for (int i = 0; i < SYS_WORK_Q_WORKERS; i++) {
+		k_work_q_add_worker(&k_sys_work_q, &sys_work_q_workers[i],
+				    sys_work_q_worker_stacks[i],
+				    K_THREAD_STACK_SIZEOF(
+					    sys_work_q_worker_stacks[i]),
+				    CONFIG_SYSTEM_WORKQUEUE_PRIORITY);
+	}
+#endif
+
 	return 0;
 }
 
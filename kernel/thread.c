@@ -27,6 +27,7 @@
 #include <kernel_internal.h>
 #include <kswap.h>
 #include <init.h>
+#include <tracing.h>
 
 extern struct _static_thread_data _static_thread_data_list_start[];
 extern struct _static_thread_data _static_thread_data_list_end[];
@@ -61,6 +62,56 @@ void k_thread_foreach(k_thread_user_cb_t user_cb, void *user_data)
 void k_thread_foreach(k_thread_user_cb_t user_cb, void *user_data) { }
 #endif
 
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+/* cycle count when the current thread last got accounted */
+static u32_t runtime_start;
+
+/* Must be called with interrupts locked */
+static void runtime_update(void)
+{
+	u32_t now = k_cycle_get_32();
+
+	_current->runtime_cycles += now - runtime_start;
+	runtime_start = now;
+}
+
+void _thread_runtime_switch(void)
+{
+	runtime_update();
+}
+
+u64_t k_thread_runtime_get(k_tid_t thread)
+{
+	unsigned int key = irq_lock();
+	u64_t cycles;
+
+	/* Account the current thread up to now, shortening the time
+	 * accounted at once and the risk of cycle counter wrap around
+	 */
+	runtime_update();
+	cycles = thread->runtime_cycles;
+
+	irq_unlock(key);
+
+	return cycles;
+}
+
+u64_t k_cpu_idle_runtime_get(void)
+{
+	u64_t cycles = 0;
+	int i;
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (_kernel.cpus[i].idle_thread) {
+			cycles += k_thread_runtime_get(
+				_kernel.cpus[i].idle_thread);
+		}
+	}
+
+	return cycles;
+}
+#endif /* CONFIG_THREAD_RUNTIME_STATS */
+
 int k_is_in_isr(void)
 {
 	return _is_in_isr();
@@ -149,6 +200,53 @@ Z_SYSCALL_HANDLER0_SIMPLE(k_thread_custom_data_get);
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_THREAD_CUSTOM_DATA */
 
+int _impl_k_thread_stack_space_get(const struct k_thread *thread,
+				   size_t *unused_ptr)
+{
+#if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO)
+	const u8_t *start = (const u8_t *)thread->stack_info.start;
+	size_t size = thread->stack_info.size;
+	size_t unused = 0;
+
+#ifdef CONFIG_STACK_SENTINEL
+	/* The lowest word holds the sentinel instead of the pattern */
+	start += sizeof(u32_t);
+	size -= sizeof(u32_t);
+#endif
+
+	/* Stacks grow down, their lowest addresses are the last used: skip
+	 * the words never written, then the bytes of the first word written
+	 */
+	while (unused + sizeof(u32_t) <= size &&
+	       *(const u32_t *)(start + unused) == 0xaaaaaaaa) {
+		unused += sizeof(u32_t);
+	}
+	while (unused < size && start[unused] == 0xaa) {
+		unused++;
+	}
+
+	*unused_ptr = unused;
+
+	return 0;
+#else
+	ARG_UNUSED(thread);
+	ARG_UNUSED(unused_ptr);
+
+	return -ENOTSUP;
+#endif
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_thread_stack_space_get, thread_p, unused_p)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(thread_p, K_OBJ_THREAD));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(unused_p, sizeof(size_t)));
+
+	return _impl_k_thread_stack_space_get((struct k_thread *)thread_p,
+					      (size_t *)unused_p);
+}
+#endif /* CONFIG_USERSPACE */
+
 #if defined(CONFIG_THREAD_MONITOR)
 /*
  * Remove a thread from the kernel's list of active threads.
@@ -298,6 +396,7 @@ void _setup_new_thread(struct k_thread *new_thread,
 
 	_new_thread(new_thread, stack, stack_size, entry, p1, p2, p3,
 		    prio, options);
+	sys_trace_thread_create(new_thread, prio);
 #ifdef CONFIG_USERSPACE
 	_k_object_init(new_thread);
 	_k_object_init(stack);
@@ -305,6 +404,10 @@ void _setup_new_thread(struct k_thread *new_thread,
 
 	/* Any given thread has access to itself */
 	k_object_access_grant(new_thread, new_thread);
+#ifdef CONFIG_OBJECT_VALIDATION_CACHE
+	/* Forget the validations of a previous thread using the object */
+	new_thread->obj_cache.gen = 0;
+#endif
 #endif
 #ifdef CONFIG_ARCH_HAS_CUSTOM_SWAP_TO_MAIN
 	/* _current may be null if the dummy thread is not used */
@@ -328,6 +431,7 @@ void _setup_new_thread(struct k_thread *new_thread,
 	new_thread->base.prio_deadline = 0;
 #endif
 	new_thread->resource_pool = _current->resource_pool;
+	new_thread->pended_mutex = NULL;
 }
 
 #ifdef CONFIG_MULTITHREADING
@@ -9,6 +9,7 @@
 #include <init.h>
 #include <wait_q.h>
 #include <syscall_handler.h>
+#include <tracing.h>
 
 extern struct k_timer _k_timer_list_start[];
 extern struct k_timer _k_timer_list_end[];
@@ -49,6 +50,8 @@ void _timer_expiration_handler(struct _timeout *t)
 	struct k_thread *thread;
 	unsigned int key;
 
+	sys_trace_timer_expiry(timer);
+
 	/*
 	 * if the timer is periodic, start it again; don't add _TICK_ALIGN
 	 * since we're already aligned to a tick boundary
@@ -110,6 +113,21 @@ void k_timer_init(struct k_timer *timer,
 }
 
 
+static void timer_start_ticks(struct k_timer *timer, s32_t duration_in_ticks,
+			      s32_t period_in_ticks)
+{
+	unsigned int key = irq_lock();
+
+	if (timer->timeout.delta_ticks_from_prev != _INACTIVE) {
+		_abort_timeout(&timer->timeout);
+	}
+
+	timer->period = period_in_ticks;
+	timer->status = 0;
+	_add_timeout(NULL, &timer->timeout, &timer->wait_q, duration_in_ticks);
+	irq_unlock(key);
+}
+
 void _impl_k_timer_start(struct k_timer *timer, s32_t duration, s32_t period)
 {
 	__ASSERT(duration >= 0 && period >= 0 &&
@@ -120,16 +138,21 @@ void _impl_k_timer_start(struct k_timer *timer, s32_t duration, s32_t period)
 	period_in_ticks = _ms_to_ticks(period);
 	duration_in_ticks = _ms_to_ticks(duration);
 
-	unsigned int key = irq_lock();
+	timer_start_ticks(timer, duration_in_ticks, period_in_ticks);
+}
 
-	if (timer->timeout.delta_ticks_from_prev != _INACTIVE) {
-		_abort_timeout(&timer->timeout);
-	}
+void _impl_k_timer_start_us(struct k_timer *timer, s32_t duration,
+			    s32_t period)
+{
+	__ASSERT(duration >= 0 && period >= 0 &&
+		 (duration != 0 || period != 0), "invalid parameters\n");
 
-	timer->period = period_in_ticks;
-	timer->status = 0;
-	_add_timeout(NULL, &timer->timeout, &timer->wait_q, duration_in_ticks);
-	irq_unlock(key);
+	volatile s32_t period_in_ticks, duration_in_ticks;
+
+	period_in_ticks = _us_to_ticks(period);
+	duration_in_ticks = _us_to_ticks(duration);
+
+	timer_start_ticks(timer, duration_in_ticks, period_in_ticks);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -146,6 +169,20 @@ Z_SYSCALL_HANDLER(k_timer_start, timer, duration_p, period_p)
 	_impl_k_timer_start((struct k_timer *)timer, duration, period);
 	return 0;
 }
+
+Z_SYSCALL_HANDLER(k_timer_start_us, timer, duration_p, period_p)
+{
+	s32_t duration, period;
+
+	duration = (s32_t)duration_p;
+	period = (s32_t)period_p;
+
+	Z_OOPS(Z_SYSCALL_VERIFY(duration >= 0 && period >= 0 &&
+				(duration != 0 || period != 0)));
+	Z_OOPS(Z_SYSCALL_OBJ(timer, K_OBJ_TIMER));
+	_impl_k_timer_start_us((struct k_timer *)timer, duration, period);
+	return 0;
+}
 #endif
 
 void _impl_k_timer_stop(struct k_timer *timer)
@@ -236,6 +273,9 @@ s32_t _timeout_remaining_get(struct _timeout *timeout)
 	if (timeout->delta_ticks_from_prev == _INACTIVE) {
 		remaining_ticks = 0;
 	} else {
+#ifdef CONFIG_TIMEOUT_QUEUE_FAST
+		remaining_ticks = _timeout_rbq_remaining(timeout);
+#else
 		/*
 		 * compute remaining ticks by walking the timeout list
 		 * and summing up the various tick deltas involved
@@ -249,6 +289,7 @@ s32_t _timeout_remaining_get(struct _timeout *timeout)
 								   &t->node);
 			remaining_ticks += t->delta_ticks_from_prev;
 		}
+#endif
 	}
 
 	irq_unlock(key);
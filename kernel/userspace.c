@@ -47,6 +47,25 @@ struct perm_ctx {
 	struct k_thread *parent;
 };
 
+#ifdef CONFIG_OBJECT_VALIDATION_CACHE
+/*
+ * Generation of the kernel object validations cached by the threads.
+ * Bumping it flushes the caches of all the threads at once: a thread cache
+ * of another generation is flushed when next used. Generation 0 is never
+ * used, so that new threads start with an empty cache.
+ */
+static u32_t obj_cache_gen = 1;
+
+static void obj_cache_flush_all(void)
+{
+	if (++obj_cache_gen == 0) {
+		obj_cache_gen = 1;
+	}
+}
+#else
+#define obj_cache_flush_all() do { } while ((0))
+#endif /* CONFIG_OBJECT_VALIDATION_CACHE */
+
 #ifdef CONFIG_DYNAMIC_OBJECTS
 struct dyn_obj {
 	struct _k_object kobj;
@@ -174,6 +193,7 @@ void k_object_free(void *obj)
 	if (dyn_obj) {
 		rb_remove(&obj_rb_tree, &dyn_obj->node);
 		sys_dlist_remove(&dyn_obj->obj_list);
+		obj_cache_flush_all();
 	}
 	irq_unlock(key);
 
@@ -230,6 +250,9 @@ static int thread_index_get(struct k_thread *t)
 
 static void unref_check(struct _k_object *ko)
 {
+	/* A permission was revoked, the object may be freed */
+	obj_cache_flush_all();
+
 	for (int i = 0; i < CONFIG_MAX_THREAD_BYTES; i++) {
 		if (ko->perms[i]) {
 			return;
@@ -407,6 +430,24 @@ void k_object_access_all_grant(void *object)
 	}
 }
 
+static int obj_init_check(struct _k_object *ko, enum _obj_init_check init)
+{
+	/* Initialization state checks. _OBJ_INIT_ANY, we don't care */
+	if (likely(init == _OBJ_INIT_TRUE)) {
+		/* Object MUST be intialized */
+		if (unlikely(!(ko->flags & K_OBJ_FLAG_INITIALIZED))) {
+			return -EINVAL;
+		}
+	} else if (init < _OBJ_INIT_TRUE) { /* _OBJ_INIT_FALSE case */
+		/* Object MUST NOT be initialized */
+		if (unlikely(ko->flags & K_OBJ_FLAG_INITIALIZED)) {
+			return -EADDRINUSE;
+		}
+	}
+
+	return 0;
+}
+
 int _k_object_validate(struct _k_object *ko, enum k_objects otype,
 		       enum _obj_init_check init)
 {
@@ -421,21 +462,50 @@ int _k_object_validate(struct _k_object *ko, enum k_objects otype,
 		return -EPERM;
 	}
 
-	/* Initialization state checks. _OBJ_INIT_ANY, we don't care */
-	if (likely(init == _OBJ_INIT_TRUE)) {
-		/* Object MUST be intialized */
-		if (unlikely(!(ko->flags & K_OBJ_FLAG_INITIALIZED))) {
-			return -EINVAL;
+	return obj_init_check(ko, init);
+}
+
+#ifdef CONFIG_OBJECT_VALIDATION_CACHE
+int _k_object_validate_cached(void *obj, enum k_objects otype,
+			      enum _obj_init_check init)
+{
+	struct _thread_obj_cache *cache = &_current->obj_cache;
+	int i = ((uintptr_t)obj / sizeof(void *)) %
+		CONFIG_OBJECT_VALIDATION_CACHE_SIZE;
+	struct _k_object *ko;
+	int ret;
+
+	if (unlikely(cache->gen != obj_cache_gen)) {
+		memset(cache->entries, 0, sizeof(cache->entries));
+		cache->gen = obj_cache_gen;
+	}
+
+	ko = cache->entries[i].ko;
+	if (likely(ko && cache->entries[i].obj == obj)) {
+		/* The thread is known to have access to the object */
+		if (unlikely(otype != K_OBJ_ANY && ko->type != otype)) {
+			ret = -EBADF;
+		} else {
+			ret = obj_init_check(ko, init);
 		}
-	} else if (init < _OBJ_INIT_TRUE) { /* _OBJ_INIT_FALSE case */
-		/* Object MUST NOT be initialized */
-		if (unlikely(ko->flags & K_OBJ_FLAG_INITIALIZED)) {
-			return -EADDRINUSE;
+	} else {
+		ko = _k_object_find(obj);
+		ret = _k_object_validate(ko, otype, init);
+		if (ret == 0) {
+			cache->entries[i].obj = obj;
+			cache->entries[i].ko = ko;
 		}
 	}
 
-	return 0;
+#ifdef CONFIG_PRINTK
+	if (ret) {
+		_dump_object_error(ret, obj, ko, otype);
+	}
+#endif
+
+	return ret;
 }
+#endif /* CONFIG_OBJECT_VALIDATION_CACHE */
 
 void _k_object_init(void *object)
 {
@@ -15,46 +15,93 @@
 #include <wait_q.h>
 #include <errno.h>
 
-static void work_q_main(void *work_q_ptr, void *p2, void *p3)
+static void work_q_process(struct k_work *work)
+{
+	k_work_handler_t handler = work->handler;
+
+	/* Reset pending state so it can be resubmitted by handler */
+	if (atomic_test_and_clear_bit(work->flags, K_WORK_STATE_PENDING)) {
+		handler(work);
+	}
+}
+
+static void work_q_main(void *work_q_ptr, void *batch_p, void *p3)
 {
 	struct k_work_q *work_q = work_q_ptr;
+	int batch = (int)(uintptr_t)batch_p;
 
-	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
 	while (1) {
-		struct k_work *work;
-		k_work_handler_t handler;
-
-		work = k_queue_get(&work_q->queue, K_FOREVER);
-		if (!work) {
-			continue;
+		void *work[K_WORK_Q_BATCH_MAX];
+		int n, i;
+
+		if (batch > 1) {
+			n = k_queue_get_batch(&work_q->queue, work, batch,
+					      K_FOREVER);
+		} else {
+			work[0] = k_queue_get(&work_q->queue, K_FOREVER);
+			n = work[0] ? 1 : 0;
 		}
 
-		handler = work->handler;
-
-		/* Reset pending state so it can be resubmitted by handler */
-		if (atomic_test_and_clear_bit(work->flags,
-					      K_WORK_STATE_PENDING)) {
-			handler(work);
+		for (i = 0; i < n; i++) {
+			work_q_process(work[i]);
 		}
 
 		/* Make sure we don't hog up the CPU if the FIFO never (or
 		 * very rarely) gets empty.
 		 */
-		k_yield();
+		if (n) {
+			k_yield();
+		}
 	}
 }
 
 void k_work_q_start(struct k_work_q *work_q, k_thread_stack_t *stack,
 		    size_t stack_size, int prio)
 {
+	k_work_q_start_batch(work_q, stack, stack_size, prio, 1);
+}
+
+void k_work_q_start_batch(struct k_work_q *work_q, k_thread_stack_t *stack,
+			  size_t stack_size, int prio, int batch)
+{
+	__ASSERT(batch > 0 && batch <= K_WORK_Q_BATCH_MAX,
+		 "invalid batch size %d", batch);
+
 	k_queue_init(&work_q->queue);
 	k_thread_create(&work_q->thread, stack, stack_size, work_q_main,
-			work_q, 0, 0, prio, 0, 0);
+			work_q, (void *)(uintptr_t)batch, 0, prio, 0, 0);
 	_k_object_init(work_q);
 }
 
+void k_work_q_add_worker(struct k_work_q *work_q, struct k_thread *thread,
+			 k_thread_stack_t *stack, size_t stack_size, int prio)
+{
+	k_thread_create(thread, stack, stack_size, work_q_main,
+			work_q, (void *)1, 0, prio, 0, 0);
+}
+
+#ifdef CONFIG_WORK_ITEM_PRIORITY
+void _k_work_q_insert(struct k_work_q *work_q, struct k_work *work)
+{
+	int key = irq_lock();
+	sys_sfnode_t *node, *prev = NULL;
+
+	/* Queue after the last work item of the same or a higher priority */
+	SYS_SFLIST_FOR_EACH_NODE(&work_q->queue.data_q, node) {
+		if (((struct k_work *)node)->prio > work->prio) {
+			break;
+		}
+		prev = node;
+	}
+
+	k_queue_insert(&work_q->queue, prev, work);
+
+	irq_unlock(key);
+}
+#endif /* CONFIG_WORK_ITEM_PRIORITY */
+
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 static void work_timeout(struct _timeout *t)
 {
@@ -7,6 +7,27 @@
  */
 
 #include <string.h>
+#include <stdint.h>
+
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING
+/*
+ * The optimized routines handle strings and memory a word at a time.
+ * Reading a whole aligned word can go past the end of a string, but never
+ * across a page or memory region boundary, so it is harmless.
+ */
+typedef uintptr_t mem_word_t;
+
+#define WORD_SIZE sizeof(mem_word_t)
+#define WORD_MASK (WORD_SIZE - 1)
+#define WORD_ALIGNED(p) (((uintptr_t)(p) & WORD_MASK) == 0)
+
+/* 0x0101...01 and 0x8080...80 */
+#define WORD_ONES ((mem_word_t)-1 / 0xff)
+#define WORD_HIGHS (WORD_ONES * 0x80)
+
+/* Nonzero if word <w> has a zero byte */
+#define WORD_HAS_ZERO(w) (((w) - WORD_ONES) & ~(w) & WORD_HIGHS)
+#endif
 
 /**
  *
@@ -68,6 +89,25 @@ char *strchr(const char *s, int c)
 {
 	char tmp = (char) c;
 
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING
+	mem_word_t c_word = WORD_ONES * (unsigned char)c;
+	const mem_word_t *w;
+
+	while (!WORD_ALIGNED(s)) {
+		if ((*s == tmp) || (*s == '\0')) {
+			return (*s == tmp) ? (char *) s : NULL;
+		}
+		s++;
+	}
+
+	/* skip words holding neither the byte nor the terminator */
+	w = (const mem_word_t *)s;
+	while (!WORD_HAS_ZERO(*w) && !WORD_HAS_ZERO(*w ^ c_word)) {
+		w++;
+	}
+	s = (const char *)w;
+#endif
+
 	while ((*s != tmp) && (*s != '\0'))
 		s++;
 
@@ -103,6 +143,25 @@ char *strrchr(const char *s, int c)
 
 size_t strlen(const char *s)
 {
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING
+	const char *start = s;
+	const mem_word_t *w;
+
+	while (!WORD_ALIGNED(s)) {
+		if (*s == '\0') {
+			return s - start;
+		}
+		s++;
+	}
+
+	for (w = (const mem_word_t *)s; !WORD_HAS_ZERO(*w); w++) {
+	}
+
+	for (s = (const char *)w; *s != '\0'; s++) {
+	}
+
+	return s - start;
+#else
 	size_t n = 0;
 
 	while (*s != '\0') {
@@ -111,6 +170,7 @@ size_t strlen(const char *s)
 	}
 
 	return n;
+#endif
 }
 
 /**
@@ -122,6 +182,30 @@ size_t strlen(const char *s)
 
 int strcmp(const char *s1, const char *s2)
 {
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING
+	/* compare words only if both strings have identical alignment */
+	if (WORD_ALIGNED((uintptr_t)s1 ^ (uintptr_t)s2)) {
+		const mem_word_t *w1, *w2;
+
+		while (!WORD_ALIGNED(s1) && (*s1 == *s2) && (*s1 != '\0')) {
+			s1++;
+			s2++;
+		}
+
+		/* stops at once if a difference was found above */
+		w1 = (const mem_word_t *)s1;
+		w2 = (const mem_word_t *)s2;
+		while (WORD_ALIGNED(w1) && (*w1 == *w2) &&
+		       !WORD_HAS_ZERO(*w1)) {
+			w1++;
+			w2++;
+		}
+
+		s1 = (const char *)w1;
+		s2 = (const char *)w2;
+	}
+#endif
+
 	while ((*s1 == *s2) && (*s1 != '\0')) {
 		s1++;
 		s2++;
@@ -226,6 +310,7 @@ void *memmove(void *d, const void *s, size_t n)
 	return d;
 }
 
+#ifndef CONFIG_ARCH_HAS_CUSTOM_MEMCPY
 /**
  *
  * @brief Copy bytes in memory
@@ -235,11 +320,73 @@ void *memmove(void *d, const void *s, size_t n)
 
 void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 {
-	/* attempt word-sized copying only if buffers have identical alignment */
-
 	unsigned char *d_byte = (unsigned char *)d;
 	const unsigned char *s_byte = (const unsigned char *)s;
 
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING
+	/* copy small areas byte by byte */
+	if (n >= 2 * WORD_SIZE) {
+		mem_word_t *d_word;
+		const mem_word_t *s_word;
+		size_t words;
+
+		/* do byte-sized copying until the destination is aligned */
+		while (!WORD_ALIGNED(d_byte)) {
+			*(d_byte++) = *(s_byte++);
+			n--;
+		}
+
+		d_word = (mem_word_t *)d_byte;
+		words = n / WORD_SIZE;
+
+		if (WORD_ALIGNED(s_byte)) {
+			/* do word-sized copying, four words at a time */
+			s_word = (const mem_word_t *)s_byte;
+
+			for (; words >= 4; words -= 4) {
+				d_word[0] = s_word[0];
+				d_word[1] = s_word[1];
+				d_word[2] = s_word[2];
+				d_word[3] = s_word[3];
+				d_word += 4;
+				s_word += 4;
+			}
+
+			while (words--) {
+				*(d_word++) = *(s_word++);
+			}
+		} else {
+			/*
+			 * Read aligned source words, and shift the bytes of
+			 * two consecutive words into each destination word.
+			 */
+			unsigned int shift = ((uintptr_t)s_byte & WORD_MASK) * 8;
+			mem_word_t lo, hi;
+
+			s_word = (const mem_word_t *)((uintptr_t)s_byte &
+						      ~WORD_MASK);
+			lo = *(s_word++);
+
+			while (words--) {
+				hi = *(s_word++);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+				*(d_word++) = (lo << shift) |
+					      (hi >> (WORD_SIZE * 8 - shift));
+#else
+				*(d_word++) = (lo >> shift) |
+					      (hi << (WORD_SIZE * 8 - shift));
+#endif
+				lo = hi;
+			}
+		}
+
+		s_byte += (unsigned char *)d_word - d_byte;
+		n -= (unsigned char *)d_word - d_byte;
+		d_byte = (unsigned char *)d_word;
+	}
+#else
+	/* attempt word-sized copying only if buffers have identical alignment */
+
 	if ((((unsigned int)d ^ (unsigned int)s_byte) & 0x3) == 0) {
 
 		/* do byte-sized copying until word-aligned or finished */
@@ -265,6 +412,7 @@ void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 		d_byte = (unsigned char *)d_word;
 		s_byte = (unsigned char *)s_word;
 	}
+#endif
 
 	/* do byte-sized copying until finished */
 
@@ -275,7 +423,9 @@ void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 
 	return d;
 }
+#endif /* CONFIG_ARCH_HAS_CUSTOM_MEMCPY */
 
+#ifndef CONFIG_ARCH_HAS_CUSTOM_MEMSET
 /**
  *
  * @brief Set bytes in memory
@@ -306,6 +456,16 @@ void *memset(void *buf, int c, size_t n)
 	c_word |= c_word << 8;
 	c_word |= c_word << 16;
 
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING
+	for (; n >= 4 * sizeof(unsigned int); n -= 4 * sizeof(unsigned int)) {
+		d_word[0] = c_word;
+		d_word[1] = c_word;
+		d_word[2] = c_word;
+		d_word[3] = c_word;
+		d_word += 4;
+	}
+#endif
+
 	while (n >= sizeof(unsigned int)) {
 		*(d_word++) = c_word;
 		n -= sizeof(unsigned int);
@@ -322,6 +482,7 @@ void *memset(void *buf, int c, size_t n)
 
 	return buf;
 }
+#endif /* CONFIG_ARCH_HAS_CUSTOM_MEMSET */
 
 /**
  *
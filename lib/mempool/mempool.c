@@ -82,6 +82,13 @@ void _sys_mem_pool_base_init(struct sys_mem_pool_base *p)
 	size_t buflen = p->n_max * p->max_sz, sz = p->max_sz;
 	u32_t *bits = p->buf + buflen;
 
+#ifdef CONFIG_SYS_MEM_POOL_TLSF
+	if (p->flags & SYS_MEM_POOL_TLSF) {
+		_sys_mem_pool_tlsf_init(p);
+		return;
+	}
+#endif
+
 	for (i = 0; i < p->n_levels; i++) {
 		int nblocks = buflen / sz;
 
@@ -218,8 +225,8 @@ static void *block_break(struct sys_mem_pool_base *p, void *block, int l,
 	return block;
 }
 
-int _sys_mem_pool_block_alloc(struct sys_mem_pool_base *p, size_t size,
-			      u32_t *level_p, u32_t *block_p, void **data_p)
+static int buddy_alloc(struct sys_mem_pool_base *p, size_t size,
+		       u32_t *level_p, u32_t *block_p, void **data_p)
 {
 	int i, from_l;
 	int alloc_l = -1, free_l = -1;
@@ -278,16 +285,30 @@ int _sys_mem_pool_block_alloc(struct sys_mem_pool_base *p, size_t size,
 	*block_p = block_num(p, data, lsizes[alloc_l]);
 	*data_p = data;
 
+	_sys_mem_pool_stats_alloc(p, lsizes[alloc_l]);
+
 	return 0;
 }
 
-void _sys_mem_pool_block_free(struct sys_mem_pool_base *p, u32_t level,
-			      u32_t block)
+int _sys_mem_pool_block_alloc(struct sys_mem_pool_base *p, size_t size,
+			      u32_t *level_p, u32_t *block_p, void **data_p)
+{
+#ifdef CONFIG_SYS_MEM_POOL_TLSF
+	if (p->flags & SYS_MEM_POOL_TLSF) {
+		return _sys_mem_pool_tlsf_alloc(p, size, level_p, block_p,
+						data_p);
+	}
+#endif
+
+	return buddy_alloc(p, size, level_p, block_p, data_p);
+}
+
+static void buddy_free(struct sys_mem_pool_base *p, u32_t level, u32_t block)
 {
 	size_t lsizes[p->n_levels];
 	int i;
 
-	/* As in _sys_mem_pool_block_alloc(), we build a table of level sizes
+	/* As in buddy_alloc(), we build a table of level sizes
 	 * to avoid having to store it in precious RAM bytes.
 	 * Overhead here is somewhat higher because block_free()
 	 * doesn't inherently need to traverse all the larger
@@ -298,9 +319,68 @@ void _sys_mem_pool_block_free(struct sys_mem_pool_base *p, u32_t level,
 		lsizes[i] = _ALIGN4(lsizes[i-1] / 4);
 	}
 
+	_sys_mem_pool_stats_free(p, lsizes[level]);
+
 	block_free(p, level, lsizes, block);
 }
 
+void _sys_mem_pool_block_free(struct sys_mem_pool_base *p, u32_t level,
+			      u32_t block)
+{
+#ifdef CONFIG_SYS_MEM_POOL_TLSF
+	if (p->flags & SYS_MEM_POOL_TLSF) {
+		_sys_mem_pool_tlsf_free(p, level, block);
+		return;
+	}
+#endif
+
+	buddy_free(p, level, block);
+}
+
+#ifdef CONFIG_MEM_POOL_STATS
+/* Size of the largest free block, the first non-empty level */
+static size_t max_free_block(struct sys_mem_pool_base *p)
+{
+	size_t lsz = _ALIGN4(p->max_sz);
+	int i;
+
+#ifdef CONFIG_SYS_MEM_POOL_TLSF
+	if (p->flags & SYS_MEM_POOL_TLSF) {
+		return _sys_mem_pool_tlsf_max_free(p);
+	}
+#endif
+
+	for (i = 0; i < p->n_levels; i++) {
+		if (!level_empty(p, i)) {
+			return lsz;
+		}
+		lsz = _ALIGN4(lsz / 4);
+	}
+
+	return 0;
+}
+
+void _sys_mem_pool_base_stats_get(struct sys_mem_pool_base *p,
+				  struct sys_mem_pool_stats *stats)
+{
+	int key = 0;
+
+	/* user mode pools are already protected by their mutex */
+	if (!(p->flags & SYS_MEM_POOL_USER)) {
+		key = irq_lock();
+	}
+
+	stats->used_bytes = atomic_get(&p->used_bytes);
+	stats->peak_bytes = atomic_get(&p->peak_bytes);
+	stats->failures = atomic_get(&p->failures);
+	stats->max_free_block = max_free_block(p);
+
+	if (!(p->flags & SYS_MEM_POOL_USER)) {
+		irq_unlock(key);
+	}
+}
+#endif
+
 /*
  * Functions specific to user-mode blocks
  */
@@ -316,6 +396,7 @@ void *sys_mem_pool_alloc(struct sys_mem_pool *p, size_t size)
 	size += sizeof(struct sys_mem_pool_block);
 	if (_sys_mem_pool_block_alloc(&p->base, size, &level, &block,
 				      (void **)&ret)) {
+		_sys_mem_pool_stats_failure(&p->base);
 		ret = NULL;
 		goto out;
 	}
@@ -347,3 +428,13 @@ void sys_mem_pool_free(void *ptr)
 	k_mutex_unlock(p->mutex);
 }
 
+
+#ifdef CONFIG_MEM_POOL_STATS
+void sys_mem_pool_stats_get(struct sys_mem_pool *p,
+			    struct sys_mem_pool_stats *stats)
+{
+	k_mutex_lock(p->mutex, K_FOREVER);
+	_sys_mem_pool_base_stats_get(&p->base, stats);
+	k_mutex_unlock(p->mutex);
+}
+#endif
@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Two-Level Segregated Fit allocator backend for memory pools.
+ *
+ * Free blocks are kept in one list per size class.  The first level
+ * splits sizes into powers of two, the second level splits each power
+ * of two into SL_COUNT linear subranges.  Two levels of bitmaps record
+ * which lists are non-empty, so that finding a suitable free block is
+ * a couple of bit scans: allocation and free run in bounded time
+ * regardless of the pool state, and blocks are only rounded up to the
+ * next size class boundary (at most 1/SL_COUNT of their size) instead
+ * of the next power of four.
+ *
+ * The pool buffer holds the control structure (bitmaps and list heads,
+ * sized for the buffer) followed by the blocks.  Every block starts
+ * with a header holding its size and a pointer to the block right
+ * before it in memory, used to merge adjacent free blocks.
+ */
+
+#include <kernel.h>
+#include <string.h>
+#include <misc/__assert.h>
+#include <misc/mempool_base.h>
+
+#define SL_LOG2 CONFIG_SYS_MEM_POOL_TLSF_SL_LOG2
+#define SL_COUNT (1 << SL_LOG2)
+
+#define ALIGN sizeof(void *)
+#define ALIGN_LOG2 (find_msb_set(ALIGN) - 1)
+
+/* Blocks smaller than this all go in the first class, in lists of
+ * exact sizes
+ */
+#define FL_SHIFT (SL_LOG2 + ALIGN_LOG2)
+
+/* Unit of the block numbers in block ids */
+#define BLOCK_UNIT 4
+
+#define BLOCK_FREE 1
+
+struct tlsf_block {
+	/* block right before this one in memory, NULL for the first */
+	struct tlsf_block *prev_phys;
+
+	/* size of the block including this header, BLOCK_FREE flag */
+	size_t size;
+
+	/* free blocks only */
+	struct tlsf_block *next_free;
+	struct tlsf_block *prev_free;
+};
+
+#define HDR_SIZE offsetof(struct tlsf_block, next_free)
+#define MIN_BLOCK sizeof(struct tlsf_block)
+
+struct tlsf_control {
+	/* end of the last block */
+	char *end;
+
+	u32_t fl_bitmap;
+	u32_t fl_count;
+
+	/* fl_count bitmaps, then fl_count * SL_COUNT list heads */
+	u32_t *sl_bitmap;
+	struct tlsf_block **heads;
+};
+
+static inline struct tlsf_control *control(struct sys_mem_pool_base *p)
+{
+	return (struct tlsf_control *)ROUND_UP(p->buf, ALIGN);
+}
+
+static inline size_t block_size(struct tlsf_block *b)
+{
+	return b->size & ~BLOCK_FREE;
+}
+
+static inline bool block_is_free(struct tlsf_block *b)
+{
+	return b->size & BLOCK_FREE;
+}
+
+static struct tlsf_block *block_next(struct tlsf_control *c,
+				     struct tlsf_block *b)
+{
+	char *next = (char *)b + block_size(b);
+
+	return next < c->end ? (struct tlsf_block *)next : NULL;
+}
+
+/* Size class of a block size */
+static void mapping(size_t size, int *fl, int *sl)
+{
+	if (size < (1 << FL_SHIFT)) {
+		*fl = 0;
+		*sl = size >> ALIGN_LOG2;
+	} else {
+		int msb = find_msb_set(size) - 1;
+
+		*fl = msb - FL_SHIFT + 1;
+		*sl = (size >> (msb - SL_LOG2)) & (SL_COUNT - 1);
+	}
+}
+
+/* Size class of the smallest free blocks all large enough for @a size */
+static void mapping_search(size_t size, int *fl, int *sl)
+{
+	if (size >= (1 << FL_SHIFT)) {
+		int msb = find_msb_set(size) - 1;
+
+		size += (1 << (msb - SL_LOG2)) - 1;
+	}
+
+	mapping(size, fl, sl);
+}
+
+static struct tlsf_block **list_head(struct tlsf_control *c, int fl, int sl)
+{
+	return &c->heads[fl * SL_COUNT + sl];
+}
+
+static void insert_free(struct tlsf_control *c, struct tlsf_block *b)
+{
+	struct tlsf_block **head;
+	int fl, sl;
+
+	mapping(block_size(b), &fl, &sl);
+	head = list_head(c, fl, sl);
+
+	b->size |= BLOCK_FREE;
+	b->prev_free = NULL;
+	b->next_free = *head;
+	if (*head) {
+		(*head)->prev_free = b;
+	}
+	*head = b;
+
+	c->fl_bitmap |= BIT(fl);
+	c->sl_bitmap[fl] |= BIT(sl);
+}
+
+static void remove_free(struct tlsf_control *c, struct tlsf_block *b)
+{
+	int fl, sl;
+
+	mapping(block_size(b), &fl, &sl);
+
+	if (b->prev_free) {
+		b->prev_free->next_free = b->next_free;
+	} else {
+		*list_head(c, fl, sl) = b->next_free;
+		if (!b->next_free) {
+			c->sl_bitmap[fl] &= ~BIT(sl);
+			if (!c->sl_bitmap[fl]) {
+				c->fl_bitmap &= ~BIT(fl);
+			}
+		}
+	}
+	if (b->next_free) {
+		b->next_free->prev_free = b->prev_free;
+	}
+
+	b->size &= ~BLOCK_FREE;
+}
+
+/* No size class is entirely made of large enough blocks: the first
+ * block in the class of @a size itself may still do.
+ */
+static struct tlsf_block *last_chance(struct tlsf_control *c, size_t size)
+{
+	struct tlsf_block *b;
+	int fl, sl;
+
+	mapping(size, &fl, &sl);
+	if (fl >= c->fl_count) {
+		return NULL;
+	}
+
+	b = *list_head(c, fl, sl);
+
+	return b && block_size(b) >= size ? b : NULL;
+}
+
+/* Free block of at least @a size bytes from the best size class, or NULL */
+static struct tlsf_block *search_free(struct tlsf_control *c, size_t size)
+{
+	u32_t sl_map, fl_map;
+	int fl, sl;
+
+	mapping_search(size, &fl, &sl);
+	if (fl >= c->fl_count) {
+		return last_chance(c, size);
+	}
+
+	sl_map = c->sl_bitmap[fl] & (~0U << sl);
+	if (!sl_map) {
+		fl_map = fl + 1 < 32 ? c->fl_bitmap & (~0U << (fl + 1)) : 0;
+		if (!fl_map) {
+			return last_chance(c, size);
+		}
+
+		fl = find_lsb_set(fl_map) - 1;
+		sl_map = c->sl_bitmap[fl];
+	}
+
+	sl = find_lsb_set(sl_map) - 1;
+
+	return *list_head(c, fl, sl);
+}
+
+/* Give the end of a block back to the pool if it is large enough */
+static void split(struct tlsf_control *c, struct tlsf_block *b, size_t size)
+{
+	size_t rest = block_size(b) - size;
+	struct tlsf_block *r, *next;
+
+	if (rest < MIN_BLOCK) {
+		return;
+	}
+
+	r = (struct tlsf_block *)((char *)b + size);
+	r->size = rest;
+	r->prev_phys = b;
+	b->size = size;
+
+	next = block_next(c, r);
+	if (next) {
+		next->prev_phys = r;
+	}
+
+	insert_free(c, r);
+}
+
+/* Merge the block right after @a b into it, neither being in a list */
+static void absorb_next(struct tlsf_control *c, struct tlsf_block *b)
+{
+	struct tlsf_block *n = block_next(c, b);
+
+	b->size += block_size(n);
+
+	n = block_next(c, b);
+	if (n) {
+		n->prev_phys = b;
+	}
+}
+
+static inline int pool_irq_lock(struct sys_mem_pool_base *p)
+{
+	if (p->flags & SYS_MEM_POOL_USER) {
+		return 0;
+	} else {
+		return irq_lock();
+	}
+}
+
+static inline void pool_irq_unlock(struct sys_mem_pool_base *p, int key)
+{
+	if (!(p->flags & SYS_MEM_POOL_USER)) {
+		irq_unlock(key);
+	}
+}
+
+void _sys_mem_pool_tlsf_init(struct sys_mem_pool_base *p)
+{
+	struct tlsf_control *c = control(p);
+	struct tlsf_block *b;
+	char *start, *end;
+	int fl, sl;
+
+	end = (char *)ROUND_DOWN((char *)p->buf + p->max_sz, ALIGN);
+
+	/* Size the control structure for the largest possible block */
+	mapping(end - (char *)c, &fl, &sl);
+
+	c->end = end;
+	c->fl_bitmap = 0;
+	c->fl_count = fl + 1;
+	c->sl_bitmap = (u32_t *)(c + 1);
+	c->heads = (struct tlsf_block **)ROUND_UP(c->sl_bitmap + c->fl_count,
+						   ALIGN);
+
+	start = (char *)(c->heads + c->fl_count * SL_COUNT);
+
+	__ASSERT(start + MIN_BLOCK <= end, "TLSF pool too small");
+	__ASSERT((end - (char *)c) / BLOCK_UNIT < BIT(20),
+		 "TLSF pool too large");
+
+	memset(c->sl_bitmap, 0, c->fl_count * sizeof(u32_t));
+	memset(c->heads, 0, c->fl_count * SL_COUNT * sizeof(*c->heads));
+
+	b = (struct tlsf_block *)start;
+	b->prev_phys = NULL;
+	b->size = end - start;
+	insert_free(c, b);
+}
+
+int _sys_mem_pool_tlsf_alloc(struct sys_mem_pool_base *p, size_t size,
+			     u32_t *level_p, u32_t *block_p, void **data_p)
+{
+	struct tlsf_control *c = control(p);
+	struct tlsf_block *b;
+	int key;
+
+	if (size > c->end - (char *)c) {
+		*data_p = NULL;
+		return -ENOMEM;
+	}
+
+	size = max(ROUND_UP(size + HDR_SIZE, ALIGN), MIN_BLOCK);
+
+	key = pool_irq_lock(p);
+
+	b = search_free(c, size);
+	if (!b) {
+		pool_irq_unlock(p, key);
+		*data_p = NULL;
+		return -ENOMEM;
+	}
+
+	remove_free(c, b);
+	split(c, b, size);
+
+	_sys_mem_pool_stats_alloc(p, block_size(b));
+
+	pool_irq_unlock(p, key);
+
+	*data_p = (char *)b + HDR_SIZE;
+	*level_p = 0;
+	*block_p = ((char *)*data_p - (char *)c) / BLOCK_UNIT;
+
+	return 0;
+}
+
+void _sys_mem_pool_tlsf_free(struct sys_mem_pool_base *p, u32_t level,
+			     u32_t block)
+{
+	struct tlsf_control *c = control(p);
+	struct tlsf_block *b, *n;
+	int key;
+
+	ARG_UNUSED(level);
+
+	b = (struct tlsf_block *)((char *)c + block * BLOCK_UNIT - HDR_SIZE);
+
+	key = pool_irq_lock(p);
+
+	__ASSERT(!block_is_free(b), "TLSF block freed twice");
+
+	_sys_mem_pool_stats_free(p, block_size(b));
+
+	n = block_next(c, b);
+	if (n && block_is_free(n)) {
+		remove_free(c, n);
+		absorb_next(c, b);
+	}
+
+	if (b->prev_phys && block_is_free(b->prev_phys)) {
+		b = b->prev_phys;
+		remove_free(c, b);
+		absorb_next(c, b);
+	}
+
+	insert_free(c, b);
+
+	pool_irq_unlock(p, key);
+}
+
+#ifdef CONFIG_MEM_POOL_STATS
+/* Must be called with the pool locked */
+size_t _sys_mem_pool_tlsf_max_free(struct sys_mem_pool_base *p)
+{
+	struct tlsf_control *c = control(p);
+	struct tlsf_block *b;
+	size_t max_sz = 0;
+	int fl, sl;
+
+	if (!c->fl_bitmap) {
+		return 0;
+	}
+
+	/* The largest free block is in the last non-empty list, whose
+	 * blocks are not sorted by size
+	 */
+	fl = find_msb_set(c->fl_bitmap) - 1;
+	sl = find_msb_set(c->sl_bitmap[fl]) - 1;
+
+	for (b = *list_head(c, fl, sl); b; b = b->next_free) {
+		max_sz = max(max_sz, block_size(b));
+	}
+
+	return max_sz - HDR_SIZE;
+}
+#endif
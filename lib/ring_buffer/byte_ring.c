@@ -0,0 +1,187 @@
+/* byte_ring.c: Lock-free byte ring buffer API */
+
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The single consumer owns the head index and the producers own the tail
+ * index, so that a single producer and the consumer only need atomic loads
+ * and stores of these indexes to share the buffer.
+ *
+ * Several producers first reserve space by moving the claim index with a
+ * compare and swap, then write in the reserved space.  The bytes claimed
+ * can only be handed to the consumer once all of them are written: the
+ * last producer to commit, when no other one holds claimed space, moves
+ * the tail index up to the claim index.
+ */
+
+#include <ring_buffer.h>
+#include <string.h>
+
+static inline u32_t ring_index(struct byte_ring *ring, u32_t i)
+{
+	return i & (ring->size - 1);
+}
+
+/* Free contiguous space at index @a i, for up to @a size bytes */
+static u32_t free_space(struct byte_ring *ring, u32_t i, u32_t size)
+{
+	u32_t space = ring->size - (i - (u32_t)atomic_get(&ring->head));
+
+	space = min(space, ring->size - ring_index(ring, i));
+
+	return min(space, size);
+}
+
+u32_t sys_byte_ring_put_claim(struct byte_ring *ring, u8_t **data,
+			      u32_t size)
+{
+	u32_t tail = atomic_get(&ring->tail);
+
+	*data = &ring->buf[ring_index(ring, tail)];
+
+	return free_space(ring, tail, size);
+}
+
+int sys_byte_ring_put_commit(struct byte_ring *ring, u32_t size)
+{
+	u32_t tail = atomic_get(&ring->tail);
+
+	if (size > ring->size - (tail - (u32_t)atomic_get(&ring->head))) {
+		return -EINVAL;
+	}
+
+	/* Keep the claim index, used to get the free space, in sync */
+	atomic_set(&ring->claim, tail + size);
+	atomic_set(&ring->tail, tail + size);
+
+	return 0;
+}
+
+u32_t sys_byte_ring_put(struct byte_ring *ring, const u8_t *data,
+			u32_t size)
+{
+	u32_t done = 0;
+	u32_t n;
+	u8_t *dst;
+
+	while (done < size &&
+	       (n = sys_byte_ring_put_claim(ring, &dst, size - done))) {
+		memcpy(dst, data + done, n);
+		sys_byte_ring_put_commit(ring, n);
+		done += n;
+	}
+
+	return done;
+}
+
+u32_t sys_byte_ring_mpsc_put_claim(struct byte_ring *ring, u8_t **data,
+				   u32_t size)
+{
+	u32_t claim, n;
+
+	/* Hold the tail back until the claimed space is written */
+	atomic_inc(&ring->pending);
+
+	do {
+		claim = atomic_get(&ring->claim);
+		n = free_space(ring, claim, size);
+		if (!n) {
+			sys_byte_ring_mpsc_put_commit(ring);
+			return 0;
+		}
+	} while (!atomic_cas(&ring->claim, claim, claim + n));
+
+	*data = &ring->buf[ring_index(ring, claim)];
+
+	return n;
+}
+
+void sys_byte_ring_mpsc_put_commit(struct byte_ring *ring)
+{
+	u32_t claim, tail;
+
+	if (atomic_dec(&ring->pending) != 1) {
+		/* The last producer to commit publishes our bytes */
+		return;
+	}
+
+	/*
+	 * A producer claiming space from now on either shows up in the
+	 * pending count, and publishes our bytes along with its own, or
+	 * claims after the claim index read here.
+	 */
+	claim = atomic_get(&ring->claim);
+	if (atomic_get(&ring->pending)) {
+		return;
+	}
+
+	do {
+		tail = atomic_get(&ring->tail);
+		if ((s32_t)(claim - tail) <= 0) {
+			/* already published by a later producer */
+			return;
+		}
+	} while (!atomic_cas(&ring->tail, tail, claim));
+}
+
+u32_t sys_byte_ring_mpsc_put(struct byte_ring *ring, const u8_t *data,
+			     u32_t size)
+{
+	u32_t done = 0;
+	u32_t n;
+	u8_t *dst;
+
+	while (done < size &&
+	       (n = sys_byte_ring_mpsc_put_claim(ring, &dst, size - done))) {
+		memcpy(dst, data + done, n);
+		sys_byte_ring_mpsc_put_commit(ring);
+		done += n;
+	}
+
+	return done;
+}
+
+u32_t sys_byte_ring_peek(struct byte_ring *ring, u8_t **data, u32_t size)
+{
+	u32_t head = atomic_get(&ring->head);
+	u32_t used = (u32_t)atomic_get(&ring->tail) - head;
+
+	*data = &ring->buf[ring_index(ring, head)];
+
+	used = min(used, ring->size - ring_index(ring, head));
+
+	return min(used, size);
+}
+
+int sys_byte_ring_consume(struct byte_ring *ring, u32_t size)
+{
+	u32_t head = atomic_get(&ring->head);
+
+	if (size > (u32_t)atomic_get(&ring->tail) - head) {
+		return -EINVAL;
+	}
+
+	atomic_set(&ring->head, head + size);
+
+	return 0;
+}
+
+u32_t sys_byte_ring_get(struct byte_ring *ring, u8_t *data, u32_t size)
+{
+	u32_t done = 0;
+	u32_t n;
+	u8_t *src;
+
+	while (done < size &&
+	       (n = sys_byte_ring_peek(ring, &src, size - done))) {
+		memcpy(data + done, src, n);
+		sys_byte_ring_consume(ring, n);
+		done += n;
+	}
+
+	return done;
+}
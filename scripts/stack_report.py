@@ -0,0 +1,247 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2018 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Report the worst-case stack depth of thread entry functions
+
+The stack usage of each function, written by the compiler in .su files when
+building with CONFIG_STACK_USAGE (-fstack-usage), is combined with the call
+graph read from the disassembly of the kernel image, to compute the deepest
+stack each entry function may use with the functions it calls.
+
+The entry functions are the ones given with --entry, thread entry points
+typically, or by default all the functions never called directly, which
+include the thread entry points and the callbacks.
+
+The depths reported are lower bounds when the notes say so:
+
+  dynamic   a function uses a dynamically sized stack (alloca or VLA)
+  indirect  a function calls through a pointer, which is not followed
+  recursive a function is part of a recursion, which is cut
+  unknown   a function called has no stack usage information, as assembly
+            or precompiled library code
+
+The stack used by the arch specific thread entry code, by exceptions and by
+interrupts running on the thread stack is not accounted either.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+# objdump -d --no-show-raw-insn output
+FUNC_RE = re.compile(r"^([0-9a-f]+) <(.+)>:$")
+INSN_RE = re.compile(r"^\s*([0-9a-f]+):\s+(\S+)\s*(.*)$")
+TARGET_RE = re.compile(r"<([^>]+)>\s*$")
+
+# -fstack-usage output: file:line[:column]:function<TAB>bytes<TAB>qualifiers
+SU_RE = re.compile(r"^.*?:\d+:(?:\d+:)?(.+)\t(\d+)\t(\S+)$")
+
+# Mnemonics of the direct and indirect calls of the supported architectures
+CALLS = {"call", "calll", "callq", "bl", "blx", "jal", "jl", "call0",
+         "call4", "call8", "call12", "callr", "jsr", "bsr"}
+INDIRECT_CALLS = {"callx0", "callx4", "callx8", "callx12", "jalr", "jlr"}
+
+# Mnemonics of the unconditional jumps, which may be tail calls
+JUMPS = {"jmp", "jmpq", "b", "j", "bra"}
+
+
+def parse_args():
+    global args
+
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+
+    parser.add_argument("elf", help="Kernel image")
+    parser.add_argument("-d", "--directory", default=".",
+                        help="Directory searched for .su files, the current "
+                        "directory by default")
+    parser.add_argument("-e", "--entry", action="append", default=[],
+                        help="Entry function to report, may be repeated")
+    parser.add_argument("--objdump", default="objdump",
+                        help="objdump program to disassemble the image")
+    parser.add_argument("-v", "--verbose", action="store_true",
+                        help="Print the deepest call chain of each entry")
+    args = parser.parse_args()
+
+
+def error(msg):
+    sys.exit("stack_report: " + msg)
+
+
+def mnemonic(insn):
+    # Drop the size, condition and delay slot suffixes (b.w, bl.d, jl_s)
+    return re.split(r"[._]", insn)[0]
+
+
+def symbol(name):
+    return name.split("@")[0]
+
+
+def read_stack_usage(directory):
+    usage = {}
+    dynamic = set()
+
+    for root, _, files in os.walk(directory):
+        for f in files:
+            if not f.endswith(".su"):
+                continue
+            with open(os.path.join(root, f)) as su:
+                for line in su:
+                    m = SU_RE.match(line.rstrip("\n"))
+                    if not m:
+                        continue
+                    name, size, qualifiers = m.groups()
+                    # Static functions of the same name in several files
+                    # are not told apart, assume the largest
+                    usage[name] = max(usage.get(name, 0), int(size))
+                    if qualifiers == "dynamic":
+                        dynamic.add(name)
+
+    return usage, dynamic
+
+
+def read_call_graph(elf):
+    calls = {}
+    tails = {}
+    indirect = set()
+    func = None
+
+    try:
+        out = subprocess.check_output([args.objdump, "-d",
+                                       "--no-show-raw-insn", elf],
+                                      universal_newlines=True)
+    except (OSError, subprocess.CalledProcessError) as e:
+        error("can not disassemble %s: %s" % (elf, e))
+
+    for line in out.splitlines():
+        m = FUNC_RE.match(line)
+        if m:
+            func = symbol(m.group(2))
+            calls.setdefault(func, set())
+            tails.setdefault(func, set())
+            continue
+
+        m = INSN_RE.match(line)
+        if not m or func is None:
+            continue
+
+        insn = mnemonic(m.group(2))
+        # Drop the comments, which may name the data accessed
+        operands = re.sub(r"\s+[#;].*$", "", m.group(3))
+        target = TARGET_RE.search(operands)
+        # A target with an offset is not the start of a function
+        if target and "+" in target.group(1):
+            target = None
+        if target:
+            target = symbol(target.group(1))
+
+        if insn in CALLS:
+            if target:
+                calls[func].add(target)
+            else:
+                indirect.add(func)
+        elif insn in INDIRECT_CALLS:
+            indirect.add(func)
+        elif insn in JUMPS and target and target != func:
+            tails[func].add(target)
+        elif insn in JUMPS and operands.startswith("*"):
+            indirect.add(func)
+
+    return calls, tails, indirect
+
+
+class StackGraph:
+    def __init__(self, usage, dynamic, calls, tails, indirect):
+        self.usage = usage
+        self.dynamic = dynamic
+        self.calls = calls
+        self.tails = tails
+        self.indirect = indirect
+        self.depths = {}
+        self.visiting = set()
+
+    def notes(self, func):
+        notes = set()
+
+        if func not in self.usage:
+            notes.add("unknown")
+        if func in self.dynamic:
+            notes.add("dynamic")
+        if func in self.indirect:
+            notes.add("indirect")
+
+        return notes
+
+    def depth(self, func):
+        """Return the worst-case depth, chain and notes of a function"""
+
+        if func in self.depths:
+            return self.depths[func]
+
+        self.visiting.add(func)
+
+        own = self.usage.get(func, 0)
+        notes = self.notes(func)
+        best, chain = own, [func]
+
+        # The frame of the caller is still on the stack during a call,
+        # it is already popped when jumping to a tail call
+        for callees, frame in ((self.calls.get(func, ()), own),
+                               (self.tails.get(func, ()), 0)):
+            for callee in sorted(callees):
+                if callee in self.visiting:
+                    notes.add("recursive")
+                    continue
+                d, c, n = self.depth(callee)
+                notes |= n
+                if frame + d > best:
+                    best, chain = frame + d, [func] + c
+
+        self.visiting.remove(func)
+        self.depths[func] = (best, chain, notes)
+
+        return self.depths[func]
+
+
+def main():
+    parse_args()
+    sys.setrecursionlimit(10000)
+
+    usage, dynamic = read_stack_usage(args.directory)
+    if not usage:
+        error("no stack usage information found in %s, build with "
+              "CONFIG_STACK_USAGE enabled" % args.directory)
+
+    calls, tails, indirect = read_call_graph(args.elf)
+    graph = StackGraph(usage, dynamic, calls, tails, indirect)
+
+    if args.entry:
+        entries = args.entry
+        for entry in entries:
+            if entry not in calls:
+                error("no function %s in %s" % (entry, args.elf))
+    else:
+        called = set()
+        for callees in list(calls.values()) + list(tails.values()):
+            called |= callees
+        entries = [f for f in calls if f in usage and f not in called]
+
+    results = sorted(((graph.depth(e), e) for e in entries),
+                     key=lambda r: (-r[0][0], r[1]))
+
+    print("%-40s %8s  %s" % ("Entry", "Stack", "Notes"))
+    for (depth, chain, notes), entry in results:
+        print("%-40s %8d  %s" % (entry, depth, " ".join(sorted(notes))))
+        if args.verbose:
+            for func in chain:
+                print("    %-36s %8d" % (func, usage.get(func, 0)))
+
+
+if __name__ == "__main__":
+    main()
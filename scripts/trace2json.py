@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2018 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Convert a kernel event trace stream to Chrome trace JSON
+
+The trace stream recorded with CONFIG_TRACING is converted to the JSON
+trace event format, which can be viewed as a timeline in chrome://tracing
+or https://ui.perfetto.dev.  Each thread gets a track showing when it was
+running, interrupts are shown on a track of their own, and the other
+kernel events are shown as instant events of the thread they happened in.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+SYS_TRACE_MAGIC = 0x5a545243
+SYS_TRACE_VERSION = 1
+
+HEADER_FORMAT = "IBBHII"
+EVENT_FORMAT = "IBBHII"
+
+# enum sys_trace_event_id of include/tracing.h
+EVENTS = [
+    None,
+    "dropped",
+    "thread_create",
+    "thread_switched_out",
+    "thread_switched_in",
+    "isr_enter",
+    "isr_exit",
+    "sem_give",
+    "sem_take",
+    "mutex_lock",
+    "mutex_unlock",
+    "queue_put",
+    "queue_get",
+    "mem_slab_alloc",
+    "mem_slab_free",
+    "mem_pool_alloc",
+    "mem_pool_free",
+    "timer_expiry",
+]
+
+# track of the interrupts, thread addresses are aligned and never 1
+ISR_TID = 1
+
+
+def parse_args():
+    global args
+
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+
+    parser.add_argument("input", help="Trace stream file")
+    parser.add_argument("-o", "--output",
+                        help="Output file, standard output by default")
+    args = parser.parse_args()
+
+
+def error(msg):
+    sys.exit("trace2json: " + msg)
+
+
+def read_header(data):
+    for order in "<>":
+        fields = struct.unpack_from(order + HEADER_FORMAT, data)
+        if fields[0] == SYS_TRACE_MAGIC:
+            break
+    else:
+        error("not a trace stream")
+
+    _, version, event_size, _, cycles_per_sec, _ = fields
+    if version != SYS_TRACE_VERSION:
+        error("unsupported trace stream version %d" % version)
+    if event_size != struct.calcsize(EVENT_FORMAT):
+        error("unsupported event size %d" % event_size)
+
+    return order, cycles_per_sec
+
+
+def read_events(data, order):
+    fmt = struct.Struct(order + EVENT_FORMAT)
+    offset = struct.calcsize(HEADER_FORMAT)
+    now = None
+
+    while offset + fmt.size <= len(data):
+        ts, ev_id, cpu, ev_data, thread, arg = fmt.unpack_from(data, offset)
+        offset += fmt.size
+
+        # Extend the 32-bit cycle counts, allowing for events recorded
+        # slightly out of order by concurrent contexts
+        if now is None:
+            now = ts
+        else:
+            now += ((ts - now + 0x80000000) & 0xffffffff) - 0x80000000
+
+        yield now, ev_id, cpu, ev_data, thread, arg
+
+
+def thread_name(thread):
+    if not thread:
+        return "pre-kernel"
+    return "thread 0x%08x" % thread
+
+
+def convert(data):
+    order, cycles_per_sec = read_header(data)
+    out = []
+    threads = set()
+    cpus = set()
+
+    for cycles, ev_id, cpu, ev_data, thread, arg in read_events(data, order):
+        ts = cycles * 1000000.0 / cycles_per_sec
+        name = EVENTS[ev_id] if ev_id < len(EVENTS) else None
+        ev = {"ts": ts, "pid": cpu, "tid": thread}
+
+        cpus.add(cpu)
+        threads.add((cpu, thread))
+
+        if name == "thread_switched_in" or name == "thread_switched_out":
+            ev.update(name="running", tid=arg,
+                      ph="B" if name == "thread_switched_in" else "E")
+            threads.add((cpu, arg))
+        elif name == "isr_enter":
+            ev.update(name="irq %d" % ev_data, tid=ISR_TID, ph="B")
+        elif name == "isr_exit":
+            ev.update(tid=ISR_TID, ph="E")
+        elif name == "dropped":
+            ev.update(name="dropped", ph="i", s="g",
+                      args={"events": arg})
+        elif name == "thread_create":
+            ev.update(name=name, ph="i", s="t",
+                      args={"thread": "0x%08x" % arg, "prio": ev_data})
+        elif name:
+            ev.update(name=name, ph="i", s="t",
+                      args={"object": "0x%08x" % arg})
+        else:
+            ev.update(name="unknown %d" % ev_id, ph="i", s="t",
+                      args={"data": ev_data, "arg": arg})
+
+        out.append(ev)
+
+    for cpu in sorted(cpus):
+        out.append({"ph": "M", "pid": cpu, "name": "process_name",
+                    "args": {"name": "cpu %d" % cpu}})
+        out.append({"ph": "M", "pid": cpu, "tid": ISR_TID,
+                    "name": "thread_name", "args": {"name": "interrupts"}})
+    for cpu, thread in sorted(threads):
+        if thread != ISR_TID:
+            out.append({"ph": "M", "pid": cpu, "tid": thread,
+                        "name": "thread_name",
+                        "args": {"name": thread_name(thread)}})
+
+    return {"traceEvents": out, "displayTimeUnit": "ns"}
+
+
+def main():
+    parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+
+    trace = convert(data)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Deferred logging: the log macros only copy the format string and the
+ * arguments of a message to a lock-free ring buffer, and a thread of the
+ * lowest priority formats and outputs the messages later on.
+ *
+ * Each message is a header followed by its arguments, taking a multiple
+ * of MSG_ALIGN bytes in the ring buffer.  Messages never wrap around the
+ * end of the buffer: when the space left at the end is too small, it is
+ * filled with a padding record and the message is written at the start of
+ * the buffer.
+ */
+
+#define SYS_LOG_LEVEL SYS_LOG_LEVEL_DEBUG
+
+#include <kernel.h>
+#include <atomic.h>
+#include <ring_buffer.h>
+#include <string.h>
+#include <logging/sys_log.h>
+
+#define BUF_SIZE CONFIG_SYS_LOG_DEFERRED_BUFFER_SIZE
+
+BUILD_ASSERT_MSG((BUF_SIZE & (BUF_SIZE - 1)) == 0 && BUF_SIZE <= 65536,
+		 "log buffer size must be a power of 2, up to 64 KiB");
+
+struct log_msg {
+	u16_t len;	/* bytes taken in the ring buffer */
+	u8_t level;	/* SYS_LOG_LEVEL_OFF for padding */
+	u8_t nargs;
+	u32_t timestamp;
+	const char *fmt;
+	uintptr_t args[];
+};
+
+#define MSG_ALIGN __alignof__(struct log_msg)
+
+static u8_t __aligned(MSG_ALIGN) log_buf[BUF_SIZE];
+
+static struct byte_ring log_ring = {
+	.size = BUF_SIZE,
+	.buf = log_buf,
+};
+
+int _sys_log_runtime_level = SYS_LOG_LEVEL_DEBUG;
+
+/* messages dropped, in total and since the last drop report */
+static atomic_t dropped_total;
+static atomic_t dropped;
+
+/* set while the logging thread waits for messages */
+static atomic_t thread_idle;
+
+static K_SEM_DEFINE(log_sem, 0, 1);
+
+void sys_log_runtime_level_set(int level)
+{
+	_sys_log_runtime_level = level;
+}
+
+u32_t sys_log_dropped_get(void)
+{
+	return atomic_get(&dropped_total);
+}
+
+/* Claim @a len contiguous bytes, or return NULL if the buffer is full */
+static struct log_msg *msg_claim(u32_t len)
+{
+	struct log_msg *msg;
+	int i;
+
+	for (i = 0; i < 2; i++) {
+		u32_t n = sys_byte_ring_mpsc_put_claim(&log_ring,
+						       (u8_t **)&msg, len);
+		bool at_end;
+
+		if (n == len) {
+			return msg;
+		}
+		if (!n) {
+			break;
+		}
+
+		at_end = (u8_t *)msg + n == log_buf + BUF_SIZE;
+
+		/* The space claimed cannot be given back, the consumer skips
+		 * it as padding.
+		 */
+		msg->len = n;
+		msg->level = SYS_LOG_LEVEL_OFF;
+		sys_byte_ring_mpsc_put_commit(&log_ring);
+
+		/* Only a claim cut short by the end of the buffer is worth
+		 * retrying, otherwise the buffer is full.
+		 */
+		if (!at_end) {
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+void _sys_log_deferred(int level, const char *fmt, const uintptr_t *args,
+		       int nargs)
+{
+	u32_t len = ROUND_UP(sizeof(struct log_msg) + nargs * sizeof(*args),
+			     MSG_ALIGN);
+	u32_t timestamp = k_cycle_get_32();
+	struct log_msg *msg;
+
+	msg = msg_claim(len);
+	if (!msg) {
+		atomic_inc(&dropped_total);
+		atomic_inc(&dropped);
+		return;
+	}
+
+	msg->len = len;
+	msg->level = level;
+	msg->nargs = nargs;
+	msg->timestamp = timestamp;
+	msg->fmt = fmt;
+	memcpy(msg->args, args, nargs * sizeof(*args));
+
+	sys_byte_ring_mpsc_put_commit(&log_ring);
+
+	if (atomic_cas(&thread_idle, 1, 0)) {
+		k_sem_give(&log_sem);
+	}
+}
+
+static void msg_output(struct log_msg *msg)
+{
+	uintptr_t a[SYS_LOG_DEFERRED_MAX_ARGS] = { 0 };
+
+	memcpy(a, msg->args, msg->nargs * sizeof(a[0]));
+
+	/* Unused arguments are ignored by the format string */
+	SYS_LOG_BACKEND_FN(msg->fmt, msg->timestamp, a[0], a[1], a[2], a[3],
+			   a[4], a[5], a[6], a[7], a[8], a[9], a[10], a[11],
+			   a[12], a[13], a[14], a[15], a[16], a[17], a[18],
+			   a[19], a[20], a[21], a[22], a[23], a[24], a[25],
+			   a[26], a[27], a[28], a[29], a[30], a[31]);
+}
+
+/* Output the oldest message, return 0 if there was none */
+static int msg_process(void)
+{
+	struct log_msg *msg;
+
+	if (!sys_byte_ring_peek(&log_ring, (u8_t **)&msg, sizeof(*msg))) {
+		return 0;
+	}
+
+	if (msg->level != SYS_LOG_LEVEL_OFF) {
+		msg_output(msg);
+	}
+
+	sys_byte_ring_consume(&log_ring, msg->len);
+
+	return 1;
+}
+
+static void log_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		u32_t n;
+
+		if (msg_process()) {
+			continue;
+		}
+
+		n = atomic_set(&dropped, 0);
+		if (n) {
+			SYS_LOG_BACKEND_FN("--- %u log messages dropped ---\n",
+					   n);
+		}
+
+		/*
+		 * A message committed from now on wakes the thread up. The
+		 * ones committed earlier are seen below.
+		 */
+		atomic_set(&thread_idle, 1);
+		if (sys_byte_ring_is_empty(&log_ring)) {
+			k_sem_take(&log_sem, K_FOREVER);
+		}
+	}
+}
+
+K_THREAD_DEFINE(sys_log_thread, CONFIG_SYS_LOG_DEFERRED_STACK_SIZE,
+		log_thread, NULL, NULL, NULL,
+		K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
@@ -346,6 +346,55 @@ static inline void cache_remove(struct net_conn *conn)
 #define cache_remove(...)
 #endif /* CONFIG_NET_CONN_CACHE */
 
+#if defined(CONFIG_NET_CONN_HASH)
+
+/* The connections bound to a local port are kept in hash buckets keyed on
+ * the protocol and the ports, the remote port being 0 for the connections
+ * accepting any remote port. The connections accepting any local port are
+ * kept in a separate list. The connection of a received packet is looked up
+ * in the bucket of its ports, then in the bucket of its local port with any
+ * remote port, and last in the list.
+ */
+static sys_slist_t conn_hash[CONFIG_NET_CONN_HASH_SIZE];
+static sys_slist_t conn_any_port;
+
+/* The ports are in network byte order */
+static sys_slist_t *conn_bucket(enum net_ip_protocol proto,
+				u16_t remote_port, u16_t local_port)
+{
+	u32_t key;
+
+	if (!local_port) {
+		return &conn_any_port;
+	}
+
+	/* Multiplicative hashing spreads consecutive ports over the buckets */
+	key = (((u32_t)local_port << 16) | remote_port) ^ proto;
+	key *= 2654435761U;
+
+	return &conn_hash[(key >> 16) % CONFIG_NET_CONN_HASH_SIZE];
+}
+
+static inline sys_slist_t *conn_bucket_of(struct net_conn *conn)
+{
+	return conn_bucket(conn->proto, net_sin(&conn->remote_addr)->sin_port,
+			   net_sin(&conn->local_addr)->sin_port);
+}
+
+static inline void conn_hash_add(struct net_conn *conn)
+{
+	sys_slist_append(conn_bucket_of(conn), &conn->node);
+}
+
+static inline void conn_hash_remove(struct net_conn *conn)
+{
+	sys_slist_find_and_remove(conn_bucket_of(conn), &conn->node);
+}
+#else
+#define conn_hash_add(...)
+#define conn_hash_remove(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
 int net_conn_unregister(struct net_conn_handle *handle)
 {
 	struct net_conn *conn = (struct net_conn *)handle;
@@ -359,6 +408,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	}
 
 	cache_remove(conn);
+	conn_hash_remove(conn);
 
 	NET_DBG("[%zu] connection handler %p removed",
 		(conn - conns) / sizeof(*conn), conn);
@@ -443,112 +493,139 @@ void prepare_register_debug_print(char *dst, int dst_len,
 }
 #endif /* CONFIG_NET_DEBUG_CONN */
 
-/* Check if we already have identical connection handler installed. */
-static int find_conn_handler(enum net_ip_protocol proto,
-			     const struct sockaddr *remote_addr,
-			     const struct sockaddr *local_addr,
-			     u16_t remote_port,
-			     u16_t local_port)
+/* Check if a connection handler has the same addresses and ports */
+static bool is_identical_conn(struct net_conn *conn,
+			      enum net_ip_protocol proto,
+			      const struct sockaddr *remote_addr,
+			      const struct sockaddr *local_addr,
+			      u16_t remote_port,
+			      u16_t local_port)
 {
-	int i;
+	if (!(conn->flags & NET_CONN_IN_USE)) {
+		return false;
+	}
 
-	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
-		if (!(conns[i].flags & NET_CONN_IN_USE)) {
-			continue;
-		}
+	if (conn->proto != proto) {
+		return false;
+	}
 
-		if (conns[i].proto != proto) {
-			continue;
+	if (remote_addr) {
+		if (!(conn->flags & NET_CONN_REMOTE_ADDR_SET)) {
+			return false;
 		}
 
-		if (remote_addr) {
-			if (!(conns[i].flags & NET_CONN_REMOTE_ADDR_SET)) {
-				continue;
-			}
-
 #if defined(CONFIG_NET_IPV6)
-			if (remote_addr->sa_family == AF_INET6 &&
-			    remote_addr->sa_family ==
-			    conns[i].remote_addr.sa_family) {
-				if (!net_ipv6_addr_cmp(
-					    &net_sin6(remote_addr)->sin6_addr,
-					    &net_sin6(&conns[i].remote_addr)->
-								sin6_addr)) {
-					continue;
-				}
-			} else
+		if (remote_addr->sa_family == AF_INET6 &&
+		    remote_addr->sa_family ==
+		    conn->remote_addr.sa_family) {
+			if (!net_ipv6_addr_cmp(
+				    &net_sin6(remote_addr)->sin6_addr,
+				    &net_sin6(&conn->remote_addr)->
+							sin6_addr)) {
+				return false;
+			}
+		} else
 #endif
 #if defined(CONFIG_NET_IPV4)
-			if (remote_addr->sa_family == AF_INET &&
-			    remote_addr->sa_family ==
-			    conns[i].remote_addr.sa_family) {
-				if (!net_ipv4_addr_cmp(
-					    &net_sin(remote_addr)->sin_addr,
-					    &net_sin(&conns[i].remote_addr)->
-								sin_addr)) {
-					continue;
-				}
-			} else
-#endif
-			{
-				continue;
-			}
-		} else {
-			if (conns[i].flags & NET_CONN_REMOTE_ADDR_SET) {
-				continue;
+		if (remote_addr->sa_family == AF_INET &&
+		    remote_addr->sa_family ==
+		    conn->remote_addr.sa_family) {
+			if (!net_ipv4_addr_cmp(
+				    &net_sin(remote_addr)->sin_addr,
+				    &net_sin(&conn->remote_addr)->
+							sin_addr)) {
+				return false;
 			}
+		} else
+#endif
+		{
+			return false;
+		}
+	} else {
+		if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+			return false;
 		}
+	}
 
-		if (local_addr) {
-			if (!(conns[i].flags & NET_CONN_LOCAL_ADDR_SET)) {
-				continue;
-			}
+	if (local_addr) {
+		if (!(conn->flags & NET_CONN_LOCAL_ADDR_SET)) {
+			return false;
+		}
 
 #if defined(CONFIG_NET_IPV6)
-			if (local_addr->sa_family == AF_INET6 &&
-			    local_addr->sa_family ==
-			    conns[i].local_addr.sa_family) {
-				if (!net_ipv6_addr_cmp(
-					    &net_sin6(local_addr)->sin6_addr,
-					    &net_sin6(&conns[i].local_addr)->
-								sin6_addr)) {
-					continue;
-				}
-			} else
+		if (local_addr->sa_family == AF_INET6 &&
+		    local_addr->sa_family ==
+		    conn->local_addr.sa_family) {
+			if (!net_ipv6_addr_cmp(
+				    &net_sin6(local_addr)->sin6_addr,
+				    &net_sin6(&conn->local_addr)->
+							sin6_addr)) {
+				return false;
+			}
+		} else
 #endif
 #if defined(CONFIG_NET_IPV4)
-			if (local_addr->sa_family == AF_INET &&
-			    local_addr->sa_family ==
-			    conns[i].local_addr.sa_family) {
-				if (!net_ipv4_addr_cmp(
-					    &net_sin(local_addr)->sin_addr,
-					    &net_sin(&conns[i].local_addr)->
-								sin_addr)) {
-					continue;
-				}
-			} else
-#endif
-			{
-				continue;
-			}
-		} else {
-			if (conns[i].flags & NET_CONN_LOCAL_ADDR_SET) {
-				continue;
+		if (local_addr->sa_family == AF_INET &&
+		    local_addr->sa_family ==
+		    conn->local_addr.sa_family) {
+			if (!net_ipv4_addr_cmp(
+				    &net_sin(local_addr)->sin_addr,
+				    &net_sin(&conn->local_addr)->
+							sin_addr)) {
+				return false;
 			}
+		} else
+#endif
+		{
+			return false;
 		}
-
-		if (net_sin(&conns[i].remote_addr)->sin_port !=
-		    htons(remote_port)) {
-			continue;
+	} else {
+		if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
+			return false;
 		}
+	}
 
-		if (net_sin(&conns[i].local_addr)->sin_port !=
-		    htons(local_port)) {
-			continue;
+	if (net_sin(&conn->remote_addr)->sin_port !=
+	    htons(remote_port)) {
+		return false;
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port !=
+	    htons(local_port)) {
+		return false;
+	}
+
+	return true;
+}
+
+/* Check if we already have identical connection handler installed. */
+static int find_conn_handler(enum net_ip_protocol proto,
+			     const struct sockaddr *remote_addr,
+			     const struct sockaddr *local_addr,
+			     u16_t remote_port,
+			     u16_t local_port)
+{
+#if defined(CONFIG_NET_CONN_HASH)
+	struct net_conn *conn;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(conn_bucket(proto, htons(remote_port),
+						 htons(local_port)),
+				     conn, node) {
+		if (is_identical_conn(conn, proto, remote_addr, local_addr,
+				      remote_port, local_port)) {
+			return conn - conns;
 		}
+	}
+#else
+	int i;
 
-		return i;
+	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
+		if (is_identical_conn(&conns[i], proto, remote_addr,
+				      local_addr, remote_port, local_port)) {
+			return i;
+		}
 	}
+#endif
 
 	return -ENOENT;
 }
@@ -676,6 +753,8 @@ int net_conn_register(enum net_ip_protocol proto,
 		conns[i].rank = rank;
 		conns[i].proto = proto;
 
+		conn_hash_add(&conns[i]);
+
 		/* Cache needs to be cleared if new entries are added. */
 		cache_clear();
 
@@ -803,10 +882,108 @@ static bool is_invalid_packet(struct net_pkt *pkt,
 	return my_src_addr && (src_port == dst_port);
 }
 
-enum net_verdict net_conn_input(enum net_ip_protocol proto, struct net_pkt *pkt)
+/* Check a connection against a received packet, and make it the best match
+ * if it ranks higher than the current best match.
+ */
+static void check_conn(struct net_conn *conn,
+		       enum net_ip_protocol proto,
+		       struct net_pkt *pkt,
+		       u16_t src_port,
+		       u16_t dst_port,
+		       int *best_match,
+		       s16_t *best_rank)
+{
+	if (!(conn->flags & NET_CONN_IN_USE)) {
+		return;
+	}
+
+	if (conn->proto != proto) {
+		return;
+	}
+
+	if (net_sin(&conn->remote_addr)->sin_port) {
+		if (net_sin(&conn->remote_addr)->sin_port != src_port) {
+			return;
+		}
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port) {
+		if (net_sin(&conn->local_addr)->sin_port != dst_port) {
+			return;
+		}
+	}
+
+	if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+		if (!check_addr(pkt, &conn->remote_addr, true)) {
+			return;
+		}
+	}
+
+	if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
+		if (!check_addr(pkt, &conn->local_addr, false)) {
+			return;
+		}
+	}
+
+	/* If we have an existing best_match, and that one
+	 * specifies a remote port, then we've matched to a
+	 * LISTENING connection that should not override.
+	 */
+	if (*best_match >= 0 &&
+	    net_sin(&conns[*best_match].remote_addr)->sin_port) {
+		return;
+	}
+
+	if (*best_rank < conn->rank) {
+		*best_rank = conn->rank;
+		*best_match = conn - conns;
+	}
+}
+
+/* Return the index of the connection handling a received packet, or -1 */
+static int find_best_match(enum net_ip_protocol proto,
+			   struct net_pkt *pkt,
+			   u16_t src_port,
+			   u16_t dst_port)
 {
-	int i, best_match = -1;
+	int best_match = -1;
 	s16_t best_rank = -1;
+	int i;
+
+#if defined(CONFIG_NET_CONN_HASH)
+	sys_slist_t *lists[] = {
+		conn_bucket(proto, src_port, dst_port),
+		conn_bucket(proto, 0, dst_port),
+		&conn_any_port,
+	};
+	struct net_conn *conn;
+
+	for (i = 0; i < ARRAY_SIZE(lists); i++) {
+		/* The lists are the same for a packet without local port,
+		 * and the buckets may be the same on collisions.
+		 */
+		if (i > 0 && lists[i] == lists[i - 1]) {
+			continue;
+		}
+
+		SYS_SLIST_FOR_EACH_CONTAINER(lists[i], conn, node) {
+			check_conn(conn, proto, pkt, src_port, dst_port,
+				   &best_match, &best_rank);
+		}
+	}
+#else
+	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
+		check_conn(&conns[i], proto, pkt, src_port, dst_port,
+			   &best_match, &best_rank);
+	}
+#endif
+
+	return best_match;
+}
+
+enum net_verdict net_conn_input(enum net_ip_protocol proto, struct net_pkt *pkt)
+{
+	int best_match;
 	u16_t src_port, dst_port;
 	u16_t chksum;
 
@@ -882,55 +1059,7 @@ enum net_verdict net_conn_input(enum net_ip_protocol proto, struct net_pkt *pkt)
 			net_pkt_family(pkt), ntohs(chksum), data_len);
 	}
 
-	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
-		if (!(conns[i].flags & NET_CONN_IN_USE)) {
-			continue;
-		}
-
-		if (conns[i].proto != proto) {
-			continue;
-		}
-
-		if (net_sin(&conns[i].remote_addr)->sin_port) {
-			if (net_sin(&conns[i].remote_addr)->sin_port !=
-			    src_port) {
-				continue;
-			}
-		}
-
-		if (net_sin(&conns[i].local_addr)->sin_port) {
-			if (net_sin(&conns[i].local_addr)->sin_port !=
-			    dst_port) {
-				continue;
-			}
-		}
-
-		if (conns[i].flags & NET_CONN_REMOTE_ADDR_SET) {
-			if (!check_addr(pkt, &conns[i].remote_addr, true)) {
-				continue;
-			}
-		}
-
-		if (conns[i].flags & NET_CONN_LOCAL_ADDR_SET) {
-			if (!check_addr(pkt, &conns[i].local_addr, false)) {
-				continue;
-			}
-		}
-
-		/* If we have an existing best_match, and that one
-		 * specifies a remote port, then we've matched to a
-		 * LISTENING connection that should not override.
-		 */
-		if (best_match >= 0 &&
-		    net_sin(&conns[best_match].remote_addr)->sin_port) {
-			continue;
-		}
-
-		if (best_rank < conns[i].rank) {
-			best_rank = conns[i].rank;
-			best_match = i;
-		}
-	}
+	best_match = find_best_match(proto, pkt, src_port, dst_port);
 
 	if (best_match >= 0) {
 
@@ -16,6 +16,7 @@
 #include <zephyr/types.h>
 
 #include <misc/util.h>
+#include <misc/slist.h>
 
 #include <net/net_core.h>
 #include <net/net_ip.h>
@@ -45,6 +46,11 @@ typedef enum net_verdict (*net_conn_cb_t)(struct net_conn *conn,
  *
  */
 struct net_conn {
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Node in the hash bucket of the connection ports */
+	sys_snode_t node;
+#endif
+
 	/** Remote IP address */
 	struct sockaddr remote_addr;
 
@@ -1292,6 +1292,43 @@ static int get_context_priority(struct net_context *context,
 #endif
 }
 
+static int set_context_tcp_flag(struct net_context *context, u16_t flag,
+				const void *value, size_t len)
+{
+	if (net_context_get_ip_proto(context) != IPPROTO_TCP) {
+		return -EPROTOTYPE;
+	}
+
+	if (len != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	return net_tcp_set_send_flag(context, flag, *((int *)value) != 0);
+}
+
+static int get_context_tcp_flag(struct net_context *context, u16_t flag,
+				void *value, size_t *len)
+{
+	int ret;
+
+	if (net_context_get_ip_proto(context) != IPPROTO_TCP) {
+		return -EPROTOTYPE;
+	}
+
+	ret = net_tcp_get_send_flag(context, flag);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*((int *)value) = ret;
+
+	if (len) {
+		*len = sizeof(int);
+	}
+
+	return 0;
+}
+
 int net_context_set_option(struct net_context *context,
 			   enum net_context_option option,
 			   const void *value, size_t len)
@@ -1308,6 +1345,14 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_PRIORITY:
 		ret = set_context_priority(context, value, len);
 		break;
+	case NET_OPT_TCP_NODELAY:
+		ret = set_context_tcp_flag(context, NET_TCP_NODELAY,
+					   value, len);
+		break;
+	case NET_OPT_TCP_CORK:
+		ret = set_context_tcp_flag(context, NET_TCP_CORK,
+					   value, len);
+		break;
 	}
 
 	return ret;
@@ -1329,6 +1374,14 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_PRIORITY:
 		ret = get_context_priority(context, value, len);
 		break;
+	case NET_OPT_TCP_NODELAY:
+		ret = get_context_tcp_flag(context, NET_TCP_NODELAY,
+					   value, len);
+		break;
+	case NET_OPT_TCP_CORK:
+		ret = get_context_tcp_flag(context, NET_TCP_CORK,
+					   value, len);
+		break;
 	}
 
 	return ret;
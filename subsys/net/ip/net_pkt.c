@@ -1218,6 +1218,34 @@ static inline u16_t net_pkt_append_bytes(struct net_pkt *pkt,
 	return 0;
 }
 
+u16_t net_pkt_append_room(struct net_pkt *pkt)
+{
+	struct net_context *ctx = NULL;
+	u16_t max_len;
+
+	if (pkt->slab != &rx_pkts) {
+		ctx = net_pkt_context(pkt);
+	}
+
+	if (!ctx) {
+		return UINT16_MAX;
+	}
+
+	/* Make sure we don't send more data in one packet than
+	 * protocol or MTU allows when there is a context for the
+	 * packet.
+	 */
+	max_len = pkt->data_len;
+
+#if defined(CONFIG_NET_TCP)
+	if (ctx->tcp && (ctx->tcp->send_mss < max_len)) {
+		max_len = ctx->tcp->send_mss;
+	}
+#endif
+
+	return max_len;
+}
+
 u16_t net_pkt_append(struct net_pkt *pkt, u16_t len, const u8_t *data,
 		    s32_t timeout)
 {
@@ -1242,22 +1270,9 @@ u16_t net_pkt_append(struct net_pkt *pkt, u16_t len, const u8_t *data,
 		ctx = net_pkt_context(pkt);
 	}
 
-	if (ctx) {
-		/* Make sure we don't send more data in one packet than
-		 * protocol or MTU allows when there is a context for the
-		 * packet.
-		 */
-		max_len = pkt->data_len;
-
-#if defined(CONFIG_NET_TCP)
-		if (ctx->tcp && (ctx->tcp->send_mss < max_len)) {
-			max_len = ctx->tcp->send_mss;
-		}
-#endif
-
-		if (len > max_len) {
-			len = max_len;
-		}
+	max_len = net_pkt_append_room(pkt);
+	if (len > max_len) {
+		len = max_len;
 	}
 
 	appended = net_pkt_append_bytes(pkt, data, len, timeout);
@@ -340,10 +340,11 @@ void net_tc_tx_init(void)
 			K_THREAD_STACK_SIZEOF(tx_stack[i]),
 			thread_priority, K_PRIO_COOP(thread_priority));
 
-		k_work_q_start(&tx_classes[i].work_q,
-			       tx_stack[i],
-			       K_THREAD_STACK_SIZEOF(tx_stack[i]),
-			       K_PRIO_COOP(thread_priority));
+		k_work_q_start_batch(&tx_classes[i].work_q,
+				     tx_stack[i],
+				     K_THREAD_STACK_SIZEOF(tx_stack[i]),
+				     K_PRIO_COOP(thread_priority),
+				     CONFIG_NET_TC_BATCH_SIZE);
 	}
 
 	k_yield();
@@ -380,10 +381,11 @@ void net_tc_rx_init(void)
 			K_THREAD_STACK_SIZEOF(rx_stack[i]),
 			thread_priority, K_PRIO_COOP(thread_priority));
 
-		k_work_q_start(&rx_classes[i].work_q,
-			       rx_stack[i],
-			       K_THREAD_STACK_SIZEOF(rx_stack[i]),
-			       K_PRIO_COOP(thread_priority));
+		k_work_q_start_batch(&rx_classes[i].work_q,
+				     rx_stack[i],
+				     K_THREAD_STACK_SIZEOF(rx_stack[i]),
+				     K_PRIO_COOP(thread_priority),
+				     CONFIG_NET_TC_BATCH_SIZE);
 	}
 
 	k_yield();
@@ -51,7 +51,7 @@ static struct tcp_backlog_entry {
 	struct sockaddr remote;
 	u32_t send_seq;
 	u32_t send_ack;
-	u16_t send_mss;
+	struct net_tcp_options opts;
 	struct k_delayed_work ack_timer;
 } tcp_backlog[CONFIG_NET_TCP_BACKLOG_SIZE];
 
@@ -156,10 +156,12 @@ static void net_tcp_trace(struct net_pkt *pkt, struct net_tcp *tcp)
 
 static inline u32_t retry_timeout(const struct net_tcp *tcp)
 {
-	return ((u32_t)1 << tcp->retry_timeout_shift) *
-				CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
+	return ((u32_t)1 << tcp->retry_timeout_shift) * tcp->rto;
 }
 
+/* RFC 6298 chapter 2.5, upper bound of the retransmission timeout */
+#define MAX_RTO K_SECONDS(60)
+
 #define is_6lo_technology(pkt)						    \
 	(IS_ENABLED(CONFIG_NET_IPV6) &&	net_pkt_family(pkt) == AF_INET6 &&  \
 	 ((IS_ENABLED(CONFIG_NET_L2_BT) &&			    \
@@ -186,6 +188,121 @@ static inline u32_t retry_timeout(const struct net_tcp *tcp)
 		}							\
 	} while (0)
 
+static u32_t tcp_pkt_seq(struct net_pkt *pkt)
+{
+	struct net_tcp_hdr hdr, *tcp_hdr;
+
+	tcp_hdr = net_tcp_get_hdr(pkt, &hdr);
+	if (!tcp_hdr) {
+		return 0;
+	}
+
+	return sys_get_be32(tcp_hdr->seq);
+}
+
+/* Sequence number following a segment of the sent list, its FIN included */
+static u32_t tcp_pkt_end(struct net_pkt *pkt)
+{
+	struct net_tcp_hdr hdr, *tcp_hdr;
+
+	tcp_hdr = net_tcp_get_hdr(pkt, &hdr);
+	if (!tcp_hdr) {
+		return 0;
+	}
+
+	return sys_get_be32(tcp_hdr->seq) + net_pkt_appdatalen(pkt) +
+		(NET_TCP_FLAGS(tcp_hdr) & NET_TCP_FIN ? 1 : 0);
+}
+
+/* Was a segment of the sent list sent already */
+static bool tcp_pkt_sent(struct net_tcp *tcp, struct net_pkt *pkt)
+{
+	return net_tcp_seq_greater(tcp->send_next, tcp_pkt_seq(pkt));
+}
+
+/* Is the data of a segment of the sent list SACKed by the peer */
+static bool tcp_pkt_sacked(struct net_tcp *tcp, struct net_pkt *pkt)
+{
+	u32_t seq, end;
+	int i;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK) ||
+	    !(tcp->flags & NET_TCP_SACK_OK)) {
+		return false;
+	}
+
+	seq = tcp_pkt_seq(pkt);
+	end = tcp_pkt_end(pkt);
+
+	for (i = 0; i < NET_TCP_MAX_SACK_BLOCKS; i++) {
+		if (tcp->sacked[i].start == tcp->sacked[i].end) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(seq, tcp->sacked[i].start) >= 0 &&
+		    net_tcp_seq_cmp(end, tcp->sacked[i].end) <= 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Number of bytes sent and neither acked nor SACKed */
+static u32_t tcp_flight_size(struct net_tcp *tcp)
+{
+	struct net_pkt *pkt;
+	u32_t flight = 0;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		if (!tcp_pkt_sent(tcp, pkt)) {
+			break;
+		}
+
+		if (!tcp_pkt_sacked(tcp, pkt)) {
+			flight += net_pkt_appdatalen(pkt);
+		}
+	}
+
+	return flight;
+}
+
+/* Send, or send again, a segment of the sent list */
+static int tcp_send_segment(struct net_tcp *tcp, struct net_pkt *pkt,
+			    bool rexmit)
+{
+	u32_t end;
+	int ret;
+
+	/* Still waiting to be sent by the interface */
+	if (net_pkt_queued(pkt)) {
+		return 0;
+	}
+
+	if (net_pkt_sent(pkt)) {
+		do_ref_if_needed(tcp, pkt);
+		net_pkt_set_sent(pkt, false);
+	}
+
+	net_pkt_set_queued(pkt, true);
+
+	end = tcp_pkt_end(pkt);
+	if (net_tcp_seq_greater(end, tcp->send_max)) {
+		tcp->send_max = end;
+	}
+
+	ret = net_tcp_send_pkt(pkt);
+	if (ret < 0 && !is_6lo_technology(pkt)) {
+		NET_DBG("[%p] pkt %p not sent (%d)", tcp, pkt, ret);
+		net_pkt_unref(pkt);
+	} else if (rexmit && IS_ENABLED(CONFIG_NET_STATISTICS_TCP) &&
+		   !is_6lo_technology(pkt)) {
+		net_stats_update_tcp_seg_rexmit(net_pkt_iface(pkt));
+	}
+
+	return ret;
+}
+
 static void abort_connection(struct net_tcp *tcp)
 {
 	struct net_context *ctx = tcp->context;
@@ -206,7 +323,8 @@ static void tcp_retry_expired(struct k_work *work)
 	struct net_pkt *pkt;
 
 	/* Double the retry period for exponential backoff and resent
-	 * the first (only the first!) unack'd packet.
+	 * the first unack'd packet. The other packets sent are considered
+	 * lost too, they are resent as the congestion window opens again.
 	 */
 	if (!sys_slist_is_empty(&tcp->sent_list)) {
 		tcp->retry_timeout_shift++;
@@ -218,28 +336,19 @@ static void tcp_retry_expired(struct k_work *work)
 
 		k_delayed_work_submit(&tcp->retry_timer, retry_timeout(tcp));
 
+		net_tcp_cc_timeout(tcp, tcp_flight_size(tcp));
+
 		pkt = CONTAINER_OF(sys_slist_peek_head(&tcp->sent_list),
 				   struct net_pkt, sent_list);
 
-		if (net_pkt_sent(pkt)) {
-			do_ref_if_needed(tcp, pkt);
-			net_pkt_set_sent(pkt, false);
-		}
-
-		net_pkt_set_queued(pkt, true);
+		tcp->send_next = tcp_pkt_end(pkt);
 
-		if (net_tcp_send_pkt(pkt) < 0 && !is_6lo_technology(pkt)) {
+		if (tcp_send_segment(tcp, pkt, true) < 0) {
 			NET_DBG("retry %u: [%p] pkt %p send failed",
 				tcp->retry_timeout_shift, tcp, pkt);
-			net_pkt_unref(pkt);
 		} else {
 			NET_DBG("retry %u: [%p] sent pkt %p",
 				tcp->retry_timeout_shift, tcp, pkt);
-			if (IS_ENABLED(CONFIG_NET_STATISTICS_TCP) &&
-			    !is_6lo_technology(pkt)) {
-				net_stats_update_tcp_seg_rexmit(
-							net_pkt_iface(pkt));
-			}
 		}
 	} else if (CONFIG_NET_TCP_TIME_WAIT_DELAY != 0) {
 		if (tcp->fin_sent && tcp->fin_rcvd) {
@@ -250,6 +359,18 @@ static void tcp_retry_expired(struct k_work *work)
 	}
 }
 
+/* Smallest window scale shift making our window fit in 16 bits */
+static u8_t recv_wscale(void)
+{
+	u8_t shift = 0;
+
+	while ((NET_TCP_BUF_MAX_LEN >> shift) > UINT16_MAX) {
+		shift++;
+	}
+
+	return shift;
+}
+
 struct net_tcp *net_tcp_alloc(struct net_context *context)
 {
 	int i, key;
@@ -275,12 +396,18 @@ struct net_tcp *net_tcp_alloc(struct net_context *context)
 
 	tcp_context[i].send_seq = tcp_init_isn();
 	tcp_context[i].recv_wnd = min(NET_TCP_MAX_WIN, NET_TCP_BUF_MAX_LEN);
+	tcp_context[i].recv_wscale = recv_wscale();
 	tcp_context[i].send_mss = NET_TCP_DEFAULT_MSS;
+	tcp_context[i].send_wnd = UINT16_MAX;
+	tcp_context[i].rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
+
+	net_tcp_cc_init(&tcp_context[i]);
 
 	tcp_context[i].accept_cb = NULL;
 
 	k_delayed_work_init(&tcp_context[i].retry_timer, tcp_retry_expired);
 	k_sem_init(&tcp_context[i].connect_wait, 0, UINT_MAX);
+	k_sem_init(&tcp_context[i].queue_lock, 1, 1);
 
 	return &tcp_context[i];
 }
@@ -321,10 +448,24 @@ int net_tcp_release(struct net_tcp *tcp)
 		net_pkt_unref(pkt);
 	}
 
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tcp->ooo_list, pkt, tmp,
+					  sent_list) {
+		sys_slist_remove(&tcp->ooo_list, NULL, &pkt->sent_list);
+		net_pkt_unref(pkt);
+	}
+
+	tcp->ooo_count = 0;
+
+	if (tcp->pending_pkt) {
+		net_pkt_unref(tcp->pending_pkt);
+		tcp->pending_pkt = NULL;
+	}
+
 	retry_timer_cancel(tcp);
 	k_sem_reset(&tcp->connect_wait);
 
 	ack_timer_cancel(tcp);
+	k_delayed_work_cancel(&tcp->delayed_ack_timer);
 	fin_timer_cancel(tcp);
 	timewait_timer_cancel(tcp);
 
@@ -500,12 +641,43 @@ u32_t net_tcp_get_recv_wnd(const struct net_tcp *tcp)
 	return tcp->recv_wnd;
 }
 
+/* Window field of a segment, the window of a SYN is never scaled */
+static u16_t tcp_adv_wnd(const struct net_tcp *tcp, u8_t flags)
+{
+	u32_t wnd = net_tcp_get_recv_wnd(tcp);
+
+	if (!(flags & NET_TCP_SYN) && (tcp->flags & NET_TCP_WSCALE)) {
+		wnd >>= tcp->recv_wscale;
+	}
+
+	return min(wnd, UINT16_MAX);
+}
+
+/* Timestamps option, aligned on 32 bits */
+static u8_t tcp_put_ts_opt(u8_t *options, u32_t tsecr)
+{
+	options[0] = NET_TCP_NOP_OPT;
+	options[1] = NET_TCP_NOP_OPT;
+	options[2] = NET_TCP_TIMESTAMP_OPT;
+	options[3] = NET_TCP_TIMESTAMP_SIZE;
+	sys_put_be32(k_uptime_get_32(), options + 4);
+	sys_put_be32(tsecr, options + 8);
+
+	return 2 * NET_TCP_NOP_SIZE + NET_TCP_TIMESTAMP_SIZE;
+}
+
+static u8_t tcp_ts_opt(struct net_tcp *tcp, u8_t *options)
+{
+	return tcp_put_ts_opt(options, tcp->ts_recent);
+}
+
 int net_tcp_prepare_segment(struct net_tcp *tcp, u8_t flags,
 			    void *options, size_t optlen,
 			    const struct sockaddr_ptr *local,
 			    const struct sockaddr *remote,
 			    struct net_pkt **send_pkt)
 {
+	u8_t ts_options[2 * NET_TCP_NOP_SIZE + NET_TCP_TIMESTAMP_SIZE];
 	u32_t seq;
 	u16_t wnd;
 	struct tcp_segment segment = { 0 };
@@ -554,7 +726,15 @@ int net_tcp_prepare_segment(struct net_tcp *tcp, u8_t flags,
 		}
 	}
 
-	wnd = net_tcp_get_recv_wnd(tcp);
+	wnd = tcp_adv_wnd(tcp, flags);
+	tcp->adv_wnd = net_tcp_get_recv_wnd(tcp);
+
+	/* Once negotiated, timestamps are sent in every segment */
+	if (!options && (tcp->flags & NET_TCP_TS_OK) &&
+	    !(flags & NET_TCP_SYN)) {
+		optlen = tcp_ts_opt(tcp, ts_options);
+		options = ts_options;
+	}
 
 	segment.src_addr = (struct sockaddr_ptr *)local;
 	segment.dst_addr = remote;
@@ -647,31 +827,139 @@ u16_t net_tcp_get_recv_mss(const struct net_tcp *tcp)
 	return 0;
 }
 
-static void net_tcp_set_syn_opt(struct net_tcp *tcp, u8_t *options,
-				u8_t *optionlen)
+/* The options are offered in a SYN, a SYN-ACK only carries the ones
+ * offered by the peer: the ones of the SYN answered when given in peer,
+ * else the ones already negotiated by the connection.
+ */
+static void net_tcp_set_syn_opt(struct net_tcp *tcp,
+				const struct net_tcp_options *peer,
+				u8_t *options, u8_t *optionlen)
 {
+	bool offer = !peer && net_tcp_get_state(tcp) == NET_TCP_SYN_SENT;
+	u16_t flags = peer ? peer->flags : tcp->flags;
+	u32_t tsecr = peer ? peer->tsval : tcp->ts_recent;
 	u32_t recv_mss;
 
 	*optionlen = 0;
 
-	if (!(tcp->flags & NET_TCP_RECV_MSS_SET)) {
-		recv_mss = net_tcp_get_recv_mss(tcp);
-		tcp->flags |= NET_TCP_RECV_MSS_SET;
-	} else {
-		recv_mss = 0;
-	}
+	/* The SYN is sent with its options again when retransmitted */
+	recv_mss = net_tcp_get_recv_mss(tcp);
+	tcp->flags |= NET_TCP_RECV_MSS_SET;
 
 	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
 	UNALIGNED_PUT(htonl(recv_mss),
 		      (u32_t *)(options + *optionlen));
 
 	*optionlen += NET_TCP_MSS_SIZE;
+
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+	    (offer || (flags & NET_TCP_WSCALE))) {
+		options[(*optionlen)++] = NET_TCP_NOP_OPT;
+		options[(*optionlen)++] = NET_TCP_WINDOW_SCALE_OPT;
+		options[(*optionlen)++] = NET_TCP_WINDOW_SCALE_SIZE;
+		options[(*optionlen)++] = tcp->recv_wscale;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+	    (offer || (flags & NET_TCP_SACK_OK))) {
+		options[(*optionlen)++] = NET_TCP_NOP_OPT;
+		options[(*optionlen)++] = NET_TCP_NOP_OPT;
+		options[(*optionlen)++] = NET_TCP_SACK_PERM_OPT;
+		options[(*optionlen)++] = NET_TCP_SACK_PERM_SIZE;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) &&
+	    (offer || (flags & NET_TCP_TS_OK))) {
+		*optionlen += tcp_put_ts_opt(options + *optionlen, tsecr);
+	}
+}
+
+/* SACK option reporting the segments received out of order, the block
+ * of the last segment received coming first as per RFC 2018 chapter 4.
+ */
+static u8_t tcp_sack_opt(struct net_tcp *tcp, u8_t *options, int max_blocks)
+{
+	struct net_tcp_sack_block blocks[NET_TCP_MAX_SACK_BLOCKS];
+	struct net_tcp_sack_block last;
+	struct net_pkt *pkt;
+	int count = 0;
+	int i;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->ooo_list, pkt, sent_list) {
+		u32_t seq = tcp_pkt_seq(pkt);
+		u32_t end = seq + net_pkt_appdatalen(pkt);
+
+		if (count &&
+		    net_tcp_seq_cmp(seq, blocks[count - 1].end) <= 0) {
+			if (net_tcp_seq_greater(end, blocks[count - 1].end)) {
+				blocks[count - 1].end = end;
+			}
+
+			continue;
+		}
+
+		if (count == NET_TCP_MAX_SACK_BLOCKS) {
+			break;
+		}
+
+		blocks[count].start = seq;
+		blocks[count].end = end;
+		count++;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (net_tcp_seq_cmp(tcp->ooo_last, blocks[i].start) >= 0 &&
+		    net_tcp_seq_cmp(tcp->ooo_last, blocks[i].end) < 0) {
+			last = blocks[i];
+			memmove(&blocks[1], &blocks[0], i * sizeof(blocks[0]));
+			blocks[0] = last;
+			break;
+		}
+	}
+
+	count = min(count, max_blocks);
+	if (!count) {
+		return 0;
+	}
+
+	options[0] = NET_TCP_NOP_OPT;
+	options[1] = NET_TCP_NOP_OPT;
+	options[2] = NET_TCP_SACK_OPT;
+	options[3] = 2 + count * NET_TCP_SACK_BLOCK_SIZE;
+
+	for (i = 0; i < count; i++) {
+		sys_put_be32(blocks[i].start,
+			     options + 4 + i * NET_TCP_SACK_BLOCK_SIZE);
+		sys_put_be32(blocks[i].end,
+			     options + 8 + i * NET_TCP_SACK_BLOCK_SIZE);
+	}
+
+	return 4 + count * NET_TCP_SACK_BLOCK_SIZE;
+}
+
+/* Options of an ACK: timestamps and SACK blocks */
+static u8_t tcp_ack_opts(struct net_tcp *tcp, u8_t *options)
+{
+	u8_t len = 0;
+
+	if (tcp->flags & NET_TCP_TS_OK) {
+		len = tcp_ts_opt(tcp, options);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+	    (tcp->flags & NET_TCP_SACK_OK) && tcp->ooo_count) {
+		len += tcp_sack_opt(tcp, options + len,
+				    (NET_TCP_MAX_HDR_OPT_SIZE - len - 4) /
+				    NET_TCP_SACK_BLOCK_SIZE);
+	}
+
+	return len;
 }
 
 int net_tcp_prepare_ack(struct net_tcp *tcp, const struct sockaddr *remote,
 			struct net_pkt **pkt)
 {
-	u8_t options[NET_TCP_MAX_OPT_SIZE];
+	u8_t options[NET_TCP_MAX_HDR_OPT_SIZE];
 	u8_t optionlen;
 
 	switch (net_tcp_get_state(tcp)) {
@@ -679,7 +967,7 @@ int net_tcp_prepare_ack(struct net_tcp *tcp, const struct sockaddr *remote,
 		/* In the SYN_RCVD state acknowledgment must be with the
 		 * SYN flag.
 		 */
-		net_tcp_set_syn_opt(tcp, options, &optionlen);
+		net_tcp_set_syn_opt(tcp, NULL, options, &optionlen);
 
 		return net_tcp_prepare_segment(tcp, NET_TCP_SYN | NET_TCP_ACK,
 					       options, optionlen, NULL, remote,
@@ -692,8 +980,11 @@ int net_tcp_prepare_ack(struct net_tcp *tcp, const struct sockaddr *remote,
 		return net_tcp_prepare_segment(tcp, NET_TCP_FIN | NET_TCP_ACK,
 					       0, 0, NULL, remote, pkt);
 	default:
-		return net_tcp_prepare_segment(tcp, NET_TCP_ACK, 0, 0, NULL,
-					       remote, pkt);
+		optionlen = tcp_ack_opts(tcp, options);
+
+		return net_tcp_prepare_segment(tcp, NET_TCP_ACK,
+					       optionlen ? options : NULL,
+					       optionlen, NULL, remote, pkt);
 	}
 
 	return -EINVAL;
@@ -792,24 +1083,56 @@ const char *net_tcp_state_str(enum net_tcp_state state)
 	return "";
 }
 
-int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
+/* Largest amount of data the segments sent carry */
+static u16_t tcp_send_mss(struct net_tcp *tcp)
 {
-	struct net_conn *conn = (struct net_conn *)context->conn_handler;
-	size_t data_len = net_pkt_get_len(pkt);
-	int ret;
+	u16_t mss = net_tcp_get_recv_mss(tcp);
 
-	NET_DBG("[%p] Queue %p len %zd", context->tcp, pkt, data_len);
+	mss = mss ? min(tcp->send_mss, mss) : tcp->send_mss;
 
-	if (net_context_get_state(context) != NET_CONTEXT_CONNECTED) {
-		return -ENOTCONN;
+	if (tcp->flags & NET_TCP_TS_OK) {
+		mss -= 2 * NET_TCP_NOP_SIZE + NET_TCP_TIMESTAMP_SIZE;
 	}
 
-	NET_ASSERT(context->tcp);
-	if (context->tcp->flags & NET_TCP_IS_SHUTDOWN) {
-		return -ESHUTDOWN;
+	return mss;
+}
+
+/* Largest amount of data a segment sent from pkt carries, the room
+ * net_pkt_append() leaves for the MTU may be less than the MSS.
+ */
+static u16_t tcp_pkt_mss(struct net_tcp *tcp, struct net_pkt *pkt)
+{
+	return min(tcp_send_mss(tcp), net_pkt_get_len(pkt) + pkt->data_len);
+}
+
+/* Whether the data written must wait for more data to fill a segment */
+static bool tcp_nagle_hold(struct net_tcp *tcp, struct net_pkt *pkt)
+{
+	if (net_pkt_get_len(pkt) >= tcp_pkt_mss(tcp, pkt)) {
+		return false;
+	}
+
+	if (tcp->flags & NET_TCP_CORK) {
+		return true;
+	}
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_NAGLE) ||
+	    (tcp->flags & NET_TCP_NODELAY)) {
+		return false;
 	}
 
-	net_pkt_set_appdatalen(pkt, net_pkt_get_len(pkt));
+	/* RFC 896: a small segment is only sent with no data unacked */
+	return !sys_slist_is_empty(&tcp->sent_list);
+}
+
+static int tcp_queue_segment(struct net_context *context,
+			     struct net_pkt *pkt)
+{
+	struct net_conn *conn = (struct net_conn *)context->conn_handler;
+	size_t data_len = net_pkt_get_len(pkt);
+	int ret;
+
+	net_pkt_set_appdatalen(pkt, data_len);
 
 	/* Set PSH on all packets, our window is so small that there's
 	 * no point in the remote side trying to finesse things and
@@ -838,6 +1161,191 @@ int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 	return 0;
 }
 
+/* Put the data waiting in a segment, unless it must wait for more data */
+static int tcp_queue_pending(struct net_context *context, bool force)
+{
+	struct net_tcp *tcp = context->tcp;
+	struct net_pkt *pkt;
+	int ret = 0;
+
+	k_sem_take(&tcp->queue_lock, K_FOREVER);
+
+	pkt = tcp->pending_pkt;
+	if (!pkt || (!force && tcp_nagle_hold(tcp, pkt))) {
+		goto out;
+	}
+
+	tcp->pending_pkt = NULL;
+
+	ret = tcp_queue_segment(context, pkt);
+	if (ret < 0) {
+		net_pkt_unref(pkt);
+	}
+
+out:
+	k_sem_give(&tcp->queue_lock);
+
+	return ret;
+}
+
+/* Move up to len bytes from the start of the data of src to the end of
+ * the data of dst, returns the number of bytes moved. The room left to
+ * append to src grows by as much.
+ */
+static u16_t tcp_pkt_move(struct net_pkt *dst, struct net_pkt *src,
+			  u16_t len)
+{
+	struct net_buf *frag;
+	u16_t moved = 0;
+	u16_t count, appended;
+
+	while (moved < len && src->frags) {
+		frag = src->frags;
+		count = min(len - moved, frag->len);
+
+		appended = net_pkt_append(dst, count, frag->data,
+					  ALLOC_TIMEOUT);
+		net_buf_pull(frag, appended);
+		moved += appended;
+
+		if (!frag->len) {
+			net_pkt_frag_del(src, NULL, frag);
+		}
+
+		if (appended < count) {
+			break;
+		}
+	}
+
+	src->data_len += moved;
+
+	return moved;
+}
+
+int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
+{
+	struct net_tcp *tcp = context->tcp;
+	struct net_pkt *pending;
+	struct net_buf *last;
+	size_t data_len = net_pkt_get_len(pkt);
+	size_t pending_len;
+	u16_t mss;
+	int ret;
+
+	NET_DBG("[%p] Queue %p len %zd", tcp, pkt, data_len);
+
+	if (net_context_get_state(context) != NET_CONTEXT_CONNECTED) {
+		return -ENOTCONN;
+	}
+
+	NET_ASSERT(tcp);
+	if (tcp->flags & NET_TCP_IS_SHUTDOWN) {
+		return -ESHUTDOWN;
+	}
+
+	/* The data waiting, sent concurrently on ACK reception, must be
+	 * given its sequence numbers before the new data.
+	 */
+	k_sem_take(&tcp->queue_lock, K_FOREVER);
+
+	pending = tcp->pending_pkt;
+	tcp->pending_pkt = NULL;
+
+	if (pending) {
+		pending_len = net_pkt_get_len(pending);
+		mss = tcp_pkt_mss(tcp, pending);
+
+		if (pending_len + data_len <= mss) {
+			/* The data waiting is put in front of the new data,
+			 * the caller keeps using the pkt it passed.
+			 */
+			last = net_buf_frag_last(pending->frags);
+			last->frags = pkt->frags;
+			pkt->frags = pending->frags;
+			pending->frags = NULL;
+			pkt->data_len -= min(pkt->data_len, pending_len);
+
+			net_pkt_unref(pending);
+			net_pkt_compact(pkt);
+		} else {
+			/* The data waiting is completed to a full segment,
+			 * the rest of the new data may wait in turn.
+			 */
+			if (pending_len < mss) {
+				tcp_pkt_move(pending, pkt, mss - pending_len);
+			}
+
+			ret = tcp_queue_segment(context, pending);
+			if (ret < 0) {
+				net_pkt_unref(pending);
+				goto out;
+			}
+		}
+
+		data_len = net_pkt_get_len(pkt);
+	}
+
+	if (tcp_nagle_hold(tcp, pkt)) {
+		NET_DBG("[%p] Holding %zd bytes", tcp, data_len);
+
+		/* The pkt is owned by the stack as if it was queued */
+		tcp->pending_pkt = pkt;
+		ret = 0;
+		goto out;
+	}
+
+	ret = tcp_queue_segment(context, pkt);
+
+out:
+	k_sem_give(&tcp->queue_lock);
+
+	return ret;
+}
+
+int net_tcp_set_send_flag(struct net_context *context, u16_t flag, bool set)
+{
+	int key;
+
+	if (flag != NET_TCP_NODELAY && flag != NET_TCP_CORK) {
+		return -EINVAL;
+	}
+
+	if (!context->tcp) {
+		return -EPROTOTYPE;
+	}
+
+	key = irq_lock();
+
+	if (set) {
+		context->tcp->flags |= flag;
+	} else {
+		context->tcp->flags &= ~flag;
+	}
+
+	irq_unlock(key);
+
+	/* The data held may be sent now */
+	if (net_context_get_state(context) == NET_CONTEXT_CONNECTED &&
+	    context->tcp->pending_pkt) {
+		net_tcp_send_data(context, NULL, NULL, NULL);
+	}
+
+	return 0;
+}
+
+int net_tcp_get_send_flag(struct net_context *context, u16_t flag)
+{
+	if (flag != NET_TCP_NODELAY && flag != NET_TCP_CORK) {
+		return -EINVAL;
+	}
+
+	if (!context->tcp) {
+		return -EPROTOTYPE;
+	}
+
+	return !!(context->tcp->flags & flag);
+}
+
 int net_tcp_send_pkt(struct net_pkt *pkt)
 {
 	struct net_context *ctx = net_pkt_context(pkt);
@@ -876,6 +1384,12 @@ int net_tcp_send_pkt(struct net_pkt *pkt)
 
 	ctx->tcp->sent_ack = ctx->tcp->send_ack;
 
+	/* The segment acks the data received, no ACK is due any longer */
+	if (ctx->tcp->unacked_segs) {
+		ctx->tcp->unacked_segs = 0;
+		k_delayed_work_cancel(&ctx->tcp->delayed_ack_timer);
+	}
+
 	/* As we modified the header, we need to write it back.
 	 */
 	net_tcp_set_hdr(pkt, tcp_hdr);
@@ -953,50 +1467,190 @@ static void restart_timer(struct net_tcp *tcp)
 	}
 }
 
+static void queue_fin(struct net_context *ctx);
+
 int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
 		      void *token, void *user_data)
 {
+	struct net_tcp *tcp = context->tcp;
 	struct net_pkt *pkt;
+	u32_t flight, wnd, seq, len;
+	int key;
+
+	tcp_queue_pending(context, false);
 
-	/* For now, just send all queued data synchronously.  Need to
-	 * add window handling and retry/ACK logic.
+	/* Send the queued data, as much as the window advertised by the
+	 * peer and the congestion window allow. The rest is sent when
+	 * ACKs are received.
 	 */
-	SYS_SLIST_FOR_EACH_CONTAINER(&context->tcp->sent_list, pkt, sent_list) {
-		/* Do not resend packets that were sent by expire timer */
-		if (net_pkt_queued(pkt)) {
-			NET_DBG("[%p] Skipping pkt %p because it was already "
-				"sent.", context->tcp, pkt);
+	flight = tcp_flight_size(tcp);
+	wnd = min(tcp->cwnd, tcp->send_wnd);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		seq = tcp_pkt_seq(pkt);
+		len = net_pkt_appdatalen(pkt);
+
+		/* Do not resend packets already sent */
+		if (net_tcp_seq_greater(tcp->send_next, seq)) {
+			continue;
+		}
+
+		/* Nor the ones the peer already received */
+		if (tcp_pkt_sacked(tcp, pkt)) {
+			tcp->send_next = tcp_pkt_end(pkt);
+			continue;
+		}
+
+		if (flight + len > wnd && (flight || !tcp->send_wnd)) {
+			NET_DBG("[%p] Window full, flight %u cwnd %u wnd %u",
+				tcp, flight, tcp->cwnd, tcp->send_wnd);
+			break;
+		}
+
+		/* The pkt may be sent concurrently on ACK reception */
+		key = irq_lock();
+		if (net_tcp_seq_greater(tcp->send_next, seq)) {
+			irq_unlock(key);
+			continue;
+		}
+
+		tcp->send_next = tcp_pkt_end(pkt);
+		irq_unlock(key);
+
+		NET_DBG("[%p] Sending pkt %p (%zd bytes)", tcp, pkt,
+			net_pkt_get_len(pkt));
+
+		tcp_send_segment(tcp, pkt, false);
+		flight += len;
+	}
+
+	if ((tcp->flags & NET_TCP_FIN_QUEUED) && !pkt) {
+		tcp->flags &= ~NET_TCP_FIN_QUEUED;
+		queue_fin(context);
+	}
+
+	/* Just make the callback synchronously even if it didn't
+	 * go over the wire.  In theory it would be nice to track
+	 * specific ACK locations in the stream and make the
+	 * callback at that time, but there's nowhere to store the
+	 * potentially-separate token/user_data values right now.
+	 */
+	if (cb) {
+		cb(context, 0, token, user_data);
+	}
+
+	return 0;
+}
+
+/* Merge the SACK blocks received in the ones known, forgetting the
+ * blocks acked.
+ */
+static void tcp_sack_update(struct net_tcp *tcp,
+			    const struct net_tcp_options *opts, u32_t ack)
+{
+	struct net_tcp_sack_block *known;
+	const struct net_tcp_sack_block *block;
+	int i, j, empty;
+
+	for (i = 0; i < NET_TCP_MAX_SACK_BLOCKS; i++) {
+		known = &tcp->sacked[i];
+
+		if (!net_tcp_seq_greater(known->end, ack)) {
+			known->start = known->end = 0;
+		}
+	}
+
+	for (i = 0; i < opts->sack_count; i++) {
+		block = &opts->sack[i];
+
+		/* Skip invalid blocks and the ones reporting duplicates */
+		if (!net_tcp_seq_greater(block->end, block->start) ||
+		    !net_tcp_seq_greater(block->end, ack)) {
+			continue;
+		}
+
+		empty = -1;
+
+		for (j = 0; j < NET_TCP_MAX_SACK_BLOCKS; j++) {
+			known = &tcp->sacked[j];
+
+			if (known->start == known->end) {
+				if (empty < 0) {
+					empty = j;
+				}
+
+				continue;
+			}
+
+			if (net_tcp_seq_cmp(block->start, known->end) <= 0 &&
+			    net_tcp_seq_cmp(block->end, known->start) >= 0) {
+				if (net_tcp_seq_greater(known->start,
+							block->start)) {
+					known->start = block->start;
+				}
+
+				if (net_tcp_seq_greater(block->end,
+							known->end)) {
+					known->end = block->end;
+				}
+
+				break;
+			}
+		}
+
+		if (j == NET_TCP_MAX_SACK_BLOCKS && empty >= 0) {
+			tcp->sacked[empty] = *block;
+		}
+	}
+}
+
+/* Is data above a sequence number SACKed by the peer */
+static bool tcp_sacked_above(struct net_tcp *tcp, u32_t seq)
+{
+	int i;
+
+	for (i = 0; i < NET_TCP_MAX_SACK_BLOCKS; i++) {
+		if (tcp->sacked[i].start != tcp->sacked[i].end &&
+		    net_tcp_seq_greater(tcp->sacked[i].start, seq)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Retransmit the first segment sent, neither acked nor SACKed, which
+ * was not retransmitted yet during the recovery. On duplicate ACKs, the
+ * segment must be followed by SACKed data to be considered lost.
+ */
+static void tcp_rexmit_hole(struct net_tcp *tcp, bool partial_ack)
+{
+	struct net_pkt *pkt;
+	u32_t seq;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		if (!tcp_pkt_sent(tcp, pkt)) {
+			break;
+		}
+
+		seq = tcp_pkt_seq(pkt);
+
+		if (tcp_pkt_sacked(tcp, pkt) ||
+		    net_tcp_seq_cmp(seq, tcp->rexmit_max) < 0) {
 			continue;
 		}
 
-		if (!net_pkt_sent(pkt)) {
-			int ret;
-
-			NET_DBG("[%p] Sending pkt %p (%zd bytes)", context->tcp,
-				pkt, net_pkt_get_len(pkt));
+		if (!partial_ack && !tcp_sacked_above(tcp, seq)) {
+			break;
+		}
 
-			ret = net_tcp_send_pkt(pkt);
-			if (ret < 0 && !is_6lo_technology(pkt)) {
-				NET_DBG("[%p] pkt %p not sent (%d)",
-					context->tcp, pkt, ret);
-				net_pkt_unref(pkt);
-			}
+		NET_DBG("[%p] retransmit hole at %u", tcp, seq);
 
-			net_pkt_set_queued(pkt, true);
-		}
-	}
+		tcp->rexmit_max = tcp_pkt_end(pkt);
+		tcp_send_segment(tcp, pkt, true);
 
-	/* Just make the callback synchronously even if it didn't
-	 * go over the wire.  In theory it would be nice to track
-	 * specific ACK locations in the stream and make the
-	 * callback at that time, but there's nowhere to store the
-	 * potentially-separate token/user_data values right now.
-	 */
-	if (cb) {
-		cb(context, 0, token, user_data);
+		return;
 	}
-
-	return 0;
 }
 
 bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
@@ -1006,6 +1660,7 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 	sys_snode_t *head;
 	struct net_pkt *pkt;
 	u32_t seq;
+	u32_t acked = 0;
 	bool valid_ack = false;
 
 	if (net_tcp_seq_greater(ack, ctx->tcp->send_seq)) {
@@ -1036,6 +1691,9 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 		}
 
 		seq = sys_get_be32(tcp_hdr->seq) + net_pkt_appdatalen(pkt) - 1;
+		if (NET_TCP_FLAGS(tcp_hdr) & NET_TCP_FIN) {
+			seq++;
+		}
 
 		if (!net_tcp_seq_greater(ack, seq)) {
 			break;
@@ -1051,11 +1709,25 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 			}
 		}
 
+		acked += net_pkt_appdatalen(pkt);
+
 		sys_slist_remove(list, NULL, head);
 		net_pkt_unref(pkt);
 		valid_ack = true;
 	}
 
+	/* The data acked after a timeout is not sent again */
+	if (net_tcp_seq_greater(ack, tcp->send_next)) {
+		tcp->send_next = ack;
+	}
+
+	if (valid_ack && net_tcp_cc_ack(tcp, ack, acked)) {
+		/* Partial acknowledgment during a recovery, the next
+		 * segment is lost too.
+		 */
+		tcp_rexmit_hole(tcp, true);
+	}
+
 	/* Restart the timer on a valid inbound ACK.  This isn't quite the
 	 * same behavior as per-packet retry timers, but is close in practice
 	 * (it starts retries one timer period after the connection
@@ -1346,6 +2018,7 @@ int net_tcp_parse_opts(struct net_pkt *pkt, int opt_totlen,
 		  + net_pkt_ipv6_ext_len(pkt)
 		  + sizeof(struct net_tcp_hdr);
 	u8_t opt, optlen;
+	int i;
 
 	/* TODO: this should be done for each TCP pkt, on reception */
 	if (pos + opt_totlen > net_pkt_get_len(pkt)) {
@@ -1397,6 +2070,54 @@ int net_tcp_parse_opts(struct net_pkt *pkt, int opt_totlen,
 			frag = net_frag_read_be16(frag, pos, &pos,
 						  &opts->mss);
 			break;
+		case NET_TCP_WINDOW_SCALE_OPT:
+			if (optlen != 1) {
+				goto error;
+			}
+
+			frag = net_frag_read_u8(frag, pos, &pos,
+						&opts->wscale);
+			opts->flags |= NET_TCP_WSCALE;
+			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (optlen != 0) {
+				goto error;
+			}
+
+			opts->flags |= NET_TCP_SACK_OK;
+			break;
+		case NET_TCP_SACK_OPT:
+			if (optlen == 0 || optlen % NET_TCP_SACK_BLOCK_SIZE) {
+				goto error;
+			}
+
+			opts->sack_count = 0;
+
+			for (i = 0; i < optlen / NET_TCP_SACK_BLOCK_SIZE; i++) {
+				struct net_tcp_sack_block block;
+
+				frag = net_frag_read_be32(frag, pos, &pos,
+							  &block.start);
+				frag = net_frag_read_be32(frag, pos, &pos,
+							  &block.end);
+
+				if (i < NET_TCP_MAX_SACK_BLOCKS) {
+					opts->sack[opts->sack_count++] = block;
+				}
+			}
+
+			break;
+		case NET_TCP_TIMESTAMP_OPT:
+			if (optlen != 8) {
+				goto error;
+			}
+
+			frag = net_frag_read_be32(frag, pos, &pos,
+						  &opts->tsval);
+			frag = net_frag_read_be32(frag, pos, &pos,
+						  &opts->tsecr);
+			opts->flags |= NET_TCP_TS_OK;
+			break;
 		default:
 			frag = net_frag_skip(frag, pos, &pos, optlen);
 			break;
@@ -1446,16 +2167,55 @@ static void queue_fin(struct net_context *ctx)
 	struct net_pkt *pkt = NULL;
 	int ret;
 
+	/* The data held to fill a segment is sent first, the FIN follows
+	 * once all the data is sent.
+	 */
+	if (ctx->tcp->pending_pkt) {
+		tcp_queue_pending(ctx, true);
+
+		ctx->tcp->flags |= NET_TCP_FIN_QUEUED;
+		net_tcp_send_data(ctx, NULL, NULL, NULL);
+
+		return;
+	}
+
+	/* The data waiting for the window to open is sent first */
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->tcp->sent_list, pkt, sent_list) {
+		if (!tcp_pkt_sent(ctx->tcp, pkt)) {
+			ctx->tcp->flags |= NET_TCP_FIN_QUEUED;
+			return;
+		}
+	}
+
+	pkt = NULL;
+
 	ret = net_tcp_prepare_segment(ctx->tcp, NET_TCP_FIN, NULL, 0,
 				      NULL, &ctx->remote, &pkt);
 	if (ret || !pkt) {
 		return;
 	}
 
-	ret = net_tcp_send_pkt(pkt);
-	if (ret < 0) {
-		net_pkt_unref(pkt);
+	/* A listening context has no peer to acknowledge the FIN */
+	if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		ret = net_tcp_send_pkt(pkt);
+		if (ret < 0) {
+			net_pkt_unref(pkt);
+		}
+
+		return;
+	}
+
+	/* The FIN is retransmitted as the data until it is acked */
+	sys_slist_append(&ctx->tcp->sent_list, &pkt->sent_list);
+
+	if (k_delayed_work_remaining_get(&ctx->tcp->retry_timer) == 0) {
+		k_delayed_work_submit(&ctx->tcp->retry_timer,
+				      retry_timeout(ctx->tcp));
 	}
+
+	do_ref_if_needed(ctx->tcp, pkt);
+
+	net_tcp_send_data(ctx, NULL, NULL, NULL);
 }
 
 int net_tcp_put(struct net_context *context)
@@ -1490,9 +2250,15 @@ int net_tcp_listen(struct net_context *context)
 	return -EOPNOTSUPP;
 }
 
+static int send_ack(struct net_context *context,
+		    struct sockaddr *remote, bool force);
+static int send_reset(struct net_context *context, struct sockaddr *local,
+		      struct sockaddr *remote);
+
 int net_tcp_update_recv_wnd(struct net_context *context, s32_t delta)
 {
-	s32_t new_win;
+	s32_t new_win, threshold;
+	bool update;
 
 	if (!context->tcp) {
 		NET_ERR("context->tcp == NULL");
@@ -1500,18 +2266,29 @@ int net_tcp_update_recv_wnd(struct net_context *context, s32_t delta)
 	}
 
 	new_win = context->tcp->recv_wnd + delta;
-	if (new_win < 0 || new_win > UINT16_MAX) {
+	if (new_win < 0 || new_win > NET_TCP_MAX_WIN) {
 		return -EINVAL;
 	}
 
+	threshold = min(net_tcp_get_recv_mss(context->tcp),
+			NET_TCP_BUF_MAX_LEN / 2);
+
+	/* Let the peer know when the window opened by a full segment since
+	 * it was last advertised, see RFC 1122 chapter 4.2.3.3.
+	 */
+	update = delta > 0 &&
+		 new_win - (s32_t)context->tcp->adv_wnd >= threshold;
+
 	context->tcp->recv_wnd = new_win;
 
+	if (update &&
+	    net_tcp_get_state(context->tcp) == NET_TCP_ESTABLISHED) {
+		send_ack(context, &context->remote, true);
+	}
+
 	return 0;
 }
 
-static int send_reset(struct net_context *context, struct sockaddr *local,
-		      struct sockaddr *remote);
-
 static void backlog_ack_timeout(struct k_work *work)
 {
 	struct tcp_backlog_entry *backlog =
@@ -1592,8 +2369,37 @@ static int tcp_backlog_find(struct net_pkt *pkt, int *empty_slot)
 	return -EADDRNOTAVAIL;
 }
 
+/* Apply the options of the SYN received from the peer, the options not
+ * enabled locally are ignored.
+ */
+static void tcp_set_peer_opts(struct net_tcp *tcp,
+			      const struct net_tcp_options *opts)
+{
+	tcp->send_mss = opts->mss;
+	tcp->flags &= ~(NET_TCP_WSCALE | NET_TCP_SACK_OK | NET_TCP_TS_OK);
+
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+	    (opts->flags & NET_TCP_WSCALE)) {
+		tcp->flags |= NET_TCP_WSCALE;
+		tcp->send_wscale = min(opts->wscale, NET_TCP_MAX_WSCALE);
+	} else {
+		tcp->send_wscale = 0;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+	    (opts->flags & NET_TCP_SACK_OK)) {
+		tcp->flags |= NET_TCP_SACK_OK;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) &&
+	    (opts->flags & NET_TCP_TS_OK)) {
+		tcp->flags |= NET_TCP_TS_OK;
+		tcp->ts_recent = opts->tsval;
+	}
+}
+
 static int tcp_backlog_syn(struct net_pkt *pkt, struct net_context *context,
-			   u16_t send_mss)
+			   const struct net_tcp_options *opts)
 {
 	int empty_slot = -1;
 	int ret;
@@ -1619,7 +2425,7 @@ static int tcp_backlog_syn(struct net_pkt *pkt, struct net_context *context,
 
 	tcp_backlog[empty_slot].send_seq = context->tcp->send_seq;
 	tcp_backlog[empty_slot].send_ack = context->tcp->send_ack;
-	tcp_backlog[empty_slot].send_mss = send_mss;
+	tcp_backlog[empty_slot].opts = *opts;
 
 	k_delayed_work_init(&tcp_backlog[empty_slot].ack_timer,
 			    backlog_ack_timeout);
@@ -1653,7 +2459,7 @@ static int tcp_backlog_ack(struct net_pkt *pkt, struct net_context *context)
 		sizeof(struct sockaddr));
 	context->tcp->send_seq = tcp_backlog[r].send_seq + 1;
 	context->tcp->send_ack = tcp_backlog[r].send_ack;
-	context->tcp->send_mss = tcp_backlog[r].send_mss;
+	tcp_set_peer_opts(context->tcp, &tcp_backlog[r].opts);
 
 	k_delayed_work_cancel(&tcp_backlog[r].ack_timer);
 	memset(&tcp_backlog[r], 0, sizeof(struct tcp_backlog_entry));
@@ -1692,6 +2498,15 @@ static void handle_fin_timeout(struct k_work *work)
 	struct net_tcp *tcp =
 		CONTAINER_OF(work, struct net_tcp, fin_timer);
 
+	/* The data still queued is sent first, the retransmission timer
+	 * aborts the connection if the peer is gone.
+	 */
+	if (!sys_slist_is_empty(&tcp->sent_list) ||
+	    (tcp->flags & NET_TCP_FIN_QUEUED)) {
+		k_delayed_work_submit(&tcp->fin_timer, FIN_TIMEOUT);
+		return;
+	}
+
 	NET_DBG("Did not receive FIN in %dms", FIN_TIMEOUT);
 
 	net_context_unref(tcp->context);
@@ -1736,6 +2551,38 @@ static void handle_timewait_timeout(struct k_work *work)
 	}
 }
 
+static void handle_delayed_ack(struct k_work *work)
+{
+	struct net_tcp *tcp = CONTAINER_OF(work, struct net_tcp,
+					   delayed_ack_timer);
+
+	if (!tcp->context) {
+		return;
+	}
+
+	NET_DBG("[%p] Sending the ACK delayed", tcp);
+
+	send_ack(tcp->context, &tcp->context->remote, false);
+}
+
+/* Delay the ACK of the data received in order, see RFC 1122 chapter
+ * 4.2.3.2, until a segment is sent or the segments to ack are enough.
+ */
+static bool tcp_delay_ack(struct net_tcp *tcp)
+{
+	if (!CONFIG_NET_TCP_ACK_DELAY ||
+	    ++tcp->unacked_segs >= CONFIG_NET_TCP_ACK_SEGMENTS) {
+		return false;
+	}
+
+	if (tcp->unacked_segs == 1) {
+		k_delayed_work_submit(&tcp->delayed_ack_timer,
+				      CONFIG_NET_TCP_ACK_DELAY);
+	}
+
+	return true;
+}
+
 int net_tcp_get(struct net_context *context)
 {
 	context->tcp = net_tcp_alloc(context);
@@ -1745,6 +2592,8 @@ int net_tcp_get(struct net_context *context)
 	}
 
 	k_delayed_work_init(&context->tcp->ack_timer, handle_ack_timeout);
+	k_delayed_work_init(&context->tcp->delayed_ack_timer,
+			    handle_delayed_ack);
 	k_delayed_work_init(&context->tcp->fin_timer, handle_fin_timeout);
 	k_delayed_work_init(&context->tcp->timewait_timer,
 			    handle_timewait_timeout);
@@ -1826,12 +2675,17 @@ static void print_send_info(struct net_pkt *pkt, const char *msg)
 static inline int send_syn_segment(struct net_context *context,
 				       const struct sockaddr_ptr *local,
 				       const struct sockaddr *remote,
+				       const struct net_tcp_options *peer,
 				       int flags, const char *msg)
 {
+	u8_t options[NET_TCP_MAX_HDR_OPT_SIZE];
 	struct net_pkt *pkt = NULL;
+	u8_t optionlen;
 	int ret;
 
-	ret = net_tcp_prepare_segment(context->tcp, flags, NULL, 0,
+	net_tcp_set_syn_opt(context->tcp, peer, options, &optionlen);
+
+	ret = net_tcp_prepare_segment(context->tcp, flags, options, optionlen,
 				      local, remote, &pkt);
 	if (ret) {
 		return ret;
@@ -1855,14 +2709,16 @@ static inline int send_syn(struct net_context *context,
 {
 	net_tcp_change_state(context->tcp, NET_TCP_SYN_SENT);
 
-	return send_syn_segment(context, NULL, remote, NET_TCP_SYN, "SYN");
+	return send_syn_segment(context, NULL, remote, NULL, NET_TCP_SYN,
+				"SYN");
 }
 
 static inline int send_syn_ack(struct net_context *context,
 			       struct sockaddr_ptr *local,
-			       struct sockaddr *remote)
+			       struct sockaddr *remote,
+			       const struct net_tcp_options *peer)
 {
-	return send_syn_segment(context, local, remote,
+	return send_syn_segment(context, local, remote, peer,
 				    NET_TCP_SYN | NET_TCP_ACK,
 				    "SYN_ACK");
 }
@@ -1920,13 +2776,178 @@ static int send_reset(struct net_context *context,
 /* This is called when we receive data after the connection has been
  * established. The core TCP logic is located here.
  */
+/* RFC 6298 chapter 2, update the retransmission timeout from a round
+ * trip time measured with the timestamp echoed by the peer.
+ */
+static void tcp_rtt_sample(struct net_tcp *tcp, u32_t tsecr)
+{
+	u32_t rtt = k_uptime_get_32() - tsecr;
+	u32_t delta;
+
+	if (!tcp->srtt) {
+		tcp->srtt = max(rtt, 1);
+		tcp->rttvar = rtt / 2;
+	} else {
+		delta = tcp->srtt > rtt ? tcp->srtt - rtt : rtt - tcp->srtt;
+		tcp->rttvar = (3 * tcp->rttvar + delta) / 4;
+		tcp->srtt = max((7 * tcp->srtt + rtt) / 8, 1);
+	}
+
+	/* The initial timeout is kept as the lower bound, RFC 6298 asks
+	 * for 1 second at least.
+	 */
+	tcp->rto = tcp->srtt + max(4 * tcp->rttvar, 1);
+	tcp->rto = max(tcp->rto, CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT);
+	tcp->rto = min(tcp->rto, MAX_RTO);
+
+	NET_DBG("[%p] rtt %u srtt %u rttvar %u rto %u", tcp, rtt, tcp->srtt,
+		tcp->rttvar, tcp->rto);
+}
+
+static bool tcp_acks_new_data(struct net_tcp *tcp, u32_t ack)
+{
+	struct net_pkt *pkt;
+
+	pkt = SYS_SLIST_PEEK_HEAD_CONTAINER(&tcp->sent_list, pkt, sent_list);
+
+	return pkt && tcp_pkt_sent(tcp, pkt) &&
+		net_tcp_seq_greater(ack, tcp_pkt_seq(pkt));
+}
+
+/* An ACK not acknowledging new data, see RFC 5681 chapter 2 for the
+ * definition of a duplicate ACK.
+ */
+static bool tcp_is_dup_ack(struct net_tcp *tcp, struct net_tcp_hdr *tcp_hdr,
+			   u16_t data_len)
+{
+	struct net_pkt *pkt;
+
+	if (data_len || (NET_TCP_FLAGS(tcp_hdr) & (NET_TCP_SYN | NET_TCP_FIN))) {
+		return false;
+	}
+
+	if (((u32_t)sys_get_be16(tcp_hdr->wnd) << tcp->send_wscale) !=
+	    tcp->send_wnd) {
+		return false;
+	}
+
+	pkt = SYS_SLIST_PEEK_HEAD_CONTAINER(&tcp->sent_list, pkt, sent_list);
+
+	return pkt && tcp_pkt_sent(tcp, pkt) &&
+		tcp_pkt_seq(pkt) == sys_get_be32(tcp_hdr->ack);
+}
+
+static void tcp_dup_ack(struct net_tcp *tcp)
+{
+	struct net_pkt *pkt;
+
+	if (net_tcp_cc_dup_ack(tcp, tcp_flight_size(tcp))) {
+		/* Fast retransmit of the first segment not acked */
+		pkt = SYS_SLIST_PEEK_HEAD_CONTAINER(&tcp->sent_list, pkt,
+						    sent_list);
+		tcp->rexmit_max = tcp_pkt_end(pkt);
+		tcp_send_segment(tcp, pkt, true);
+	} else if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+		   (tcp->flags & (NET_TCP_IN_RECOVERY | NET_TCP_SACK_OK)) ==
+		   (NET_TCP_IN_RECOVERY | NET_TCP_SACK_OK)) {
+		tcp_rexmit_hole(tcp, false);
+	}
+}
+
+/* Queue a segment received ahead of the next expected one, in sequence
+ * order. Returns false if the segment cannot be queued.
+ */
+static bool tcp_ooo_queue(struct net_tcp *tcp, struct net_pkt *pkt,
+			  u8_t tcp_flags)
+{
+	u32_t seq = tcp_pkt_seq(pkt);
+	u16_t len = net_pkt_appdatalen(pkt);
+	struct net_pkt *prev = NULL, *cur;
+
+	if (!CONFIG_NET_TCP_OOO_COUNT || tcp->ooo_count >=
+	    CONFIG_NET_TCP_OOO_COUNT) {
+		return false;
+	}
+
+	if (!len || (tcp_flags & (NET_TCP_SYN | NET_TCP_FIN | NET_TCP_RST))) {
+		return false;
+	}
+
+	if (seq + len - tcp->send_ack > net_tcp_get_recv_wnd(tcp)) {
+		return false;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->ooo_list, cur, sent_list) {
+		if (tcp_pkt_seq(cur) == seq) {
+			/* Duplicate */
+			return false;
+		}
+
+		if (net_tcp_seq_greater(tcp_pkt_seq(cur), seq)) {
+			break;
+		}
+
+		prev = cur;
+	}
+
+	sys_slist_insert(&tcp->ooo_list, prev ? &prev->sent_list : NULL,
+			 &pkt->sent_list);
+	tcp->ooo_count++;
+	tcp->ooo_last = seq;
+
+	NET_DBG("[%p] queued pkt %p seq %u out of order (%u queued)", tcp,
+		pkt, seq, tcp->ooo_count);
+
+	return true;
+}
+
+/* Pass the segments queued out of order that became in order */
+static void tcp_ooo_deliver(struct net_conn *conn, struct net_context *context)
+{
+	struct net_tcp *tcp = context->tcp;
+	struct net_pkt *pkt;
+	u32_t seq;
+	u16_t len;
+
+	while ((pkt = SYS_SLIST_PEEK_HEAD_CONTAINER(&tcp->ooo_list, pkt,
+						    sent_list))) {
+		seq = tcp_pkt_seq(pkt);
+		if (net_tcp_seq_greater(seq, tcp->send_ack)) {
+			break;
+		}
+
+		sys_slist_remove(&tcp->ooo_list, NULL, &pkt->sent_list);
+		tcp->ooo_count--;
+
+		/* Segments overlapping the data received are retransmitted
+		 * differently, just drop them.
+		 */
+		len = net_pkt_appdatalen(pkt);
+		if (seq != tcp->send_ack || len > net_tcp_get_recv_wnd(tcp)) {
+			net_pkt_unref(pkt);
+			continue;
+		}
+
+		tcp->send_ack += len;
+
+		if (net_context_packet_received(conn, pkt,
+						tcp->recv_user_data) ==
+		    NET_DROP) {
+			net_pkt_unref(pkt);
+		}
+	}
+}
+
 NET_CONN_CB(tcp_established)
 {
 	struct net_context *context = (struct net_context *)user_data;
+	struct net_tcp_options tcp_opts = { 0 };
 	struct net_tcp_hdr hdr, *tcp_hdr;
 	enum net_verdict ret = NET_OK;
+	int opt_totlen;
 	u8_t tcp_flags;
 	u16_t data_len;
+	bool ooo;
 
 	NET_ASSERT(context && context->tcp);
 
@@ -1945,6 +2966,12 @@ NET_CONN_CB(tcp_established)
 
 	tcp_flags = NET_TCP_FLAGS(tcp_hdr);
 
+	opt_totlen = NET_TCP_HDR_LEN(tcp_hdr) - sizeof(struct net_tcp_hdr);
+	if (opt_totlen > 0 &&
+	    net_tcp_parse_opts(pkt, opt_totlen, &tcp_opts) < 0) {
+		return NET_DROP;
+	}
+
 	if (net_tcp_seq_cmp(sys_get_be32(tcp_hdr->seq),
 			    context->tcp->send_ack) < 0) {
 		/* Peer sent us packet we've already seen. Apparently,
@@ -1958,13 +2985,31 @@ NET_CONN_CB(tcp_established)
 		return NET_DROP;
 	}
 
+	net_context_set_appdata_values(pkt, IPPROTO_TCP);
+
 	if (net_tcp_seq_cmp(sys_get_be32(tcp_hdr->seq),
 			    context->tcp->send_ack) > 0) {
-		/* Don't try to reorder packets.  If it doesn't
-		 * match the next segment exactly, drop and wait for
-		 * retransmit
+		/* Segments received ahead of the next one expected are
+		 * queued if possible, and the duplicate ACK sent lets the
+		 * peer detect the loss.
 		 */
-		return NET_DROP;
+		if (tcp_flags & NET_TCP_RST) {
+			return NET_DROP;
+		}
+
+		if (tcp_ooo_queue(context->tcp, pkt, tcp_flags)) {
+			ret = NET_OK;
+		} else {
+			ret = NET_DROP;
+		}
+
+		send_ack(context, &conn->remote_addr, true);
+
+		return ret;
+	}
+
+	if (tcp_opts.flags & context->tcp->flags & NET_TCP_TS_OK) {
+		context->tcp->ts_recent = tcp_opts.tsval;
 	}
 
 	/*
@@ -1992,13 +3037,38 @@ NET_CONN_CB(tcp_established)
 		return NET_DROP;
 	}
 
+	data_len = net_pkt_appdatalen(pkt);
+
 	/* Handle TCP state transition */
 	if (tcp_flags & NET_TCP_ACK) {
-		if (!net_tcp_ack_received(context,
-				     sys_get_be32(tcp_hdr->ack))) {
+		u32_t ack = sys_get_be32(tcp_hdr->ack);
+
+		if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+		    (context->tcp->flags & NET_TCP_SACK_OK)) {
+			tcp_sack_update(context->tcp, &tcp_opts, ack);
+		}
+
+		/* Only the segments sent once give valid samples, RFC 6298
+		 * chapter 3.
+		 */
+		if ((tcp_opts.flags & context->tcp->flags & NET_TCP_TS_OK) &&
+		    tcp_opts.tsecr && !context->tcp->retry_timeout_shift &&
+		    !(context->tcp->flags & NET_TCP_IN_RECOVERY) &&
+		    tcp_acks_new_data(context->tcp, ack)) {
+			tcp_rtt_sample(context->tcp, tcp_opts.tsecr);
+		}
+
+		if (tcp_is_dup_ack(context->tcp, tcp_hdr, data_len)) {
+			tcp_dup_ack(context->tcp);
+		}
+
+		if (!net_tcp_ack_received(context, ack)) {
 			return NET_DROP;
 		}
 
+		context->tcp->send_wnd = (u32_t)sys_get_be16(tcp_hdr->wnd) <<
+					 context->tcp->send_wscale;
+
 		/* TCP state might be changed after maintaining the sent pkt
 		 * list, e.g., an ack of FIN is received.
 		 */
@@ -2040,9 +3110,6 @@ NET_CONN_CB(tcp_established)
 		context->tcp->fin_rcvd = 1;
 	}
 
-	net_context_set_appdata_values(pkt, IPPROTO_TCP);
-
-	data_len = net_pkt_appdatalen(pkt);
 	if (data_len > net_tcp_get_recv_wnd(context->tcp)) {
 		NET_ERR("Context %p: overflow of recv window (%d vs %d), "
 			"pkt dropped",
@@ -2066,7 +3133,27 @@ NET_CONN_CB(tcp_established)
 		context->tcp->send_ack += 1;
 	}
 
-	send_ack(context, &conn->remote_addr, false);
+	/* The ACK is not delayed while there are holes in the data
+	 * received, RFC 5681 chapter 4.2.
+	 */
+	ooo = data_len && context->tcp->ooo_count;
+	if (ooo) {
+		tcp_ooo_deliver(conn, context);
+	}
+
+	/* The ACK may have opened the windows, send the data waiting */
+	if ((tcp_flags & NET_TCP_ACK) &&
+	    (!sys_slist_is_empty(&context->tcp->sent_list) ||
+	     context->tcp->pending_pkt)) {
+		net_tcp_send_data(context, NULL, NULL, NULL);
+	}
+
+	/* Unless the data sent carried the ACK already */
+	if (context->tcp->sent_ack != context->tcp->send_ack &&
+	    (!data_len || (tcp_flags & NET_TCP_FIN) || ooo ||
+	     !tcp_delay_ack(context->tcp))) {
+		send_ack(context, &conn->remote_addr, false);
+	}
 
 clean_up:
 	if (net_tcp_get_state(context->tcp) == NET_TCP_TIME_WAIT) {
@@ -2142,8 +3229,12 @@ NET_CONN_CB(tcp_synack_received)
 		/* Remove the temporary connection handler and register
 		 * a proper now as we have an established connection.
 		 */
+		struct net_tcp_options tcp_opts = {
+			.mss = NET_TCP_DEFAULT_MSS,
+		};
 		struct sockaddr local_addr;
 		struct sockaddr remote_addr;
+		int opt_totlen;
 
 		if (net_pkt_get_src_addr(
 			pkt, &remote_addr, sizeof(remote_addr)) < 0) {
@@ -2152,6 +3243,20 @@ NET_CONN_CB(tcp_synack_received)
 			return NET_DROP;
 		}
 
+		opt_totlen = NET_TCP_HDR_LEN(tcp_hdr)
+			     - sizeof(struct net_tcp_hdr);
+		if (opt_totlen > 0 &&
+		    net_tcp_parse_opts(pkt, opt_totlen, &tcp_opts) < 0) {
+			return NET_DROP;
+		}
+
+		/* The window of a SYN-ACK is never scaled */
+		tcp_set_peer_opts(context->tcp, &tcp_opts);
+		context->tcp->send_wnd = sys_get_be16(tcp_hdr->wnd);
+		context->tcp->send_next = context->tcp->send_seq;
+		context->tcp->send_max = context->tcp->send_seq;
+		net_tcp_cc_init(context->tcp);
+
 		if (net_pkt_get_dst_addr(
 			pkt, &local_addr, sizeof(local_addr)) < 0) {
 			NET_DBG("Cannot parse local address from received pkt");
@@ -2221,6 +3326,29 @@ static void pkt_get_sockaddr(sa_family_t family, struct net_pkt *pkt,
 #endif
 }
 
+/* Set up the sending side of an accepted connection from the ACK
+ * completing the handshake.
+ */
+static void tcp_accepted_opts(struct net_tcp *tcp, struct net_pkt *pkt,
+			      struct net_tcp_hdr *tcp_hdr)
+{
+	struct net_tcp_options tcp_opts = { 0 };
+	int opt_totlen;
+
+	tcp->send_wnd = (u32_t)sys_get_be16(tcp_hdr->wnd) << tcp->send_wscale;
+	tcp->send_next = tcp->send_seq;
+	tcp->send_max = tcp->send_seq;
+
+	opt_totlen = NET_TCP_HDR_LEN(tcp_hdr) - sizeof(struct net_tcp_hdr);
+	if (opt_totlen > 0 &&
+	    net_tcp_parse_opts(pkt, opt_totlen, &tcp_opts) == 0 &&
+	    (tcp->flags & NET_TCP_TS_OK) && (tcp_opts.flags & NET_TCP_TS_OK)) {
+		tcp->ts_recent = tcp_opts.tsval;
+	}
+
+	net_tcp_cc_init(tcp);
+}
+
 #if defined(CONFIG_NET_CONTEXT_NET_PKT_POOL)
 static inline void copy_pool_vars(struct net_context *new_context,
 				  struct net_context *listen_context)
@@ -2312,9 +3440,7 @@ NET_CONN_CB(tcp_syn_rcvd)
 		context->tcp->send_ack =
 			sys_get_be32(tcp_hdr->seq) + 1;
 
-		/* Get MSS from TCP options here*/
-
-		r = tcp_backlog_syn(pkt, context, tcp_opts.mss);
+		r = tcp_backlog_syn(pkt, context, &tcp_opts);
 		if (r < 0) {
 			if (r == -EADDRINUSE) {
 				NET_DBG("TCP connection already exists");
@@ -2327,7 +3453,10 @@ NET_CONN_CB(tcp_syn_rcvd)
 
 		pkt_get_sockaddr(net_context_get_family(context),
 				 pkt, &pkt_src_addr);
-		send_syn_ack(context, &pkt_src_addr, &remote_addr);
+		/* The SYN-ACK carries the options the peer offered, kept in
+		 * the backlog entry until the connection is accepted.
+		 */
+		send_syn_ack(context, &pkt_src_addr, &remote_addr, &tcp_opts);
 
 		return NET_DROP;
 	}
@@ -2426,6 +3555,12 @@ NET_CONN_CB(tcp_syn_rcvd)
 		 */
 		new_context->tcp->state = NET_TCP_ESTABLISHED;
 
+		tcp_accepted_opts(new_context->tcp, pkt, tcp_hdr);
+
+		/* The sending options of the listening socket are inherited */
+		new_context->tcp->flags |= tcp->flags &
+					   (NET_TCP_NODELAY | NET_TCP_CORK);
+
 		net_context_set_state(new_context, NET_CONTEXT_CONNECTED);
 
 		if (new_context->remote.sa_family == AF_INET) {
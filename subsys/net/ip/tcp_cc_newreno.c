@@ -0,0 +1,138 @@
+/** @file
+ * @brief TCP NewReno congestion control
+ *
+ * Slow start, congestion avoidance and fast retransmit of RFC 5681, with
+ * the fast recovery of RFC 6582.
+ */
+
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#if defined(CONFIG_NET_DEBUG_TCP)
+#define SYS_LOG_DOMAIN "net/tcp"
+#define NET_LOG_ENABLED 1
+#endif
+
+#include <kernel.h>
+#include <stdbool.h>
+
+#include "net_private.h"
+#include "tcp_internal.h"
+
+/* Number of duplicate ACKs triggering a fast retransmit */
+#define DUP_ACK_THRESHOLD 3
+
+/* RFC 5681 chapter 3.1, initial value of cwnd */
+static u32_t initial_window(u16_t mss)
+{
+	if (mss > 2190) {
+		return 2 * mss;
+	}
+
+	if (mss > 1095) {
+		return 3 * mss;
+	}
+
+	return 4 * mss;
+}
+
+/* RFC 5681 chapter 3.1, equation 4 */
+static u32_t loss_ssthresh(struct net_tcp *tcp, u32_t flight)
+{
+	return max(flight / 2, 2 * (u32_t)tcp->send_mss);
+}
+
+void net_tcp_cc_init(struct net_tcp *tcp)
+{
+	tcp->cwnd = initial_window(tcp->send_mss);
+	tcp->ssthresh = UINT32_MAX;
+	tcp->bytes_acked = 0;
+	tcp->dup_acks = 0;
+	tcp->flags &= ~NET_TCP_IN_RECOVERY;
+}
+
+bool net_tcp_cc_ack(struct net_tcp *tcp, u32_t ack, u32_t acked)
+{
+	u32_t mss = tcp->send_mss;
+
+	tcp->dup_acks = 0;
+
+	if (tcp->flags & NET_TCP_IN_RECOVERY) {
+		if (!net_tcp_seq_greater(tcp->recover, ack)) {
+			/* Full acknowledgment, deflate the window */
+			tcp->cwnd = tcp->ssthresh;
+			tcp->flags &= ~NET_TCP_IN_RECOVERY;
+
+			NET_DBG("[%p] recovery done, cwnd %u", tcp, tcp->cwnd);
+
+			return false;
+		}
+
+		/* Partial acknowledgment: deflate the window by the amount
+		 * acked, add back one segment and retransmit the next one.
+		 */
+		tcp->cwnd = tcp->cwnd > acked ? tcp->cwnd - acked : 0;
+		if (acked >= mss) {
+			tcp->cwnd += mss;
+		}
+
+		tcp->cwnd = max(tcp->cwnd, mss);
+
+		return true;
+	}
+
+	if (tcp->cwnd < tcp->ssthresh) {
+		/* Slow start */
+		tcp->cwnd += min(acked, mss);
+	} else {
+		/* Congestion avoidance, one segment per window acked */
+		tcp->bytes_acked += acked;
+		if (tcp->bytes_acked >= tcp->cwnd) {
+			tcp->bytes_acked -= tcp->cwnd;
+			tcp->cwnd += mss;
+		}
+	}
+
+	return false;
+}
+
+bool net_tcp_cc_dup_ack(struct net_tcp *tcp, u32_t flight)
+{
+	if (tcp->flags & NET_TCP_IN_RECOVERY) {
+		/* Each duplicate ACK means a segment left the network */
+		tcp->cwnd += tcp->send_mss;
+
+		return false;
+	}
+
+	if (++tcp->dup_acks < DUP_ACK_THRESHOLD) {
+		return false;
+	}
+
+	tcp->ssthresh = loss_ssthresh(tcp, flight);
+	tcp->cwnd = tcp->ssthresh + DUP_ACK_THRESHOLD * tcp->send_mss;
+	tcp->recover = tcp->send_max;
+	tcp->dup_acks = 0;
+	tcp->flags |= NET_TCP_IN_RECOVERY;
+
+	NET_DBG("[%p] fast retransmit, ssthresh %u recover %u", tcp,
+		tcp->ssthresh, tcp->recover);
+
+	return true;
+}
+
+void net_tcp_cc_timeout(struct net_tcp *tcp, u32_t flight)
+{
+	/* The threshold is kept on the next timeouts of the same segment */
+	if (tcp->retry_timeout_shift <= 1) {
+		tcp->ssthresh = loss_ssthresh(tcp, flight);
+	}
+
+	tcp->cwnd = tcp->send_mss;
+	tcp->bytes_acked = 0;
+	tcp->dup_acks = 0;
+	tcp->flags &= ~NET_TCP_IN_RECOVERY;
+}
@@ -0,0 +1,46 @@
+/** @file
+ * @brief TCP without congestion control
+ *
+ * The amount of data in flight is only limited by the window advertised
+ * by the peer, and segments are only retransmitted on timeout.
+ */
+
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <stdbool.h>
+
+#include "tcp_internal.h"
+
+void net_tcp_cc_init(struct net_tcp *tcp)
+{
+	tcp->cwnd = UINT32_MAX;
+	tcp->ssthresh = UINT32_MAX;
+}
+
+bool net_tcp_cc_ack(struct net_tcp *tcp, u32_t ack, u32_t acked)
+{
+	ARG_UNUSED(tcp);
+	ARG_UNUSED(ack);
+	ARG_UNUSED(acked);
+
+	return false;
+}
+
+bool net_tcp_cc_dup_ack(struct net_tcp *tcp, u32_t flight)
+{
+	ARG_UNUSED(tcp);
+	ARG_UNUSED(flight);
+
+	return false;
+}
+
+void net_tcp_cc_timeout(struct net_tcp *tcp, u32_t flight)
+{
+	ARG_UNUSED(tcp);
+	ARG_UNUSED(flight);
+}
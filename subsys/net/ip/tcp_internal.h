@@ -44,6 +44,29 @@ extern "C" {
 /** MSS option has been set already */
 #define NET_TCP_RECV_MSS_SET BIT(5)
 
+/** Window scale option exchanged, the windows are scaled */
+#define NET_TCP_WSCALE BIT(6)
+
+/** SACK permitted option exchanged */
+#define NET_TCP_SACK_OK BIT(7)
+
+/** Timestamps option exchanged, all segments carry timestamps */
+#define NET_TCP_TS_OK BIT(8)
+
+/** Lost segments are being recovered after duplicate ACKs */
+#define NET_TCP_IN_RECOVERY BIT(9)
+
+/** A FIN is to be sent once the queued data is sent */
+#define NET_TCP_FIN_QUEUED BIT(10)
+
+/** Small segments are sent without waiting for the data in flight to be
+ * acked (TCP_NODELAY)
+ */
+#define NET_TCP_NODELAY BIT(11)
+
+/** Only full-sized segments are sent (TCP_CORK) */
+#define NET_TCP_CORK BIT(12)
+
 /*
  * TCP connection states
  */
@@ -81,33 +104,72 @@ enum net_tcp_state {
  */
 #define NET_TCP_DEFAULT_MSS   536
 
+/* Max shift of the window scale option, RFC 7323 chapter 2.3 */
+#define NET_TCP_MAX_WSCALE 14
+
 /* TCP max window size */
-#define NET_TCP_MAX_WIN   (4 * 1024)
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+#define NET_TCP_MAX_WIN   ((u32_t)UINT16_MAX << NET_TCP_MAX_WSCALE)
+#else
+#define NET_TCP_MAX_WIN   UINT16_MAX
+#endif
 
 /* Maximal value of the sequence number */
 #define NET_TCP_MAX_SEQ   0xffffffff
 
+/* Max length of the options in a TCP header */
+#define NET_TCP_MAX_HDR_OPT_SIZE  40
+
+/* Room reserved for the options in a data segment, which only carries
+ * the timestamps
+ */
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+#define NET_TCP_MAX_OPT_SIZE  (2 * NET_TCP_NOP_SIZE + NET_TCP_TIMESTAMP_SIZE)
+#else
 #define NET_TCP_MAX_OPT_SIZE  8
+#endif
 
 /* TCP Option codes */
 #define NET_TCP_END_OPT          0
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMP_OPT    8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+#define NET_TCP_TIMESTAMP_SIZE    10
+
+/* Max SACK blocks in an option, RFC 2018 chapter 3 */
+#define NET_TCP_MAX_SACK_BLOCKS   4
+
+/** Block of data received out of order, reported in a SACK option */
+struct net_tcp_sack_block {
+	u32_t start;
+	u32_t end;
+};
 
 /** Parsed TCP option values for net_tcp_parse_opts()  */
 struct net_tcp_options {
+	/** Options found, NET_TCP_WSCALE, NET_TCP_SACK_OK or NET_TCP_TS_OK */
+	u16_t flags;
 	u16_t mss;
+	u8_t wscale;
+	u8_t sack_count;
+	u32_t tsval;
+	u32_t tsecr;
+	struct net_tcp_sack_block sack[NET_TCP_MAX_SACK_BLOCKS];
 };
 
 /* Max received bytes to buffer internally */
-#define NET_TCP_BUF_MAX_LEN 1280
+#define NET_TCP_BUF_MAX_LEN CONFIG_NET_TCP_RECV_WINDOW_SIZE
 
 /* Max segment lifetime, in seconds */
 #define NET_TCP_MAX_SEG_LIFETIME 60
@@ -124,6 +186,9 @@ struct net_tcp {
 	/** ACK message timer */
 	struct k_delayed_work ack_timer;
 
+	/** Timer sending the ACK of the data received if no segment does */
+	struct k_delayed_work delayed_ack_timer;
+
 	/** Timer for doing active close in case the peer FIN is lost. */
 	struct k_delayed_work fin_timer;
 
@@ -136,6 +201,14 @@ struct net_tcp {
 	/** List pointer used for TCP retransmit buffering */
 	sys_slist_t sent_list;
 
+	/** Data written by the application waiting to fill a segment */
+	struct net_pkt *pending_pkt;
+
+	/** Serializes the data queued, from the pending pkt or not, with
+	 * the sequence numbers given to it.
+	 */
+	struct k_sem queue_lock;
+
 	/** Current sequence number. */
 	u32_t send_seq;
 
@@ -148,7 +221,7 @@ struct net_tcp {
 	/** Current retransmit period */
 	u32_t retry_timeout_shift : 5;
 	/** Flags for the TCP */
-	u32_t flags : 8;
+	u32_t flags : 13;
 	/** Current TCP state */
 	u32_t state : 4;
 	/* An outbound FIN packet has been sent */
@@ -156,7 +229,7 @@ struct net_tcp {
 	/* An inbound FIN packet has been received */
 	u32_t fin_rcvd : 1;
 	/** Remaining bits in this u32_t */
-	u32_t _padding : 13;
+	u32_t _padding : 8;
 
 	/** Accept callback to be called when the connection has been
 	 * established.
@@ -171,12 +244,67 @@ struct net_tcp {
 	/**
 	 * Current TCP receive window for our side
 	 */
-	u16_t recv_wnd;
+	u32_t recv_wnd;
+
+	/** Receive window last advertised to the peer */
+	u32_t adv_wnd;
 
 	/**
 	 * Send MSS for the peer
 	 */
 	u16_t send_mss;
+
+	/** Window scale shifts of the peer window and of our window */
+	u8_t send_wscale;
+	u8_t recv_wscale;
+
+	/** Send window advertised by the peer */
+	u32_t send_wnd;
+
+	/** Sequence number of the next segment to send */
+	u32_t send_next;
+
+	/** Sequence number following the highest segment sent */
+	u32_t send_max;
+
+	/** Congestion window and slow start threshold */
+	u32_t cwnd;
+	u32_t ssthresh;
+
+	/** Bytes acked since the last congestion window increase */
+	u32_t bytes_acked;
+
+	/** Highest sequence number sent when the recovery started */
+	u32_t recover;
+
+	/** Duplicate ACKs received in a row */
+	u8_t dup_acks;
+
+	/** Retransmission timeout, smoothed RTT and RTT variation in ms */
+	u32_t rto;
+	u32_t srtt;
+	u32_t rttvar;
+
+	/** Timestamp to echo to the peer */
+	u32_t ts_recent;
+
+	/** Data above the first unacked segment SACKed by the peer */
+	struct net_tcp_sack_block sacked[NET_TCP_MAX_SACK_BLOCKS];
+
+	/** Sequence number up to which SACK holes were retransmitted */
+	u32_t rexmit_max;
+
+	/** Segments received out of order, in sequence order */
+	sys_slist_t ooo_list;
+
+	/** Sequence number of the last segment received out of order */
+	u32_t ooo_last;
+
+	/** Number of segments in ooo_list */
+	u8_t ooo_count;
+
+	/** Segments received with data since the last ACK sent */
+	u8_t unacked_segs;
 };
 
 typedef void (*net_tcp_cb_t)(struct net_tcp *tcp, void *user_data);
@@ -428,8 +556,8 @@ u16_t net_tcp_get_chksum(struct net_pkt *pkt, struct net_buf *frag);
 /**
  * @brief Parse TCP options from network packet.
  *
- * Parse TCP options, returning MSS value (as that the only one we
- * handle so far).
+ * Parse TCP options, returning the MSS, window scale, SACK and
+ * timestamps option values.
  *
  * @param pkt Network packet
  * @param opt_totlen Total length of options to parse
@@ -498,6 +626,33 @@ int net_tcp_listen(struct net_context *context);
  */
 int net_tcp_update_recv_wnd(struct net_context *context, s32_t delta);
 
+/**
+ * @brief Set or clear a flag changing how the data written is sent.
+ *
+ * Clearing NET_TCP_NODELAY enables the Nagle algorithm of RFC 896,
+ * small segments are only sent when there is no data in flight. With
+ * NET_TCP_CORK set, only full-sized segments are sent until the flag
+ * is cleared or the connection closed.
+ *
+ * @param context Network context
+ * @param flag NET_TCP_NODELAY or NET_TCP_CORK
+ * @param set Whether to set or clear the flag
+ *
+ * @return 0 if successful, -EINVAL for another flag, -EPROTOTYPE if
+ *         there is no TCP context
+ */
+int net_tcp_set_send_flag(struct net_context *context, u16_t flag, bool set);
+
+/**
+ * @brief Get a flag changing how the data written is sent.
+ *
+ * @param context Network context
+ * @param flag NET_TCP_NODELAY or NET_TCP_CORK
+ *
+ * @return 1 if the flag is set, 0 if not, < 0 on error
+ */
+int net_tcp_get_send_flag(struct net_context *context, u16_t flag);
+
 /**
  * @brief Initialize TCP parts of a context
  *
@@ -551,6 +706,52 @@ int net_tcp_connect(struct net_context *context,
 		    net_context_connect_cb_t cb,
 		    void *user_data);
 
+/*
+ * Congestion control, implemented by the algorithm selected in Kconfig.
+ * It maintains the congestion window (cwnd) of a connection, the amount
+ * of data allowed in flight on top of the window advertised by the peer.
+ */
+
+/**
+ * @brief Initialize the congestion control state of a connection
+ *
+ * Called when a connection is established, the send MSS being known.
+ *
+ * @param tcp TCP context
+ */
+void net_tcp_cc_init(struct net_tcp *tcp);
+
+/**
+ * @brief Account for new data acknowledged by the peer
+ *
+ * @param tcp TCP context
+ * @param ack Received ACK sequence number
+ * @param acked Number of bytes newly acknowledged
+ *
+ * @return true if the first unacknowledged segment is to be retransmitted
+ *         (partial acknowledgment during a recovery), false otherwise
+ */
+bool net_tcp_cc_ack(struct net_tcp *tcp, u32_t ack, u32_t acked);
+
+/**
+ * @brief Account for a duplicate ACK received
+ *
+ * @param tcp TCP context
+ * @param flight Number of bytes in flight
+ *
+ * @return true if the first unacknowledged segment is to be retransmitted
+ *         (fast retransmit), false otherwise
+ */
+bool net_tcp_cc_dup_ack(struct net_tcp *tcp, u32_t flight);
+
+/**
+ * @brief Account for a retransmission timeout
+ *
+ * @param tcp TCP context
+ * @param flight Number of bytes in flight before the timeout
+ */
+void net_tcp_cc_timeout(struct net_tcp *tcp, u32_t flight);
+
 #else
 static inline struct net_tcp *net_tcp_alloc(struct net_context *context)
 {
@@ -737,6 +938,25 @@ static inline int net_tcp_update_recv_wnd(struct net_context *context,
 	return -EPROTONOSUPPORT;
 }
 
+static inline int net_tcp_set_send_flag(struct net_context *context,
+					u16_t flag, bool set)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(flag);
+	ARG_UNUSED(set);
+
+	return -EPROTONOSUPPORT;
+}
+
+static inline int net_tcp_get_send_flag(struct net_context *context,
+					u16_t flag)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(flag);
+
+	return -EPROTONOSUPPORT;
+}
+
 static inline int net_tcp_get(struct net_context *context)
 {
 	ARG_UNUSED(context);
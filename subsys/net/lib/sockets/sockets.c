@@ -46,6 +46,35 @@ static inline u32_t sock_get_flag(struct net_context *ctx, u32_t mask)
 #define sock_set_eof(ctx) sock_set_flag(ctx, SOCK_EOF, SOCK_EOF)
 #define sock_is_nonblock(ctx) sock_get_flag(ctx, SOCK_NONBLOCK)
 
+static inline void sock_init(struct net_context *ctx)
+{
+	/* recv_q and accept_q are in union */
+	k_fifo_init(&ctx->recv_q);
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	k_poll_signal_init(&ctx->eof_signal);
+#endif
+}
+
+static inline void sock_mark_eof(struct net_context *ctx)
+{
+	sock_set_eof(ctx);
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	k_poll_signal(&ctx->eof_signal, 0);
+#endif
+}
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+static bool zsock_is_epoll(int fd);
+static int zsock_epoll_close(int epfd);
+static void zsock_epoll_remove_sock(int sock);
+#else
+#define zsock_is_epoll(fd) false
+#define zsock_epoll_close(epfd) 0
+#define zsock_epoll_remove_sock(sock)
+#endif
+
 static inline int _k_fifo_wait_non_empty(struct k_fifo *fifo, int32_t timeout)
 {
 	struct k_poll_event events[] = {
@@ -82,8 +111,7 @@ int zsock_socket(int family, int type, int proto)
 	/* Initialize user_data, all other calls will preserve it */
 	ctx->user_data = NULL;
 
-	/* recv_q and accept_q are in union */
-	k_fifo_init(&ctx->recv_q);
+	sock_init(ctx);
 
 	/* TODO: Ensure non-negative */
 	return POINTER_TO_INT(ctx);
@@ -93,6 +121,12 @@ int zsock_close(int sock)
 {
 	struct net_context *ctx = INT_TO_POINTER(sock);
 
+	if (zsock_is_epoll(sock)) {
+		return zsock_epoll_close(sock);
+	}
+
+	zsock_epoll_remove_sock(sock);
+
 	/* Reset callbacks to avoid any race conditions while
 	 * flushing queues. No need to check return values here,
 	 * as these are fail-free operations and we're closing
@@ -118,7 +152,7 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 		/* This just installs a callback, so cannot fail. */
 		(void)net_context_recv(new_ctx, zsock_received_cb, K_NO_WAIT,
 				       NULL);
-		k_fifo_init(&new_ctx->recv_q);
+		sock_init(new_ctx);
 
 		k_fifo_put(&parent->accept_q, new_ctx);
 	}
@@ -140,7 +174,7 @@ static void zsock_received_cb(struct net_context *ctx, struct net_pkt *pkt,
 			 * be blocked waiting on it to become non-empty,
 			 * so cancel that wait.
 			 */
-			sock_set_eof(ctx);
+			sock_mark_eof(ctx);
 			k_fifo_cancel_wait(&ctx->recv_q);
 			NET_DBG("Marked socket %p as peer-closed", ctx);
 		} else {
@@ -235,30 +269,22 @@ ssize_t zsock_send(int sock, const void *buf, size_t len, int flags)
 	return zsock_sendto(sock, buf, len, flags, NULL, 0);
 }
 
-ssize_t zsock_sendto(int sock, const void *buf, size_t len, int flags,
-		     const struct sockaddr *dest_addr, socklen_t addrlen)
+static inline s32_t zsock_timeout(struct net_context *ctx, int flags)
 {
-	int err;
-	struct net_pkt *send_pkt;
-	s32_t timeout = K_FOREVER;
-	struct net_context *ctx = INT_TO_POINTER(sock);
-
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
-		timeout = K_NO_WAIT;
+		return K_NO_WAIT;
 	}
 
-	send_pkt = net_pkt_get_tx(ctx, timeout);
-	if (!send_pkt) {
-		errno = EAGAIN;
-		return -1;
-	}
+	return K_FOREVER;
+}
 
-	len = net_pkt_append(send_pkt, len, buf, timeout);
-	if (!len) {
-		net_pkt_unref(send_pkt);
-		errno = EAGAIN;
-		return -1;
-	}
+/* Send a packet, of which ownership is taken */
+static ssize_t zsock_send_pkt(struct net_context *ctx,
+			      struct net_pkt *send_pkt, size_t len,
+			      s32_t timeout, const struct sockaddr *dest_addr,
+			      socklen_t addrlen)
+{
+	int err;
 
 	/* Register the callback before sending in order to receive the response
 	 * from the peer.
@@ -286,22 +312,186 @@ ssize_t zsock_sendto(int sock, const void *buf, size_t len, int flags,
 	return len;
 }
 
-static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
-				       void *buf,
-				       size_t max_len,
-				       int flags,
-				       struct sockaddr *src_addr,
-				       socklen_t *addrlen)
+ssize_t zsock_sendto(int sock, const void *buf, size_t len, int flags,
+		     const struct sockaddr *dest_addr, socklen_t addrlen)
 {
-	size_t recv_len = 0;
-	s32_t timeout = K_FOREVER;
-	unsigned int header_len;
-	struct net_pkt *pkt;
+	struct net_pkt *send_pkt;
+	struct net_context *ctx = INT_TO_POINTER(sock);
+	s32_t timeout = zsock_timeout(ctx, flags);
 
-	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
-		timeout = K_NO_WAIT;
+	send_pkt = net_pkt_get_tx(ctx, timeout);
+	if (!send_pkt) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	len = net_pkt_append(send_pkt, len, buf, timeout);
+	if (!len) {
+		net_pkt_unref(send_pkt);
+		errno = EAGAIN;
+		return -1;
 	}
 
+	return zsock_send_pkt(ctx, send_pkt, len, timeout, dest_addr, addrlen);
+}
+
+ssize_t zsock_sendmsg(int sock, const struct zsock_msghdr *msg, int flags)
+{
+	struct net_pkt *send_pkt;
+	struct net_context *ctx = INT_TO_POINTER(sock);
+	s32_t timeout = zsock_timeout(ctx, flags);
+	size_t len = 0;
+	int i;
+
+	send_pkt = net_pkt_get_tx(ctx, timeout);
+	if (!send_pkt) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	/* Gather the buffers in the packet, up to the first one which
+	 * does not fit.
+	 */
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		size_t iov_len = msg->msg_iov[i].iov_len;
+		size_t appended;
+
+		appended = net_pkt_append(send_pkt, iov_len,
+					  msg->msg_iov[i].iov_base, timeout);
+		len += appended;
+		if (appended != iov_len) {
+			break;
+		}
+	}
+
+	if (!len) {
+		net_pkt_unref(send_pkt);
+		errno = EAGAIN;
+		return -1;
+	}
+
+	return zsock_send_pkt(ctx, send_pkt, len, timeout, msg->msg_name,
+			      msg->msg_namelen);
+}
+
+struct net_buf *zsock_alloc_send_buf(int sock, int flags)
+{
+	struct net_context *ctx = INT_TO_POINTER(sock);
+	struct net_buf *frag;
+
+	frag = net_pkt_get_data(ctx, zsock_timeout(ctx, flags));
+	if (!frag) {
+		errno = EAGAIN;
+	}
+
+	return frag;
+}
+
+/* Cut a chain of fragments after len bytes, copying the tail of the
+ * fragment across the cut to a new one, and return the fragments after
+ * the cut, or NULL if no fragment could be allocated.
+ */
+static struct net_buf *zsock_frags_cut(struct net_context *ctx,
+				       struct net_buf *frags, size_t len,
+				       s32_t timeout)
+{
+	struct net_buf *frag = frags, *last = NULL, *rest;
+
+	while (len >= frag->len) {
+		len -= frag->len;
+		last = frag;
+		frag = frag->frags;
+	}
+
+	if (!len) {
+		last->frags = NULL;
+		return frag;
+	}
+
+	rest = net_pkt_get_data(ctx, timeout);
+	if (!rest) {
+		return NULL;
+	}
+
+	net_buf_add_mem(rest, frag->data + len, frag->len - len);
+	frag->len = len;
+	rest->frags = frag->frags;
+	frag->frags = NULL;
+
+	return rest;
+}
+
+ssize_t zsock_sendto_zc(int sock, struct net_buf *frags, int flags,
+			const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	struct net_pkt *send_pkt;
+	struct net_context *ctx = INT_TO_POINTER(sock);
+	s32_t timeout = zsock_timeout(ctx, flags);
+	struct net_buf *rest;
+	ssize_t sent = 0, res;
+	size_t len;
+
+	do {
+		send_pkt = net_pkt_get_tx(ctx, timeout);
+		if (!send_pkt) {
+			net_buf_unref(frags);
+			errno = EAGAIN;
+			return sent ? sent : -1;
+		}
+
+		len = net_buf_frags_len(frags);
+		rest = NULL;
+
+		/* A stream is sent in packets no larger than those filled
+		 * by net_pkt_append(), TCP does not split them.
+		 */
+		if (net_context_get_type(ctx) == SOCK_STREAM) {
+			if (len > net_pkt_append_room(send_pkt)) {
+				len = net_pkt_append_room(send_pkt);
+				rest = zsock_frags_cut(ctx, frags, len,
+						       timeout);
+				if (!rest) {
+					net_pkt_unref(send_pkt);
+					net_buf_unref(frags);
+					errno = EAGAIN;
+					return sent ? sent : -1;
+				}
+			}
+
+			send_pkt->data_len -= len;
+		}
+
+		/* The fragments are sent as they are, the headers are
+		 * inserted in front of them by the stack.
+		 */
+		net_pkt_frag_add(send_pkt, frags);
+
+		res = zsock_send_pkt(ctx, send_pkt, len, timeout, dest_addr,
+				     addrlen);
+		if (res < 0) {
+			if (rest) {
+				net_buf_unref(rest);
+			}
+
+			return sent ? sent : -1;
+		}
+
+		sent += res;
+		frags = rest;
+	} while (frags);
+
+	return sent;
+}
+
+/* Get the next datagram, with its source address if requested */
+static struct net_pkt *zsock_recv_dgram_pkt(struct net_context *ctx,
+					    int flags,
+					    struct sockaddr *src_addr,
+					    socklen_t *addrlen)
+{
+	s32_t timeout = zsock_timeout(ctx, flags);
+	struct net_pkt *pkt;
+
 	if (flags & ZSOCK_MSG_PEEK) {
 		int res;
 
@@ -309,7 +499,7 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		/* EAGAIN when timeout expired, EINTR when cancelled */
 		if (res && res != -EAGAIN && res != -EINTR) {
 			errno = -res;
-			return -1;
+			return NULL;
 		}
 
 		pkt = k_fifo_peek_head(&ctx->recv_q);
@@ -319,7 +509,7 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 
 	if (!pkt) {
 		errno = EAGAIN;
-		return -1;
+		return NULL;
 	}
 
 	if (src_addr && addrlen) {
@@ -327,8 +517,8 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 
 		rv = net_pkt_get_src_addr(pkt, src_addr, *addrlen);
 		if (rv < 0) {
-			errno = rv;
-			return -1;
+			errno = -rv;
+			goto fail;
 		}
 
 		/* addrlen is a value-result argument, set to actual
@@ -340,21 +530,57 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 			*addrlen = sizeof(struct sockaddr_in6);
 		} else {
 			errno = ENOTSUP;
-			return -1;
+			goto fail;
 		}
 	}
 
+	return pkt;
+
+fail:
+	if (!(flags & ZSOCK_MSG_PEEK)) {
+		net_pkt_unref(pkt);
+	}
+
+	return NULL;
+}
+
+static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
+				       struct zsock_iovec *iov,
+				       int iovlen,
+				       int *msg_flags,
+				       int flags,
+				       struct sockaddr *src_addr,
+				       socklen_t *addrlen)
+{
+	size_t recv_len = 0;
+	size_t data_len;
+	unsigned int header_len;
+	struct net_pkt *pkt;
+	int i;
+
+	pkt = zsock_recv_dgram_pkt(ctx, flags, src_addr, addrlen);
+	if (!pkt) {
+		return -1;
+	}
+
 	/* Set starting point behind packet header since we've
 	 * handled src addr and port.
 	 */
 	header_len = net_pkt_appdata(pkt) - pkt->frags->data;
+	data_len = net_pkt_appdatalen(pkt);
 
-	recv_len = net_pkt_appdatalen(pkt);
-	if (recv_len > max_len) {
-		recv_len = max_len;
+	/* Scatter the datagram in the buffers, what does not fit is lost */
+	for (i = 0; i < iovlen && recv_len < data_len; i++) {
+		size_t len = min(iov[i].iov_len, data_len - recv_len);
+
+		net_frag_linearize(iov[i].iov_base, len, pkt,
+				   header_len + recv_len, len);
+		recv_len += len;
 	}
 
-	net_frag_linearize(buf, recv_len, pkt, header_len, recv_len);
+	if (msg_flags && recv_len < data_len) {
+		*msg_flags |= ZSOCK_MSG_TRUNC;
+	}
 
 	if (!(flags & ZSOCK_MSG_PEEK)) {
 		net_pkt_unref(pkt);
@@ -363,56 +589,85 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 	return recv_len;
 }
 
+/* Wait for the head packet of a stream socket: returns 0 with *pkt
+ * set to NULL on EOF, -1 with errno set on error.
+ */
+static int zsock_wait_stream_pkt(struct net_context *ctx, s32_t timeout,
+				 struct net_pkt **pkt)
+{
+	int res;
+
+	*pkt = NULL;
+
+	if (sock_is_eof(ctx)) {
+		return 0;
+	}
+
+	res = _k_fifo_wait_non_empty(&ctx->recv_q, timeout);
+	/* EAGAIN when timeout expired, EINTR when cancelled */
+	if (res && res != -EAGAIN && res != -EINTR) {
+		errno = -res;
+		return -1;
+	}
+
+	*pkt = k_fifo_peek_head(&ctx->recv_q);
+	if (!*pkt) {
+		/* Either timeout expired, or wait was cancelled
+		 * due to connection closure by peer.
+		 */
+		NET_DBG("NULL return from fifo");
+		if (sock_is_eof(ctx)) {
+			return 0;
+		} else {
+			errno = EAGAIN;
+			return -1;
+		}
+	}
+
+	if (!(*pkt)->frags) {
+		NET_ERR("net_pkt has empty fragments on start!");
+		*pkt = NULL;
+		errno = EAGAIN;
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Drop the head packet of a stream socket, once all its data is consumed */
+static void zsock_drop_stream_pkt(struct net_context *ctx,
+				  struct net_pkt *pkt)
+{
+	k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+	if (net_pkt_eof(pkt)) {
+		sock_mark_eof(ctx);
+	}
+
+	net_pkt_unref(pkt);
+}
+
 static inline ssize_t zsock_recv_stream(struct net_context *ctx,
 					void *buf,
 					size_t max_len,
 					int flags)
 {
 	size_t recv_len = 0;
-	s32_t timeout = K_FOREVER;
-	int res;
-
-	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
-		timeout = K_NO_WAIT;
-	}
+	s32_t timeout = zsock_timeout(ctx, flags);
 
 	do {
 		struct net_pkt *pkt;
 		struct net_buf *frag;
 		u32_t frag_len;
 
-		if (sock_is_eof(ctx)) {
-			return 0;
-		}
-
-		res = _k_fifo_wait_non_empty(&ctx->recv_q, timeout);
-		/* EAGAIN when timeout expired, EINTR when cancelled */
-		if (res && res != -EAGAIN && res != -EINTR) {
-			errno = -res;
+		if (zsock_wait_stream_pkt(ctx, timeout, &pkt) < 0) {
 			return -1;
 		}
 
-		pkt = k_fifo_peek_head(&ctx->recv_q);
 		if (!pkt) {
-			/* Either timeout expired, or wait was cancelled
-			 * due to connection closure by peer.
-			 */
-			NET_DBG("NULL return from fifo");
-			if (sock_is_eof(ctx)) {
-				return 0;
-			} else {
-				errno = EAGAIN;
-				return -1;
-			}
+			return 0;
 		}
 
 		frag = pkt->frags;
-		if (!frag) {
-			NET_ERR("net_pkt has empty fragments on start!");
-			errno = EAGAIN;
-			return -1;
-		}
-
 		frag_len = frag->len;
 		recv_len = frag_len;
 		if (recv_len > max_len) {
@@ -431,12 +686,7 @@ static inline ssize_t zsock_recv_stream(struct net_context *ctx,
 					/* Finished processing head pkt in
 					 * the fifo. Drop it from there.
 					 */
-					k_fifo_get(&ctx->recv_q, K_NO_WAIT);
-					if (net_pkt_eof(pkt)) {
-						sock_set_eof(ctx);
-					}
-
-					net_pkt_unref(pkt);
+					zsock_drop_stream_pkt(ctx, pkt);
 				}
 			}
 		}
@@ -461,7 +711,11 @@ ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 	enum net_sock_type sock_type = net_context_get_type(ctx);
 
 	if (sock_type == SOCK_DGRAM) {
-		return zsock_recv_dgram(ctx, buf, max_len, flags, src_addr, addrlen);
+		struct zsock_iovec iov = { .iov_base = buf,
+					   .iov_len = max_len };
+
+		return zsock_recv_dgram(ctx, &iov, 1, NULL, flags, src_addr,
+					addrlen);
 	} else if (sock_type == SOCK_STREAM) {
 		return zsock_recv_stream(ctx, buf, max_len, flags);
 	} else {
@@ -471,6 +725,174 @@ ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return 0;
 }
 
+ssize_t zsock_recvmsg(int sock, struct zsock_msghdr *msg, int flags)
+{
+	struct net_context *ctx = INT_TO_POINTER(sock);
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	ssize_t recv_len = 0;
+	int i;
+
+	msg->msg_flags = 0;
+
+	if (sock_type == SOCK_DGRAM) {
+		return zsock_recv_dgram(ctx, msg->msg_iov, msg->msg_iovlen,
+					&msg->msg_flags, flags, msg->msg_name,
+					msg->msg_name ? &msg->msg_namelen :
+					NULL);
+	}
+
+	__ASSERT(sock_type == SOCK_STREAM, "Unknown socket type");
+
+	/* Only the first buffer waits for data, the next ones get what
+	 * is already received. A peek does not go past the first buffer,
+	 * as it does not consume the data.
+	 */
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		struct zsock_iovec *iov = &msg->msg_iov[i];
+		ssize_t len;
+
+		if (iov->iov_len == 0) {
+			continue;
+		}
+
+		len = zsock_recv_stream(ctx, iov->iov_base, iov->iov_len,
+					recv_len ? flags | ZSOCK_MSG_DONTWAIT :
+					flags);
+		if (len < 0) {
+			return recv_len ? recv_len : -1;
+		}
+
+		recv_len += len;
+		if ((size_t)len < iov->iov_len || (flags & ZSOCK_MSG_PEEK)) {
+			break;
+		}
+	}
+
+	return recv_len;
+}
+
+static ssize_t zsock_recv_dgram_zc(struct net_context *ctx,
+				   struct net_buf **frags, int flags,
+				   struct sockaddr *src_addr,
+				   socklen_t *addrlen)
+{
+	struct net_pkt *pkt;
+	struct net_buf *frag;
+	u8_t *appdata;
+	size_t len;
+
+	pkt = zsock_recv_dgram_pkt(ctx, flags, src_addr, addrlen);
+	if (!pkt) {
+		return -1;
+	}
+
+	appdata = net_pkt_appdata(pkt);
+	len = net_pkt_appdatalen(pkt);
+
+	/* Drop the fragments of the headers, and the headers at the
+	 * start of the first fragment with data.
+	 */
+	frag = pkt->frags;
+	while (len && frag && !(appdata >= frag->data &&
+				appdata < frag->data + frag->len)) {
+		frag = net_pkt_frag_del(pkt, NULL, frag);
+	}
+
+	if (!len || !frag) {
+		net_pkt_unref(pkt);
+		*frags = NULL;
+		return 0;
+	}
+
+	net_buf_pull(frag, appdata - frag->data);
+
+	*frags = pkt->frags;
+	pkt->frags = NULL;
+	net_pkt_unref(pkt);
+
+	return len;
+}
+
+static ssize_t zsock_recv_stream_zc(struct net_context *ctx,
+				    struct net_buf **frags, int flags)
+{
+	s32_t timeout = zsock_timeout(ctx, flags);
+	struct net_pkt *pkt;
+	size_t len;
+
+	do {
+		if (zsock_wait_stream_pkt(ctx, timeout, &pkt) < 0) {
+			return -1;
+		}
+
+		if (!pkt) {
+			*frags = NULL;
+			return 0;
+		}
+
+		/* The whole head packet is consumed, its headers were
+		 * already pulled when it was received.
+		 */
+		*frags = pkt->frags;
+		pkt->frags = NULL;
+		zsock_drop_stream_pkt(ctx, pkt);
+
+		len = net_buf_frags_len(*frags);
+		if (!len) {
+			net_buf_unref(*frags);
+		}
+	} while (len == 0);
+
+	/* Remember the length handed over in the first fragment, the
+	 * receive window is reopened by that much at release whatever
+	 * the caller did to the fragments in between.
+	 */
+	BUILD_ASSERT(CONFIG_NET_BUF_USER_DATA_SIZE >= sizeof(u32_t));
+	*(u32_t *)net_buf_user_data(*frags) = len;
+
+	return len;
+}
+
+ssize_t zsock_recv_zc(int sock, struct net_buf **frags, int flags,
+		      struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	struct net_context *ctx = INT_TO_POINTER(sock);
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+
+	if (flags & ZSOCK_MSG_PEEK) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sock_type == SOCK_DGRAM) {
+		return zsock_recv_dgram_zc(ctx, frags, flags, src_addr,
+					   addrlen);
+	} else if (sock_type == SOCK_STREAM) {
+		return zsock_recv_stream_zc(ctx, frags, flags);
+	} else {
+		__ASSERT(0, "Unknown socket type");
+	}
+
+	return 0;
+}
+
+void zsock_recv_zc_release(int sock, struct net_buf *frags)
+{
+	struct net_context *ctx = INT_TO_POINTER(sock);
+
+	if (!frags) {
+		return;
+	}
+
+	/* The receive window is opened only once the buffers are free */
+	if (net_context_get_type(ctx) == SOCK_STREAM) {
+		net_context_update_recv_wnd(ctx,
+					    *(u32_t *)net_buf_user_data(frags));
+	}
+
+	net_buf_unref(frags);
+}
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -497,6 +919,74 @@ int zsock_fcntl(int sock, int cmd, int flags)
 	}
 }
 
+static int sockopt_tcp_option(struct net_context *ctx, int level,
+			      int optname)
+{
+	if (level != IPPROTO_TCP ||
+	    net_context_get_ip_proto(ctx) != IPPROTO_TCP) {
+		return -ENOPROTOOPT;
+	}
+
+	switch (optname) {
+	case ZSOCK_TCP_NODELAY:
+		return NET_OPT_TCP_NODELAY;
+	case ZSOCK_TCP_CORK:
+		return NET_OPT_TCP_CORK;
+	default:
+		return -ENOPROTOOPT;
+	}
+}
+
+int zsock_setsockopt(int sock, int level, int optname,
+		     const void *optval, socklen_t optlen)
+{
+	struct net_context *ctx = INT_TO_POINTER(sock);
+	int option;
+
+	option = sockopt_tcp_option(ctx, level, optname);
+	SET_ERRNO(option);
+
+	if (!optval || optlen != sizeof(int)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	SET_ERRNO(net_context_set_option(ctx, option, optval, optlen));
+
+	return 0;
+}
+
+int zsock_getsockopt(int sock, int level, int optname,
+		     void *optval, socklen_t *optlen)
+{
+	struct net_context *ctx = INT_TO_POINTER(sock);
+	size_t len = sizeof(int);
+	int option;
+
+	option = sockopt_tcp_option(ctx, level, optname);
+	SET_ERRNO(option);
+
+	if (!optval || !optlen || *optlen < sizeof(int)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	SET_ERRNO(net_context_get_option(ctx, option, optval, &len));
+	*optlen = len;
+
+	return 0;
+}
+
+int zsock_poll_event_init(struct k_poll_event *event, int sock)
+{
+	struct net_context *ctx = INT_TO_POINTER(sock);
+
+	k_poll_event_init(event, K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &ctx->recv_q);
+
+	return 0;
+}
+
 int zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
 	int i;
@@ -518,17 +1008,12 @@ int zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
 		}
 
 		if (pfd->events & ZSOCK_POLLIN) {
-			struct net_context *ctx = INT_TO_POINTER(pfd->fd);
-
 			if (pev == pev_end) {
 				errno = ENOMEM;
 				return -1;
 			}
 
-			pev->obj = &ctx->recv_q;
-			pev->type = K_POLL_TYPE_FIFO_DATA_AVAILABLE;
-			pev->mode = K_POLL_MODE_NOTIFY_ONLY;
-			pev->state = K_POLL_STATE_NOT_READY;
+			zsock_poll_event_init(pev, pfd->fd);
 			pev++;
 		}
 	}
@@ -569,6 +1054,323 @@ int zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
 	return ret;
 }
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+
+/* Poll events of a registration, identified by their tag */
+enum {
+	EPOLL_EVENT_IN,
+	EPOLL_EVENT_HUP,
+	EPOLL_EVENT_OUT,
+	EPOLL_EVENT_NUM,
+};
+
+/* Number of ready poll events collected by a wait */
+#define EPOLL_WAIT_MAX 16
+
+struct zsock_epoll_reg {
+	sys_snode_t node;
+	int sock;
+	struct zsock_epoll_event event;
+	struct k_poll_event poll_events[EPOLL_EVENT_NUM];
+};
+
+struct zsock_epoll {
+	struct k_poll_set set;
+	sys_slist_t regs;
+	bool used;
+};
+
+static struct zsock_epoll epolls[CONFIG_NET_SOCKETS_EPOLL_MAX];
+
+K_MEM_SLAB_DEFINE(epoll_regs, sizeof(struct zsock_epoll_reg),
+		  CONFIG_NET_SOCKETS_EPOLL_REGS_MAX, 4);
+
+/* As sockets are always writable for now, the EPOLLOUT events are
+ * registered on a signal which is always raised.
+ */
+static struct k_poll_signal epoll_writable = {
+	.poll_events = SYS_DLIST_STATIC_INIT(&epoll_writable.poll_events),
+	.signaled = 1,
+};
+
+static bool zsock_is_epoll(int fd)
+{
+	struct zsock_epoll *ep = INT_TO_POINTER(fd);
+
+	return ep >= epolls && ep < epolls + ARRAY_SIZE(epolls);
+}
+
+static void epoll_reg_add(struct zsock_epoll *ep, struct zsock_epoll_reg *reg)
+{
+	struct net_context *ctx = INT_TO_POINTER(reg->sock);
+	struct k_poll_event *pev = reg->poll_events;
+	int i;
+
+	zsock_poll_event_init(&pev[EPOLL_EVENT_IN], reg->sock);
+	k_poll_event_init(&pev[EPOLL_EVENT_HUP], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &ctx->eof_signal);
+	k_poll_event_init(&pev[EPOLL_EVENT_OUT], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &epoll_writable);
+
+	for (i = 0; i < EPOLL_EVENT_NUM; i++) {
+		pev[i].tag = i;
+	}
+
+	if (reg->event.events & ZSOCK_EPOLLIN) {
+		k_poll_set_add(&ep->set, &pev[EPOLL_EVENT_IN]);
+	}
+
+	/* The hang-up is reported whether requested or not */
+	k_poll_set_add(&ep->set, &pev[EPOLL_EVENT_HUP]);
+
+	if (reg->event.events & ZSOCK_EPOLLOUT) {
+		k_poll_set_add(&ep->set, &pev[EPOLL_EVENT_OUT]);
+	}
+}
+
+static void epoll_reg_remove(struct zsock_epoll *ep,
+			     struct zsock_epoll_reg *reg)
+{
+	int i;
+
+	/* The events not requested are not in the set, and are skipped */
+	for (i = 0; i < EPOLL_EVENT_NUM; i++) {
+		(void)k_poll_set_remove(&ep->set, &reg->poll_events[i]);
+	}
+}
+
+static struct zsock_epoll_reg *epoll_reg_find(struct zsock_epoll *ep,
+					      int sock, sys_snode_t **prev)
+{
+	struct zsock_epoll_reg *reg;
+
+	*prev = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ep->regs, reg, node) {
+		if (reg->sock == sock) {
+			return reg;
+		}
+
+		*prev = &reg->node;
+	}
+
+	return NULL;
+}
+
+static void epoll_reg_free(struct zsock_epoll *ep,
+			   struct zsock_epoll_reg *reg, sys_snode_t *prev)
+{
+	epoll_reg_remove(ep, reg);
+	sys_slist_remove(&ep->regs, prev, &reg->node);
+	k_mem_slab_free(&epoll_regs, (void **)&reg);
+}
+
+int zsock_epoll_create(int size)
+{
+	unsigned int key;
+	int i;
+
+	if (size <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	key = irq_lock();
+
+	for (i = 0; i < ARRAY_SIZE(epolls); i++) {
+		if (!epolls[i].used) {
+			epolls[i].used = true;
+			break;
+		}
+	}
+
+	irq_unlock(key);
+
+	if (i == ARRAY_SIZE(epolls)) {
+		errno = ENFILE;
+		return -1;
+	}
+
+	k_poll_set_init(&epolls[i].set);
+	sys_slist_init(&epolls[i].regs);
+
+	return POINTER_TO_INT(&epolls[i]);
+}
+
+static int zsock_epoll_close(int epfd)
+{
+	struct zsock_epoll *ep = INT_TO_POINTER(epfd);
+	sys_snode_t *node;
+
+	while ((node = sys_slist_peek_head(&ep->regs)) != NULL) {
+		epoll_reg_free(ep, CONTAINER_OF(node, struct zsock_epoll_reg,
+						node), NULL);
+	}
+
+	ep->used = false;
+
+	return 0;
+}
+
+/* Remove a socket being closed from the epoll instances */
+static void zsock_epoll_remove_sock(int sock)
+{
+	struct zsock_epoll_reg *reg;
+	sys_snode_t *prev;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(epolls); i++) {
+		if (!epolls[i].used) {
+			continue;
+		}
+
+		reg = epoll_reg_find(&epolls[i], sock, &prev);
+		if (reg) {
+			epoll_reg_free(&epolls[i], reg, prev);
+		}
+	}
+}
+
+int zsock_epoll_ctl(int epfd, int op, int sock,
+		    struct zsock_epoll_event *event)
+{
+	struct zsock_epoll *ep = INT_TO_POINTER(epfd);
+	struct zsock_epoll_reg *reg;
+	sys_snode_t *prev;
+
+	if (!zsock_is_epoll(epfd) || !ep->used || zsock_is_epoll(sock)) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL && !event) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	reg = epoll_reg_find(ep, sock, &prev);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		if (reg) {
+			errno = EEXIST;
+			return -1;
+		}
+
+		if (k_mem_slab_alloc(&epoll_regs, (void **)&reg, K_NO_WAIT)) {
+			errno = ENOMEM;
+			return -1;
+		}
+
+		reg->sock = sock;
+		reg->event = *event;
+		sys_slist_append(&ep->regs, &reg->node);
+		epoll_reg_add(ep, reg);
+		return 0;
+	case ZSOCK_EPOLL_CTL_MOD:
+		if (!reg) {
+			errno = ENOENT;
+			return -1;
+		}
+
+		epoll_reg_remove(ep, reg);
+		reg->event = *event;
+		epoll_reg_add(ep, reg);
+		return 0;
+	case ZSOCK_EPOLL_CTL_DEL:
+		if (!reg) {
+			errno = ENOENT;
+			return -1;
+		}
+
+		epoll_reg_free(ep, reg, prev);
+		return 0;
+	default:
+		errno = EINVAL;
+		return -1;
+	}
+}
+
+int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+		     int maxevents, int timeout)
+{
+	struct zsock_epoll *ep = INT_TO_POINTER(epfd);
+	struct k_poll_event *ready[EPOLL_WAIT_MAX];
+	struct zsock_epoll_reg *regs[EPOLL_WAIT_MAX];
+	struct zsock_epoll_reg *reg;
+	u32_t mask;
+	int n, i, j, ret = 0;
+
+	if (!zsock_is_epoll(epfd) || !ep->used) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (timeout < 0) {
+		timeout = K_FOREVER;
+	}
+
+	/* The queue of a socket is cancelled when the peer closes it, its
+	 * hang-up event is then ready.
+	 */
+	do {
+		n = k_poll_set_wait(&ep->set, ready,
+				    min(maxevents, (int)ARRAY_SIZE(ready)),
+				    timeout);
+	} while (n == -EINTR);
+
+	if (n == -EAGAIN) {
+		return 0;
+	} else if (n < 0) {
+		errno = -n;
+		return -1;
+	}
+
+	/* Merge the ready poll events of each socket */
+	for (i = 0; i < n; i++) {
+		reg = CONTAINER_OF(ready[i] - ready[i]->tag,
+				   struct zsock_epoll_reg, poll_events);
+
+		switch (ready[i]->tag) {
+		case EPOLL_EVENT_IN:
+			mask = ZSOCK_EPOLLIN;
+			break;
+		case EPOLL_EVENT_HUP:
+			/* Reading does not block once the peer closed */
+			mask = ZSOCK_EPOLLHUP |
+			       (reg->event.events & ZSOCK_EPOLLIN);
+			break;
+		default:
+			mask = ZSOCK_EPOLLOUT;
+			break;
+		}
+
+		for (j = 0; j < ret; j++) {
+			if (regs[j] == reg) {
+				break;
+			}
+		}
+
+		if (j == ret) {
+			regs[ret] = reg;
+			events[ret].events = 0;
+			events[ret].data = reg->event.data;
+			ret++;
+		}
+
+		events[j].events |= mask;
+	}
+
+	return ret;
+}
+
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
+
 int zsock_inet_pton(sa_family_t family, const char *src, void *dst)
 {
 	if (net_addr_pton(family, src, dst) == 0) {
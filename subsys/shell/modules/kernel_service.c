@@ -10,6 +10,7 @@
 #include <debug/object_tracing.h>
 #include <misc/reboot.h>
 #include <misc/stack.h>
+#include <stdlib.h>
 #include <string.h>
 
 #define SHELL_KERNEL "kernel"
@@ -86,6 +87,170 @@ static int shell_cmd_stack(int argc, char *argv[])
 }
 #endif
 
+#if defined(CONFIG_THREAD_RUNTIME_STATS) && defined(CONFIG_THREAD_MONITOR)
+/* threads sampled by "kernel top", the others are shown from creation */
+#define TOP_THREADS_MAX 32
+
+#define TOP_WINDOW_DEFAULT 1000
+
+struct top_sample {
+	const struct k_thread *thread;
+	u64_t cycles;
+};
+
+static struct top_sample top_samples[TOP_THREADS_MAX];
+static int top_count;
+
+static u32_t permille(u64_t part, u64_t total)
+{
+	return total ? (u32_t)(part * 1000 / total) : 0;
+}
+
+static void shell_top_sample(const struct k_thread *thread, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (top_count < TOP_THREADS_MAX) {
+		top_samples[top_count].thread = thread;
+		top_samples[top_count].cycles =
+			k_thread_runtime_get((k_tid_t)thread);
+		top_count++;
+	}
+}
+
+/* The 32 bit cycle counter wraps on long windows: add back the wraps
+ * the uptime tells of.
+ */
+static u64_t top_window(u32_t start, s64_t uptime)
+{
+	u32_t cycles = k_cycle_get_32() - start;
+	u64_t elapsed = (u64_t)k_uptime_delta(&uptime) *
+			sys_clock_hw_cycles_per_sec / MSEC_PER_SEC;
+
+	return cycles + ((elapsed - cycles + (1ULL << 31)) & ~0xffffffffULL);
+}
+
+static void shell_top_dump(const struct k_thread *thread, void *user_data)
+{
+	u64_t cycles = k_thread_runtime_get((k_tid_t)thread);
+	u64_t window = *(u64_t *)user_data;
+	u32_t cpu;
+	int i;
+
+	for (i = 0; i < top_count; i++) {
+		if (top_samples[i].thread == thread) {
+			cycles -= top_samples[i].cycles;
+			break;
+		}
+	}
+
+	cpu = permille(cycles, window);
+
+	printk("%s%p %5d %3u.%u%%", (thread == k_current_get()) ? "*" : " ",
+	       thread, thread->base.prio, cpu / 10, cpu % 10);
+
+#if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO)
+	{
+		size_t size = thread->stack_info.size;
+		size_t unused;
+
+		k_thread_stack_space_get(thread, &unused);
+		printk("  %zu / %zu\n", size - unused, size);
+	}
+#else
+	printk("\n");
+#endif
+}
+
+static int shell_cmd_top(int argc, char *argv[])
+{
+	s32_t duration = TOP_WINDOW_DEFAULT;
+	u64_t idle, window;
+	s64_t uptime;
+	u32_t start, cpu;
+
+	if (argc > 2) {
+		return -EINVAL;
+	}
+
+	if (argc == 2) {
+		duration = strtol(argv[1], NULL, 10);
+		if (duration <= 0) {
+			return -EINVAL;
+		}
+	}
+
+	top_count = 0;
+	idle = k_cpu_idle_runtime_get();
+	uptime = k_uptime_get();
+	start = k_cycle_get_32();
+	k_thread_foreach(shell_top_sample, NULL);
+
+	k_sleep(duration);
+
+	window = top_window(start, uptime);
+	idle = k_cpu_idle_runtime_get() - idle;
+
+	/* The idle time is summed over the CPUs */
+	cpu = permille(idle, window * CONFIG_MP_NUM_CPUS);
+
+	printk("CPU usage over %d ms, idle %u.%u%%:\n", duration, cpu / 10,
+	       cpu % 10);
+	printk(" thread      prio   cpu  stack used / size\n");
+	k_thread_foreach(shell_top_dump, &window);
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_MEM_POOL_STATS) || defined(CONFIG_MEM_SLAB_STATS)
+static int shell_cmd_mem(int argc, char *argv[])
+{
+#if defined(CONFIG_MEM_POOL_STATS)
+	extern struct k_mem_pool _k_mem_pool_list_start[];
+	extern struct k_mem_pool _k_mem_pool_list_end[];
+	struct sys_mem_pool_stats stats;
+	struct k_mem_pool *pool;
+#endif
+#if defined(CONFIG_MEM_SLAB_STATS)
+	extern struct k_mem_slab _k_mem_slab_list_start[];
+	extern struct k_mem_slab _k_mem_slab_list_end[];
+	struct k_mem_slab *slab;
+#endif
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_MEM_POOL_STATS)
+	printk("Memory pools:\n");
+	for (pool = _k_mem_pool_list_start; pool < _k_mem_pool_list_end;
+	     pool++) {
+		u32_t size = pool->base.max_sz * pool->base.n_max;
+
+		k_mem_pool_stats_get(pool, &stats);
+		printk(" %p: used %u peak %u of %u bytes, largest free %u,"
+		       " failures %u\n", pool, stats.used_bytes,
+		       stats.peak_bytes, size, stats.max_free_block,
+		       stats.failures);
+	}
+#endif
+
+#if defined(CONFIG_MEM_SLAB_STATS)
+	printk("Memory slabs:\n");
+	for (slab = _k_mem_slab_list_start; slab < _k_mem_slab_list_end;
+	     slab++) {
+		printk(" %p: used %u peak %u of %u blocks of %u bytes,"
+		       " failures %u\n", slab, k_mem_slab_num_used_get(slab),
+		       k_mem_slab_max_used_get(slab), slab->num_blocks,
+		       (u32_t)slab->block_size,
+		       k_mem_slab_num_failures_get(slab));
+	}
+#endif
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_REBOOT)
 static int shell_cmd_reboot(int argc, char *argv[])
 {
@@ -119,6 +284,12 @@ struct shell_cmd kernel_commands[] = {
 				&& defined(CONFIG_THREAD_STACK_INFO)
 	{ "stacks", shell_cmd_stack, "show system stacks" },
 #endif
+#if defined(CONFIG_THREAD_RUNTIME_STATS) && defined(CONFIG_THREAD_MONITOR)
+	{ "top", shell_cmd_top, "[duration in ms], show thread CPU usage" },
+#endif
+#if defined(CONFIG_MEM_POOL_STATS) || defined(CONFIG_MEM_SLAB_STATS)
+	{ "mem", shell_cmd_mem, "show memory pool and slab usage" },
+#endif
 #if defined(CONFIG_REBOOT)
 	{ "reboot", shell_cmd_reboot, "<warm cold>" },
 #endif
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Kernel event tracing: the hooks of the kernel write fixed size events to
+ * a lock-free ring buffer, and a thread of the lowest priority streams
+ * them to the backend, after a header describing the stream.
+ *
+ * Recording an event only takes a claim and a commit in the ring buffer:
+ * its cost is bounded whatever the backend, which is never called from
+ * the hooks.  As the buffer size is a multiple of the event size, events
+ * never wrap around the end of the buffer.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <atomic.h>
+#include <ring_buffer.h>
+#include <tracing.h>
+
+#include "tracing_backend.h"
+
+#define BUF_SIZE CONFIG_TRACING_BUFFER_SIZE
+
+BUILD_ASSERT_MSG((BUF_SIZE & (BUF_SIZE - 1)) == 0 &&
+		 BUF_SIZE >= sizeof(struct sys_trace_event),
+		 "trace buffer size must be a power of 2, of at least 16 bytes");
+
+static u8_t __aligned(4) trace_buf[BUF_SIZE];
+
+static struct byte_ring trace_ring = {
+	.size = BUF_SIZE,
+	.buf = trace_buf,
+};
+
+/* events dropped, in total and since the last drop report */
+static atomic_t dropped_total;
+static atomic_t dropped;
+
+u32_t sys_trace_dropped_get(void)
+{
+	return atomic_get(&dropped_total);
+}
+
+static inline void event_fill(struct sys_trace_event *ev, u8_t id,
+			      u16_t data, const void *arg)
+{
+	ev->timestamp = k_cycle_get_32();
+	ev->id = id;
+#ifdef CONFIG_SMP
+	ev->cpu = _arch_curr_cpu()->id;
+#else
+	ev->cpu = 0;
+#endif
+	ev->data = data;
+	ev->thread = (u32_t)(uintptr_t)_current;
+	ev->arg = (u32_t)(uintptr_t)arg;
+}
+
+void _sys_trace_event(u8_t id, u16_t data, const void *arg)
+{
+	struct sys_trace_event *ev;
+
+	if (!sys_byte_ring_mpsc_put_claim(&trace_ring, (u8_t **)&ev,
+					  sizeof(*ev))) {
+		atomic_inc(&dropped_total);
+		atomic_inc(&dropped);
+		return;
+	}
+
+	event_fill(ev, id, data, arg);
+
+	sys_byte_ring_mpsc_put_commit(&trace_ring);
+}
+
+void _sys_trace_thread_switch(struct k_thread *from, struct k_thread *to)
+{
+	if (from == to) {
+		return;
+	}
+
+	_sys_trace_event(SYS_TRACE_ID_THREAD_SWITCHED_OUT, 0, from);
+	_sys_trace_event(SYS_TRACE_ID_THREAD_SWITCHED_IN, 0, to);
+}
+
+#if !defined(CONFIG_SMP)
+/* Called by the context switch code of the architecture, before it
+ * switches to the thread at the head of the ready queue
+ */
+void _sys_trace_context_switch(void)
+{
+	_sys_trace_thread_switch(_current, _kernel.ready_q.cache);
+}
+#endif
+
+void _sys_trace_isr_enter(int irq)
+{
+	_sys_trace_event(SYS_TRACE_ID_ISR_ENTER, irq, NULL);
+}
+
+void _sys_trace_isr_exit(void)
+{
+	_sys_trace_event(SYS_TRACE_ID_ISR_EXIT, 0, NULL);
+}
+
+static void header_output(void)
+{
+	struct sys_trace_header hdr = {
+		.magic = SYS_TRACE_MAGIC,
+		.version = SYS_TRACE_VERSION,
+		.event_size = sizeof(struct sys_trace_event),
+		.cycles_per_sec = sys_clock_hw_cycles_per_sec,
+	};
+
+	tracing_backend_output((u8_t *)&hdr, sizeof(hdr));
+}
+
+/* Report the events dropped since the last report, in stream order */
+static void dropped_output(void)
+{
+	struct sys_trace_event ev;
+	u32_t n = atomic_set(&dropped, 0);
+
+	if (n) {
+		event_fill(&ev, SYS_TRACE_ID_DROPPED, 0, (void *)(uintptr_t)n);
+		tracing_backend_output((u8_t *)&ev, sizeof(ev));
+	}
+}
+
+static void trace_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	tracing_backend_init();
+	header_output();
+
+	while (1) {
+		u8_t *data;
+		u32_t n;
+
+		while ((n = sys_byte_ring_peek(&trace_ring, &data, BUF_SIZE))) {
+			tracing_backend_output(data, n);
+			sys_byte_ring_consume(&trace_ring, n);
+		}
+
+		dropped_output();
+
+		k_sleep(CONFIG_TRACING_FLUSH_INTERVAL);
+	}
+}
+
+K_THREAD_DEFINE(sys_trace_thread, CONFIG_TRACING_THREAD_STACK_SIZE,
+		trace_thread, NULL, NULL, NULL,
+		K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __TRACING_BACKEND_H__
+#define __TRACING_BACKEND_H__
+
+#include <zephyr/types.h>
+
+/* Prepare the backend, called by the tracing thread before any output */
+void tracing_backend_init(void);
+
+/* Output @a len bytes of the trace stream */
+void tracing_backend_output(const u8_t *data, u32_t len);
+
+#endif /* __TRACING_BACKEND_H__ */
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <kernel.h>
+#include "posix_soc_if.h"
+
+#include "tracing_backend.h"
+
+static FILE *trace_file;
+
+void tracing_backend_init(void)
+{
+	trace_file = fopen(CONFIG_TRACING_BACKEND_POSIX_FILE, "wb");
+	if (!trace_file) {
+		posix_print_warning("Could not open trace file %s\n",
+				    CONFIG_TRACING_BACKEND_POSIX_FILE);
+	}
+}
+
+void tracing_backend_output(const u8_t *data, u32_t len)
+{
+	if (!trace_file) {
+		return;
+	}
+
+	fwrite(data, 1, len, trace_file);
+	fflush(trace_file);
+}
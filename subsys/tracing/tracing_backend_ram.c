@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <string.h>
+#include <tracing.h>
+
+#include "tracing_backend.h"
+
+u8_t tracing_ram_buf[CONFIG_TRACING_BACKEND_RAM_SIZE];
+volatile u32_t tracing_ram_len;
+
+void tracing_backend_init(void)
+{
+	tracing_ram_len = 0;
+}
+
+void tracing_backend_output(const u8_t *data, u32_t len)
+{
+	/* Keep whole events only, the stream ends when the buffer is full */
+	if (len > sizeof(tracing_ram_buf) - tracing_ram_len) {
+		len = sizeof(tracing_ram_buf) - tracing_ram_len;
+		len -= len % sizeof(struct sys_trace_event);
+	}
+
+	memcpy(tracing_ram_buf + tracing_ram_len, data, len);
+	tracing_ram_len += len;
+}
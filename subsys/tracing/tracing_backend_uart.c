@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <device.h>
+#include <uart.h>
+#include <misc/__assert.h>
+
+#include "tracing_backend.h"
+
+static struct device *uart_dev;
+
+void tracing_backend_init(void)
+{
+	uart_dev = device_get_binding(CONFIG_TRACING_BACKEND_UART_DEV_NAME);
+	__ASSERT(uart_dev, "trace UART device not found");
+}
+
+void tracing_backend_output(const u8_t *data, u32_t len)
+{
+	if (!uart_dev) {
+		return;
+	}
+
+	while (len--) {
+		uart_poll_out(uart_dev, *data++);
+	}
+}
@@ -0,0 +1,145 @@
+/* claim_b.c */
+
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "master.h"
+
+#ifdef CLAIM_BENCH
+
+/* size of the messages and of the pipe transfers measured */
+#define CLAIM_MSG_SIZE 256
+#define CLAIM_PIPE_SIZE 1024
+
+static volatile u32_t claim_sum;
+
+/* stand for the production of the data sent */
+static void produce(void *data, size_t size, int i)
+{
+	memset(data, i, size);
+}
+
+/* stand for the consumption of the data received */
+static void consume(const void *data, size_t size)
+{
+	const u32_t *word = data;
+	u32_t sum = 0;
+
+	for (; size >= sizeof(*word); size -= sizeof(*word)) {
+		sum += *word++;
+	}
+	claim_sum += sum;
+}
+
+/**
+ *
+ * @brief Message queue transfers with copies or claims
+ *
+ * @return N/A
+ */
+static void claim_msgq_test(void)
+{
+	u32_t et; /* elapsed time */
+	void *msg;
+	int i;
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_CLAIM_RUNS; i++) {
+		produce(data_bench, CLAIM_MSG_SIZE, i);
+		k_msgq_put(&DEMOQX256, data_bench, K_FOREVER);
+		k_msgq_get(&DEMOQX256, data_bench, K_FOREVER);
+		consume(data_bench, CLAIM_MSG_SIZE);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT,
+		"enqueue and dequeue 256 bytes msg in FIFO, copied",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_CLAIM_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_CLAIM_RUNS; i++) {
+		k_msgq_put_claim(&DEMOQX256, &msg, K_FOREVER);
+		produce(msg, CLAIM_MSG_SIZE, i);
+		k_msgq_put_commit(&DEMOQX256);
+		k_msgq_get_claim(&DEMOQX256, &msg, K_FOREVER);
+		consume(msg, CLAIM_MSG_SIZE);
+		k_msgq_get_commit(&DEMOQX256);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT,
+		"enqueue and dequeue 256 bytes msg in FIFO, claimed",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_CLAIM_RUNS));
+}
+
+/**
+ *
+ * @brief Pipe transfers with copies or claims
+ *
+ * @return N/A
+ */
+static void claim_pipe_test(void)
+{
+	u32_t et; /* elapsed time */
+	size_t bytes, size;
+	void *data;
+	int i;
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_CLAIM_RUNS; i++) {
+		produce(data_bench, CLAIM_PIPE_SIZE, i);
+		k_pipe_put(&PIPE_BIGBUFF, data_bench, CLAIM_PIPE_SIZE, &bytes,
+			   CLAIM_PIPE_SIZE, K_FOREVER);
+		k_pipe_get(&PIPE_BIGBUFF, data_bench, CLAIM_PIPE_SIZE, &bytes,
+			   CLAIM_PIPE_SIZE, K_FOREVER);
+		consume(data_bench, CLAIM_PIPE_SIZE);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT,
+		"put and get 1024 bytes in pipe, copied",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_CLAIM_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_CLAIM_RUNS; i++) {
+		/* the pipe is empty, the space claimed is contiguous */
+		size = CLAIM_PIPE_SIZE;
+		k_pipe_put_claim(&PIPE_BIGBUFF, &data, &size, K_FOREVER);
+		produce(data, size, i);
+		k_pipe_put_commit(&PIPE_BIGBUFF, size);
+		size = CLAIM_PIPE_SIZE;
+		k_pipe_get_claim(&PIPE_BIGBUFF, &data, &size, K_FOREVER);
+		consume(data, size);
+		k_pipe_get_commit(&PIPE_BIGBUFF, size);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT,
+		"put and get 1024 bytes in pipe, claimed",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_CLAIM_RUNS));
+}
+
+/**
+ *
+ * @brief Zero-copy transfer speed test
+ *
+ * Compare transfers copying the data to and from the message queue and pipe
+ * buffers with transfers claiming the buffers in place.
+ *
+ * @return N/A
+ */
+void claim_test(void)
+{
+	claim_msgq_test();
+	claim_pipe_test();
+	PRINT_STRING(dashline, output_file);
+}
+
+#endif /* CLAIM_BENCH */
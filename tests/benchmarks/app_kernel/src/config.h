@@ -36,4 +36,7 @@
 /* flag for performing the Event benchmark */
 #define EVENT_BENCH
 
+/* flag for performing the zero-copy claim/commit benchmark */
+#define CLAIM_BENCH
+
 #endif /* _CONFIG_H */
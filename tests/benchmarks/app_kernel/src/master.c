@@ -41,6 +41,7 @@ K_THREAD_DEFINE(RECVTASK, 1024, recvtask, NULL, NULL, NULL, 5, 0, K_NO_WAIT);
 
 K_MSGQ_DEFINE(DEMOQX1, 1, 500, 4);
 K_MSGQ_DEFINE(DEMOQX4, 4, 500, 4);
+K_MSGQ_DEFINE(DEMOQX256, 256, 4, 4);
 K_MSGQ_DEFINE(MB_COMM, 12, 1, 4);
 K_MSGQ_DEFINE(CH_COMM, 12, 1, 4);
 
@@ -141,6 +142,7 @@ void main(void)
 		event_test();
 		mailbox_test();
 		pipe_test();
+		claim_test();
 		PRINT_STRING("|         END OF TESTS                     "
 					 "                                   |\n",
 					 output_file);
@@ -48,6 +48,7 @@
 #define NR_OF_EVENT_RUNS  1000
 #define NR_OF_MBOX_RUNS 128
 #define NR_OF_PIPE_RUNS 256
+#define NR_OF_CLAIM_RUNS 256
 /* #define SEMA_WAIT_TIME (5 * sys_clock_ticks_per_sec) */
 #define SEMA_WAIT_TIME (5000)
 /* global data */
@@ -132,6 +133,12 @@ extern void event_test(void);
 #define event_test dummy_test
 #endif
 
+#ifdef CLAIM_BENCH
+extern void claim_test(void);
+#else
+#define claim_test dummy_test
+#endif
+
 /* kernel objects needed for benchmarking */
 extern struct k_mutex DEMO_MUTEX;
 
@@ -144,6 +151,7 @@ extern struct k_sem STARTRCV;
 
 extern struct k_msgq DEMOQX1;
 extern struct k_msgq DEMOQX4;
+extern struct k_msgq DEMOQX256;
 extern struct k_msgq MB_COMM;
 extern struct k_msgq CH_COMM;
 
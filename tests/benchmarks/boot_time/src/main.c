@@ -17,6 +17,7 @@
  */
 
 #include <zephyr.h>
+#include <device.h>
 
 #include <tc_util.h>
 
@@ -25,6 +26,31 @@ extern u64_t __start_time_stamp;    /* timestamp when kernel begins executing */
 extern u64_t __main_time_stamp;     /* timestamp when main() begins executing */
 extern u64_t __idle_time_stamp;     /* timestamp when CPU went idle */
 
+#ifdef CONFIG_DEVICE_INIT_STATS
+static void device_init_report(int freq)
+{
+	struct device *devices;
+	int count, i;
+
+	device_list_get(&devices, &count);
+
+	TC_PRINT("Device initialization:\n");
+	for (i = 0; i < count; i++) {
+		struct device_config *config = devices[i].config;
+		u32_t cycles = devices[i].init_cycles;
+
+		/* SYS_INIT() functions have no name */
+		if (config->name && config->name[0]) {
+			TC_PRINT("%-14s: %u cycles, %u us\n", config->name,
+				 cycles, cycles / freq);
+		} else {
+			TC_PRINT("%-14p: %u cycles, %u us\n", config->init,
+				 cycles, cycles / freq);
+		}
+	}
+}
+#endif
+
 void main(void)
 {
 	u64_t task_time_stamp;      /* timestamp at beginning of first task  */
@@ -72,6 +98,10 @@ void main(void)
 		 (u32_t)(s_idle_time_stamp & 0xFFFFFFFFULL),
 		 (u32_t)  (idle_us  & 0xFFFFFFFFULL));
 
+#ifdef CONFIG_DEVICE_INIT_STATS
+	device_init_report(freq);
+#endif
+
 	TC_PRINT("Boot Time Measurement finished\n");
 
 	/* for sanity regression test utility. */
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Measure worst case timeout queue insertion time
+ *
+ * This file contains the test that measures how long interrupts stay locked
+ * when arming and cancelling a timeout, depending on the number of timeouts
+ * already armed in the kernel timeout queue. A set of timers is started
+ * first, then a probe timer expiring after all of them is started and
+ * stopped repeatedly: k_timer_start() and k_timer_stop() add and abort the
+ * probe timeout with interrupts locked, so the worst case time of these
+ * calls bounds the interrupt locking time of the timeout queue.
+ */
+
+#include "timestamp.h"
+#include "utils.h"
+
+#include <arch/cpu.h>
+
+/* maximum number of timeouts armed in the timeout queue */
+#define N_ARMED_MAX 128
+
+/* number of probe start/stop cycles for each queue depth */
+#define N_TEST_PROBE 100
+
+static struct k_timer armed[N_ARMED_MAX];
+static struct k_timer probe;
+
+static const int armed_counts[] = { 1, 8, 32, N_ARMED_MAX };
+
+/**
+ *
+ * @brief Arm or disarm the first @a count timers
+ *
+ * Each timer expires on a different tick, later than the previous one, so
+ * that the probe timer ends up at the tail of a list based timeout queue.
+ *
+ * @return N/A
+ */
+static void arm_timers(int count, int start)
+{
+	int i;
+
+	for (i = 0; i < count; i++) {
+		if (start) {
+			k_timer_start(&armed[i], (i + 1) * MSEC_PER_SEC * 100,
+				      0);
+		} else {
+			k_timer_stop(&armed[i]);
+		}
+	}
+}
+
+/**
+ *
+ * @brief The test main function
+ *
+ * @return 0 on success
+ */
+int timeout_q_scaling(void)
+{
+	u32_t start_worst, stop_worst, start_total, stop_total;
+	u32_t timestamp;
+	int i, j;
+
+	PRINT_FORMAT(" 7 - Measure worst case time to arm and cancel a timeout");
+	PRINT_FORMAT(" depending on the number of armed timeouts");
+
+	for (i = 0; i < N_ARMED_MAX; i++) {
+		k_timer_init(&armed[i], NULL, NULL);
+	}
+	k_timer_init(&probe, NULL, NULL);
+
+	for (i = 0; i < ARRAY_SIZE(armed_counts); i++) {
+		start_worst = stop_worst = 0;
+		start_total = stop_total = 0;
+
+		arm_timers(armed_counts[i], 1);
+
+		for (j = 0; j < N_TEST_PROBE; j++) {
+			timestamp = TIME_STAMP_DELTA_GET(0);
+			k_timer_start(&probe,
+				      (N_ARMED_MAX + 1) * MSEC_PER_SEC * 100, 0);
+			timestamp = TIME_STAMP_DELTA_GET(timestamp);
+
+			start_total += timestamp;
+			if (timestamp > start_worst) {
+				start_worst = timestamp;
+			}
+
+			timestamp = TIME_STAMP_DELTA_GET(0);
+			k_timer_stop(&probe);
+			timestamp = TIME_STAMP_DELTA_GET(timestamp);
+
+			stop_total += timestamp;
+			if (timestamp > stop_worst) {
+				stop_worst = timestamp;
+			}
+		}
+
+		arm_timers(armed_counts[i], 0);
+
+		PRINT_FORMAT(" %3d armed: start avg %u max %u tcs = %u nsec",
+			     armed_counts[i], start_total / N_TEST_PROBE,
+			     start_worst,
+			     SYS_CLOCK_HW_CYCLES_TO_NS(start_worst));
+		PRINT_FORMAT(" %3d armed: stop  avg %u max %u tcs = %u nsec",
+			     armed_counts[i], stop_total / N_TEST_PROBE,
+			     stop_worst,
+			     SYS_CLOCK_HW_CYCLES_TO_NS(stop_worst));
+	}
+
+	return 0;
+}
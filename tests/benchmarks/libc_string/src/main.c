@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Compare the C library string routines with byte-at-a-time versions.
+ *
+ * Each routine is called on buffers and strings of several sizes, with
+ * word-aligned and misaligned addresses, and the benchmark reports the
+ * average cycles per call of the C library routine and of a reference
+ * implementation handling one byte at a time.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <string.h>
+
+#define MAX_SIZE 1024
+#define N_CALLS 64
+
+static const int sizes[] = { 8, 64, 256, MAX_SIZE };
+
+/* source and destination offsets from a word boundary */
+static const struct {
+	int src;
+	int dst;
+} offsets[] = {
+	{ 0, 0 },
+	{ 1, 1 },
+	{ 1, 3 },
+};
+
+static char src_buf[MAX_SIZE + 8] __aligned(8);
+static char dst_buf[MAX_SIZE + 8] __aligned(8);
+
+static bool failed;
+
+/* keep the reference routines out of line, like the C library ones */
+#define __noinline __attribute__((noinline))
+
+static void __noinline byte_memcpy(void *d, const void *s, size_t n)
+{
+	unsigned char *d_byte = d;
+	const unsigned char *s_byte = s;
+
+	while (n--) {
+		*(d_byte++) = *(s_byte++);
+	}
+}
+
+static void __noinline byte_memset(void *d, int c, size_t n)
+{
+	unsigned char *d_byte = d;
+
+	while (n--) {
+		*(d_byte++) = c;
+	}
+}
+
+static size_t __noinline byte_strlen(const char *s)
+{
+	size_t n = 0;
+
+	while (s[n] != '\0') {
+		n++;
+	}
+
+	return n;
+}
+
+static char * __noinline byte_strchr(const char *s, int c)
+{
+	while ((*s != (char)c) && (*s != '\0')) {
+		s++;
+	}
+
+	return (*s == (char)c) ? (char *)s : NULL;
+}
+
+static int __noinline byte_strcmp(const char *s1, const char *s2)
+{
+	while ((*s1 == *s2) && (*s1 != '\0')) {
+		s1++;
+		s2++;
+	}
+
+	return *s1 - *s2;
+}
+
+enum routine {
+	MEMCPY,
+	MEMSET,
+	STRLEN,
+	STRCHR,
+	STRCMP,
+	N_ROUTINES
+};
+
+static const char * const routine_names[] = {
+	"memcpy", "memset", "strlen", "strchr", "strcmp"
+};
+
+/* Set up the buffers as strings of @a size - 1 bytes */
+static void init_strings(char *src, char *dst, int size)
+{
+	int i;
+
+	for (i = 0; i < size - 1; i++) {
+		src[i] = dst[i] = 'a' + i % 26;
+	}
+	src[size - 1] = dst[size - 1] = '\0';
+}
+
+static u32_t run(enum routine r, bool reference, char *src, char *dst,
+		 int size)
+{
+	u32_t start;
+	size_t n;
+	char *p;
+	int i;
+
+	init_strings(src, dst, size);
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < N_CALLS; i++) {
+		switch (r) {
+		case MEMCPY:
+			if (reference) {
+				byte_memcpy(dst, src, size);
+			} else {
+				memcpy(dst, src, size);
+			}
+			break;
+		case MEMSET:
+			if (reference) {
+				byte_memset(dst, 'x', size);
+			} else {
+				memset(dst, 'x', size);
+			}
+			break;
+		case STRLEN:
+			if (reference) {
+				n = byte_strlen(src);
+			} else {
+				n = strlen(src);
+			}
+			failed |= (n != size - 1);
+			break;
+		case STRCHR:
+			/* look for a byte which is not there */
+			if (reference) {
+				p = byte_strchr(src, '#');
+			} else {
+				p = strchr(src, '#');
+			}
+			failed |= (p != NULL);
+			break;
+		case STRCMP:
+			if (reference) {
+				n = byte_strcmp(src, dst);
+			} else {
+				n = strcmp(src, dst);
+			}
+			failed |= (n != 0);
+			break;
+		default:
+			break;
+		}
+	}
+
+	return (k_cycle_get_32() - start) / N_CALLS;
+}
+
+void main(void)
+{
+	int r, i, j;
+
+	TC_START("C library string routines");
+
+	TC_PRINT(" cycles per call, byte-at-a-time reference / C library\n");
+
+	for (r = 0; r < N_ROUTINES; r++) {
+		for (i = 0; i < ARRAY_SIZE(offsets); i++) {
+			char *src = src_buf + offsets[i].src;
+			char *dst = dst_buf + offsets[i].dst;
+
+			TC_PRINT(" %s, offsets %d/%d:", routine_names[r],
+				 offsets[i].src, offsets[i].dst);
+
+			for (j = 0; j < ARRAY_SIZE(sizes); j++) {
+				TC_PRINT(" %d: %u/%u", sizes[j],
+					 run(r, true, src, dst, sizes[j]),
+					 run(r, false, src, dst, sizes[j]));
+			}
+			TC_PRINT("\n");
+		}
+	}
+
+	TC_END_RESULT(failed ? TC_FAIL : TC_PASS);
+	TC_END_REPORT(failed ? TC_FAIL : TC_PASS);
+}
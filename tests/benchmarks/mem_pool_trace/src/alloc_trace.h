@@ -0,0 +1,990 @@
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Allocation trace of a device running an MQTT client and a small HTTP
+ * server, with the buffer sizes and lifetimes of the network application
+ * protocols:
+ *
+ * - MQTT publish: a header and topic buffer (24 to 80 bytes) and a
+ *   payload (40 to 600 bytes), both kept until acknowledged, up to six
+ *   messages in flight.
+ * - HTTP request: a request buffer (200 to 1200 bytes) freed once parsed,
+ *   then a response header (120 to 300 bytes) and a body chunk (256 to
+ *   1460 bytes) kept until sent, for up to three connections each with a
+ *   96 byte context.
+ *
+ * Each entry allocates or frees the block held in a slot. Replace this
+ * file with a trace recorded from the application to be tuned, keeping
+ * the same format.
+ */
+
+#define TRACE_SLOTS 21
+
+static const struct trace_op trace[] = {
+	TRACE_ALLOC(0, 68),
+	TRACE_ALLOC(1, 186),
+	TRACE_FREE(0),
+	TRACE_FREE(1),
+	TRACE_ALLOC(1, 71),
+	TRACE_ALLOC(0, 510),
+	TRACE_FREE(1),
+	TRACE_FREE(0),
+	TRACE_ALLOC(0, 24),
+	TRACE_ALLOC(1, 104),
+	TRACE_ALLOC(2, 25),
+	TRACE_ALLOC(3, 45),
+	TRACE_FREE(0),
+	TRACE_FREE(1),
+	TRACE_ALLOC(1, 29),
+	TRACE_ALLOC(0, 355),
+	TRACE_FREE(2),
+	TRACE_FREE(3),
+	TRACE_ALLOC(3, 44),
+	TRACE_ALLOC(2, 239),
+	TRACE_ALLOC(4, 29),
+	TRACE_ALLOC(5, 177),
+	TRACE_ALLOC(6, 448),
+	TRACE_ALLOC(7, 280),
+	TRACE_FREE(6),
+	TRACE_ALLOC(6, 451),
+	TRACE_FREE(7),
+	TRACE_FREE(6),
+	TRACE_ALLOC(6, 65),
+	TRACE_ALLOC(7, 510),
+	TRACE_FREE(1),
+	TRACE_FREE(0),
+	TRACE_ALLOC(0, 96),
+	TRACE_ALLOC(1, 561),
+	TRACE_ALLOC(8, 181),
+	TRACE_FREE(1),
+	TRACE_ALLOC(1, 600),
+	TRACE_ALLOC(9, 29),
+	TRACE_ALLOC(10, 53),
+	TRACE_ALLOC(11, 31),
+	TRACE_ALLOC(12, 80),
+	TRACE_FREE(3),
+	TRACE_FREE(2),
+	TRACE_ALLOC(2, 24),
+	TRACE_ALLOC(3, 467),
+	TRACE_ALLOC(13, 471),
+	TRACE_ALLOC(14, 280),
+	TRACE_FREE(13),
+	TRACE_ALLOC(13, 1195),
+	TRACE_ALLOC(15, 46),
+	TRACE_ALLOC(16, 425),
+	TRACE_ALLOC(17, 46),
+	TRACE_ALLOC(18, 54),
+	TRACE_FREE(4),
+	TRACE_FREE(5),
+	TRACE_FREE(0),
+	TRACE_FREE(6),
+	TRACE_FREE(7),
+	TRACE_FREE(8),
+	TRACE_FREE(1),
+	TRACE_ALLOC(1, 55),
+	TRACE_ALLOC(8, 219),
+	TRACE_FREE(9),
+	TRACE_FREE(10),
+	TRACE_ALLOC(10, 651),
+	TRACE_ALLOC(9, 158),
+	TRACE_FREE(10),
+	TRACE_ALLOC(10, 595),
+	TRACE_FREE(14),
+	TRACE_FREE(13),
+	TRACE_ALLOC(13, 96),
+	TRACE_ALLOC(14, 669),
+	TRACE_ALLOC(7, 267),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 1170),
+	TRACE_ALLOC(6, 59),
+	TRACE_ALLOC(0, 165),
+	TRACE_FREE(11),
+	TRACE_FREE(12),
+	TRACE_FREE(2),
+	TRACE_FREE(3),
+	TRACE_ALLOC(3, 63),
+	TRACE_ALLOC(2, 74),
+	TRACE_FREE(15),
+	TRACE_FREE(16),
+	TRACE_ALLOC(16, 778),
+	TRACE_ALLOC(15, 269),
+	TRACE_FREE(16),
+	TRACE_ALLOC(16, 383),
+	TRACE_FREE(9),
+	TRACE_FREE(10),
+	TRACE_ALLOC(10, 57),
+	TRACE_ALLOC(9, 99),
+	TRACE_FREE(17),
+	TRACE_FREE(18),
+	TRACE_FREE(1),
+	TRACE_FREE(8),
+	TRACE_FREE(7),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 96),
+	TRACE_ALLOC(7, 957),
+	TRACE_ALLOC(8, 225),
+	TRACE_FREE(7),
+	TRACE_ALLOC(7, 1184),
+	TRACE_FREE(15),
+	TRACE_FREE(16),
+	TRACE_FREE(14),
+	TRACE_FREE(6),
+	TRACE_FREE(0),
+	TRACE_FREE(13),
+	TRACE_FREE(3),
+	TRACE_FREE(2),
+	TRACE_FREE(8),
+	TRACE_FREE(7),
+	TRACE_ALLOC(7, 50),
+	TRACE_ALLOC(8, 143),
+	TRACE_FREE(10),
+	TRACE_FREE(9),
+	TRACE_FREE(7),
+	TRACE_FREE(8),
+	TRACE_ALLOC(8, 407),
+	TRACE_ALLOC(7, 283),
+	TRACE_FREE(8),
+	TRACE_ALLOC(8, 581),
+	TRACE_FREE(7),
+	TRACE_FREE(8),
+	TRACE_ALLOC(8, 572),
+	TRACE_ALLOC(7, 241),
+	TRACE_FREE(8),
+	TRACE_ALLOC(8, 1243),
+	TRACE_FREE(7),
+	TRACE_FREE(8),
+	TRACE_ALLOC(8, 72),
+	TRACE_ALLOC(7, 285),
+	TRACE_FREE(8),
+	TRACE_FREE(7),
+	TRACE_ALLOC(7, 665),
+	TRACE_ALLOC(8, 219),
+	TRACE_FREE(7),
+	TRACE_ALLOC(7, 491),
+	TRACE_FREE(8),
+	TRACE_FREE(7),
+	TRACE_ALLOC(7, 96),
+	TRACE_ALLOC(8, 807),
+	TRACE_ALLOC(9, 258),
+	TRACE_FREE(8),
+	TRACE_ALLOC(8, 955),
+	TRACE_ALLOC(10, 96),
+	TRACE_ALLOC(2, 260),
+	TRACE_ALLOC(3, 141),
+	TRACE_FREE(2),
+	TRACE_ALLOC(2, 691),
+	TRACE_FREE(9),
+	TRACE_FREE(8),
+	TRACE_ALLOC(8, 96),
+	TRACE_ALLOC(9, 221),
+	TRACE_ALLOC(13, 217),
+	TRACE_FREE(9),
+	TRACE_ALLOC(9, 532),
+	TRACE_ALLOC(0, 48),
+	TRACE_ALLOC(6, 138),
+	TRACE_FREE(0),
+	TRACE_FREE(6),
+	TRACE_ALLOC(6, 668),
+	TRACE_ALLOC(0, 171),
+	TRACE_FREE(6),
+	TRACE_ALLOC(6, 424),
+	TRACE_FREE(3),
+	TRACE_FREE(2),
+	TRACE_FREE(13),
+	TRACE_FREE(9),
+	TRACE_ALLOC(9, 644),
+	TRACE_ALLOC(13, 197),
+	TRACE_FREE(9),
+	TRACE_ALLOC(9, 693),
+	TRACE_ALLOC(2, 56),
+	TRACE_ALLOC(3, 72),
+	TRACE_ALLOC(14, 386),
+	TRACE_ALLOC(16, 215),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 613),
+	TRACE_FREE(0),
+	TRACE_FREE(6),
+	TRACE_ALLOC(6, 1092),
+	TRACE_ALLOC(0, 228),
+	TRACE_FREE(6),
+	TRACE_ALLOC(6, 1376),
+	TRACE_FREE(13),
+	TRACE_FREE(9),
+	TRACE_ALLOC(9, 291),
+	TRACE_ALLOC(13, 166),
+	TRACE_FREE(9),
+	TRACE_ALLOC(9, 832),
+	TRACE_FREE(16),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 32),
+	TRACE_ALLOC(16, 50),
+	TRACE_FREE(2),
+	TRACE_FREE(3),
+	TRACE_FREE(0),
+	TRACE_FREE(6),
+	TRACE_ALLOC(6, 56),
+	TRACE_ALLOC(0, 125),
+	TRACE_FREE(14),
+	TRACE_FREE(16),
+	TRACE_ALLOC(16, 55),
+	TRACE_ALLOC(14, 47),
+	TRACE_FREE(6),
+	TRACE_FREE(0),
+	TRACE_ALLOC(0, 34),
+	TRACE_ALLOC(6, 64),
+	TRACE_ALLOC(3, 1101),
+	TRACE_ALLOC(2, 226),
+	TRACE_FREE(3),
+	TRACE_ALLOC(3, 1453),
+	TRACE_FREE(13),
+	TRACE_FREE(9),
+	TRACE_FREE(8),
+	TRACE_FREE(16),
+	TRACE_FREE(14),
+	TRACE_FREE(2),
+	TRACE_FREE(3),
+	TRACE_ALLOC(3, 49),
+	TRACE_ALLOC(2, 123),
+	TRACE_ALLOC(14, 960),
+	TRACE_ALLOC(16, 135),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 432),
+	TRACE_ALLOC(8, 73),
+	TRACE_ALLOC(9, 221),
+	TRACE_FREE(0),
+	TRACE_FREE(6),
+	TRACE_FREE(16),
+	TRACE_FREE(14),
+	TRACE_FREE(3),
+	TRACE_FREE(2),
+	TRACE_ALLOC(2, 966),
+	TRACE_ALLOC(3, 186),
+	TRACE_FREE(2),
+	TRACE_ALLOC(2, 351),
+	TRACE_FREE(8),
+	TRACE_FREE(9),
+	TRACE_ALLOC(9, 96),
+	TRACE_ALLOC(8, 743),
+	TRACE_ALLOC(14, 249),
+	TRACE_FREE(8),
+	TRACE_ALLOC(8, 502),
+	TRACE_ALLOC(16, 381),
+	TRACE_ALLOC(6, 164),
+	TRACE_FREE(16),
+	TRACE_ALLOC(16, 1082),
+	TRACE_FREE(3),
+	TRACE_FREE(2),
+	TRACE_ALLOC(2, 27),
+	TRACE_ALLOC(3, 189),
+	TRACE_FREE(2),
+	TRACE_FREE(3),
+	TRACE_ALLOC(3, 29),
+	TRACE_ALLOC(2, 145),
+	TRACE_FREE(3),
+	TRACE_FREE(2),
+	TRACE_ALLOC(2, 72),
+	TRACE_ALLOC(3, 93),
+	TRACE_FREE(2),
+	TRACE_FREE(3),
+	TRACE_ALLOC(3, 65),
+	TRACE_ALLOC(2, 97),
+	TRACE_FREE(3),
+	TRACE_FREE(2),
+	TRACE_ALLOC(2, 51),
+	TRACE_ALLOC(3, 592),
+	TRACE_FREE(2),
+	TRACE_FREE(3),
+	TRACE_FREE(7),
+	TRACE_ALLOC(7, 32),
+	TRACE_ALLOC(3, 111),
+	TRACE_ALLOC(2, 920),
+	TRACE_ALLOC(0, 207),
+	TRACE_FREE(2),
+	TRACE_ALLOC(2, 291),
+	TRACE_FREE(14),
+	TRACE_FREE(8),
+	TRACE_FREE(9),
+	TRACE_FREE(7),
+	TRACE_FREE(3),
+	TRACE_FREE(6),
+	TRACE_FREE(16),
+	TRACE_ALLOC(16, 96),
+	TRACE_ALLOC(6, 505),
+	TRACE_ALLOC(3, 227),
+	TRACE_FREE(6),
+	TRACE_ALLOC(6, 1211),
+	TRACE_ALLOC(7, 50),
+	TRACE_ALLOC(9, 353),
+	TRACE_FREE(10),
+	TRACE_FREE(7),
+	TRACE_FREE(9),
+	TRACE_ALLOC(9, 1087),
+	TRACE_ALLOC(7, 261),
+	TRACE_FREE(9),
+	TRACE_ALLOC(9, 1092),
+	TRACE_FREE(0),
+	TRACE_FREE(2),
+	TRACE_ALLOC(2, 96),
+	TRACE_ALLOC(0, 1121),
+	TRACE_ALLOC(10, 219),
+	TRACE_FREE(0),
+	TRACE_ALLOC(0, 666),
+	TRACE_FREE(3),
+	TRACE_FREE(6),
+	TRACE_ALLOC(6, 66),
+	TRACE_ALLOC(3, 61),
+	TRACE_ALLOC(8, 96),
+	TRACE_ALLOC(14, 1074),
+	TRACE_ALLOC(13, 253),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 1040),
+	TRACE_FREE(7),
+	TRACE_FREE(9),
+	TRACE_FREE(16),
+	TRACE_FREE(6),
+	TRACE_FREE(3),
+	TRACE_ALLOC(3, 50),
+	TRACE_ALLOC(6, 174),
+	TRACE_ALLOC(16, 35),
+	TRACE_ALLOC(9, 195),
+	TRACE_FREE(3),
+	TRACE_FREE(6),
+	TRACE_ALLOC(6, 289),
+	TRACE_ALLOC(3, 220),
+	TRACE_FREE(6),
+	TRACE_ALLOC(6, 1030),
+	TRACE_FREE(10),
+	TRACE_FREE(0),
+	TRACE_ALLOC(0, 39),
+	TRACE_ALLOC(10, 598),
+	TRACE_FREE(16),
+	TRACE_FREE(9),
+	TRACE_ALLOC(9, 79),
+	TRACE_ALLOC(16, 362),
+	TRACE_FREE(0),
+	TRACE_FREE(10),
+	TRACE_ALLOC(10, 57),
+	TRACE_ALLOC(0, 248),
+	TRACE_ALLOC(7, 96),
+	TRACE_ALLOC(15, 990),
+	TRACE_ALLOC(1, 209),
+	TRACE_FREE(15),
+	TRACE_ALLOC(15, 679),
+	TRACE_FREE(13),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 500),
+	TRACE_ALLOC(13, 137),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 716),
+	TRACE_FREE(3),
+	TRACE_FREE(6),
+	TRACE_ALLOC(6, 612),
+	TRACE_ALLOC(3, 166),
+	TRACE_FREE(6),
+	TRACE_ALLOC(6, 365),
+	TRACE_FREE(1),
+	TRACE_FREE(15),
+	TRACE_ALLOC(15, 60),
+	TRACE_ALLOC(1, 119),
+	TRACE_FREE(9),
+	TRACE_FREE(16),
+	TRACE_ALLOC(16, 583),
+	TRACE_ALLOC(9, 199),
+	TRACE_FREE(16),
+	TRACE_ALLOC(16, 340),
+	TRACE_FREE(13),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 35),
+	TRACE_ALLOC(13, 297),
+	TRACE_FREE(10),
+	TRACE_FREE(0),
+	TRACE_ALLOC(0, 26),
+	TRACE_ALLOC(10, 67),
+	TRACE_FREE(15),
+	TRACE_FREE(1),
+	TRACE_ALLOC(1, 63),
+	TRACE_ALLOC(15, 149),
+	TRACE_FREE(14),
+	TRACE_FREE(13),
+	TRACE_ALLOC(13, 267),
+	TRACE_ALLOC(14, 179),
+	TRACE_FREE(13),
+	TRACE_ALLOC(13, 1319),
+	TRACE_FREE(3),
+	TRACE_FREE(6),
+	TRACE_ALLOC(6, 911),
+	TRACE_ALLOC(3, 204),
+	TRACE_FREE(6),
+	TRACE_ALLOC(6, 914),
+	TRACE_FREE(9),
+	TRACE_FREE(16),
+	TRACE_ALLOC(16, 68),
+	TRACE_ALLOC(9, 159),
+	TRACE_ALLOC(18, 37),
+	TRACE_ALLOC(17, 74),
+	TRACE_FREE(0),
+	TRACE_FREE(10),
+	TRACE_ALLOC(10, 56),
+	TRACE_ALLOC(0, 85),
+	TRACE_FREE(1),
+	TRACE_FREE(15),
+	TRACE_FREE(14),
+	TRACE_FREE(13),
+	TRACE_FREE(16),
+	TRACE_FREE(9),
+	TRACE_FREE(3),
+	TRACE_FREE(6),
+	TRACE_FREE(18),
+	TRACE_FREE(17),
+	TRACE_ALLOC(17, 37),
+	TRACE_ALLOC(18, 73),
+	TRACE_ALLOC(6, 34),
+	TRACE_ALLOC(3, 437),
+	TRACE_ALLOC(9, 842),
+	TRACE_ALLOC(16, 122),
+	TRACE_FREE(9),
+	TRACE_ALLOC(9, 479),
+	TRACE_ALLOC(13, 319),
+	TRACE_ALLOC(14, 148),
+	TRACE_FREE(13),
+	TRACE_ALLOC(13, 362),
+	TRACE_FREE(16),
+	TRACE_FREE(9),
+	TRACE_ALLOC(9, 343),
+	TRACE_ALLOC(16, 227),
+	TRACE_FREE(9),
+	TRACE_ALLOC(9, 1347),
+	TRACE_FREE(14),
+	TRACE_FREE(13),
+	TRACE_ALLOC(13, 592),
+	TRACE_ALLOC(14, 254),
+	TRACE_FREE(13),
+	TRACE_ALLOC(13, 389),
+	TRACE_FREE(16),
+	TRACE_FREE(9),
+	TRACE_ALLOC(9, 804),
+	TRACE_ALLOC(16, 198),
+	TRACE_FREE(9),
+	TRACE_ALLOC(9, 586),
+	TRACE_ALLOC(15, 79),
+	TRACE_ALLOC(1, 516),
+	TRACE_ALLOC(12, 56),
+	TRACE_ALLOC(11, 160),
+	TRACE_ALLOC(5, 57),
+	TRACE_ALLOC(4, 224),
+	TRACE_ALLOC(19, 595),
+	TRACE_ALLOC(20, 272),
+	TRACE_FREE(19),
+	TRACE_ALLOC(19, 275),
+	TRACE_FREE(14),
+	TRACE_FREE(13),
+	TRACE_ALLOC(13, 34),
+	TRACE_ALLOC(14, 125),
+	TRACE_FREE(10),
+	TRACE_FREE(0),
+	TRACE_ALLOC(0, 367),
+	TRACE_ALLOC(10, 223),
+	TRACE_FREE(0),
+	TRACE_ALLOC(0, 864),
+	TRACE_FREE(16),
+	TRACE_FREE(9),
+	TRACE_FREE(17),
+	TRACE_FREE(18),
+	TRACE_ALLOC(18, 452),
+	TRACE_ALLOC(17, 188),
+	TRACE_FREE(18),
+	TRACE_ALLOC(18, 567),
+	TRACE_FREE(20),
+	TRACE_FREE(19),
+	TRACE_FREE(6),
+	TRACE_FREE(3),
+	TRACE_FREE(10),
+	TRACE_FREE(0),
+	TRACE_FREE(15),
+	TRACE_FREE(1),
+	TRACE_FREE(17),
+	TRACE_FREE(18),
+	TRACE_ALLOC(18, 57),
+	TRACE_ALLOC(17, 142),
+	TRACE_ALLOC(1, 56),
+	TRACE_ALLOC(15, 81),
+	TRACE_FREE(12),
+	TRACE_FREE(11),
+	TRACE_ALLOC(11, 625),
+	TRACE_ALLOC(12, 170),
+	TRACE_FREE(11),
+	TRACE_ALLOC(11, 406),
+	TRACE_ALLOC(0, 77),
+	TRACE_ALLOC(10, 105),
+	TRACE_FREE(5),
+	TRACE_FREE(4),
+	TRACE_ALLOC(4, 607),
+	TRACE_ALLOC(5, 220),
+	TRACE_FREE(4),
+	TRACE_ALLOC(4, 1206),
+	TRACE_FREE(12),
+	TRACE_FREE(11),
+	TRACE_ALLOC(11, 52),
+	TRACE_ALLOC(12, 62),
+	TRACE_FREE(13),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 652),
+	TRACE_ALLOC(13, 170),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 623),
+	TRACE_FREE(5),
+	TRACE_FREE(4),
+	TRACE_ALLOC(4, 75),
+	TRACE_ALLOC(5, 98),
+	TRACE_FREE(7),
+	TRACE_FREE(18),
+	TRACE_FREE(17),
+	TRACE_FREE(1),
+	TRACE_FREE(15),
+	TRACE_ALLOC(15, 246),
+	TRACE_ALLOC(1, 274),
+	TRACE_FREE(15),
+	TRACE_ALLOC(15, 1393),
+	TRACE_FREE(13),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 79),
+	TRACE_ALLOC(13, 139),
+	TRACE_FREE(0),
+	TRACE_FREE(10),
+	TRACE_FREE(11),
+	TRACE_FREE(12),
+	TRACE_FREE(4),
+	TRACE_FREE(5),
+	TRACE_ALLOC(5, 38),
+	TRACE_ALLOC(4, 552),
+	TRACE_ALLOC(12, 55),
+	TRACE_ALLOC(11, 264),
+	TRACE_FREE(14),
+	TRACE_FREE(13),
+	TRACE_FREE(5),
+	TRACE_FREE(4),
+	TRACE_FREE(1),
+	TRACE_FREE(15),
+	TRACE_FREE(8),
+	TRACE_FREE(12),
+	TRACE_FREE(11),
+	TRACE_ALLOC(11, 75),
+	TRACE_ALLOC(12, 121),
+	TRACE_FREE(11),
+	TRACE_FREE(12),
+	TRACE_FREE(2),
+	TRACE_ALLOC(2, 469),
+	TRACE_ALLOC(12, 293),
+	TRACE_FREE(2),
+	TRACE_ALLOC(2, 639),
+	TRACE_ALLOC(11, 60),
+	TRACE_ALLOC(8, 59),
+	TRACE_ALLOC(15, 77),
+	TRACE_ALLOC(1, 153),
+	TRACE_ALLOC(4, 96),
+	TRACE_ALLOC(5, 647),
+	TRACE_ALLOC(13, 280),
+	TRACE_FREE(5),
+	TRACE_ALLOC(5, 1217),
+	TRACE_FREE(12),
+	TRACE_FREE(2),
+	TRACE_FREE(11),
+	TRACE_FREE(8),
+	TRACE_FREE(13),
+	TRACE_FREE(5),
+	TRACE_ALLOC(5, 42),
+	TRACE_ALLOC(13, 230),
+	TRACE_ALLOC(8, 55),
+	TRACE_ALLOC(11, 335),
+	TRACE_ALLOC(2, 77),
+	TRACE_ALLOC(12, 341),
+	TRACE_ALLOC(14, 1082),
+	TRACE_ALLOC(10, 293),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 509),
+	TRACE_FREE(15),
+	TRACE_FREE(1),
+	TRACE_ALLOC(1, 213),
+	TRACE_ALLOC(15, 233),
+	TRACE_FREE(1),
+	TRACE_ALLOC(1, 1315),
+	TRACE_FREE(10),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 69),
+	TRACE_ALLOC(10, 66),
+	TRACE_FREE(5),
+	TRACE_FREE(13),
+	TRACE_ALLOC(13, 24),
+	TRACE_ALLOC(5, 257),
+	TRACE_ALLOC(0, 52),
+	TRACE_ALLOC(17, 364),
+	TRACE_FREE(8),
+	TRACE_FREE(11),
+	TRACE_ALLOC(11, 606),
+	TRACE_ALLOC(8, 195),
+	TRACE_FREE(11),
+	TRACE_ALLOC(11, 554),
+	TRACE_FREE(15),
+	TRACE_FREE(1),
+	TRACE_ALLOC(1, 49),
+	TRACE_ALLOC(15, 70),
+	TRACE_ALLOC(18, 28),
+	TRACE_ALLOC(7, 86),
+	TRACE_FREE(2),
+	TRACE_FREE(12),
+	TRACE_ALLOC(12, 96),
+	TRACE_ALLOC(2, 204),
+	TRACE_ALLOC(3, 263),
+	TRACE_FREE(2),
+	TRACE_ALLOC(2, 510),
+	TRACE_FREE(8),
+	TRACE_FREE(11),
+	TRACE_ALLOC(11, 48),
+	TRACE_ALLOC(8, 594),
+	TRACE_ALLOC(6, 229),
+	TRACE_ALLOC(19, 184),
+	TRACE_FREE(6),
+	TRACE_ALLOC(6, 939),
+	TRACE_FREE(14),
+	TRACE_FREE(10),
+	TRACE_FREE(3),
+	TRACE_FREE(2),
+	TRACE_ALLOC(2, 995),
+	TRACE_ALLOC(3, 219),
+	TRACE_FREE(2),
+	TRACE_ALLOC(2, 1050),
+	TRACE_ALLOC(10, 24),
+	TRACE_ALLOC(14, 593),
+	TRACE_FREE(13),
+	TRACE_FREE(5),
+	TRACE_FREE(4),
+	TRACE_FREE(0),
+	TRACE_FREE(17),
+	TRACE_FREE(19),
+	TRACE_FREE(6),
+	TRACE_FREE(12),
+	TRACE_FREE(1),
+	TRACE_FREE(15),
+	TRACE_FREE(18),
+	TRACE_FREE(7),
+	TRACE_FREE(11),
+	TRACE_FREE(8),
+	TRACE_ALLOC(8, 48),
+	TRACE_ALLOC(11, 88),
+	TRACE_ALLOC(7, 56),
+	TRACE_ALLOC(18, 260),
+	TRACE_FREE(10),
+	TRACE_FREE(14),
+	TRACE_FREE(3),
+	TRACE_FREE(2),
+	TRACE_ALLOC(2, 96),
+	TRACE_ALLOC(3, 929),
+	TRACE_ALLOC(14, 273),
+	TRACE_FREE(3),
+	TRACE_ALLOC(3, 833),
+	TRACE_ALLOC(10, 96),
+	TRACE_ALLOC(15, 875),
+	TRACE_ALLOC(1, 299),
+	TRACE_FREE(15),
+	TRACE_ALLOC(15, 288),
+	TRACE_ALLOC(12, 62),
+	TRACE_ALLOC(6, 404),
+	TRACE_FREE(8),
+	TRACE_FREE(11),
+	TRACE_ALLOC(11, 31),
+	TRACE_ALLOC(8, 379),
+	TRACE_ALLOC(19, 78),
+	TRACE_ALLOC(17, 593),
+	TRACE_ALLOC(0, 29),
+	TRACE_ALLOC(4, 78),
+	TRACE_ALLOC(5, 78),
+	TRACE_ALLOC(13, 376),
+	TRACE_FREE(7),
+	TRACE_FREE(18),
+	TRACE_ALLOC(18, 77),
+	TRACE_ALLOC(7, 587),
+	TRACE_FREE(12),
+	TRACE_FREE(6),
+	TRACE_FREE(11),
+	TRACE_FREE(8),
+	TRACE_FREE(14),
+	TRACE_FREE(3),
+	TRACE_ALLOC(3, 96),
+	TRACE_ALLOC(14, 726),
+	TRACE_ALLOC(8, 253),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 302),
+	TRACE_FREE(1),
+	TRACE_FREE(15),
+	TRACE_ALLOC(15, 52),
+	TRACE_ALLOC(1, 234),
+	TRACE_FREE(19),
+	TRACE_FREE(17),
+	TRACE_ALLOC(17, 57),
+	TRACE_ALLOC(19, 141),
+	TRACE_FREE(0),
+	TRACE_FREE(4),
+	TRACE_FREE(8),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 974),
+	TRACE_ALLOC(8, 285),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 1093),
+	TRACE_FREE(5),
+	TRACE_FREE(13),
+	TRACE_FREE(18),
+	TRACE_FREE(7),
+	TRACE_FREE(8),
+	TRACE_FREE(14),
+	TRACE_FREE(15),
+	TRACE_FREE(1),
+	TRACE_ALLOC(1, 46),
+	TRACE_ALLOC(15, 426),
+	TRACE_FREE(17),
+	TRACE_FREE(19),
+	TRACE_ALLOC(19, 1085),
+	TRACE_ALLOC(17, 149),
+	TRACE_FREE(19),
+	TRACE_ALLOC(19, 560),
+	TRACE_FREE(17),
+	TRACE_FREE(19),
+	TRACE_ALLOC(19, 541),
+	TRACE_ALLOC(17, 227),
+	TRACE_FREE(19),
+	TRACE_ALLOC(19, 1433),
+	TRACE_FREE(17),
+	TRACE_FREE(19),
+	TRACE_ALLOC(19, 677),
+	TRACE_ALLOC(17, 192),
+	TRACE_FREE(19),
+	TRACE_ALLOC(19, 399),
+	TRACE_FREE(17),
+	TRACE_FREE(19),
+	TRACE_ALLOC(19, 223),
+	TRACE_ALLOC(17, 194),
+	TRACE_FREE(19),
+	TRACE_ALLOC(19, 1367),
+	TRACE_FREE(17),
+	TRACE_FREE(19),
+	TRACE_FREE(1),
+	TRACE_FREE(15),
+	TRACE_ALLOC(15, 29),
+	TRACE_ALLOC(1, 104),
+	TRACE_ALLOC(19, 70),
+	TRACE_ALLOC(17, 48),
+	TRACE_FREE(15),
+	TRACE_FREE(1),
+	TRACE_ALLOC(1, 58),
+	TRACE_ALLOC(15, 153),
+	TRACE_FREE(19),
+	TRACE_FREE(17),
+	TRACE_ALLOC(17, 680),
+	TRACE_ALLOC(19, 158),
+	TRACE_FREE(17),
+	TRACE_ALLOC(17, 873),
+	TRACE_FREE(19),
+	TRACE_FREE(17),
+	TRACE_ALLOC(17, 24),
+	TRACE_ALLOC(19, 258),
+	TRACE_ALLOC(14, 66),
+	TRACE_ALLOC(8, 119),
+	TRACE_FREE(1),
+	TRACE_FREE(15),
+	TRACE_ALLOC(15, 39),
+	TRACE_ALLOC(1, 323),
+	TRACE_ALLOC(7, 527),
+	TRACE_ALLOC(18, 296),
+	TRACE_FREE(7),
+	TRACE_ALLOC(7, 582),
+	TRACE_FREE(18),
+	TRACE_FREE(7),
+	TRACE_ALLOC(7, 240),
+	TRACE_ALLOC(18, 247),
+	TRACE_FREE(7),
+	TRACE_ALLOC(7, 973),
+	TRACE_FREE(18),
+	TRACE_FREE(7),
+	TRACE_ALLOC(7, 1038),
+	TRACE_ALLOC(18, 220),
+	TRACE_FREE(7),
+	TRACE_ALLOC(7, 598),
+	TRACE_FREE(18),
+	TRACE_FREE(7),
+	TRACE_FREE(10),
+	TRACE_FREE(17),
+	TRACE_FREE(19),
+	TRACE_ALLOC(19, 53),
+	TRACE_ALLOC(17, 160),
+	TRACE_ALLOC(10, 79),
+	TRACE_ALLOC(7, 121),
+	TRACE_FREE(14),
+	TRACE_FREE(8),
+	TRACE_FREE(3),
+	TRACE_FREE(15),
+	TRACE_FREE(1),
+	TRACE_ALLOC(1, 26),
+	TRACE_ALLOC(15, 490),
+	TRACE_FREE(19),
+	TRACE_FREE(17),
+	TRACE_ALLOC(17, 204),
+	TRACE_ALLOC(19, 173),
+	TRACE_FREE(17),
+	TRACE_ALLOC(17, 1459),
+	TRACE_FREE(19),
+	TRACE_FREE(17),
+	TRACE_ALLOC(17, 46),
+	TRACE_ALLOC(19, 488),
+	TRACE_FREE(10),
+	TRACE_FREE(7),
+	TRACE_ALLOC(7, 62),
+	TRACE_ALLOC(10, 67),
+	TRACE_FREE(1),
+	TRACE_FREE(15),
+	TRACE_ALLOC(15, 64),
+	TRACE_ALLOC(1, 148),
+	TRACE_FREE(17),
+	TRACE_FREE(19),
+	TRACE_FREE(7),
+	TRACE_FREE(10),
+	TRACE_ALLOC(10, 61),
+	TRACE_ALLOC(7, 73),
+	TRACE_FREE(2),
+	TRACE_FREE(15),
+	TRACE_FREE(1),
+	TRACE_ALLOC(1, 51),
+	TRACE_ALLOC(15, 580),
+	TRACE_ALLOC(2, 69),
+	TRACE_ALLOC(19, 92),
+	TRACE_FREE(10),
+	TRACE_FREE(7),
+	TRACE_ALLOC(7, 35),
+	TRACE_ALLOC(10, 124),
+	TRACE_ALLOC(17, 59),
+	TRACE_ALLOC(3, 119),
+	TRACE_FREE(1),
+	TRACE_FREE(15),
+	TRACE_ALLOC(15, 25),
+	TRACE_ALLOC(1, 144),
+	TRACE_ALLOC(8, 64),
+	TRACE_ALLOC(14, 312),
+	TRACE_FREE(2),
+	TRACE_FREE(19),
+	TRACE_ALLOC(19, 41),
+	TRACE_ALLOC(2, 89),
+	TRACE_FREE(7),
+	TRACE_FREE(10),
+	TRACE_FREE(17),
+	TRACE_FREE(3),
+	TRACE_ALLOC(3, 56),
+	TRACE_ALLOC(17, 243),
+	TRACE_FREE(15),
+	TRACE_FREE(1),
+	TRACE_FREE(8),
+	TRACE_FREE(14),
+	TRACE_ALLOC(14, 35),
+	TRACE_ALLOC(8, 566),
+	TRACE_FREE(19),
+	TRACE_FREE(2),
+	TRACE_ALLOC(2, 54),
+	TRACE_ALLOC(19, 58),
+	TRACE_FREE(3),
+	TRACE_FREE(17),
+	TRACE_ALLOC(17, 946),
+	TRACE_ALLOC(3, 187),
+	TRACE_FREE(17),
+	TRACE_ALLOC(17, 420),
+	TRACE_ALLOC(1, 45),
+	TRACE_ALLOC(15, 96),
+	TRACE_ALLOC(10, 963),
+	TRACE_ALLOC(7, 198),
+	TRACE_FREE(10),
+	TRACE_ALLOC(10, 292),
+	TRACE_FREE(14),
+	TRACE_FREE(8),
+	TRACE_FREE(3),
+	TRACE_FREE(17),
+	TRACE_ALLOC(17, 60),
+	TRACE_ALLOC(3, 160),
+	TRACE_ALLOC(8, 40),
+	TRACE_ALLOC(14, 126),
+	TRACE_FREE(2),
+	TRACE_FREE(19),
+	TRACE_ALLOC(19, 79),
+	TRACE_ALLOC(2, 87),
+	TRACE_FREE(1),
+	TRACE_FREE(15),
+	TRACE_ALLOC(15, 96),
+	TRACE_ALLOC(1, 985),
+	TRACE_ALLOC(18, 279),
+	TRACE_FREE(1),
+	TRACE_ALLOC(1, 1371),
+	TRACE_FREE(7),
+	TRACE_FREE(10),
+	TRACE_ALLOC(10, 737),
+	TRACE_ALLOC(7, 237),
+	TRACE_FREE(10),
+	TRACE_ALLOC(10, 566),
+	TRACE_ALLOC(13, 36),
+	TRACE_ALLOC(5, 340),
+	TRACE_ALLOC(4, 52),
+	TRACE_ALLOC(0, 104),
+	TRACE_FREE(17),
+	TRACE_FREE(3),
+	TRACE_FREE(8),
+	TRACE_FREE(14),
+	TRACE_FREE(18),
+	TRACE_FREE(1),
+	TRACE_ALLOC(1, 96),
+	TRACE_ALLOC(18, 817),
+	TRACE_ALLOC(14, 220),
+	TRACE_FREE(18),
+	TRACE_ALLOC(18, 1072),
+	TRACE_FREE(7),
+	TRACE_FREE(10),
+	TRACE_ALLOC(10, 55),
+	TRACE_ALLOC(7, 78),
+	TRACE_FREE(19),
+	TRACE_FREE(2),
+	TRACE_FREE(13),
+	TRACE_FREE(5),
+	TRACE_ALLOC(5, 73),
+	TRACE_ALLOC(13, 114),
+	TRACE_FREE(4),
+	TRACE_FREE(0),
+	TRACE_ALLOC(0, 47),
+	TRACE_ALLOC(4, 154),
+	TRACE_ALLOC(2, 96),
+	TRACE_ALLOC(19, 928),
+	TRACE_ALLOC(8, 225),
+	TRACE_FREE(19),
+	TRACE_ALLOC(19, 1214),
+	TRACE_FREE(14),
+	TRACE_FREE(18),
+	TRACE_FREE(10),
+	TRACE_FREE(7),
+	TRACE_ALLOC(7, 71),
+	TRACE_ALLOC(10, 41),
+	TRACE_ALLOC(18, 63),
+	TRACE_ALLOC(14, 68),
+	TRACE_FREE(5),
+	TRACE_FREE(13),
+	TRACE_ALLOC(13, 49),
+	TRACE_ALLOC(5, 141),
+	TRACE_FREE(0),
+	TRACE_FREE(4),
+	TRACE_FREE(8),
+	TRACE_FREE(19),
+	TRACE_FREE(7),
+	TRACE_FREE(10),
+	TRACE_FREE(18),
+	TRACE_FREE(14),
+	TRACE_FREE(13),
+	TRACE_FREE(5),
+	TRACE_FREE(15),
+	TRACE_FREE(1),
+	TRACE_FREE(2),
+};
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Replay an allocation trace on memory pools with different backends.
+ *
+ * The same trace of k_mem_pool_malloc()/k_free() calls is replayed on a
+ * buddy memory pool and on a TLSF memory pool of the same size. For each
+ * pool, the benchmark reports how many allocations failed, the largest
+ * amount of requested memory held at once, and the average and worst
+ * case time of an allocation and of a free.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+#define POOL_SIZE 8192
+
+/* times the trace is replayed on each pool */
+#define N_ROUNDS 10
+
+struct trace_op {
+	u16_t slot;
+	u16_t size;	/* 0 to free the block in slot */
+};
+
+#define TRACE_ALLOC(s, sz) { .slot = (s), .size = (sz) }
+#define TRACE_FREE(s) { .slot = (s), .size = 0 }
+
+#include "alloc_trace.h"
+
+K_MEM_POOL_DEFINE(buddy_pool, 16, POOL_SIZE / 4, 4, 4);
+K_MEM_POOL_TLSF_DEFINE(tlsf_pool, POOL_SIZE, 4);
+
+struct trace_stats {
+	u32_t allocs;
+	u32_t failures;
+	u32_t peak_bytes;
+	u32_t alloc_total;
+	u32_t alloc_worst;
+	u32_t free_total;
+	u32_t free_worst;
+};
+
+static void *slots[TRACE_SLOTS];
+static u16_t slot_sizes[TRACE_SLOTS];
+
+static void replay(struct k_mem_pool *pool, struct trace_stats *stats)
+{
+	u32_t bytes = 0;
+	u32_t start, t;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(trace); i++) {
+		const struct trace_op *op = &trace[i];
+
+		if (op->size) {
+			start = k_cycle_get_32();
+			slots[op->slot] = k_mem_pool_malloc(pool, op->size);
+			t = k_cycle_get_32() - start;
+
+			stats->allocs++;
+			stats->alloc_total += t;
+			stats->alloc_worst = max(stats->alloc_worst, t);
+
+			if (!slots[op->slot]) {
+				stats->failures++;
+				continue;
+			}
+
+			slot_sizes[op->slot] = op->size;
+			bytes += op->size;
+			stats->peak_bytes = max(stats->peak_bytes, bytes);
+		} else if (slots[op->slot]) {
+			start = k_cycle_get_32();
+			k_free(slots[op->slot]);
+			t = k_cycle_get_32() - start;
+
+			stats->free_total += t;
+			stats->free_worst = max(stats->free_worst, t);
+
+			slots[op->slot] = NULL;
+			bytes -= slot_sizes[op->slot];
+		}
+	}
+}
+
+static void report(const char *name, struct trace_stats *stats)
+{
+	u32_t frees = stats->allocs - stats->failures;
+
+	TC_PRINT(" %s pool:\n", name);
+	TC_PRINT("   failed allocations: %u of %u\n", stats->failures,
+		 stats->allocs);
+	TC_PRINT("   peak requested bytes held: %u of %u\n",
+		 stats->peak_bytes, POOL_SIZE);
+	TC_PRINT("   alloc: avg %u max %u cycles\n",
+		 stats->alloc_total / stats->allocs, stats->alloc_worst);
+	TC_PRINT("   free:  avg %u max %u cycles\n",
+		 frees ? stats->free_total / frees : 0, stats->free_worst);
+}
+
+void main(void)
+{
+	struct trace_stats buddy = { 0 }, tlsf = { 0 };
+	int i;
+
+	TC_START("Memory pool allocation trace");
+
+	TC_PRINT(" %d operations, %d rounds, %d byte pools\n",
+		 (int)ARRAY_SIZE(trace), N_ROUNDS, POOL_SIZE);
+
+	for (i = 0; i < N_ROUNDS; i++) {
+		replay(&buddy_pool, &buddy);
+	}
+	report("buddy", &buddy);
+
+	for (i = 0; i < N_ROUNDS; i++) {
+		replay(&tlsf_pool, &tlsf);
+	}
+	report("TLSF", &tlsf);
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
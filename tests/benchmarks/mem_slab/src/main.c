@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure memory slab allocation throughput.
+ *
+ * Blocks are allocated and freed from a thread, in pairs and in bursts
+ * larger than a magazine, then in pairs from an ISR. The results are
+ * meant to be compared between builds with and without
+ * CONFIG_MEM_SLAB_MAGAZINE.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <irq_offload.h>
+
+#define BLOCK_SIZE 64
+#define N_BLOCKS 64
+
+/* alloc/free pairs done by each test */
+#define N_PAIRS 10000
+
+/* blocks allocated at once in the burst test */
+#define BURST 32
+
+K_MEM_SLAB_DEFINE(bench_slab, BLOCK_SIZE, N_BLOCKS, 4);
+
+static void *burst_blocks[BURST];
+
+static u32_t isr_cycles;
+
+static void alloc_free_pairs(void)
+{
+	void *block;
+	int i;
+
+	for (i = 0; i < N_PAIRS; i++) {
+		k_mem_slab_alloc(&bench_slab, &block, K_NO_WAIT);
+		k_mem_slab_free(&bench_slab, &block);
+	}
+}
+
+static void alloc_free_bursts(void)
+{
+	int i, j;
+
+	for (i = 0; i < N_PAIRS / BURST; i++) {
+		for (j = 0; j < BURST; j++) {
+			k_mem_slab_alloc(&bench_slab, &burst_blocks[j],
+					 K_NO_WAIT);
+		}
+		for (j = 0; j < BURST; j++) {
+			k_mem_slab_free(&bench_slab, &burst_blocks[j]);
+		}
+	}
+}
+
+static void isr_alloc_free_pairs(void *arg)
+{
+	u32_t start;
+
+	ARG_UNUSED(arg);
+
+	start = k_cycle_get_32();
+	alloc_free_pairs();
+	isr_cycles = k_cycle_get_32() - start;
+}
+
+static void report(const char *what, u32_t pairs, u32_t cycles)
+{
+	u64_t ns = SYS_CLOCK_HW_CYCLES_TO_NS64(cycles);
+	u32_t rate = 0;
+
+	if (ns) {
+		rate = (u32_t)((u64_t)pairs * NSEC_PER_SEC / ns);
+	}
+
+	TC_PRINT(" %-24s %u cycles/pair, %u pairs/sec\n", what,
+		 cycles / pairs, rate);
+}
+
+void main(void)
+{
+	u32_t start, cycles;
+	int status = TC_PASS;
+
+	TC_START("Memory slab alloc/free throughput");
+
+	TC_PRINT(" %d blocks of %d bytes, magazine cache %s\n",
+		 N_BLOCKS, BLOCK_SIZE,
+		 IS_ENABLED(CONFIG_MEM_SLAB_MAGAZINE) ? "enabled" : "disabled");
+
+	start = k_cycle_get_32();
+	alloc_free_pairs();
+	cycles = k_cycle_get_32() - start;
+	report("thread, pairs", N_PAIRS, cycles);
+
+	start = k_cycle_get_32();
+	alloc_free_bursts();
+	cycles = k_cycle_get_32() - start;
+	report("thread, bursts", (N_PAIRS / BURST) * BURST, cycles);
+
+	irq_offload(isr_alloc_free_pairs, NULL);
+	report("ISR, pairs", N_PAIRS, isr_cycles);
+
+	/* every block must be back, cached or not */
+	if (k_mem_slab_num_used_get(&bench_slab) != 0 ||
+	    k_mem_slab_num_free_get(&bench_slab) != N_BLOCKS) {
+		TC_ERROR("blocks leaked: %u used\n",
+			 k_mem_slab_num_used_get(&bench_slab));
+		status = TC_FAIL;
+	}
+
+	TC_END_RESULT(status);
+	TC_END_REPORT(status);
+}
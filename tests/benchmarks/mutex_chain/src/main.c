@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the latency of a mutex at the end of a priority inheritance chain.
+ *
+ * Low priority threads each own a mutex and wait on the previous one, the
+ * first one owning its mutex for a short work. The main thread, at high
+ * priority, locks the last mutex while a medium priority thread loads the
+ * CPU, and the time it waits for the mutex is measured.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+#define CHAIN_LEN 4
+#define ITERATIONS 10
+
+/* work of the head of the chain and length of the load, in milliseconds */
+#define WORK_MS 1
+#define LOAD_MS 50
+
+#define STACK_SIZE 1024
+
+#define LOW_PRIO K_PRIO_PREEMPT(10)
+#define LOAD_PRIO K_PRIO_PREEMPT(5)
+
+static struct k_mutex chain_mutex[CHAIN_LEN];
+static K_SEM_DEFINE(go_sem, 0, 1);
+
+static K_THREAD_STACK_ARRAY_DEFINE(chain_stack, CHAIN_LEN, STACK_SIZE);
+static struct k_thread chain_thread[CHAIN_LEN];
+static K_THREAD_STACK_DEFINE(load_stack, STACK_SIZE);
+static struct k_thread load_thread;
+
+static void work(int ms)
+{
+	int i;
+
+	for (i = 0; i < ms; i++) {
+		k_busy_wait(USEC_PER_MSEC);
+	}
+}
+
+static void chain_entry(void *p1, void *p2, void *p3)
+{
+	int i = POINTER_TO_INT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_mutex_lock(&chain_mutex[i], K_FOREVER);
+
+	if (i == 0) {
+		k_sem_take(&go_sem, K_FOREVER);
+		work(WORK_MS);
+	} else {
+		k_mutex_lock(&chain_mutex[i - 1], K_FOREVER);
+		k_mutex_unlock(&chain_mutex[i - 1]);
+	}
+
+	k_mutex_unlock(&chain_mutex[i]);
+}
+
+static void load_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	work(LOAD_MS);
+}
+
+static void measure(u32_t *ms, u32_t *cycles)
+{
+	u32_t start_ms, start_cycles;
+	int i;
+
+	for (i = 0; i < CHAIN_LEN; i++) {
+		k_mutex_init(&chain_mutex[i]);
+		k_thread_create(&chain_thread[i], chain_stack[i], STACK_SIZE,
+				chain_entry, INT_TO_POINTER(i), NULL, NULL,
+				LOW_PRIO, 0, 0);
+	}
+
+	/* let the chain build up */
+	k_sleep(10);
+
+	k_thread_create(&load_thread, load_stack, STACK_SIZE, load_entry,
+			NULL, NULL, NULL, LOAD_PRIO, 0, 0);
+	k_sem_give(&go_sem);
+
+	start_ms = k_uptime_get_32();
+	start_cycles = k_cycle_get_32();
+
+	k_mutex_lock(&chain_mutex[CHAIN_LEN - 1], K_FOREVER);
+
+	*cycles = k_cycle_get_32() - start_cycles;
+	*ms = k_uptime_get_32() - start_ms;
+
+	k_mutex_unlock(&chain_mutex[CHAIN_LEN - 1]);
+
+	/* let the load and the chain complete */
+	k_sleep(LOAD_MS + 10);
+
+	k_thread_abort(&load_thread);
+	for (i = 0; i < CHAIN_LEN; i++) {
+		k_thread_abort(&chain_thread[i]);
+	}
+}
+
+void main(void)
+{
+	u32_t ms, cycles;
+	u32_t sum_ms = 0, sum_cycles = 0, max_ms = 0, max_cycles = 0;
+	int i;
+
+	TC_START("Mutex priority inheritance chain latency");
+
+	for (i = 0; i < ITERATIONS; i++) {
+		measure(&ms, &cycles);
+
+		sum_ms += ms;
+		sum_cycles += cycles;
+		max_ms = max(max_ms, ms);
+		max_cycles = max(max_cycles, cycles);
+	}
+
+	TC_PRINT(" chain of %d mutexes, inheritance depth %d, %d ms work,"
+		 " %d ms load\n", CHAIN_LEN,
+		 CONFIG_MUTEX_PRIORITY_INHERITANCE_DEPTH, WORK_MS, LOAD_MS);
+	TC_PRINT(" average wait: %6u ms %10u cycles\n",
+		 sum_ms / ITERATIONS, sum_cycles / ITERATIONS);
+	TC_PRINT(" worst wait:   %6u ms %10u cycles\n", max_ms, max_cycles);
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the lookup of the connection of received UDP packets.
+ *
+ * UDP connections, each with its own peer address and ports, are registered
+ * in steps, and after each step packets for the last connection registered
+ * are passed to net_conn_input(). The benchmark reports the average time
+ * per packet for each number of connections.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_ip.h>
+#include <net/udp.h>
+
+#include "connection.h"
+
+#ifdef CONFIG_BOARD_NATIVE_POSIX
+#include "timer_model.h"
+#endif
+
+#define N_PACKETS 100000
+
+#define LOCAL_PORT 4000
+#define REMOTE_PORT 5000
+
+static const int steps[] = { 1, 8, 16, 32, CONFIG_NET_MAX_CONN };
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+
+static int received;
+
+static int dummy_dev_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	static u8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+}
+
+static int dummy_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	net_pkt_unref(pkt);
+
+	return 0;
+}
+
+static struct net_if_api dummy_api = {
+	.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(net_conn_bench, "net_conn_bench", dummy_dev_init, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static enum net_verdict recv_cb(struct net_conn *conn, struct net_pkt *pkt,
+				void *user_data)
+{
+	/* keep the packet, it is passed again */
+	received++;
+
+	return NET_OK;
+}
+
+static void peer_addr(int i, struct in_addr *addr)
+{
+	addr->s4_addr[0] = 198;
+	addr->s4_addr[1] = 51;
+	addr->s4_addr[2] = 100;
+	addr->s4_addr[3] = 10 + i;
+}
+
+static int register_conn(int i)
+{
+	struct sockaddr_in remote = { .sin_family = AF_INET };
+	struct sockaddr_in local = { .sin_family = AF_INET };
+
+	peer_addr(i, &remote.sin_addr);
+	net_ipaddr_copy(&local.sin_addr, &my_addr);
+
+	return net_conn_register(IPPROTO_UDP, (struct sockaddr *)&remote,
+				 (struct sockaddr *)&local, REMOTE_PORT + i,
+				 LOCAL_PORT + i, recv_cb, NULL, NULL);
+}
+
+/* The time of native_posix is simulated and stands still while the lookups
+ * run, they are timed with the host time instead.
+ */
+static u64_t time_us(void)
+{
+#ifdef CONFIG_BOARD_NATIVE_POSIX
+	return hwtimer_get_host_time();
+#else
+	return (u64_t)k_uptime_get() * USEC_PER_MSEC;
+#endif
+}
+
+static struct net_pkt *build_pkt(struct net_if *iface, int i)
+{
+	struct net_pkt *pkt;
+	struct net_buf *frag;
+	struct net_udp_hdr *udp_hdr;
+
+	pkt = net_pkt_get_reserve_rx(0, K_FOREVER);
+	frag = net_pkt_get_frag(pkt, K_FOREVER);
+	net_pkt_frag_add(pkt, frag);
+
+	net_pkt_set_iface(pkt, iface);
+	net_pkt_set_family(pkt, AF_INET);
+	net_pkt_set_ip_hdr_len(pkt, sizeof(struct net_ipv4_hdr));
+
+	net_buf_add(frag, sizeof(struct net_ipv4_hdr) +
+		    sizeof(struct net_udp_hdr));
+
+	NET_IPV4_HDR(pkt)->vhl = 0x45;
+	NET_IPV4_HDR(pkt)->len[1] = sizeof(struct net_ipv4_hdr) +
+				    sizeof(struct net_udp_hdr);
+	NET_IPV4_HDR(pkt)->proto = IPPROTO_UDP;
+	peer_addr(i, &NET_IPV4_HDR(pkt)->src);
+	net_ipaddr_copy(&NET_IPV4_HDR(pkt)->dst, &my_addr);
+
+	udp_hdr = (struct net_udp_hdr *)net_pkt_udp_data(pkt);
+	udp_hdr->src_port = htons(REMOTE_PORT + i);
+	udp_hdr->dst_port = htons(LOCAL_PORT + i);
+	udp_hdr->len = htons(sizeof(struct net_udp_hdr));
+
+	return pkt;
+}
+
+void main(void)
+{
+	struct net_if *iface = net_if_get_default();
+	struct net_pkt *pkt;
+	int conns = 0;
+	bool failed = false;
+	u64_t start, elapsed;
+	int i, step;
+
+	TC_START("Network connection lookup");
+
+	net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0);
+
+	for (step = 0; step < ARRAY_SIZE(steps); step++) {
+		for (; conns < steps[step]; conns++) {
+			if (register_conn(conns) < 0) {
+				TC_ERROR("cannot register connection %d\n",
+					 conns);
+				failed = true;
+				goto out;
+			}
+		}
+
+		pkt = build_pkt(iface, conns - 1);
+		received = 0;
+
+		start = time_us();
+		for (i = 0; i < N_PACKETS; i++) {
+			net_conn_input(IPPROTO_UDP, pkt);
+		}
+		elapsed = time_us() - start;
+
+		net_pkt_unref(pkt);
+
+		if (received != N_PACKETS) {
+			TC_ERROR("%d packets received out of %d\n",
+				 received, N_PACKETS);
+			failed = true;
+		}
+
+		TC_PRINT(" %3d connections: %6u ns per packet\n", conns,
+			 (u32_t)(elapsed * NSEC_PER_USEC / N_PACKETS));
+	}
+
+out:
+	TC_END_RESULT(failed ? TC_FAIL : TC_PASS);
+	TC_END_REPORT(failed ? TC_FAIL : TC_PASS);
+}
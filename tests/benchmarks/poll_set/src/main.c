@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the wakeup cost of k_poll() and of poll sets against the number
+ * of events waited for.
+ *
+ * A waiter thread waits for one of N semaphores, either with k_poll() on
+ * an array of N events or with k_poll_set_wait() on a poll set holding the
+ * N events, and takes the semaphore it was woken up for. The main thread,
+ * of lower priority, gives the semaphores in turn. The benchmark reports
+ * the average number of cycles per wakeup.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+#define MAX_EVENTS 64
+#define N_WAKEUPS 256
+
+#define STACK_SIZE 1024
+
+static const int event_counts[] = { 1, 8, 32, 64 };
+
+static struct k_sem sems[MAX_EVENTS];
+static struct k_poll_event events[MAX_EVENTS];
+static struct k_poll_set set;
+
+static K_THREAD_STACK_DEFINE(waiter_stack, STACK_SIZE);
+static struct k_thread waiter_thread;
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+static bool failed;
+
+static void init_events(int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++) {
+		k_sem_init(&sems[i], 0, 1);
+		k_poll_event_init(&events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &sems[i]);
+	}
+}
+
+/* Take the semaphore of the n-th wakeup, which must be the one ready */
+static void take(struct k_poll_event *event, int i, int n)
+{
+	if (event != &events[i % n] ||
+	    k_sem_take(event->sem, K_NO_WAIT) != 0) {
+		failed = true;
+	}
+}
+
+static void poll_waiter(void *p1, void *p2, void *p3)
+{
+	int n = (int)(uintptr_t)p1;
+	int i, j;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < N_WAKEUPS; i++) {
+		for (j = 0; j < n; j++) {
+			events[j].state = K_POLL_STATE_NOT_READY;
+		}
+
+		if (k_poll(events, n, K_FOREVER) != 0) {
+			failed = true;
+			break;
+		}
+
+		for (j = 0; j < n; j++) {
+			if (events[j].state != K_POLL_STATE_NOT_READY) {
+				take(&events[j], i, n);
+				break;
+			}
+		}
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void set_waiter(void *p1, void *p2, void *p3)
+{
+	int n = (int)(uintptr_t)p1;
+	struct k_poll_event *ready;
+	int i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < N_WAKEUPS; i++) {
+		if (k_poll_set_wait(&set, &ready, 1, K_FOREVER) != 1) {
+			failed = true;
+			break;
+		}
+
+		take(ready, i, n);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static u32_t wakeups(k_thread_entry_t waiter, int n)
+{
+	u32_t start;
+	int i;
+
+	/* the waiter runs first and waits for the semaphores */
+	k_thread_create(&waiter_thread, waiter_stack, STACK_SIZE,
+			waiter, (void *)(uintptr_t)n, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, 0);
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < N_WAKEUPS; i++) {
+		k_sem_give(&sems[i % n]);
+	}
+	k_sem_take(&done_sem, K_FOREVER);
+
+	return k_cycle_get_32() - start;
+}
+
+static u32_t poll_wakeups(int n)
+{
+	init_events(n);
+
+	return wakeups(poll_waiter, n);
+}
+
+static u32_t set_wakeups(int n)
+{
+	u32_t cycles;
+	int i;
+
+	init_events(n);
+
+	k_poll_set_init(&set);
+	for (i = 0; i < n; i++) {
+		k_poll_set_add(&set, &events[i]);
+	}
+
+	cycles = wakeups(set_waiter, n);
+
+	for (i = 0; i < n; i++) {
+		k_poll_set_remove(&set, &events[i]);
+	}
+
+	return cycles;
+}
+
+static void report(const char *what, int n, u32_t cycles)
+{
+	TC_PRINT(" %-8s %2d events: %6u cycles per wakeup\n", what, n,
+		 cycles / N_WAKEUPS);
+}
+
+void main(void)
+{
+	int i;
+
+	TC_START("Poll set wakeup cost");
+
+	/* the waiter must preempt the thread giving the semaphores */
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(1));
+
+	for (i = 0; i < ARRAY_SIZE(event_counts); i++) {
+		report("k_poll", event_counts[i],
+		       poll_wakeups(event_counts[i]));
+	}
+
+	for (i = 0; i < ARRAY_SIZE(event_counts); i++) {
+		report("poll set", event_counts[i],
+		       set_wakeups(event_counts[i]));
+	}
+
+	TC_END_RESULT(failed ? TC_FAIL : TC_PASS);
+	TC_END_REPORT(failed ? TC_FAIL : TC_PASS);
+}
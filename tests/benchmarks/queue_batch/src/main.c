@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the cost of queue operations on single items and on batches.
+ *
+ * The same number of data items goes through a k_queue, either one item
+ * at a time or in batches of various sizes, first within a single thread,
+ * then from a producer thread to a waiting consumer thread. The benchmark
+ * reports the average number of cycles spent per data item.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+#define N_ITEMS 256
+#define MAX_BATCH 16
+
+#define STACK_SIZE 1024
+
+struct item {
+	void *reserved;	/* for the kernel */
+	u32_t seq;
+};
+
+static const int batch_sizes[] = { 1, 4, 16 };
+
+static struct item items[N_ITEMS];
+static struct k_queue queue;
+
+static K_THREAD_STACK_DEFINE(consumer_stack, STACK_SIZE);
+static struct k_thread consumer_thread;
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+static bool failed;
+
+/* Put items [first, first + n) in the queue */
+static void put(int first, int n)
+{
+	void *batch[MAX_BATCH];
+	int i;
+
+	if (n == 1) {
+		k_queue_append(&queue, &items[first]);
+		return;
+	}
+
+	for (i = 0; i < n; i++) {
+		batch[i] = &items[first + i];
+	}
+	k_queue_append_batch(&queue, batch, n);
+}
+
+/* Get up to n items from the queue, checking they come in order */
+static int get(int first, int n, s32_t timeout)
+{
+	void *batch[MAX_BATCH];
+	int got, i;
+
+	if (n == 1) {
+		batch[0] = k_queue_get(&queue, timeout);
+		got = batch[0] ? 1 : 0;
+	} else {
+		got = k_queue_get_batch(&queue, batch, n, timeout);
+	}
+
+	for (i = 0; i < got; i++) {
+		if (((struct item *)batch[i])->seq != first + i) {
+			failed = true;
+		}
+	}
+
+	return got;
+}
+
+static u32_t single_thread(int batch)
+{
+	u32_t start = k_cycle_get_32();
+	int i;
+
+	for (i = 0; i < N_ITEMS; i += batch) {
+		put(i, batch);
+	}
+
+	for (i = 0; i < N_ITEMS; ) {
+		i += get(i, batch, K_NO_WAIT);
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	int batch = (int)(uintptr_t)p1;
+	int i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < N_ITEMS; ) {
+		i += get(i, batch, K_FOREVER);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static u32_t producer_consumer(int batch)
+{
+	u32_t start;
+	int i;
+
+	/* the consumer runs first and waits on the empty queue */
+	k_thread_create(&consumer_thread, consumer_stack, STACK_SIZE,
+			consumer, (void *)(uintptr_t)batch, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, 0);
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < N_ITEMS; i += batch) {
+		put(i, batch);
+	}
+	k_sem_take(&done_sem, K_FOREVER);
+
+	return k_cycle_get_32() - start;
+}
+
+static void report(const char *what, int batch, u32_t cycles)
+{
+	TC_PRINT(" %-18s batch %2d: %6u cycles per item\n", what, batch,
+		 cycles / N_ITEMS);
+}
+
+void main(void)
+{
+	int i;
+
+	TC_START("Queue batch operations");
+
+	for (i = 0; i < N_ITEMS; i++) {
+		items[i].seq = i;
+	}
+	k_queue_init(&queue);
+
+	/* consumers must preempt the producer */
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(1));
+
+	for (i = 0; i < ARRAY_SIZE(batch_sizes); i++) {
+		report("single thread", batch_sizes[i],
+		       single_thread(batch_sizes[i]));
+	}
+
+	for (i = 0; i < ARRAY_SIZE(batch_sizes); i++) {
+		report("producer/consumer", batch_sizes[i],
+		       producer_consumer(batch_sizes[i]));
+	}
+
+	TC_END_RESULT(failed ? TC_FAIL : TC_PASS);
+	TC_END_REPORT(failed ? TC_FAIL : TC_PASS);
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the throughput of the word-based and byte ring buffers.
+ *
+ * Chunks of data are written to a ring buffer until it is a quarter full,
+ * then read back, until the same total amount of data has gone through
+ * each kind of ring buffer. The benchmark reports the cycles spent per KB.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <ring_buffer.h>
+#include <string.h>
+
+#define RING_POW 10
+#define RING_BYTES ((1 << RING_POW) * sizeof(u32_t))
+
+/* data written before being read back, the word ring buffer holds
+ * twice as much for 4 byte chunks with their headers
+ */
+#define FILL_BYTES (RING_BYTES / 4)
+
+/* data moved through each ring buffer for each chunk size */
+#define TOTAL_BYTES (256 * 1024)
+
+static const int chunk_sizes[] = { 4, 16, 64, 252 };
+
+SYS_RING_BUF_DECLARE_POW2(word_ring, RING_POW);
+static u8_t byte_ring_data[RING_BYTES];
+static struct byte_ring ring;
+
+static u32_t chunk[256 / sizeof(u32_t)];
+static u32_t rx_chunk[256 / sizeof(u32_t)];
+
+static bool failed;
+
+static void check(int len)
+{
+	if (memcmp(chunk, rx_chunk, len)) {
+		failed = true;
+	}
+}
+
+static u32_t word_ring_run(int len)
+{
+	u32_t start = k_cycle_get_32();
+	u8_t size32, value;
+	u16_t type;
+	int moved, n, key;
+
+	for (moved = 0; moved < TOTAL_BYTES; ) {
+		for (n = 0; n < FILL_BYTES; n += len) {
+			key = irq_lock();
+			if (sys_ring_buf_put(&word_ring, 0, 0, chunk,
+					     len / sizeof(u32_t))) {
+				failed = true;
+			}
+			irq_unlock(key);
+		}
+
+		for (; n > 0; n -= len) {
+			size32 = ARRAY_SIZE(rx_chunk);
+			key = irq_lock();
+			if (sys_ring_buf_get(&word_ring, &type, &value,
+					     rx_chunk, &size32)) {
+				failed = true;
+			}
+			irq_unlock(key);
+			check(len);
+			moved += len;
+		}
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static u32_t byte_ring_run(int len, bool mpsc)
+{
+	u32_t start = k_cycle_get_32();
+	int moved, n;
+
+	sys_byte_ring_init(&ring, RING_BYTES, byte_ring_data);
+
+	for (moved = 0; moved < TOTAL_BYTES; ) {
+		for (n = 0; n < FILL_BYTES; n += len) {
+			u32_t put;
+
+			if (mpsc) {
+				put = sys_byte_ring_mpsc_put(&ring,
+							     (u8_t *)chunk,
+							     len);
+			} else {
+				put = sys_byte_ring_put(&ring, (u8_t *)chunk,
+							len);
+			}
+			if (put != len) {
+				failed = true;
+			}
+		}
+
+		for (; n > 0; n -= len) {
+			if (sys_byte_ring_get(&ring, (u8_t *)rx_chunk,
+					      len) != len) {
+				failed = true;
+			}
+			check(len);
+			moved += len;
+		}
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static u32_t byte_ring_zero_copy_run(int len)
+{
+	u32_t start = k_cycle_get_32();
+	u32_t sum = 0;
+	int moved, n, i;
+	u32_t got;
+	u8_t *data;
+
+	sys_byte_ring_init(&ring, RING_BYTES, byte_ring_data);
+
+	for (moved = 0; moved < TOTAL_BYTES; ) {
+		/* produce and consume the data in place */
+		for (n = 0; n < FILL_BYTES; n += got) {
+			got = sys_byte_ring_put_claim(&ring, &data, len);
+			memset(data, (u8_t)n, got);
+			sys_byte_ring_put_commit(&ring, got);
+		}
+
+		while ((got = sys_byte_ring_peek(&ring, &data, len))) {
+			for (i = 0; i < got; i++) {
+				sum += data[i];
+			}
+			sys_byte_ring_consume(&ring, got);
+			moved += got;
+		}
+	}
+
+	/* keep the reads from being optimized out */
+	if (sum == 1) {
+		TC_PRINT(" checksum %u\n", sum);
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static void report(const char *what, int len, u32_t cycles)
+{
+	TC_PRINT(" %-20s %3d byte chunks: %8u cycles per KB\n", what, len,
+		 cycles / (TOTAL_BYTES / 1024));
+}
+
+void main(void)
+{
+	int i, len;
+
+	TC_START("Ring buffer throughput");
+
+	for (i = 0; i < ARRAY_SIZE(chunk); i++) {
+		chunk[i] = 0x01020304 * (i + 1);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(chunk_sizes); i++) {
+		len = chunk_sizes[i];
+
+		report("word ring", len, word_ring_run(len));
+		report("byte ring copy", len, byte_ring_run(len, false));
+		report("byte ring zero-copy", len,
+		       byte_ring_zero_copy_run(len));
+		report("byte ring MPSC", len, byte_ring_run(len, true));
+	}
+
+	TC_END_RESULT(failed ? TC_FAIL : TC_PASS);
+	TC_END_REPORT(failed ? TC_FAIL : TC_PASS);
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure scheduler throughput against the number of CPUs in use.
+ *
+ * For 1 to CONFIG_MP_NUM_CPUS pairs of threads, each pair either yields
+ * back and forth or passes a semaphore back and forth a fixed number of
+ * times. All pairs run concurrently, so with one pair per CPU the total
+ * throughput should scale with the number of CPUs if the scheduler does
+ * not serialize them.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+#define STACK_SIZE 1024
+#define THREAD_PRIO K_PRIO_PREEMPT(5)
+
+/* round trips done by each pair of threads */
+#define N_ROUNDS 10000
+
+#define N_PAIRS CONFIG_MP_NUM_CPUS
+
+K_THREAD_STACK_ARRAY_DEFINE(ping_stacks, N_PAIRS, STACK_SIZE);
+K_THREAD_STACK_ARRAY_DEFINE(pong_stacks, N_PAIRS, STACK_SIZE);
+static struct k_thread ping_threads[N_PAIRS];
+static struct k_thread pong_threads[N_PAIRS];
+
+static struct k_sem ping_sems[N_PAIRS];
+static struct k_sem pong_sems[N_PAIRS];
+
+/* given by each thread when done */
+static K_SEM_DEFINE(done_sem, 0, 2 * N_PAIRS);
+
+static void yield_thread(void *p1, void *p2, void *p3)
+{
+	int i;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < N_ROUNDS; i++) {
+		k_yield();
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void ping_thread(void *p1, void *p2, void *p3)
+{
+	int pair = (int)(uintptr_t)p1;
+	int i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < N_ROUNDS; i++) {
+		k_sem_give(&ping_sems[pair]);
+		k_sem_take(&pong_sems[pair], K_FOREVER);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void pong_thread(void *p1, void *p2, void *p3)
+{
+	int pair = (int)(uintptr_t)p1;
+	int i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < N_ROUNDS; i++) {
+		k_sem_take(&ping_sems[pair], K_FOREVER);
+		k_sem_give(&pong_sems[pair]);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+/**
+ *
+ * @brief Run @a pairs pairs of threads until they are all done
+ *
+ * @return the number of hardware cycles it took
+ */
+static u32_t run_pairs(int pairs, k_thread_entry_t ping, k_thread_entry_t pong)
+{
+	u32_t start, end;
+	int i;
+
+	/* The threads have a lower priority than main: they all start
+	 * together when main blocks on done_sem.
+	 */
+	for (i = 0; i < pairs; i++) {
+		k_sem_init(&ping_sems[i], 0, 1);
+		k_sem_init(&pong_sems[i], 0, 1);
+
+		k_thread_create(&ping_threads[i], ping_stacks[i], STACK_SIZE,
+				ping, (void *)(uintptr_t)i, NULL, NULL,
+				THREAD_PRIO, 0, K_NO_WAIT);
+		k_thread_create(&pong_threads[i], pong_stacks[i], STACK_SIZE,
+				pong, (void *)(uintptr_t)i, NULL, NULL,
+				THREAD_PRIO, 0, K_NO_WAIT);
+	}
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < 2 * pairs; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	end = k_cycle_get_32();
+
+	/* The threads may not have exited yet: make sure they are gone
+	 * before their k_thread structures are reused.
+	 */
+	for (i = 0; i < pairs; i++) {
+		k_thread_abort(&ping_threads[i]);
+		k_thread_abort(&pong_threads[i]);
+	}
+
+	return end - start;
+}
+
+static void report(const char *what, int pairs, u32_t cycles)
+{
+	u32_t ops = pairs * N_ROUNDS;
+
+	TC_PRINT(" %-28s %d pair(s): %u cycles, %u cycles/round trip,"
+		 " %u nsec/round trip\n", what, pairs, cycles, cycles / ops,
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(cycles, ops));
+}
+
+void main(void)
+{
+	int pairs;
+
+	TC_START("Scheduler SMP throughput");
+
+	TC_PRINT(" %d CPU(s), %d round trips per pair\n",
+		 CONFIG_MP_NUM_CPUS, N_ROUNDS);
+
+	for (pairs = 1; pairs <= N_PAIRS; pairs++) {
+		report("k_yield() context switch", pairs,
+		       run_pairs(pairs, yield_thread, yield_thread));
+	}
+
+	for (pairs = 1; pairs <= N_PAIRS; pairs++) {
+		report("k_sem ping-pong", pairs,
+		       run_pairs(pairs, ping_thread, pong_thread));
+	}
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2018 Linaro Limited
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the readiness of many idle sockets and one active socket.
+ *
+ * UDP sockets are opened in steps, the first one holding a datagram, and
+ * after each step poll() and epoll_wait() are called without waiting on all
+ * the sockets. The benchmark reports the average number of cycles per call
+ * for each number of sockets.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <net/socket.h>
+
+#define N_CALLS 1000
+
+#define PORT 4000
+
+#define MAX_SOCKS CONFIG_NET_SOCKETS_POLL_MAX
+
+static const int steps[] = { 1, 8, 16, 32, MAX_SOCKS };
+
+static struct pollfd fds[MAX_SOCKS];
+
+static int open_sock(int i)
+{
+	struct sockaddr_in addr = { .sin_family = AF_INET };
+	int sock;
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		return sock;
+	}
+
+	addr.sin_port = htons(PORT + i);
+	inet_pton(AF_INET, CONFIG_NET_APP_MY_IPV4_ADDR, &addr.sin_addr);
+	if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		close(sock);
+		return -1;
+	}
+
+	return sock;
+}
+
+static int send_datagram(void)
+{
+	struct sockaddr_in addr = { .sin_family = AF_INET };
+	int sock, len;
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		return sock;
+	}
+
+	addr.sin_port = htons(PORT);
+	inet_pton(AF_INET, CONFIG_NET_APP_MY_IPV4_ADDR, &addr.sin_addr);
+	len = sendto(sock, "test", 4, 0, (struct sockaddr *)&addr,
+		     sizeof(addr));
+	close(sock);
+
+	/* let the datagram go through the loopback interface */
+	k_sleep(100);
+
+	return len == 4 ? 0 : -1;
+}
+
+void main(void)
+{
+	struct epoll_event event, ready[4];
+	u32_t start, poll_cycles, epoll_cycles;
+	bool failed = false;
+	int epfd, socks = 0;
+	int i, step;
+
+	TC_START("Socket readiness");
+
+	epfd = epoll_create(1);
+	if (epfd < 0) {
+		TC_ERROR("cannot create epoll instance\n");
+		failed = true;
+		goto out;
+	}
+
+	for (step = 0; step < ARRAY_SIZE(steps); step++) {
+		for (; socks < steps[step]; socks++) {
+			fds[socks].fd = open_sock(socks);
+			fds[socks].events = POLLIN;
+			event.events = EPOLLIN;
+			event.data.fd = fds[socks].fd;
+
+			if (fds[socks].fd < 0 ||
+			    epoll_ctl(epfd, EPOLL_CTL_ADD, fds[socks].fd,
+				      &event) < 0) {
+				TC_ERROR("cannot open socket %d\n", socks);
+				failed = true;
+				goto out;
+			}
+		}
+
+		if (socks == 1 && send_datagram() < 0) {
+			TC_ERROR("cannot send datagram\n");
+			failed = true;
+			goto out;
+		}
+
+		start = k_cycle_get_32();
+		for (i = 0; i < N_CALLS; i++) {
+			if (poll(fds, socks, 0) != 1) {
+				failed = true;
+			}
+		}
+		poll_cycles = k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		for (i = 0; i < N_CALLS; i++) {
+			if (epoll_wait(epfd, ready, ARRAY_SIZE(ready), 0) != 1) {
+				failed = true;
+			}
+		}
+		epoll_cycles = k_cycle_get_32() - start;
+
+		if (failed) {
+			TC_ERROR("unexpected number of sockets ready\n");
+			goto out;
+		}
+
+		TC_PRINT(" %3d sockets: poll %6u epoll_wait %6u cycles per call\n",
+			 socks, poll_cycles / N_CALLS, epoll_cycles / N_CALLS);
+	}
+
+out:
+	TC_END_RESULT(failed ? TC_FAIL : TC_PASS);
+	TC_END_REPORT(failed ? TC_FAIL : TC_PASS);
+}
@@ -0,0 +1,169 @@
+/* sched.c */
+
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "syskernel.h"
+
+/* maximum number of ready threads queued behind the yielding threads */
+#define N_READY_MAX 32
+
+#define READY_STACK_SIZE 512
+
+K_THREAD_STACK_ARRAY_DEFINE(ready_stacks, N_READY_MAX, READY_STACK_SIZE);
+static struct k_thread ready_threads[N_READY_MAX];
+
+static const int ready_counts[] = { 0, 8, N_READY_MAX };
+
+/**
+ *
+ * @brief Ready thread, never gets to run
+ *
+ * @return N/A
+ */
+static void ready_thread(void *par1, void *par2, void *par3)
+{
+	ARG_UNUSED(par1);
+	ARG_UNUSED(par2);
+	ARG_UNUSED(par3);
+}
+
+/**
+ *
+ * @brief Yield test thread
+ *
+ * @param par1   Address of the counter, or NULL.
+ * @param par2   Number of test loops.
+ * @param par3   Unused
+ *
+ * @return N/A
+ */
+static void yield_thread(void *par1, void *par2, void *par3)
+{
+	int i;
+	int *pcounter = (int *)par1;
+	int num_loops = (int) par2;
+
+	ARG_UNUSED(par3);
+
+	for (i = 0; i < num_loops; i++) {
+		k_yield();
+		if (pcounter) {
+			(*pcounter)++;
+		}
+	}
+}
+
+/**
+ *
+ * @brief Make @a count threads ready, with priorities lower than main
+ *
+ * The threads are spread over the preemptible priorities so that the
+ * ready queue holds many threads at several priority levels.
+ *
+ * @return N/A
+ */
+static void ready_threads_start(int count)
+{
+	int prio_span = CONFIG_NUM_PREEMPT_PRIORITIES - 2;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		k_thread_create(&ready_threads[i], ready_stacks[i],
+				READY_STACK_SIZE, ready_thread,
+				NULL, NULL, NULL,
+				K_PRIO_PREEMPT(1 + (i % prio_span)), 0,
+				K_NO_WAIT);
+	}
+}
+
+/**
+ *
+ * @brief Remove the ready threads before they get a chance to run
+ *
+ * @return N/A
+ */
+static void ready_threads_stop(int count)
+{
+	int i;
+
+	for (i = 0; i < count; i++) {
+		k_thread_abort(&ready_threads[i]);
+	}
+}
+
+/**
+ *
+ * @brief Print the context switch rate of the last test case
+ *
+ * @return N/A
+ */
+static void print_switch_rate(u32_t t)
+{
+	u64_t ns = SYS_CLOCK_HW_CYCLES_TO_NS64(t);
+	u32_t rate = 0;
+
+	/* two context switches per loop, one for each yielding thread */
+	if (ns) {
+		rate = (u32_t)(2ULL * NUMBER_OF_LOOPS * NSEC_PER_SEC / ns);
+	}
+
+	fprintf(output_file, "\nContext switches per second: %u", rate);
+}
+
+/**
+ *
+ * @brief The main test entry
+ *
+ * Two cooperative threads yield to each other while a growing number of
+ * lower priority threads sit in the ready queue, which shows how the
+ * cost of a context switch depends on the ready queue algorithm.
+ *
+ * @return number of successful test cases
+ */
+int sched_test(void)
+{
+	u32_t t;
+	int i, n;
+	int return_value = 0;
+
+	for (n = 0; n < ARRAY_SIZE(ready_counts); n++) {
+		fprintf(output_file, sz_test_case_fmt, "Scheduler");
+		fprintf(output_file, " #%d", n + 1);
+		fprintf(output_file, sz_description,
+				"\n\tk_yield");
+		fprintf(output_file, "\n\t%d other ready threads",
+			ready_counts[n]);
+		printf(sz_test_start_fmt);
+
+		ready_threads_start(ready_counts[n]);
+		i = 0;
+
+		/* Both threads must be ready before the first one yields */
+		k_sched_lock();
+
+		t = BENCH_START();
+
+		k_thread_create(&thread_data1, thread_stack1, STACK_SIZE,
+				yield_thread, NULL, (void *) NUMBER_OF_LOOPS,
+				NULL, K_PRIO_COOP(3), 0, K_NO_WAIT);
+		k_thread_create(&thread_data2, thread_stack2, STACK_SIZE,
+				yield_thread, (void *) &i,
+				(void *) NUMBER_OF_LOOPS, NULL,
+				K_PRIO_COOP(3), 0, K_NO_WAIT);
+
+		k_sched_unlock();
+
+		t = TIME_STAMP_DELTA_GET(t);
+
+		ready_threads_stop(ready_counts[n]);
+
+		print_switch_rate(t);
+		return_value += check_result(i, t);
+	}
+
+	return return_value;
+}
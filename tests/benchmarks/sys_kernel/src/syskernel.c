@@ -158,10 +158,11 @@ void main(void)
 		test_result += lifo_test();
 		test_result += fifo_test();
 		test_result += stack_test();
+		test_result += sched_test();
 
 		if (test_result) {
-			/* sema/lifo/fifo/stack account for 12 tests in total */
-			if (test_result == 12) {
+			/* sema/lifo/fifo/stack/sched account for 15 tests */
+			if (test_result == 15) {
 				fprintf(output_file, sz_module_result_fmt,
 					sz_success);
 			} else {
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the number of cycles spent by the caller of a log macro.
+ *
+ * Messages are logged in bursts of N_BURST messages, small enough for the
+ * deferred log buffer, then the benchmark sleeps for the log output to
+ * catch up.
+ */
+
+#define SYS_LOG_DOMAIN "bench"
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <logging/sys_log.h>
+
+#define N_ROUNDS 8
+#define N_BURST 8
+
+/* time for the log output to catch up, in milliseconds */
+#define DRAIN_MS 100
+
+struct call_stats {
+	u32_t total;
+	u32_t worst;
+	u32_t calls;
+};
+
+static void stats_add(struct call_stats *stats, u32_t cycles)
+{
+	stats->total += cycles;
+	stats->worst = max(stats->worst, cycles);
+	stats->calls++;
+}
+
+static void report(const char *what, struct call_stats *stats)
+{
+	TC_PRINT(" %-24s avg %6u max %6u cycles\n", what,
+		 stats->total / stats->calls, stats->worst);
+}
+
+static void log_bursts(struct call_stats *stats)
+{
+	u32_t start, end;
+	int round, i;
+
+	for (round = 0; round < N_ROUNDS; round++) {
+		for (i = 0; i < N_BURST; i++) {
+			start = k_cycle_get_32();
+			SYS_LOG_INF("round %d message %d", round, i);
+			end = k_cycle_get_32();
+			stats_add(stats, end - start);
+		}
+		k_sleep(DRAIN_MS);
+	}
+}
+
+void main(void)
+{
+	struct call_stats logged = { 0 };
+#ifdef CONFIG_SYS_LOG_DEFERRED
+	struct call_stats filtered = { 0 };
+#endif
+
+	TC_START("System log call cost");
+
+#ifdef CONFIG_SYS_LOG_DEFERRED
+	TC_PRINT(" deferred logging, %d byte buffer\n",
+		 CONFIG_SYS_LOG_DEFERRED_BUFFER_SIZE);
+#else
+	TC_PRINT(" immediate logging\n");
+#endif
+
+	log_bursts(&logged);
+
+#ifdef CONFIG_SYS_LOG_DEFERRED
+	sys_log_runtime_level_set(SYS_LOG_LEVEL_WARNING);
+	log_bursts(&filtered);
+	sys_log_runtime_level_set(SYS_LOG_LEVEL_DEBUG);
+
+	TC_PRINT(" %u messages dropped\n", sys_log_dropped_get());
+#endif
+
+	report("SYS_LOG_INF()", &logged);
+#ifdef CONFIG_SYS_LOG_DEFERRED
+	report("SYS_LOG_INF(), filtered", &filtered);
+#endif
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
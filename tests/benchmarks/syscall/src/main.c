@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the round-trip cost of system calls on a semaphore.
+ *
+ * A user thread calls k_sem_count_get(), and gives and takes a semaphore
+ * either with two system calls or with a single k_syscall_batch() call.
+ * The main thread makes the same calls from supervisor mode for reference.
+ * The benchmark reports the average number of cycles per operation.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+#define N_CALLS 1024
+
+#define STACK_SIZE 1024
+
+__kernel static struct k_sem sem;
+
+static K_THREAD_STACK_DEFINE(user_stack, STACK_SIZE);
+__kernel static struct k_thread user_thread;
+__kernel static struct k_sem done_sem;
+
+static u32_t count_cycles, sem_cycles, batch_cycles;
+static bool failed;
+
+static u32_t count_get(void)
+{
+	u32_t start = k_cycle_get_32();
+	int i;
+
+	for (i = 0; i < N_CALLS; i++) {
+		if (k_sem_count_get(&sem) != 0) {
+			failed = true;
+		}
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static u32_t give_take(void)
+{
+	u32_t start = k_cycle_get_32();
+	int i;
+
+	for (i = 0; i < N_CALLS; i++) {
+		k_sem_give(&sem);
+		if (k_sem_take(&sem, K_NO_WAIT) != 0) {
+			failed = true;
+		}
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static u32_t give_take_batch(void)
+{
+	struct k_syscall_op ops[] = {
+		{ K_SYSCALL_OP_SEM_GIVE, &sem },
+		{ K_SYSCALL_OP_SEM_TAKE, &sem, NULL, K_NO_WAIT },
+	};
+	u32_t start = k_cycle_get_32();
+	int i;
+
+	for (i = 0; i < N_CALLS; i++) {
+		if (k_syscall_batch(ops, ARRAY_SIZE(ops)) != ARRAY_SIZE(ops)) {
+			failed = true;
+		}
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static void measure(void)
+{
+	count_cycles = count_get();
+	sem_cycles = give_take();
+	batch_cycles = give_take_batch();
+}
+
+static void user_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	measure();
+	k_sem_give(&done_sem);
+}
+
+static void report(const char *mode)
+{
+	TC_PRINT(" %-10s k_sem_count_get:         %6u cycles per call\n",
+		 mode, count_cycles / N_CALLS);
+	TC_PRINT(" %-10s k_sem_give, k_sem_take:  %6u cycles per pair\n",
+		 mode, sem_cycles / N_CALLS);
+	TC_PRINT(" %-10s k_syscall_batch:         %6u cycles per pair\n",
+		 mode, batch_cycles / N_CALLS);
+}
+
+void main(void)
+{
+	TC_START("System call round-trip cost");
+
+	k_sem_init(&sem, 0, 1);
+	k_sem_init(&done_sem, 0, 1);
+
+	measure();
+	report("supervisor");
+
+	k_thread_create(&user_thread, user_stack, STACK_SIZE, user_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), K_USER,
+			K_FOREVER);
+	k_thread_access_grant(&user_thread, &sem, &done_sem, NULL);
+	k_thread_start(&user_thread);
+
+	k_sem_take(&done_sem, K_FOREVER);
+	report("user");
+
+	TC_END_RESULT(failed ? TC_FAIL : TC_PASS);
+	TC_END_REPORT(failed ? TC_FAIL : TC_PASS);
+}
@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the TCP goodput on a link with a round trip time and losses.
+ *
+ * The packets sent by the network interface are held for half the round
+ * trip time before being received back, and the data segments are dropped
+ * at random at the loss rate configured. A client socket sends data to a
+ * server socket through the interface, once without loss and once with
+ * losses, and the benchmark reports the goodput of each run.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <random/rand32.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+#include <net/socket.h>
+#include <net/tcp.h>
+
+#include "tcp_internal.h"
+
+#define MTU 1280
+
+/* Data written at once by the client, below the MSS */
+#define CHUNK 1024
+
+/* Data written by the client and not yet read by the server */
+#define SEND_BUF (8 * CHUNK)
+
+/* Packets held by the link */
+#define LINK_QUEUE 128
+
+#define SERVER_PORT 4242
+
+#define RUN_TIMEOUT K_SECONDS(600)
+
+#define STACK_SIZE 2048
+
+static struct in_addr client_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr server_addr = { { { 192, 0, 2, 2 } } };
+static struct in_addr netmask = { { { 255, 255, 255, 0 } } };
+
+static struct net_if *iface;
+
+static struct {
+	struct net_pkt *pkt;
+	u32_t time;
+} link_queue[LINK_QUEUE];
+
+static int link_head, link_tail;
+static K_SEM_DEFINE(link_sem, 0, LINK_QUEUE);
+
+static int loss;
+static u32_t dropped;
+
+static u8_t client_buf[CHUNK];
+static u8_t server_buf[CHUNK];
+
+static volatile u32_t received;
+static u32_t end_time;
+static bool corrupted;
+static K_SEM_DEFINE(run_done, 0, 1);
+
+static u8_t pattern(u32_t offset)
+{
+	return offset % 251;
+}
+
+static int goodput_dev_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void goodput_iface_init(struct net_if *iface)
+{
+	static u8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+/* The handshake and the teardown are not subject to losses */
+static bool carries_data(struct net_pkt *pkt)
+{
+	struct net_tcp_hdr hdr, *tcp_hdr;
+
+	if (NET_IPV4_HDR(pkt)->proto != IPPROTO_TCP) {
+		return false;
+	}
+
+	tcp_hdr = net_tcp_get_hdr(pkt, &hdr);
+	if (!tcp_hdr) {
+		return false;
+	}
+
+	return net_pkt_get_len(pkt) >
+		net_pkt_ip_hdr_len(pkt) + NET_TCP_HDR_LEN(tcp_hdr);
+}
+
+static int goodput_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	struct net_pkt *cloned;
+	int key, next;
+
+	if (loss && carries_data(pkt) && sys_rand32_get() % 1000 < loss) {
+		dropped++;
+		net_pkt_unref(pkt);
+		return 0;
+	}
+
+	/* The sent packet is released as by a real driver, the stack may
+	 * still hold it for retransmission.
+	 */
+	cloned = net_pkt_clone(pkt, K_MSEC(100));
+	if (!cloned) {
+		return -ENOMEM;
+	}
+
+	net_pkt_unref(pkt);
+
+	key = irq_lock();
+
+	next = (link_head + 1) % LINK_QUEUE;
+	if (next == link_tail) {
+		/* Queue overflow, as on a congested router */
+		irq_unlock(key);
+		dropped++;
+		net_pkt_unref(cloned);
+		return 0;
+	}
+
+	link_queue[link_head].pkt = cloned;
+	link_queue[link_head].time = k_uptime_get_32() +
+				     CONFIG_TCP_GOODPUT_RTT / 2;
+	link_head = next;
+
+	irq_unlock(key);
+
+	k_sem_give(&link_sem);
+
+	return 0;
+}
+
+static struct net_if_api goodput_api = {
+	.init = goodput_iface_init,
+	.send = goodput_send,
+};
+
+NET_DEVICE_INIT(tcp_goodput, "tcp_goodput", goodput_dev_init, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &goodput_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), MTU);
+
+/* Receive the packets back once their delay elapsed */
+static void link_thread(void)
+{
+	struct net_pkt *pkt;
+	s32_t delay;
+	int key;
+
+	while (1) {
+		k_sem_take(&link_sem, K_FOREVER);
+
+		pkt = link_queue[link_tail].pkt;
+		delay = (s32_t)(link_queue[link_tail].time -
+				k_uptime_get_32());
+		if (delay > 0) {
+			k_sleep(delay);
+		}
+
+		key = irq_lock();
+		link_tail = (link_tail + 1) % LINK_QUEUE;
+		irq_unlock(key);
+
+		if (net_recv_data(iface, pkt) < 0) {
+			net_pkt_unref(pkt);
+		}
+	}
+}
+
+K_THREAD_DEFINE(link_id, STACK_SIZE, link_thread, NULL, NULL, NULL,
+		K_PRIO_COOP(7), 0, K_NO_WAIT);
+
+/* Read the data of each connection accepted and check it */
+static void server_thread(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+		.sin_addr = server_addr,
+	};
+	int sock, conn, len, i;
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0 ||
+	    bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    listen(sock, 1) < 0) {
+		TC_ERROR("cannot set up the server socket\n");
+		return;
+	}
+
+	while (1) {
+		conn = accept(sock, NULL, NULL);
+		if (conn < 0) {
+			continue;
+		}
+
+		while ((len = recv(conn, server_buf, sizeof(server_buf),
+				   0)) > 0) {
+			for (i = 0; i < len; i++) {
+				if (server_buf[i] != pattern(received + i)) {
+					corrupted = true;
+				}
+			}
+
+			received += len;
+		}
+
+		end_time = k_uptime_get_32();
+		close(conn);
+
+		k_sem_give(&run_done);
+	}
+}
+
+K_THREAD_DEFINE(server_id, STACK_SIZE, server_thread, NULL, NULL, NULL,
+		K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+static int client_run(void)
+{
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+		.sin_addr = client_addr,
+	};
+	struct sockaddr_in remote = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+		.sin_addr = server_addr,
+	};
+	u32_t sent = 0;
+	int sock, len, i;
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		return -1;
+	}
+
+	if (bind(sock, (struct sockaddr *)&local, sizeof(local)) < 0 ||
+	    connect(sock, (struct sockaddr *)&remote, sizeof(remote)) < 0) {
+		close(sock);
+		return -1;
+	}
+
+	while (sent < CONFIG_TCP_GOODPUT_SIZE) {
+		/* Emulate a send buffer */
+		while (sent - received >= SEND_BUF) {
+			k_sleep(1);
+		}
+
+		len = min(CONFIG_TCP_GOODPUT_SIZE - sent, sizeof(client_buf));
+		for (i = 0; i < len; i++) {
+			client_buf[i] = pattern(sent + i);
+		}
+
+		len = send(sock, client_buf, len, 0);
+		if (len < 0) {
+			close(sock);
+			return -1;
+		}
+
+		sent += len;
+	}
+
+	close(sock);
+
+	return 0;
+}
+
+static bool run(int rate)
+{
+	u32_t start, elapsed;
+
+	loss = rate;
+	dropped = 0;
+	received = 0;
+	corrupted = false;
+
+	start = k_uptime_get_32();
+
+	if (client_run() < 0) {
+		TC_ERROR("cannot send the data\n");
+		return false;
+	}
+
+	if (k_sem_take(&run_done, RUN_TIMEOUT) < 0) {
+		TC_ERROR("%u bytes received out of %u\n", received,
+			 CONFIG_TCP_GOODPUT_SIZE);
+		return false;
+	}
+
+	if (received != CONFIG_TCP_GOODPUT_SIZE || corrupted) {
+		TC_ERROR("%u bytes received out of %u%s\n", received,
+			 CONFIG_TCP_GOODPUT_SIZE,
+			 corrupted ? ", data corrupted" : "");
+		return false;
+	}
+
+	elapsed = max(end_time - start, 1);
+
+	TC_PRINT(" loss %3d/1000: %u bytes in %6u ms, %6u bytes/s, "
+		 "%u segments dropped\n", rate, received, elapsed,
+		 (u32_t)((u64_t)received * MSEC_PER_SEC / elapsed), dropped);
+
+	return true;
+}
+
+void main(void)
+{
+	bool failed = false;
+
+	TC_START("TCP goodput");
+
+	iface = net_if_get_default();
+
+	net_if_ipv4_addr_add(iface, &client_addr, NET_ADDR_MANUAL, 0);
+	net_if_ipv4_addr_add(iface, &server_addr, NET_ADDR_MANUAL, 0);
+	net_if_ipv4_set_netmask(iface, &netmask);
+
+	TC_PRINT(" rtt %d ms\n", CONFIG_TCP_GOODPUT_RTT);
+
+	if (!run(0) || !run(CONFIG_TCP_GOODPUT_LOSS)) {
+		failed = true;
+	}
+
+	TC_END_RESULT(failed ? TC_FAIL : TC_PASS);
+	TC_END_REPORT(failed ? TC_FAIL : TC_PASS);
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the jitter of sleeps and periodic timers.
+ *
+ * A thread sleeps for various durations with k_usleep(), then waits on
+ * periodic timers started with k_timer_start_us(). The benchmark reports
+ * how late each wakeup was, in microseconds, to compare builds with a
+ * periodic tick against tickless builds with various time units.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+/* sleeps and timer periods measured for each duration */
+#define N_SAMPLES 100
+
+static const s32_t sleep_us[] = { 50, 250, 1000, 1500, 10000 };
+static const s32_t period_us[] = { 100, 500, 1000, 2500 };
+
+K_TIMER_DEFINE(jitter_timer, NULL, NULL);
+
+struct jitter_stats {
+	s32_t min;
+	s32_t max;
+	s64_t total;
+};
+
+static u32_t cycles_to_us(u32_t cycles)
+{
+	return (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(cycles) / NSEC_PER_USEC);
+}
+
+static void stats_init(struct jitter_stats *stats)
+{
+	stats->min = INT32_MAX;
+	stats->max = INT32_MIN;
+	stats->total = 0;
+}
+
+static void stats_add(struct jitter_stats *stats, s32_t error)
+{
+	stats->min = min(stats->min, error);
+	stats->max = max(stats->max, error);
+	stats->total += error;
+}
+
+static void report(const char *what, s32_t us, struct jitter_stats *stats)
+{
+	TC_PRINT(" %-8s %6d us: error min %6d avg %6d max %6d us\n", what, us,
+		 stats->min, (s32_t)(stats->total / N_SAMPLES), stats->max);
+}
+
+static void sleep_jitter(s32_t us)
+{
+	struct jitter_stats stats;
+	u32_t start;
+	int i;
+
+	stats_init(&stats);
+
+	for (i = 0; i < N_SAMPLES; i++) {
+		start = k_cycle_get_32();
+		k_usleep(us);
+		stats_add(&stats, cycles_to_us(k_cycle_get_32() - start) - us);
+	}
+
+	report("sleep", us, &stats);
+}
+
+static void timer_jitter(s32_t us)
+{
+	struct jitter_stats stats;
+	u32_t last, now;
+	u32_t missed = 0;
+	int i;
+
+	stats_init(&stats);
+
+	k_timer_start_us(&jitter_timer, us, us);
+	k_timer_status_sync(&jitter_timer);
+	last = k_cycle_get_32();
+
+	for (i = 0; i < N_SAMPLES; i++) {
+		missed += k_timer_status_sync(&jitter_timer) - 1;
+		now = k_cycle_get_32();
+		stats_add(&stats, cycles_to_us(now - last) - us);
+		last = now;
+	}
+
+	k_timer_stop(&jitter_timer);
+
+	report("period", us, &stats);
+	if (missed) {
+		TC_PRINT("          %u periods missed\n", missed);
+	}
+}
+
+void main(void)
+{
+	int i;
+
+	TC_START("Timer jitter");
+
+#ifdef CONFIG_TICKLESS_KERNEL
+	TC_PRINT(" tickless kernel, %d us time unit\n",
+		 CONFIG_TICKLESS_KERNEL_TIME_UNIT_IN_MICRO_SECS);
+#else
+	TC_PRINT(" %d us system clock tick\n", sys_clock_us_per_tick);
+#endif
+
+	for (i = 0; i < ARRAY_SIZE(sleep_us); i++) {
+		sleep_jitter(sleep_us[i]);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(period_us); i++) {
+		timer_jitter(period_us[i]);
+	}
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2018 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the head-of-line blocking of workqueues.
+ *
+ * Each round submits blocking work items, which sleep for BLOCK_MS, then
+ * short work items. The benchmark reports how long the short work items
+ * waited before their handler ran, on a workqueue with a single thread,
+ * on a workqueue pool and, with CONFIG_WORK_ITEM_PRIORITY, on a workqueue
+ * with a single thread where the short work items have a higher priority.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+#define STACK_SIZE 1024
+#define WORK_Q_PRIO K_PRIO_COOP(1)
+
+#define N_ROUNDS 20
+#define BLOCK_MS 10
+#define N_BLOCKING 2
+#define N_SHORT 4
+
+/* threads of the pool, including the one started by k_work_q_start() */
+#define POOL_THREADS 3
+
+static K_THREAD_STACK_DEFINE(single_stack, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks, POOL_THREADS, STACK_SIZE);
+static struct k_thread pool_threads[POOL_THREADS - 1];
+
+static struct k_work_q single_work_q;
+static struct k_work_q pool_work_q;
+
+struct short_work {
+	struct k_work work;
+	u32_t submitted;
+};
+
+static struct k_work blocking[N_BLOCKING];
+static struct short_work short_work[N_SHORT];
+
+static K_SEM_DEFINE(done_sema, 0, N_BLOCKING + N_SHORT);
+
+static u32_t delay_total;
+static u32_t delay_worst;
+
+static u32_t cycles_to_us(u32_t cycles)
+{
+	return (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(cycles) / NSEC_PER_USEC);
+}
+
+static void blocking_handler(struct k_work *work)
+{
+	k_sleep(BLOCK_MS);
+	k_sem_give(&done_sema);
+}
+
+static void short_handler(struct k_work *work)
+{
+	struct short_work *w = CONTAINER_OF(work, struct short_work, work);
+	u32_t delay = k_cycle_get_32() - w->submitted;
+
+	delay_total += delay;
+	delay_worst = max(delay_worst, delay);
+
+	k_sem_give(&done_sema);
+}
+
+static void run(const char *name, struct k_work_q *work_q, int short_prio)
+{
+	int round, i;
+
+	delay_total = 0;
+	delay_worst = 0;
+
+	for (round = 0; round < N_ROUNDS; round++) {
+		for (i = 0; i < N_BLOCKING; i++) {
+			k_work_init(&blocking[i], blocking_handler);
+			k_work_submit_to_queue(work_q, &blocking[i]);
+		}
+
+		for (i = 0; i < N_SHORT; i++) {
+			k_work_init(&short_work[i].work, short_handler);
+#ifdef CONFIG_WORK_ITEM_PRIORITY
+			k_work_priority_set(&short_work[i].work, short_prio);
+#endif
+			short_work[i].submitted = k_cycle_get_32();
+			k_work_submit_to_queue(work_q, &short_work[i].work);
+		}
+
+		for (i = 0; i < N_BLOCKING + N_SHORT; i++) {
+			k_sem_take(&done_sema, K_FOREVER);
+		}
+	}
+
+	TC_PRINT(" %-24s delay avg %6u max %6u us\n", name,
+		 cycles_to_us(delay_total / (N_ROUNDS * N_SHORT)),
+		 cycles_to_us(delay_worst));
+}
+
+void main(void)
+{
+	int i;
+
+	TC_START("Workqueue head-of-line blocking");
+
+	TC_PRINT(" %d rounds of %d work items blocking %d ms and %d short"
+		 " work items\n", N_ROUNDS, N_BLOCKING, BLOCK_MS, N_SHORT);
+
+	k_work_q_start(&single_work_q, single_stack, STACK_SIZE, WORK_Q_PRIO);
+
+	k_work_q_start(&pool_work_q, pool_stacks[0], STACK_SIZE, WORK_Q_PRIO);
+	for (i = 1; i < POOL_THREADS; i++) {
+		k_work_q_add_worker(&pool_work_q, &pool_threads[i - 1],
+				    pool_stacks[i], STACK_SIZE, WORK_Q_PRIO);
+	}
+
+	run("single thread", &single_work_q, 0);
+	run("pool of " STRINGIFY(POOL_THREADS) " threads", &pool_work_q, 0);
+#ifdef CONFIG_WORK_ITEM_PRIORITY
+	run("single thread, priority", &single_work_q, -1);
+#endif
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
@@ -13,6 +13,8 @@
 #define DUMMY_PORT_1    "dummy"
 #define DUMMY_PORT_2    "dummy_driver"
 
+extern void test_device_init_parallel(void);
+extern void test_device_list(void);
 
 void test_dummy_device(void)
 {
@@ -104,6 +106,8 @@ void test_main(void)
 			 ztest_unit_test(build_suspend_device_list),
 			 ztest_unit_test(test_dummy_device),
 			 ztest_unit_test(test_bogus_dynamic_name),
-			 ztest_unit_test(test_dynamic_name));
+			 ztest_unit_test(test_dynamic_name),
+			 ztest_unit_test(test_device_init_parallel),
+			 ztest_unit_test(test_device_list));
 	ztest_run_test_suite(device);
 }
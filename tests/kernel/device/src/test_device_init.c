@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <init.h>
+#include <ztest.h>
+
+#define SLOW_INIT_MS 100
+#define SLOW_DEVICES 3
+
+static u32_t init_start, init_end;
+static int slow_inited;
+
+/* stands for a device waiting for its hardware during initialization */
+static int slow_init(struct device *dev)
+{
+	if (!init_start) {
+		init_start = k_uptime_get_32();
+	}
+
+	k_sleep(SLOW_INIT_MS);
+
+	init_end = k_uptime_get_32();
+	slow_inited++;
+
+	return 0;
+}
+
+DEVICE_INIT(slow_0, "slow_0", slow_init, NULL, NULL, APPLICATION,
+	    CONFIG_APPLICATION_INIT_PRIORITY);
+DEVICE_INIT_INDEPENDENT(slow_0);
+DEVICE_INIT(slow_1, "slow_1", slow_init, NULL, NULL, APPLICATION,
+	    CONFIG_APPLICATION_INIT_PRIORITY);
+DEVICE_INIT_INDEPENDENT(slow_1);
+DEVICE_INIT(slow_2, "slow_2", slow_init, NULL, NULL, APPLICATION,
+	    CONFIG_APPLICATION_INIT_PRIORITY);
+DEVICE_INIT_INDEPENDENT(slow_2);
+
+/**
+ * @brief Test the concurrent initialization of independent devices
+ *
+ * @see DEVICE_INIT_INDEPENDENT()
+ */
+void test_device_init_parallel(void)
+{
+	/**TESTPOINT: independent devices are initialized before main*/
+	zassert_equal(slow_inited, SLOW_DEVICES, NULL);
+
+	/**TESTPOINT: independent devices are initialized concurrently*/
+	if (IS_ENABLED(CONFIG_DEVICE_INIT_PARALLEL)) {
+		zassert_true(init_end - init_start <
+			     SLOW_DEVICES * SLOW_INIT_MS, NULL);
+	}
+}
+
+/**
+ * @brief Test the listing of the devices
+ *
+ * @see device_list_get()
+ */
+void test_device_list(void)
+{
+	struct device *devices;
+	int count, i, slow = 0;
+
+	device_list_get(&devices, &count);
+	for (i = 0; i < count; i++) {
+		if (devices[i].config->init == slow_init) {
+			slow++;
+		}
+	}
+	zassert_equal(slow, SLOW_DEVICES, NULL);
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <atomic.h>
+#include <misc/mempool.h>
+
+#define THREAD_NUM 4
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+#define BLK_SIZE_MIN 16
+#define BLK_SIZE_MAX 256
+#define BLK_NUM_MAX 4
+#define BLK_ALIGN 4
+
+#define TLSF_POOL_SIZE 2048
+
+/* blocks held at once and alloc/free rounds done by each thread */
+#define N_HELD 4
+#define N_ROUNDS 64
+
+K_MEM_POOL_DEFINE(bpool, BLK_SIZE_MIN, BLK_SIZE_MAX, BLK_NUM_MAX, BLK_ALIGN);
+K_MEM_POOL_TLSF_DEFINE(tpool, TLSF_POOL_SIZE, BLK_ALIGN);
+
+K_MUTEX_DEFINE(spool_mutex);
+SYS_MEM_POOL_DEFINE(spool, &spool_mutex, BLK_SIZE_MIN, BLK_SIZE_MAX,
+		    BLK_NUM_MAX, BLK_ALIGN, .data);
+
+static K_THREAD_STACK_ARRAY_DEFINE(tstack, THREAD_NUM, STACK_SIZE);
+static struct k_thread tdata[THREAD_NUM];
+static struct k_sem sync_sema;
+
+/* failed allocations seen by the threads */
+static atomic_t failures;
+
+static size_t test_size(int i)
+{
+	/* an irregular mix of sizes, some too large for a busy pool */
+	return (i * 53) % BLK_SIZE_MAX + 1;
+}
+
+static void tmpool_stress(void *p1, void *p2, void *p3)
+{
+	struct k_mem_pool *pool = p1;
+	struct k_mem_block block[N_HELD];
+	bool held[N_HELD] = { 0 };
+	int seed = (int)(uintptr_t)p2;
+
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		int slot = i % N_HELD;
+
+		if (held[slot]) {
+			k_mem_pool_free(&block[slot]);
+			held[slot] = false;
+		} else if (k_mem_pool_alloc(pool, &block[slot],
+					    test_size(seed + i), K_NO_WAIT)) {
+			atomic_inc(&failures);
+		} else {
+			held[slot] = true;
+		}
+		k_yield();
+	}
+
+	for (int i = 0; i < N_HELD; i++) {
+		if (held[i]) {
+			k_mem_pool_free(&block[i]);
+		}
+	}
+
+	k_sem_give(&sync_sema);
+}
+
+static void check_stats_concurrent(struct k_mem_pool *pool, size_t size)
+{
+	struct sys_mem_pool_stats before, after;
+	k_tid_t tid[THREAD_NUM];
+
+	k_mem_pool_stats_get(pool, &before);
+	atomic_set(&failures, 0);
+	k_sem_init(&sync_sema, 0, THREAD_NUM);
+
+	for (int i = 0; i < THREAD_NUM; i++) {
+		tid[i] = k_thread_create(&tdata[i], tstack[i], STACK_SIZE,
+					 tmpool_stress, pool,
+					 (void *)(uintptr_t)i, NULL,
+					 K_PRIO_PREEMPT(1), 0, 0);
+	}
+	for (int i = 0; i < THREAD_NUM; i++) {
+		k_sem_take(&sync_sema, K_FOREVER);
+	}
+	for (int i = 0; i < THREAD_NUM; i++) {
+		k_thread_abort(tid[i]);
+	}
+
+	k_mem_pool_stats_get(pool, &after);
+
+	/* TESTPOINT: every block was given back */
+	zassert_equal(after.used_bytes, 0, "%u bytes still used",
+		      after.used_bytes);
+	zassert_equal(after.max_free_block, before.max_free_block,
+		      "free blocks were not merged");
+	/* TESTPOINT: the high water mark fits in the pool */
+	zassert_true(after.peak_bytes > 0 && after.peak_bytes <= size,
+		     "bad peak %u", after.peak_bytes);
+	/* TESTPOINT: every failed allocation was counted */
+	zassert_equal(after.failures - before.failures,
+		      (u32_t)atomic_get(&failures), NULL);
+}
+
+/**
+ * @brief Test the statistics of a pool allocating one block
+ */
+void test_mpool_stats_alloc(void)
+{
+	struct sys_mem_pool_stats stats;
+	struct k_mem_block block;
+
+	k_mem_pool_stats_get(&bpool, &stats);
+	zassert_equal(stats.used_bytes, 0, NULL);
+	zassert_equal(stats.max_free_block, BLK_SIZE_MAX, NULL);
+
+	zassert_equal(k_mem_pool_alloc(&bpool, &block, BLK_SIZE_MIN - 4,
+				       K_NO_WAIT), 0, NULL);
+	k_mem_pool_stats_get(&bpool, &stats);
+	zassert_equal(stats.used_bytes, BLK_SIZE_MIN, NULL);
+	zassert_true(stats.peak_bytes >= BLK_SIZE_MIN, NULL);
+
+	k_mem_pool_free(&block);
+	k_mem_pool_stats_get(&bpool, &stats);
+	zassert_equal(stats.used_bytes, 0, NULL);
+	zassert_true(stats.peak_bytes >= BLK_SIZE_MIN, NULL);
+}
+
+/**
+ * @brief Test the failure counter of a pool
+ */
+void test_mpool_stats_failure(void)
+{
+	struct sys_mem_pool_stats before, after;
+	struct k_mem_block block;
+
+	k_mem_pool_stats_get(&bpool, &before);
+	zassert_equal(k_mem_pool_alloc(&bpool, &block, BLK_SIZE_MAX + 1,
+				       K_NO_WAIT), -ENOMEM, NULL);
+	zassert_equal(k_mem_pool_alloc(&bpool, &block, BLK_SIZE_MAX + 1, 10),
+		      -EAGAIN, NULL);
+	k_mem_pool_stats_get(&bpool, &after);
+
+	zassert_equal(after.failures, before.failures + 2, NULL);
+}
+
+/**
+ * @brief Test the statistics of a buddy pool shared by several threads
+ */
+void test_mpool_stats_threadsafe(void)
+{
+	check_stats_concurrent(&bpool, BLK_SIZE_MAX * BLK_NUM_MAX);
+}
+
+/**
+ * @brief Test the statistics of a TLSF pool shared by several threads
+ */
+void test_mpool_stats_tlsf_threadsafe(void)
+{
+	check_stats_concurrent(&tpool, TLSF_POOL_SIZE);
+}
+
+/**
+ * @brief Test the statistics of a sys_mem_pool
+ */
+void test_sys_mem_pool_stats(void)
+{
+	struct sys_mem_pool_stats stats;
+	void *ptr;
+
+	zassert_is_null(sys_mem_pool_alloc(&spool, BLK_SIZE_MAX * 2), NULL);
+
+	ptr = sys_mem_pool_alloc(&spool, 1);
+	zassert_not_null(ptr, NULL);
+
+	sys_mem_pool_stats_get(&spool, &stats);
+	zassert_equal(stats.failures, 1, NULL);
+	zassert_true(stats.used_bytes > 0, NULL);
+	zassert_equal(stats.max_free_block, BLK_SIZE_MAX, NULL);
+
+	sys_mem_pool_free(ptr);
+	sys_mem_pool_stats_get(&spool, &stats);
+	zassert_equal(stats.used_bytes, 0, NULL);
+}
+
+/*test case main entry*/
+void test_main(void)
+{
+	sys_mem_pool_init(&spool);
+
+	ztest_test_suite(mpool_stats,
+			 ztest_unit_test(test_mpool_stats_alloc),
+			 ztest_unit_test(test_mpool_stats_failure),
+			 ztest_unit_test(test_mpool_stats_threadsafe),
+			 ztest_unit_test(test_mpool_stats_tlsf_threadsafe),
+			 ztest_unit_test(test_sys_mem_pool_stats));
+	ztest_run_test_suite(mpool_stats);
+}
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+#include <misc/mempool.h>
+
+#define POOL_SIZE 8192
+#define POOL_ALIGN 8
+
+/* the pool bookkeeping and block headers take less than this */
+#define POOL_OVERHEAD 1024
+
+#define N_BLOCKS 64
+#define TIMEOUT 100
+
+K_MEM_POOL_TLSF_DEFINE(tpool, POOL_SIZE, POOL_ALIGN);
+
+K_MUTEX_DEFINE(spool_mutex);
+SYS_MEM_POOL_TLSF_DEFINE(spool, &spool_mutex, POOL_SIZE, POOL_ALIGN, .data);
+
+static struct k_mem_block blocks[N_BLOCKS];
+
+static size_t test_size(int i)
+{
+	/* an irregular mix of small and large requests */
+	return (i * 37) % 300 + (i % 3) * 4;
+}
+
+static void fill(struct k_mem_block *block, size_t size, int i)
+{
+	memset(block->data, i, size);
+}
+
+static bool check(struct k_mem_block *block, size_t size, int i)
+{
+	u8_t *p = block->data;
+
+	for (size_t j = 0; j < size; j++) {
+		if (p[j] != (u8_t)i) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* All of the pool but its overhead must be available in one block */
+static void check_pool_empty(void)
+{
+	struct k_mem_block block;
+
+	zassert_equal(k_mem_pool_alloc(&tpool, &block,
+				       POOL_SIZE - POOL_OVERHEAD, K_NO_WAIT),
+		      0, "free blocks were not merged");
+	k_mem_pool_free(&block);
+}
+
+/**
+ * @brief Test allocating blocks of various sizes without overlap
+ *
+ * @details Allocate blocks of irregular sizes, fill each with a
+ * different pattern and check that no block overwrote another. Free
+ * every other block first, so that the remaining frees have to merge
+ * free blocks on both sides, then check that the whole pool is
+ * available again.
+ */
+void test_tlsf_alloc_free(void)
+{
+	int i, n;
+
+	for (n = 0; n < N_BLOCKS; n++) {
+		if (k_mem_pool_alloc(&tpool, &blocks[n], test_size(n),
+				     K_NO_WAIT)) {
+			break;
+		}
+		zassert_false((uintptr_t)blocks[n].data % 4, NULL);
+		fill(&blocks[n], test_size(n), n);
+	}
+	zassert_true(n > N_BLOCKS / 2, "too few blocks allocated");
+
+	for (i = 0; i < n; i++) {
+		zassert_true(check(&blocks[i], test_size(i), i),
+			     "block overwritten");
+	}
+
+	for (i = 0; i < n; i += 2) {
+		k_mem_pool_free(&blocks[i]);
+	}
+	for (i = 1; i < n; i += 2) {
+		zassert_true(check(&blocks[i], test_size(i), i),
+			     "block overwritten");
+		k_mem_pool_free(&blocks[i]);
+	}
+
+	check_pool_empty();
+}
+
+/**
+ * @brief Test that requests are not rounded up to a power of four
+ *
+ * @details A buddy pool would round 100 byte requests up to 256 byte
+ * blocks. The TLSF pool must fit at least three quarters of the blocks
+ * the same buffer could hold without any rounding.
+ */
+void test_tlsf_rounding(void)
+{
+	int i, n;
+
+	for (n = 0; n < N_BLOCKS; n++) {
+		if (k_mem_pool_alloc(&tpool, &blocks[n], 100, K_NO_WAIT)) {
+			break;
+		}
+	}
+
+	zassert_true(n >= (POOL_SIZE / 100) * 3 / 4 || n == N_BLOCKS,
+		     "only %d blocks of 100 bytes allocated", n);
+
+	for (i = 0; i < n; i++) {
+		k_mem_pool_free(&blocks[i]);
+	}
+
+	check_pool_empty();
+}
+
+/**
+ * @brief Test waiting for a block from an exhausted pool
+ */
+void test_tlsf_timeout(void)
+{
+	struct k_mem_block block_fail;
+	int i, n;
+
+	for (n = 0; n < N_BLOCKS; n++) {
+		if (k_mem_pool_alloc(&tpool, &blocks[n], POOL_SIZE / 16,
+				     K_NO_WAIT)) {
+			break;
+		}
+	}
+	zassert_true(n < N_BLOCKS, "pool not exhausted");
+
+	zassert_equal(k_mem_pool_alloc(&tpool, &block_fail, POOL_SIZE / 16,
+				       K_NO_WAIT), -ENOMEM, NULL);
+	zassert_equal(k_mem_pool_alloc(&tpool, &block_fail, POOL_SIZE / 16,
+				       TIMEOUT), -EAGAIN, NULL);
+
+	for (i = 0; i < n; i++) {
+		k_mem_pool_free(&blocks[i]);
+	}
+}
+
+static void tlsf_isr(void *data)
+{
+	struct k_mem_block *block = data;
+
+	zassert_equal(k_mem_pool_alloc(&tpool, block, 128, K_NO_WAIT), 0,
+		      NULL);
+	k_mem_pool_free(block);
+}
+
+/**
+ * @brief Test allocating and freeing blocks from an ISR
+ */
+void test_tlsf_isr(void)
+{
+	struct k_mem_block block;
+
+	irq_offload(tlsf_isr, &block);
+
+	check_pool_empty();
+}
+
+/**
+ * @brief Test the TLSF heap memory pool
+ *
+ * @details With CONFIG_HEAP_MEM_POOL_TLSF, k_malloc() can allocate
+ * blocks of any size, and most of the heap in a single block once
+ * everything else was freed.
+ */
+void test_tlsf_heap(void)
+{
+	void *ptr[16];
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(ptr); i++) {
+		ptr[i] = k_malloc(i * 7 + 1);
+		zassert_not_null(ptr[i], NULL);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(ptr); i++) {
+		k_free(ptr[i]);
+	}
+
+	ptr[0] = k_malloc(CONFIG_HEAP_MEM_POOL_SIZE - POOL_OVERHEAD);
+	zassert_not_null(ptr[0], NULL);
+	k_free(ptr[0]);
+}
+
+/**
+ * @brief Test a TLSF sys_mem_pool
+ */
+void test_tlsf_sys_mem_pool(void)
+{
+	void *ptr[16];
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(ptr); i++) {
+		ptr[i] = sys_mem_pool_alloc(&spool, test_size(i));
+		zassert_not_null(ptr[i], NULL);
+	}
+
+	for (i = ARRAY_SIZE(ptr) - 1; i >= 0; i--) {
+		sys_mem_pool_free(ptr[i]);
+	}
+
+	ptr[0] = sys_mem_pool_alloc(&spool, POOL_SIZE - POOL_OVERHEAD);
+	zassert_not_null(ptr[0], NULL);
+	sys_mem_pool_free(ptr[0]);
+}
+
+/*test case main entry*/
+void test_main(void)
+{
+	sys_mem_pool_init(&spool);
+
+	ztest_test_suite(mpool_tlsf,
+			 ztest_unit_test(test_tlsf_alloc_free),
+			 ztest_unit_test(test_tlsf_rounding),
+			 ztest_unit_test(test_tlsf_timeout),
+			 ztest_unit_test(test_tlsf_isr),
+			 ztest_unit_test(test_tlsf_heap),
+			 ztest_unit_test(test_tlsf_sys_mem_pool));
+	ztest_run_test_suite(mpool_tlsf);
+}
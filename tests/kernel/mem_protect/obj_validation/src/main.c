@@ -104,10 +104,46 @@ void test_generic_object(void)
 	}
 }
 
+#ifdef CONFIG_OBJECT_VALIDATION_CACHE
+static __kernel struct k_sem cached_sem;
+
+void test_object_cache(void)
+{
+	struct k_sem *sem = &cached_sem;
+
+	k_object_access_grant(sem, k_current_get());
+	k_sem_init(sem, 0, 1);
+
+	/* The second validation is served from the thread cache */
+	for (int i = 0; i < 2; i++) {
+		zassert_false(_k_object_validate_cached(sem, K_OBJ_SEM,
+							_OBJ_INIT_TRUE), NULL);
+		zassert_equal(_k_object_validate_cached(sem, K_OBJ_SEM,
+							_OBJ_INIT_FALSE),
+			      -EADDRINUSE, NULL);
+	}
+
+	/* Revoking the permission flushes the cache */
+	k_object_access_revoke(sem, k_current_get());
+	zassert_equal(_k_object_validate_cached(sem, K_OBJ_SEM,
+						_OBJ_INIT_TRUE), -EPERM, NULL);
+
+	k_object_access_grant(sem, k_current_get());
+	zassert_false(_k_object_validate_cached(sem, K_OBJ_SEM,
+						_OBJ_INIT_TRUE), NULL);
+}
+#else
+void test_object_cache(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_OBJECT_VALIDATION_CACHE */
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
 	ztest_test_suite(object_validation,
-			 ztest_unit_test(test_generic_object));
+			 ztest_unit_test(test_generic_object),
+			 ztest_unit_test(test_object_cache));
 	ztest_run_test_suite(object_validation);
 }
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include "test_mslab.h"
+
+#ifdef CONFIG_MEM_SLAB_STATS
+static char __aligned(BLK_ALIGN) sslab_buf[BLK_SIZE * BLK_NUM];
+static struct k_mem_slab sslab;
+
+/**
+ * @brief Test the usage statistics of a memory slab
+ *
+ * @details Allocate every block twice, fail to allocate one more with
+ * and without a timeout, and check the high water mark and the failure
+ * counter.
+ */
+void test_mslab_stats(void)
+{
+	void *block[BLK_NUM];
+	void *block_fail;
+
+	k_mem_slab_init(&sslab, sslab_buf, BLK_SIZE, BLK_NUM);
+	zassert_equal(k_mem_slab_max_used_get(&sslab), 0, NULL);
+	zassert_equal(k_mem_slab_num_failures_get(&sslab), 0, NULL);
+
+	for (int round = 0; round < 2; round++) {
+		for (int i = 0; i < BLK_NUM; i++) {
+			zassert_equal(k_mem_slab_alloc(&sslab, &block[i],
+						       K_NO_WAIT), 0, NULL);
+		}
+		/** TESTPOINT: peak reaches the number of blocks */
+		zassert_equal(k_mem_slab_max_used_get(&sslab), BLK_NUM, NULL);
+
+		for (int i = 0; i < BLK_NUM; i++) {
+			k_mem_slab_free(&sslab, &block[i]);
+		}
+	}
+
+	zassert_equal(k_mem_slab_alloc(&sslab, &block[0], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_mem_slab_alloc(&sslab, &block[1], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_mem_slab_alloc(&sslab, &block[2], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_mem_slab_alloc(&sslab, &block_fail, K_NO_WAIT),
+		      -ENOMEM, NULL);
+	zassert_equal(k_mem_slab_alloc(&sslab, &block_fail, TIMEOUT / 100),
+		      -EAGAIN, NULL);
+
+	/** TESTPOINT: failed allocations are counted */
+	zassert_equal(k_mem_slab_num_failures_get(&sslab), 2, NULL);
+	zassert_equal(k_mem_slab_max_used_get(&sslab), BLK_NUM, NULL);
+
+	for (int i = 0; i < BLK_NUM; i++) {
+		k_mem_slab_free(&sslab, &block[i]);
+	}
+}
+#else
+void test_mslab_stats(void)
+{
+	ztest_test_skip();
+}
+#endif
@@ -19,6 +19,8 @@ extern void test_msgq_put_fail(void);
 extern void test_msgq_get_fail(void);
 extern void test_msgq_purge_when_put(void);
 extern void test_msgq_attrs_get(void);
+extern void test_msgq_claim(void);
+extern void test_msgq_claim_wait(void);
 #ifdef CONFIG_USERSPACE
 extern void test_msgq_user_thread(void);
 extern void test_msgq_user_thread_overflow(void);
@@ -72,6 +74,8 @@ void test_main(void)
 			 ztest_unit_test(test_msgq_attrs_get),
 			 ztest_user_unit_test(test_msgq_user_attrs_get),
 			 ztest_unit_test(test_msgq_purge_when_put),
-			 ztest_user_unit_test(test_msgq_user_purge_when_put));
+			 ztest_user_unit_test(test_msgq_user_purge_when_put),
+			 ztest_unit_test(test_msgq_claim),
+			 ztest_unit_test(test_msgq_claim_wait));
 	ztest_run_test_suite(msgq_api);
 }
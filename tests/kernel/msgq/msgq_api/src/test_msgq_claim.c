@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+K_MSGQ_DEFINE(claim_msgq, MSG_SIZE, MSGQ_LEN, 4);
+static u32_t data[MSGQ_LEN] = { MSG0, MSG1 };
+
+static void put_claimed(struct k_msgq *q, u32_t value)
+{
+	void *msg;
+
+	zassert_equal(k_msgq_put_claim(q, &msg, K_NO_WAIT), 0, NULL);
+	*(u32_t *)msg = value;
+	k_msgq_put_commit(q);
+}
+
+static u32_t get_claimed(struct k_msgq *q)
+{
+	void *msg;
+	u32_t value;
+
+	zassert_equal(k_msgq_get_claim(q, &msg, K_NO_WAIT), 0, NULL);
+	value = *(u32_t *)msg;
+	k_msgq_get_commit(q);
+
+	return value;
+}
+
+static void tThread_get(void *p1, void *p2, void *p3)
+{
+	u32_t rx_data;
+
+	k_sleep(TIMEOUT >> 1);
+	zassert_equal(k_msgq_get((struct k_msgq *)p1, &rx_data, K_NO_WAIT), 0,
+		      NULL);
+	zassert_equal(rx_data, data[0], NULL);
+}
+
+static void tThread_put(void *p1, void *p2, void *p3)
+{
+	k_sleep(TIMEOUT >> 1);
+	zassert_equal(k_msgq_put((struct k_msgq *)p1, &data[1], K_NO_WAIT), 0,
+		      NULL);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test claimed messages interleaved with copied messages
+ *
+ * @see k_msgq_put_claim(), k_msgq_put_commit(), k_msgq_get_claim(),
+ * k_msgq_get_commit()
+ */
+void test_msgq_claim(void)
+{
+	struct k_msgq *q = &claim_msgq;
+	u32_t rx_data;
+	void *msg, *msg2;
+
+	k_msgq_purge(q);
+
+	/**TESTPOINT: claimed messages are sent and received in order*/
+	put_claimed(q, data[0]);
+	zassert_equal(k_msgq_put(q, &data[1], K_NO_WAIT), 0, NULL);
+	zassert_equal(get_claimed(q), data[0], NULL);
+	zassert_equal(get_claimed(q), data[1], NULL);
+
+	/**TESTPOINT: a claimed message is not free until committed*/
+	zassert_equal(k_msgq_put_claim(q, &msg, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_num_free_get(q), MSGQ_LEN - 1, NULL);
+	zassert_equal(k_msgq_num_used_get(q), 0, NULL);
+
+	/**TESTPOINT: the end of the queue claimed is busy*/
+	zassert_equal(k_msgq_put_claim(q, &msg2, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_msgq_put(q, &data[1], K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_msgq_get(q, &rx_data, K_NO_WAIT), -ENOMSG, NULL);
+
+	*(u32_t *)msg = data[0];
+	k_msgq_put_commit(q);
+	zassert_equal(k_msgq_num_used_get(q), 1, NULL);
+
+	zassert_equal(k_msgq_get_claim(q, &msg, K_NO_WAIT), 0, NULL);
+	zassert_equal(*(u32_t *)msg, data[0], NULL);
+	zassert_equal(k_msgq_get(q, &rx_data, K_NO_WAIT), -EBUSY, NULL);
+
+	/**TESTPOINT: the message claimed is not overwritten*/
+	put_claimed(q, data[1]);
+	zassert_equal(k_msgq_put(q, &data[1], K_NO_WAIT), -ENOMSG, NULL);
+	zassert_equal(*(u32_t *)msg, data[0], NULL);
+	k_msgq_get_commit(q);
+
+	zassert_equal(k_msgq_get(q, &rx_data, K_NO_WAIT), 0, NULL);
+	zassert_equal(rx_data, data[1], NULL);
+	zassert_equal(k_msgq_num_free_get(q), MSGQ_LEN, NULL);
+
+	/**TESTPOINT: claims on empty or full queues fail*/
+	zassert_equal(k_msgq_get_claim(q, &msg, K_NO_WAIT), -ENOMSG, NULL);
+	zassert_equal(k_msgq_get_claim(q, &msg, TIMEOUT), -EAGAIN, NULL);
+	for (int i = 0; i < MSGQ_LEN; i++) {
+		put_claimed(q, data[i]);
+	}
+	zassert_equal(k_msgq_put_claim(q, &msg, K_NO_WAIT), -ENOMSG, NULL);
+	zassert_equal(k_msgq_put_claim(q, &msg, TIMEOUT), -EAGAIN, NULL);
+
+	k_msgq_purge(q);
+}
+
+/**
+ * @brief Test waiting for message claims
+ *
+ * @see k_msgq_put_claim(), k_msgq_get_claim()
+ */
+void test_msgq_claim_wait(void)
+{
+	struct k_msgq *q = &claim_msgq;
+	void *msg;
+
+	k_msgq_purge(q);
+
+	/**TESTPOINT: wait for room to claim*/
+	for (int i = 0; i < MSGQ_LEN; i++) {
+		zassert_equal(k_msgq_put(q, &data[0], K_NO_WAIT), 0, NULL);
+	}
+	k_thread_create(&tdata, tstack, STACK_SIZE, tThread_get, q, NULL,
+			NULL, K_PRIO_PREEMPT(0), 0, 0);
+	zassert_equal(k_msgq_put_claim(q, &msg, K_FOREVER), 0, NULL);
+	k_thread_abort(&tdata);
+
+	*(u32_t *)msg = data[1];
+	k_msgq_put_commit(q);
+	zassert_equal(get_claimed(q), data[0], NULL);
+	zassert_equal(get_claimed(q), data[1], NULL);
+
+	/**TESTPOINT: wait for a message to claim*/
+	k_thread_create(&tdata, tstack, STACK_SIZE, tThread_put, q, NULL,
+			NULL, K_PRIO_PREEMPT(0), 0, 0);
+	zassert_equal(k_msgq_get_claim(q, &msg, K_FOREVER), 0, NULL);
+	k_thread_abort(&tdata);
+
+	zassert_equal(*(u32_t *)msg, data[1], NULL);
+	zassert_equal(k_msgq_num_used_get(q), 0, NULL);
+	k_msgq_get_commit(q);
+	zassert_equal(k_msgq_num_free_get(q), MSGQ_LEN, NULL);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <ztest.h>
+
+#define TIMEOUT 100
+#define STACK_SIZE 512
+#define NUM_THREADS 3
+
+static struct k_mutex chain_mutex[2];
+
+static K_THREAD_STACK_ARRAY_DEFINE(chain_stack, NUM_THREADS, STACK_SIZE);
+static struct k_thread chain_thread[NUM_THREADS];
+
+static k_tid_t lock_order[NUM_THREADS];
+static int lock_count;
+
+/* take the first mutex and hold it while suspended */
+static void tThread_entry_hold(void *p1, void *p2, void *p3)
+{
+	k_mutex_lock(&chain_mutex[0], K_FOREVER);
+	k_thread_suspend(k_current_get());
+}
+
+/* take the second mutex, then wait on the first one */
+static void tThread_entry_nested(void *p1, void *p2, void *p3)
+{
+	k_mutex_lock(&chain_mutex[1], K_FOREVER);
+	k_mutex_lock(&chain_mutex[0], K_FOREVER);
+	k_thread_suspend(k_current_get());
+}
+
+/* wait on the mutex given, and record the order it is obtained in */
+static void tThread_entry_lock(void *p1, void *p2, void *p3)
+{
+	struct k_mutex *mutex = p1;
+
+	k_mutex_lock(mutex, K_FOREVER);
+	lock_order[lock_count++] = k_current_get();
+	k_mutex_unlock(mutex);
+}
+
+static k_tid_t spawn(int i, k_thread_entry_t entry, void *p1, int prio)
+{
+	k_tid_t tid = k_thread_create(&chain_thread[i], chain_stack[i],
+				      STACK_SIZE, entry, p1, NULL, NULL,
+				      prio, 0, 0);
+
+	/* let the thread run up to the point it waits */
+	k_sleep(TIMEOUT);
+
+	return tid;
+}
+
+/*test cases*/
+
+/**
+ * @brief Test priority inheritance along a chain of mutexes
+ *
+ * A thread waits on a mutex owned by a thread waiting on a mutex owned by a
+ * third thread: both owners inherit the priority of the waiting thread.
+ *
+ * @see k_mutex_lock()
+ */
+void test_mutex_prio_inheritance_chain(void)
+{
+	k_tid_t owner, nested, waiter;
+
+	k_mutex_init(&chain_mutex[0]);
+	k_mutex_init(&chain_mutex[1]);
+
+	owner = spawn(0, tThread_entry_hold, NULL, K_PRIO_PREEMPT(3));
+	nested = spawn(1, tThread_entry_nested, NULL, K_PRIO_PREEMPT(2));
+
+	/**TESTPOINT: the owner of the mutex waited on is boosted*/
+	zassert_equal(k_thread_priority_get(owner), K_PRIO_PREEMPT(2), NULL);
+
+	waiter = spawn(2, tThread_entry_lock, &chain_mutex[1],
+		       K_PRIO_PREEMPT(1));
+
+	/**TESTPOINT: the owners along the chain are boosted*/
+	zassert_equal(k_thread_priority_get(nested), K_PRIO_PREEMPT(1), NULL);
+#if CONFIG_MUTEX_PRIORITY_INHERITANCE_DEPTH > 1
+	zassert_equal(k_thread_priority_get(owner), K_PRIO_PREEMPT(1), NULL);
+#else
+	zassert_equal(k_thread_priority_get(owner), K_PRIO_PREEMPT(2), NULL);
+#endif
+
+	/* teardown */
+	k_thread_abort(waiter);
+	k_thread_abort(nested);
+	k_thread_abort(owner);
+}
+
+/**
+ * @brief Test wait queue ordering on priority changes
+ *
+ * The priority of a thread waiting on a mutex is raised above the one of a
+ * thread which started waiting later: it gets the mutex first.
+ *
+ * @see k_mutex_unlock(), k_thread_priority_set()
+ */
+void test_mutex_waiter_prio_change(void)
+{
+	k_tid_t low, mid;
+
+	k_mutex_init(&chain_mutex[0]);
+	lock_count = 0;
+
+	k_mutex_lock(&chain_mutex[0], K_FOREVER);
+
+	low = spawn(0, tThread_entry_lock, &chain_mutex[0], K_PRIO_PREEMPT(3));
+	mid = spawn(1, tThread_entry_lock, &chain_mutex[0], K_PRIO_PREEMPT(2));
+
+	k_thread_priority_set(low, K_PRIO_PREEMPT(1));
+
+	k_mutex_unlock(&chain_mutex[0]);
+	k_sleep(TIMEOUT);
+
+	/**TESTPOINT: the waiters get the mutex in their new priority order*/
+	zassert_equal(lock_count, 2, NULL);
+	zassert_equal(lock_order[0], low, NULL);
+	zassert_equal(lock_order[1], mid, NULL);
+}
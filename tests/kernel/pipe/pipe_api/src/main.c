@@ -19,6 +19,9 @@ extern void test_pipe_get_fail(void);
 extern void test_pipe_block_put(void);
 extern void test_pipe_block_put_sema(void);
 extern void test_pipe_get_put(void);
+extern void test_pipe_claim(void);
+extern void test_pipe_claim_wait(void);
+extern void test_pipe_claim_block_put(void);
 #ifdef CONFIG_USERSPACE
 extern void test_pipe_user_thread2thread(void);
 extern void test_pipe_user_put_fail(void);
@@ -65,6 +68,9 @@ void test_main(void)
 			 ztest_unit_test(test_pipe_get_fail),
 			 ztest_unit_test(test_pipe_block_put),
 			 ztest_unit_test(test_pipe_block_put_sema),
-			 ztest_unit_test(test_pipe_get_put));
+			 ztest_unit_test(test_pipe_get_put),
+			 ztest_unit_test(test_pipe_claim),
+			 ztest_unit_test(test_pipe_claim_wait),
+			 ztest_unit_test(test_pipe_claim_block_put));
 	ztest_run_test_suite(pipe_api);
 }
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define TIMEOUT 100
+#define STACK_SIZE 1024
+#define PIPE_LEN 8
+#define BLOCK_LEN 4
+
+static unsigned char __aligned(4) data[] = "abcd1234";
+
+K_PIPE_DEFINE(claim_pipe, PIPE_LEN, 4);
+K_MEM_POOL_DEFINE(claim_pool, 32, 32, 1, 4);
+__kernel struct k_pipe claim_pipe_nobuf;
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+
+static void tThread_get(void *p1, void *p2, void *p3)
+{
+	unsigned char rx_data[PIPE_LEN];
+	size_t rd_byte;
+
+	k_sleep(TIMEOUT >> 1);
+	zassert_false(k_pipe_get((struct k_pipe *)p1, rx_data, PIPE_LEN,
+				 &rd_byte, PIPE_LEN, K_NO_WAIT), NULL);
+	zassert_false(memcmp(rx_data, data, PIPE_LEN), NULL);
+}
+
+static void tThread_put(void *p1, void *p2, void *p3)
+{
+	size_t wt_byte;
+
+	k_sleep(TIMEOUT >> 1);
+	zassert_false(k_pipe_put((struct k_pipe *)p1, data, PIPE_LEN,
+				 &wt_byte, PIPE_LEN, K_NO_WAIT), NULL);
+}
+
+static void tThread_get_wait(void *p1, void *p2, void *p3)
+{
+	unsigned char rx_data[PIPE_LEN];
+	size_t rd_byte;
+
+	zassert_false(k_pipe_get((struct k_pipe *)p1, rx_data, PIPE_LEN,
+				 &rd_byte, PIPE_LEN, K_FOREVER), NULL);
+	zassert_false(memcmp(rx_data, data, PIPE_LEN), NULL);
+}
+
+/**
+ * @addtogroup kernel_pipe_tests
+ * @{
+ */
+
+/**
+ * @brief Test claims of space and data in a pipe buffer
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_commit(), k_pipe_get_claim(),
+ * k_pipe_get_commit()
+ */
+void test_pipe_claim(void)
+{
+	struct k_pipe *p = &claim_pipe;
+	unsigned char rx_data[PIPE_LEN];
+	size_t size, wt_byte, rd_byte;
+	void *buf;
+
+	/**TESTPOINT: claim space and commit part of it*/
+	size = PIPE_LEN;
+	zassert_false(k_pipe_put_claim(p, &buf, &size, K_NO_WAIT), NULL);
+	zassert_equal(size, PIPE_LEN, NULL);
+	zassert_equal(k_pipe_put(p, data, 1, &wt_byte, 1, K_NO_WAIT), -EBUSY,
+		      NULL);
+	memcpy(buf, data, 6);
+	k_pipe_put_commit(p, 6);
+
+	/**TESTPOINT: claim data and commit part of it*/
+	size = PIPE_LEN;
+	zassert_false(k_pipe_get_claim(p, &buf, &size, K_NO_WAIT), NULL);
+	zassert_equal(size, 6, NULL);
+	zassert_false(memcmp(buf, data, 6), NULL);
+	zassert_equal(k_pipe_get(p, rx_data, 1, &rd_byte, 1, K_NO_WAIT),
+		      -EBUSY, NULL);
+	k_pipe_get_commit(p, 4);
+
+	/**TESTPOINT: claims are contiguous up to the end of the buffer*/
+	size = PIPE_LEN;
+	zassert_false(k_pipe_put_claim(p, &buf, &size, K_NO_WAIT), NULL);
+	zassert_equal(size, 2, NULL);
+	memcpy(buf, &data[6], 2);
+	k_pipe_put_commit(p, 2);
+
+	zassert_false(k_pipe_put(p, data, 4, &wt_byte, 4, K_NO_WAIT), NULL);
+	size = PIPE_LEN;
+	zassert_equal(k_pipe_put_claim(p, &buf, &size, K_NO_WAIT), -EIO, NULL);
+	zassert_equal(k_pipe_put_claim(p, &buf, &size, TIMEOUT), -EAGAIN,
+		      NULL);
+
+	size = PIPE_LEN;
+	zassert_false(k_pipe_get_claim(p, &buf, &size, K_NO_WAIT), NULL);
+	zassert_equal(size, 4, NULL);
+	zassert_false(memcmp(buf, &data[4], 4), NULL);
+	k_pipe_get_commit(p, 4);
+
+	zassert_false(k_pipe_get(p, rx_data, 4, &rd_byte, 4, K_NO_WAIT), NULL);
+	zassert_false(memcmp(rx_data, data, 4), NULL);
+
+	size = PIPE_LEN;
+	zassert_equal(k_pipe_get_claim(p, &buf, &size, K_NO_WAIT), -EIO, NULL);
+	zassert_equal(k_pipe_get_claim(p, &buf, &size, TIMEOUT), -EAGAIN,
+		      NULL);
+
+	/**TESTPOINT: pipes without a buffer can not be claimed*/
+	k_pipe_init(&claim_pipe_nobuf, NULL, 0);
+	zassert_equal(k_pipe_put_claim(&claim_pipe_nobuf, &buf, &size,
+				       K_NO_WAIT), -EINVAL, NULL);
+}
+
+/**
+ * @brief Test waiting for claims and committing to waiting threads
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_commit(), k_pipe_get_claim(),
+ * k_pipe_get_commit()
+ */
+void test_pipe_claim_wait(void)
+{
+	struct k_pipe *p = &claim_pipe;
+	size_t size, wt_byte;
+	void *buf;
+
+	/**TESTPOINT: wait for space to claim*/
+	zassert_false(k_pipe_put(p, data, PIPE_LEN, &wt_byte, PIPE_LEN,
+				 K_NO_WAIT), NULL);
+	k_thread_create(&tdata, tstack, STACK_SIZE, tThread_get, p, NULL,
+			NULL, K_PRIO_PREEMPT(0), 0, 0);
+	size = PIPE_LEN;
+	zassert_false(k_pipe_put_claim(p, &buf, &size, K_FOREVER), NULL);
+	zassert_equal(size, PIPE_LEN, NULL);
+	k_pipe_put_commit(p, 0);
+	k_thread_abort(&tdata);
+
+	/**TESTPOINT: wait for data to claim*/
+	k_thread_create(&tdata, tstack, STACK_SIZE, tThread_put, p, NULL,
+			NULL, K_PRIO_PREEMPT(0), 0, 0);
+	size = PIPE_LEN;
+	zassert_false(k_pipe_get_claim(p, &buf, &size, K_FOREVER), NULL);
+	zassert_equal(size, PIPE_LEN, NULL);
+	zassert_false(memcmp(buf, data, PIPE_LEN), NULL);
+	k_pipe_get_commit(p, PIPE_LEN);
+	k_thread_abort(&tdata);
+
+	/**TESTPOINT: commit data to a waiting reader*/
+	k_thread_create(&tdata, tstack, STACK_SIZE, tThread_get_wait, p, NULL,
+			NULL, K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(TIMEOUT >> 1);
+	size = PIPE_LEN;
+	zassert_false(k_pipe_put_claim(p, &buf, &size, K_NO_WAIT), NULL);
+	memcpy(buf, data, PIPE_LEN);
+	k_pipe_put_commit(p, PIPE_LEN);
+	k_sleep(TIMEOUT >> 1);
+	size = PIPE_LEN;
+	zassert_equal(k_pipe_get_claim(p, &buf, &size, K_NO_WAIT), -EIO, NULL);
+	k_thread_abort(&tdata);
+}
+
+/**
+ * @brief Test a memory block written while space is claimed
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_commit(), k_pipe_block_put()
+ */
+void test_pipe_claim_block_put(void)
+{
+	struct k_pipe *p = &claim_pipe;
+	unsigned char rx_data[PIPE_LEN];
+	struct k_mem_block block;
+	struct k_sem sync_sema;
+	size_t size, rd_byte;
+	void *buf;
+
+	k_sem_init(&sync_sema, 0, 1);
+
+	/**TESTPOINT: the block waits for the claimed space to be committed*/
+	size = PIPE_LEN;
+	zassert_false(k_pipe_put_claim(p, &buf, &size, K_NO_WAIT), NULL);
+	zassert_false(k_mem_pool_alloc(&claim_pool, &block, BLOCK_LEN,
+				       K_NO_WAIT), NULL);
+	memcpy(block.data, &data[BLOCK_LEN], BLOCK_LEN);
+	k_pipe_block_put(p, &block, BLOCK_LEN, &sync_sema);
+	zassert_equal(k_sem_take(&sync_sema, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_pipe_get(p, rx_data, 1, &rd_byte, 1, K_NO_WAIT), -EIO,
+		      NULL);
+
+	/**TESTPOINT: the block is written after the data committed*/
+	memcpy(buf, data, BLOCK_LEN);
+	k_pipe_put_commit(p, BLOCK_LEN);
+	zassert_false(k_sem_take(&sync_sema, K_NO_WAIT), NULL);
+	zassert_false(k_pipe_get(p, rx_data, PIPE_LEN, &rd_byte, PIPE_LEN,
+				 K_NO_WAIT), NULL);
+	zassert_false(memcmp(rx_data, data, PIPE_LEN), NULL);
+
+	/**TESTPOINT: the block was freed*/
+	zassert_false(k_mem_pool_alloc(&claim_pool, &block, BLOCK_LEN,
+				       K_NO_WAIT), NULL);
+	k_mem_pool_free(&block);
+}
+
+/**
+ * @}
+ */
@@ -9,6 +9,11 @@ extern void test_poll_no_wait(void);
 extern void test_poll_wait(void);
 extern void test_poll_multi(void);
 extern void test_poll_grant_access(void);
+extern void test_poll_set_level(void);
+extern void test_poll_set_add_remove(void);
+extern void test_poll_set_rotate(void);
+extern void test_poll_set_wait(void);
+extern void test_poll_set_coexist(void);
 
 K_MEM_POOL_DEFINE(test_pool, 128, 128, 4, 4);
 
@@ -22,6 +27,11 @@ void test_main(void)
 	ztest_test_suite(poll_api,
 			ztest_user_unit_test(test_poll_no_wait),
 			ztest_unit_test(test_poll_wait),
-			ztest_unit_test(test_poll_multi));
+			ztest_unit_test(test_poll_multi),
+			ztest_unit_test(test_poll_set_level),
+			ztest_unit_test(test_poll_set_add_remove),
+			ztest_unit_test(test_poll_set_rotate),
+			ztest_unit_test(test_poll_set_wait),
+			ztest_unit_test(test_poll_set_coexist));
 	ztest_run_test_suite(poll_api);
 }
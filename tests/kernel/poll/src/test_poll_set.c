@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <kernel.h>
+
+struct fifo_msg {
+	void *private;
+	u32_t msg;
+};
+
+#define N_SIGNALS 8
+
+static K_POLL_SET_DEFINE(set);
+
+static K_SEM_DEFINE(set_sem, 0, 2);
+static K_FIFO_DEFINE(set_fifo);
+static struct k_poll_signal set_signal = K_POLL_SIGNAL_INITIALIZER(set_signal);
+
+static struct k_poll_event events[3];
+
+static __kernel struct k_thread set_helper_thread;
+static K_THREAD_STACK_DEFINE(set_helper_stack, KB(1));
+
+static void set_init(void)
+{
+	k_poll_set_init(&set);
+
+	k_poll_event_init(&events[0], K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_sem);
+	k_poll_event_init(&events[1], K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_fifo);
+	k_poll_event_init(&events[2], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_signal);
+
+	for (int i = 0; i < ARRAY_SIZE(events); i++) {
+		zassert_equal(k_poll_set_add(&set, &events[i]), 0, "");
+	}
+}
+
+static void set_cleanup(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(events); i++) {
+		zassert_equal(k_poll_set_remove(&set, &events[i]), 0, "");
+	}
+}
+
+/**
+ * @brief Test that a poll set reports its ready events for as long as their
+ * condition is met
+ */
+void test_poll_set_level(void)
+{
+	struct fifo_msg msg = { NULL, 0 };
+	struct k_poll_event *ready[3];
+
+	set_init();
+
+	zassert_equal(k_poll_set_wait(&set, ready, 3, K_NO_WAIT), 0, "");
+	zassert_equal(k_poll_set_wait(&set, ready, 3, 10), -EAGAIN, "");
+
+	k_sem_give(&set_sem);
+	k_fifo_put(&set_fifo, &msg);
+
+	zassert_equal(k_poll_set_wait(&set, ready, 3, K_NO_WAIT), 2, "");
+	zassert_equal(ready[0], &events[0], "");
+	zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE, "");
+	zassert_equal(ready[1], &events[1], "");
+	zassert_equal(ready[1]->state, K_POLL_STATE_FIFO_DATA_AVAILABLE, "");
+
+	/* still ready, the objects were not taken */
+	zassert_equal(k_poll_set_wait(&set, ready, 3, K_FOREVER), 2, "");
+
+	k_sem_take(&set_sem, K_NO_WAIT);
+	zassert_equal(k_poll_set_wait(&set, ready, 3, K_NO_WAIT), 1, "");
+	zassert_equal(ready[0], &events[1], "");
+
+	k_fifo_get(&set_fifo, K_NO_WAIT);
+	zassert_equal(k_poll_set_wait(&set, ready, 3, K_NO_WAIT), 0, "");
+	zassert_equal(events[1].state, K_POLL_STATE_NOT_READY, "");
+
+	k_poll_signal(&set_signal, 0x1234);
+	zassert_equal(k_poll_set_wait(&set, ready, 3, K_NO_WAIT), 1, "");
+	zassert_equal(ready[0], &events[2], "");
+	zassert_equal(ready[0]->state, K_POLL_STATE_SIGNALED, "");
+	zassert_equal(set_signal.result, 0x1234, "");
+
+	set_signal.signaled = 0;
+	zassert_equal(k_poll_set_wait(&set, ready, 3, K_NO_WAIT), 0, "");
+
+	set_cleanup();
+}
+
+/**
+ * @brief Test adding an event whose condition is met and removing events
+ */
+void test_poll_set_add_remove(void)
+{
+	struct k_poll_event *ready[3];
+	struct k_poll_set other;
+
+	k_poll_set_init(&other);
+	k_sem_give(&set_sem);
+
+	set_init();
+
+	zassert_equal(k_poll_set_add(&set, &events[0]), -EBUSY, "");
+	zassert_equal(k_poll_set_add(&other, &events[0]), -EBUSY, "");
+	zassert_equal(k_poll_set_remove(&other, &events[0]), -EINVAL, "");
+
+	zassert_equal(k_poll_set_wait(&set, ready, 3, K_NO_WAIT), 1, "");
+	zassert_equal(ready[0], &events[0], "");
+
+	zassert_equal(k_poll_set_remove(&set, &events[0]), 0, "");
+	zassert_equal(k_poll_set_remove(&set, &events[0]), -EINVAL, "");
+	zassert_equal(k_poll_set_wait(&set, ready, 3, K_NO_WAIT), 0, "");
+
+	/* the event can move to another set */
+	zassert_equal(k_poll_set_add(&other, &events[0]), 0, "");
+	zassert_equal(k_poll_set_wait(&other, ready, 3, K_NO_WAIT), 1, "");
+	zassert_equal(k_poll_set_remove(&other, &events[0]), 0, "");
+
+	zassert_equal(k_poll_set_add(&set, &events[0]), 0, "");
+	set_cleanup();
+
+	k_sem_take(&set_sem, K_NO_WAIT);
+}
+
+/**
+ * @brief Test that ready events are reported in turn when more of them are
+ * ready than a wait can report
+ */
+void test_poll_set_rotate(void)
+{
+	static struct k_poll_signal signals[N_SIGNALS];
+	static struct k_poll_event signal_events[N_SIGNALS];
+	struct k_poll_event *ready[3];
+	int seen[N_SIGNALS] = { 0 };
+	int i, j, n;
+
+	k_poll_set_init(&set);
+
+	for (i = 0; i < N_SIGNALS; i++) {
+		k_poll_signal_init(&signals[i]);
+		k_poll_event_init(&signal_events[i], K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &signals[i]);
+		zassert_equal(k_poll_set_add(&set, &signal_events[i]), 0, "");
+		k_poll_signal(&signals[i], i);
+	}
+
+	/* every event is reported once before any is reported again */
+	for (i = 0; i < N_SIGNALS; i += n) {
+		n = k_poll_set_wait(&set, ready,
+				    min(ARRAY_SIZE(ready), N_SIGNALS - i),
+				    K_NO_WAIT);
+		zassert_true(n > 0, "");
+
+		for (j = 0; j < n; j++) {
+			zassert_equal(seen[ready[j] - signal_events], 0, "");
+			seen[ready[j] - signal_events]++;
+		}
+	}
+
+	n = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(n, ARRAY_SIZE(ready), "");
+	zassert_equal(ready[0], &signal_events[0], "");
+
+	for (i = 0; i < N_SIGNALS; i++) {
+		zassert_equal(k_poll_set_remove(&set, &signal_events[i]), 0,
+			      "");
+	}
+}
+
+static void set_helper(void *p1, void *p2, void *p3)
+{
+	static struct fifo_msg msg = { NULL, 0 };
+
+	(void)p2; (void)p3;
+
+	k_sleep(50);
+
+	if (p1) {
+		k_queue_cancel_wait(&set_fifo._queue);
+	} else {
+		k_fifo_put(&set_fifo, &msg);
+	}
+}
+
+/**
+ * @brief Test waiting on a poll set for an event from another thread
+ */
+void test_poll_set_wait(void)
+{
+	struct k_poll_event *ready[3];
+	int old_prio = k_thread_priority_get(k_current_get());
+
+	/* the helper must not run before the main thread waits */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(5));
+
+	set_init();
+
+	k_thread_create(&set_helper_thread, set_helper_stack,
+			K_THREAD_STACK_SIZEOF(set_helper_stack), set_helper,
+			NULL, 0, 0, K_PRIO_COOP(6), 0, 0);
+
+	zassert_equal(k_poll_set_wait(&set, ready, 3, K_FOREVER), 1, "");
+	zassert_equal(ready[0], &events[1], "");
+	zassert_not_null(k_fifo_get(&set_fifo, K_NO_WAIT), "");
+	k_thread_abort(&set_helper_thread);
+
+	k_thread_create(&set_helper_thread, set_helper_stack,
+			K_THREAD_STACK_SIZEOF(set_helper_stack), set_helper,
+			(void *)1, 0, 0, K_PRIO_COOP(6), 0, 0);
+
+	zassert_equal(k_poll_set_wait(&set, ready, 3, K_SECONDS(1)), -EINTR,
+		      "");
+	k_thread_abort(&set_helper_thread);
+
+	set_cleanup();
+
+	k_thread_priority_set(k_current_get(), old_prio);
+}
+
+static K_SEM_DEFINE(set_helper_done, 0, 1);
+
+static void set_taker(void *p1, void *p2, void *p3)
+{
+	(void)p1; (void)p2; (void)p3;
+
+	k_sem_take(&set_sem, K_FOREVER);
+	k_sem_give(&set_helper_done);
+}
+
+static void set_poller(void *p1, void *p2, void *p3)
+{
+	struct k_poll_event event;
+
+	(void)p1; (void)p2; (void)p3;
+
+	k_poll_event_init(&event, K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_sem);
+
+	if (k_poll(&event, 1, K_FOREVER) == 0 &&
+	    event.state == K_POLL_STATE_SEM_AVAILABLE) {
+		k_sem_give(&set_helper_done);
+	}
+}
+
+/**
+ * @brief Test that threads pending on an object have precedence over a
+ * poll set and that k_poll() is still signaled with a set on the object
+ */
+void test_poll_set_coexist(void)
+{
+	struct k_poll_event *ready[3];
+
+	set_init();
+
+	k_thread_create(&set_helper_thread, set_helper_stack,
+			K_THREAD_STACK_SIZEOF(set_helper_stack), set_taker,
+			NULL, 0, 0, K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(10);
+
+	k_sem_give(&set_sem);
+	zassert_equal(k_sem_take(&set_helper_done, K_SECONDS(1)), 0, "");
+	k_thread_abort(&set_helper_thread);
+	zassert_equal(k_poll_set_wait(&set, ready, 3, K_NO_WAIT), 0, "");
+
+	k_thread_create(&set_helper_thread, set_helper_stack,
+			K_THREAD_STACK_SIZEOF(set_helper_stack), set_poller,
+			NULL, 0, 0, K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(10);
+
+	k_sem_give(&set_sem);
+	zassert_equal(k_sem_take(&set_helper_done, K_SECONDS(1)), 0, "");
+	k_thread_abort(&set_helper_thread);
+	zassert_equal(k_poll_set_wait(&set, ready, 3, K_NO_WAIT), 1, "");
+	zassert_equal(ready[0], &events[0], "");
+	k_sem_take(&set_sem, K_NO_WAIT);
+
+	set_cleanup();
+}
@@ -19,6 +19,20 @@ static void test_auto_free(void)
 }
 #endif
 
+#ifndef CONFIG_SYSCALL_BATCH
+static void test_queue_syscall_batch(void)
+{
+	ztest_test_skip();
+}
+#endif
+
+#if !defined(CONFIG_USERSPACE) || !defined(CONFIG_SYSCALL_BATCH)
+static void test_queue_user_syscall_batch(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -30,6 +44,12 @@ void test_main(void)
 			 ztest_unit_test(test_queue_isr2thread),
 			 ztest_unit_test(test_queue_get_2threads),
 			 ztest_unit_test(test_queue_get_fail),
-			 ztest_unit_test(test_queue_loop));
+			 ztest_unit_test(test_queue_loop),
+			 ztest_unit_test(test_queue_batch_thread2thread),
+			 ztest_unit_test(test_queue_batch_isr2thread),
+			 ztest_unit_test(test_queue_batch_wait),
+			 ztest_unit_test(test_queue_batch_fail),
+			 ztest_unit_test(test_queue_syscall_batch),
+			 ztest_unit_test(test_queue_user_syscall_batch));
 	ztest_run_test_suite(queue_api);
 }
@@ -16,9 +16,19 @@ extern void test_queue_isr2thread(void);
 extern void test_queue_get_2threads(void);
 extern void test_queue_get_fail(void);
 extern void test_queue_loop(void);
+extern void test_queue_batch_thread2thread(void);
+extern void test_queue_batch_isr2thread(void);
+extern void test_queue_batch_wait(void);
+extern void test_queue_batch_fail(void);
+#ifdef CONFIG_SYSCALL_BATCH
+extern void test_queue_syscall_batch(void);
+#endif
 #ifdef CONFIG_USERSPACE
 extern void test_queue_supv_to_user(void);
 extern void test_auto_free(void);
+#ifdef CONFIG_SYSCALL_BATCH
+extern void test_queue_user_syscall_batch(void);
+#endif
 #endif
 
 typedef struct qdata {
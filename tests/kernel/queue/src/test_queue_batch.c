@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_queue.h"
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define LIST_LEN 8
+#define TIMEOUT 100
+
+static qdata_t data[LIST_LEN];
+static void *items[LIST_LEN];
+static struct k_queue queue;
+static K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
+static struct k_thread tdata;
+static struct k_sem end_sema;
+
+static void tqueue_put_batch(struct k_queue *pqueue)
+{
+	void *batch[LIST_LEN];
+
+	for (int i = 0; i < LIST_LEN; i++) {
+		batch[i] = &data[i];
+	}
+
+	/**TESTPOINT: queue append batch*/
+	k_queue_append_batch(pqueue, batch, LIST_LEN);
+}
+
+static void tqueue_get_batch(struct k_queue *pqueue)
+{
+	int n;
+
+	/**TESTPOINT: queue get batch, less than available*/
+	n = k_queue_get_batch(pqueue, items, LIST_LEN / 2, K_NO_WAIT);
+	zassert_equal(n, LIST_LEN / 2, NULL);
+	for (int i = 0; i < n; i++) {
+		zassert_equal(items[i], &data[i], NULL);
+	}
+
+	/**TESTPOINT: queue get batch, more than available*/
+	n = k_queue_get_batch(pqueue, items, LIST_LEN, K_NO_WAIT);
+	zassert_equal(n, LIST_LEN / 2, NULL);
+	for (int i = 0; i < n; i++) {
+		zassert_equal(items[i], &data[LIST_LEN / 2 + i], NULL);
+	}
+
+	/**TESTPOINT: queue get batch from an empty queue*/
+	zassert_equal(k_queue_get_batch(pqueue, items, LIST_LEN, K_NO_WAIT),
+		      0, NULL);
+}
+
+static void tIsr_entry_put(void *p)
+{
+	tqueue_put_batch((struct k_queue *)p);
+}
+
+static void tIsr_entry_get(void *p)
+{
+	tqueue_get_batch((struct k_queue *)p);
+}
+
+static void tThread_get_entry(void *p1, void *p2, void *p3)
+{
+	struct k_queue *pqueue = p1;
+	int n = 0;
+
+	/**TESTPOINT: queue get batch waits for a first item*/
+	while (n < LIST_LEN) {
+		int got = k_queue_get_batch(pqueue, items + n, LIST_LEN - n,
+					    K_FOREVER);
+
+		zassert_true(got > 0, NULL);
+		n += got;
+	}
+
+	for (int i = 0; i < LIST_LEN; i++) {
+		zassert_equal(items[i], &data[i], NULL);
+	}
+
+	k_sem_give(&end_sema);
+}
+
+/*test cases*/
+void test_queue_batch_thread2thread(void)
+{
+	k_queue_init(&queue);
+	tqueue_put_batch(&queue);
+	tqueue_get_batch(&queue);
+}
+
+void test_queue_batch_isr2thread(void)
+{
+	k_queue_init(&queue);
+	irq_offload(tIsr_entry_put, &queue);
+	tqueue_get_batch(&queue);
+
+	tqueue_put_batch(&queue);
+	irq_offload(tIsr_entry_get, &queue);
+}
+
+void test_queue_batch_wait(void)
+{
+	k_queue_init(&queue);
+	k_sem_init(&end_sema, 0, 1);
+
+	k_tid_t tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+				      tThread_get_entry, &queue, NULL, NULL,
+				      K_PRIO_PREEMPT(0), 0, 0);
+
+	/* let the thread wait on the empty queue */
+	k_sleep(10);
+	tqueue_put_batch(&queue);
+
+	zassert_equal(k_sem_take(&end_sema, TIMEOUT), 0, NULL);
+	k_thread_abort(tid);
+}
+
+void test_queue_batch_fail(void)
+{
+	k_queue_init(&queue);
+	/**TESTPOINT: queue get batch times out*/
+	zassert_equal(k_queue_get_batch(&queue, items, LIST_LEN, TIMEOUT), 0,
+		      NULL);
+}
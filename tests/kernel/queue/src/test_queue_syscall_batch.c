@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_queue.h"
+
+#ifdef CONFIG_SYSCALL_BATCH
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+K_MEM_POOL_DEFINE(batch_pool, 16, 64, 2, 4);
+K_SEM_DEFINE(batch_sem, 0, 2);
+K_QUEUE_DEFINE(batch_queue);
+K_SEM_DEFINE(batch_done, 0, 1);
+
+static qdata_t batch_data[2];
+
+static void syscall_batch(void)
+{
+	struct k_syscall_op ops[] = {
+		{ K_SYSCALL_OP_SEM_GIVE, &batch_sem },
+		{ K_SYSCALL_OP_QUEUE_APPEND, &batch_queue, &batch_data[1] },
+		{ K_SYSCALL_OP_QUEUE_PREPEND, &batch_queue, &batch_data[0] },
+		{ K_SYSCALL_OP_SEM_TAKE, &batch_sem, NULL, K_NO_WAIT },
+		{ K_SYSCALL_OP_QUEUE_GET, &batch_queue, NULL, K_NO_WAIT },
+		{ K_SYSCALL_OP_QUEUE_GET, &batch_queue, NULL, K_NO_WAIT },
+		/* fails, the batch stops */
+		{ K_SYSCALL_OP_SEM_TAKE, &batch_sem, NULL, K_NO_WAIT },
+		{ K_SYSCALL_OP_SEM_GIVE, &batch_sem },
+	};
+
+	/**TESTPOINT: operations are performed in order up to a failure*/
+	zassert_equal(k_syscall_batch(ops, ARRAY_SIZE(ops)), 6, NULL);
+
+	for (int i = 0; i < 6; i++) {
+		zassert_false(ops[i].result, NULL);
+	}
+	zassert_equal(ops[4].data, &batch_data[0], NULL);
+	zassert_equal(ops[5].data, &batch_data[1], NULL);
+	zassert_equal(ops[6].result, -EBUSY, NULL);
+
+	zassert_equal(k_sem_count_get(&batch_sem), 0, NULL);
+	zassert_true(k_queue_is_empty(&batch_queue), NULL);
+}
+
+#ifdef CONFIG_USERSPACE
+static K_THREAD_STACK_DEFINE(batch_stack, STACK_SIZE);
+static __kernel struct k_thread batch_thread;
+
+static void batch_thread_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	syscall_batch();
+	k_sem_give(&batch_done);
+}
+#endif
+
+/**
+ * @brief Test batched semaphore and queue operations
+ *
+ * @see k_syscall_batch()
+ */
+void test_queue_syscall_batch(void)
+{
+	k_thread_resource_pool_assign(k_current_get(), &batch_pool);
+
+	syscall_batch();
+}
+
+#ifdef CONFIG_USERSPACE
+/**
+ * @brief Test batched semaphore and queue operations from user mode
+ *
+ * @see k_syscall_batch()
+ */
+void test_queue_user_syscall_batch(void)
+{
+	k_thread_resource_pool_assign(k_current_get(), &batch_pool);
+	k_thread_access_grant(k_current_get(), &batch_sem, &batch_queue,
+			      &batch_done, NULL);
+
+	k_thread_create(&batch_thread, batch_stack, STACK_SIZE,
+			batch_thread_entry, NULL, NULL, NULL,
+			K_HIGHEST_THREAD_PRIO, K_USER | K_INHERIT_PERMS, 0);
+	k_sem_take(&batch_done, K_FOREVER);
+}
+#endif /* CONFIG_USERSPACE */
+
+#endif /* CONFIG_SYSCALL_BATCH */
@@ -28,6 +28,14 @@ extern void test_abort_handler(void);
 extern void test_essential_thread_operation(void);
 extern void test_threads_priority_set(void);
 extern void test_delayed_thread_abort(void);
+#if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO)
+extern void test_thread_stack_space_get(void);
+#else
+static void test_thread_stack_space_get(void)
+{
+	ztest_test_skip();
+}
+#endif
 
 __kernel struct k_thread tdata;
 #define STACK_SIZE (256 + CONFIG_TEST_EXTRA_STACKSIZE)
@@ -135,7 +143,8 @@ void test_main(void)
 			 ztest_unit_test(test_systhreads_main),
 			 ztest_unit_test(test_systhreads_idle),
 			 ztest_unit_test(test_customdata_get_set_coop),
-			 ztest_user_unit_test(test_customdata_get_set_preempt)
+			 ztest_user_unit_test(test_customdata_get_set_preempt),
+			 ztest_unit_test(test_thread_stack_space_get)
 			 );
 
 	ztest_run_test_suite(threads_lifecycle);
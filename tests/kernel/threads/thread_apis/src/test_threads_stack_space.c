@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO)
+
+#define STACK_SIZE (256 + CONFIG_TEST_EXTRA_STACKSIZE)
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+
+#ifdef CONFIG_STACK_SENTINEL
+#define PATTERN_START sizeof(u32_t)
+#else
+#define PATTERN_START 0
+#endif
+
+static void thread_entry(void *p1, void *p2, void *p3)
+{
+}
+
+/**
+ * @ingroup kernel_thread_tests
+ * @brief Test the unused stack space of a thread
+ *
+ * @see k_thread_stack_space_get()
+ */
+void test_thread_stack_space_get(void)
+{
+	u8_t *start;
+	size_t unused;
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, thread_entry, NULL, NULL,
+			NULL, K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(100);
+	k_thread_abort(&tdata);
+
+	/**TESTPOINT: the stack used by the thread is accounted*/
+	zassert_equal(k_thread_stack_space_get(&tdata, &unused), 0, NULL);
+	zassert_true(unused < tdata.stack_info.size - PATTERN_START, NULL);
+
+	/**TESTPOINT: the lowest byte used gives the unused space*/
+	start = (u8_t *)tdata.stack_info.start + PATTERN_START;
+	start[5] = 0;
+	zassert_equal(k_thread_stack_space_get(&tdata, &unused), 0, NULL);
+	zassert_equal(unused, 5, NULL);
+
+	start[2] = 0;
+	zassert_equal(k_thread_stack_space_get(&tdata, &unused), 0, NULL);
+	zassert_equal(unused, 2, NULL);
+}
+
+#endif /* CONFIG_INIT_STACKS && CONFIG_THREAD_STACK_INFO */
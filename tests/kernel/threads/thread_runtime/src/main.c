@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+#define BUSY_MS 50
+#define SLEEP_MS 50
+
+static K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
+static struct k_thread tdata;
+
+static u32_t ms_to_cycles(u32_t ms)
+{
+	return (u32_t)((u64_t)ms * sys_clock_hw_cycles_per_sec / MSEC_PER_SEC);
+}
+
+static void runtime_sum(const struct k_thread *thread, void *user_data)
+{
+	*(u64_t *)user_data += k_thread_runtime_get((k_tid_t)thread);
+}
+
+/* Time accounted to all the threads, and cycle count at that time */
+static u64_t runtime_total(u32_t *now)
+{
+	unsigned int key = irq_lock();
+	u64_t total = 0;
+
+	k_thread_foreach(runtime_sum, &total);
+	*now = k_cycle_get_32();
+
+	irq_unlock(key);
+
+	return total;
+}
+
+static void busy_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		k_busy_wait(BUSY_MS * USEC_PER_MSEC / 4);
+		k_sleep(BUSY_MS / 4);
+	}
+}
+
+/**
+ * @brief Test that busy waiting is accounted to the running thread
+ */
+void test_runtime_busy(void)
+{
+	u64_t start = k_thread_runtime_get(k_current_get());
+	u64_t idle = k_cpu_idle_runtime_get();
+	u64_t busy;
+
+	k_busy_wait(BUSY_MS * USEC_PER_MSEC);
+
+	busy = k_thread_runtime_get(k_current_get()) - start;
+	zassert_true(busy >= ms_to_cycles(BUSY_MS), "busy wait not accounted");
+	zassert_true(busy < ms_to_cycles(BUSY_MS * 2), "too much accounted");
+	zassert_true(k_cpu_idle_runtime_get() - idle < ms_to_cycles(BUSY_MS),
+		     "busy wait accounted to idle");
+}
+
+/**
+ * @brief Test that sleeping is accounted to the idle thread
+ */
+void test_runtime_idle(void)
+{
+	u64_t start = k_thread_runtime_get(k_current_get());
+	u64_t idle = k_cpu_idle_runtime_get();
+
+	k_sleep(SLEEP_MS);
+
+	zassert_true(k_cpu_idle_runtime_get() - idle >= ms_to_cycles(SLEEP_MS),
+		     "sleep not accounted to idle");
+	zassert_true(k_thread_runtime_get(k_current_get()) - start <
+		     ms_to_cycles(SLEEP_MS), "sleep accounted to thread");
+}
+
+/**
+ * @brief Test that the time accounted to threads adds up to wall time
+ */
+void test_runtime_wall_time(void)
+{
+	u64_t start_total, total;
+	u32_t start, now, wall;
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, busy_thread, NULL, NULL,
+			NULL, K_PRIO_PREEMPT(0), 0, 0);
+
+	start_total = runtime_total(&start);
+	k_busy_wait(BUSY_MS * USEC_PER_MSEC);
+	k_sleep(SLEEP_MS * 2);
+	total = runtime_total(&now) - start_total;
+
+	k_thread_abort(&tdata);
+
+	wall = now - start;
+
+	zassert_true(k_thread_runtime_get(&tdata) > 0, NULL);
+	/* The counts are read a few cycles apart */
+	zassert_true(total <= wall + wall / 100 && total >= wall - wall / 100,
+		     "%u cycles accounted over %u", (u32_t)total, wall);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(thread_runtime,
+			 ztest_unit_test(test_runtime_busy),
+			 ztest_unit_test(test_runtime_idle),
+			 ztest_unit_test(test_runtime_wall_time));
+	ztest_run_test_suite(thread_runtime);
+}
@@ -301,6 +301,57 @@ void test_timer_user_data(void)
 	}
 }
 
+/* microsecond resolution tests */
+
+#define US_DURATION 1500
+#define US_PERIOD 700
+
+/* timeouts are rounded up to the next tick, and may start during a tick */
+#define US_TOLERANCE (2 * sys_clock_us_per_tick + 100)
+
+static u32_t elapsed_us(u32_t start)
+{
+	return SYS_CLOCK_HW_CYCLES_TO_NS64(k_cycle_get_32() - start) /
+	       NSEC_PER_USEC;
+}
+
+void test_timer_us(void)
+{
+	u32_t start, us;
+
+	k_timer_init(&timer, NULL, NULL);
+
+	start = k_cycle_get_32();
+	/** TESTPOINT: timer with microsecond duration and period */
+	k_timer_start_us(&timer, US_DURATION, US_PERIOD);
+	k_timer_status_sync(&timer);
+	us = elapsed_us(start);
+	TIMER_ASSERT(WITHIN_ERROR(us, US_DURATION, US_TOLERANCE), &timer);
+
+	for (int i = 1; i < EXPIRE_TIMES; i++) {
+		k_timer_status_sync(&timer);
+	}
+	us = elapsed_us(start);
+	TIMER_ASSERT(WITHIN_ERROR(us, US_DURATION + (EXPIRE_TIMES - 1) *
+				  US_PERIOD, EXPIRE_TIMES * US_TOLERANCE),
+		     &timer);
+
+	k_timer_stop(&timer);
+}
+
+void test_sleep_us(void)
+{
+	u32_t start, us;
+
+	start = k_cycle_get_32();
+	/** TESTPOINT: sleep with microsecond resolution */
+	k_usleep(US_DURATION);
+	us = elapsed_us(start);
+
+	zassert_true(WITHIN_ERROR(us, US_DURATION, US_TOLERANCE),
+		     "slept %u us", us);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(timer_api,
@@ -312,6 +363,8 @@ void test_main(void)
 			 ztest_unit_test(test_timer_status_get_anytime),
 			 ztest_unit_test(test_timer_status_sync),
 			 ztest_unit_test(test_timer_k_define),
-			 ztest_unit_test(test_timer_user_data));
+			 ztest_unit_test(test_timer_user_data),
+			 ztest_unit_test(test_timer_us),
+			 ztest_unit_test(test_sleep_us));
 	ztest_run_test_suite(timer_api);
 }
@@ -20,7 +20,9 @@
 #define NUM_OF_WORK 2
 
 static K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(batch_tstack, STACK_SIZE);
 static struct k_work_q workq;
+static struct k_work_q batch_workq;
 static struct k_work work[NUM_OF_WORK];
 static struct k_delayed_work new_work;
 static struct k_delayed_work delayed_work[NUM_OF_WORK], delayed_work_sleepy;
@@ -216,6 +218,28 @@ void test_work_submit_to_queue_thread(void)
 	}
 }
 
+/**
+ * @ingroup workqueue_thread_tests
+ *
+ * @see k_work_q_start_batch(), k_work_submit_to_queue()
+ */
+void test_work_submit_to_batch_queue(void)
+{
+	k_work_q_start_batch(&batch_workq, batch_tstack, STACK_SIZE,
+			     CONFIG_MAIN_THREAD_PRIORITY, NUM_OF_WORK);
+
+	k_sem_reset(&sync_sema);
+	twork_submit(&batch_workq);
+	for (int i = 0; i < NUM_OF_WORK; i++) {
+		k_sem_take(&sync_sema, K_FOREVER);
+	}
+
+	/**TESTPOINT: work items are not pending once processed*/
+	for (int i = 0; i < NUM_OF_WORK; i++) {
+		zassert_false(k_work_pending(&work[i]), NULL);
+	}
+}
+
 /**
  * @ingroup workqueue_thread_tests
  *
@@ -417,6 +441,7 @@ void test_main(void)
 			 ztest_unit_test(test_work_resubmit_to_queue),
 			 ztest_unit_test(test_work_submit_to_queue_thread),
 			 ztest_unit_test(test_work_submit_to_queue_isr),
+			 ztest_unit_test(test_work_submit_to_batch_queue),
 			 ztest_unit_test(test_work_submit_thread),
 			 ztest_unit_test(test_work_submit_isr),
 			 ztest_unit_test(test_delayed_work_submit_to_queue_thread),
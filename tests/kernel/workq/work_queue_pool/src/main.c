@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <atomic.h>
+
+#define TIMEOUT 100
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+/* threads of the pool, including the one started by k_work_q_start() */
+#define POOL_THREADS 3
+#define NUM_OF_WORK 4
+
+static K_THREAD_STACK_DEFINE(pool_stack, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, POOL_THREADS - 1,
+				   STACK_SIZE);
+static struct k_thread workers[POOL_THREADS - 1];
+static struct k_work_q pool;
+
+static K_THREAD_STACK_DEFINE(prio_stack, STACK_SIZE);
+static struct k_work_q prio_workq;
+
+static struct k_work blockers[POOL_THREADS];
+static struct k_work work[NUM_OF_WORK + 1];
+static struct k_delayed_work delayed_work;
+
+static struct k_sem started_sema;
+static struct k_sem release_sema;
+static struct k_sem sync_sema;
+
+static atomic_t running;
+
+/* order in which the work items were processed */
+static int order[NUM_OF_WORK + 1];
+static int processed;
+
+static void blocker_handler(struct k_work *w)
+{
+	atomic_inc(&running);
+	k_sem_give(&started_sema);
+	k_sem_take(&release_sema, K_FOREVER);
+	atomic_dec(&running);
+	k_sem_give(&sync_sema);
+}
+
+static void work_handler(struct k_work *w)
+{
+	order[processed++] = w - work;
+	k_sem_give(&sync_sema);
+}
+
+static void delayed_work_handler(struct k_work *w)
+{
+	k_sem_give(&sync_sema);
+}
+
+static void sems_init(void)
+{
+	k_sem_init(&started_sema, 0, POOL_THREADS);
+	k_sem_init(&release_sema, 0, POOL_THREADS);
+	k_sem_init(&sync_sema, 0, NUM_OF_WORK + POOL_THREADS);
+	processed = 0;
+}
+
+/* Block @a n threads of @a work_q */
+static void block_threads(struct k_work_q *work_q, int n)
+{
+	for (int i = 0; i < n; i++) {
+		k_work_init(&blockers[i], blocker_handler);
+		k_work_submit_to_queue(work_q, &blockers[i]);
+	}
+	for (int i = 0; i < n; i++) {
+		zassert_equal(k_sem_take(&started_sema, TIMEOUT), 0,
+			      "work queue thread did not start");
+	}
+}
+
+static void release_threads(int n)
+{
+	for (int i = 0; i < n; i++) {
+		k_sem_give(&release_sema);
+	}
+	for (int i = 0; i < n; i++) {
+		zassert_equal(k_sem_take(&sync_sema, TIMEOUT), 0, NULL);
+	}
+}
+
+/**
+ * @brief Test that the threads of a pool process work items concurrently
+ *
+ * @see k_work_q_add_worker()
+ */
+void test_pool_concurrency(void)
+{
+	sems_init();
+
+	/**TESTPOINT: every thread of the pool takes a work item*/
+	block_threads(&pool, POOL_THREADS);
+	zassert_equal(atomic_get(&running), POOL_THREADS, NULL);
+
+	release_threads(POOL_THREADS);
+	zassert_equal(atomic_get(&running), 0, NULL);
+}
+
+/**
+ * @brief Test that a blocked work item does not delay the next ones
+ *
+ * @see k_work_q_add_worker(), k_work_submit_to_queue()
+ */
+void test_pool_head_of_line(void)
+{
+	sems_init();
+
+	block_threads(&pool, POOL_THREADS - 1);
+
+	for (int i = 0; i < NUM_OF_WORK; i++) {
+		k_work_init(&work[i], work_handler);
+		k_work_submit_to_queue(&pool, &work[i]);
+	}
+
+	/**TESTPOINT: the other work items are processed meanwhile*/
+	for (int i = 0; i < NUM_OF_WORK; i++) {
+		zassert_equal(k_sem_take(&sync_sema, TIMEOUT), 0,
+			      "work item %d was held up", i);
+	}
+	zassert_equal(processed, NUM_OF_WORK, NULL);
+
+	release_threads(POOL_THREADS - 1);
+}
+
+/**
+ * @brief Test delayed work items on a pool
+ *
+ * @see k_delayed_work_submit_to_queue(), k_delayed_work_cancel()
+ */
+void test_pool_delayed_work(void)
+{
+	sems_init();
+
+	k_delayed_work_init(&delayed_work, delayed_work_handler);
+
+	/**TESTPOINT: cancel a delayed work item of a pool*/
+	zassert_equal(k_delayed_work_submit_to_queue(&pool, &delayed_work,
+						     TIMEOUT), 0, NULL);
+	zassert_equal(k_delayed_work_cancel(&delayed_work), 0, NULL);
+	zassert_equal(k_sem_take(&sync_sema, TIMEOUT * 2), -EAGAIN, NULL);
+
+	/**TESTPOINT: a delayed work item is processed by a pool*/
+	zassert_equal(k_delayed_work_submit_to_queue(&pool, &delayed_work,
+						     TIMEOUT), 0, NULL);
+	zassert_equal(k_sem_take(&sync_sema, TIMEOUT * 2), 0, NULL);
+}
+
+/**
+ * @brief Test that work items are processed by priority
+ *
+ * @see k_work_priority_set()
+ */
+void test_work_priority(void)
+{
+	static const int prio[] = { 2, 0, 1, -1, 0 };
+	static const int expected[] = { 3, 1, 4, 2, 0 };
+
+	sems_init();
+
+	/* Hold the thread so that the work items pile up */
+	block_threads(&prio_workq, 1);
+
+	for (int i = 0; i < ARRAY_SIZE(prio); i++) {
+		k_work_init(&work[i], work_handler);
+		k_work_priority_set(&work[i], prio[i]);
+		k_work_submit_to_queue(&prio_workq, &work[i]);
+	}
+
+	release_threads(1);
+	for (int i = 0; i < ARRAY_SIZE(prio); i++) {
+		zassert_equal(k_sem_take(&sync_sema, TIMEOUT), 0, NULL);
+	}
+
+	/**TESTPOINT: higher priorities first, FIFO within a priority*/
+	for (int i = 0; i < ARRAY_SIZE(expected); i++) {
+		zassert_equal(order[i], expected[i],
+			      "work item %d processed at %d", order[i], i);
+	}
+}
+
+/**
+ * @brief Test the system workqueue with several threads
+ *
+ * @see CONFIG_SYSTEM_WORKQUEUE_THREADS
+ */
+void test_sys_work_q_pool(void)
+{
+	sems_init();
+
+	block_threads(&k_sys_work_q, 1);
+
+	/**TESTPOINT: the system workqueue is not held up*/
+	k_work_init(&work[0], work_handler);
+	k_work_submit(&work[0]);
+	zassert_equal(k_sem_take(&sync_sema, TIMEOUT), 0, NULL);
+
+	release_threads(1);
+}
+
+void test_main(void)
+{
+	k_work_q_start(&pool, pool_stack, STACK_SIZE,
+		       CONFIG_MAIN_THREAD_PRIORITY);
+	for (int i = 0; i < POOL_THREADS - 1; i++) {
+		k_work_q_add_worker(&pool, &workers[i], worker_stacks[i],
+				    STACK_SIZE, CONFIG_MAIN_THREAD_PRIORITY);
+	}
+
+	k_work_q_start(&prio_workq, prio_stack, STACK_SIZE,
+		       CONFIG_MAIN_THREAD_PRIORITY);
+
+	ztest_test_suite(workqueue_pool,
+			 ztest_unit_test(test_pool_concurrency),
+			 ztest_unit_test(test_pool_head_of_line),
+			 ztest_unit_test(test_pool_delayed_work),
+			 ztest_unit_test(test_work_priority),
+			 ztest_unit_test(test_sys_work_q_pool));
+	ztest_run_test_suite(workqueue_pool);
+}
@@ -254,6 +254,109 @@ void test_memcmp(void)
 	zassert_true((ret != 0), "memcmp 5");
 }
 
+/*
+ * Buffers used to check the routines at every alignment, large enough for
+ * the word-at-a-time routines to go through their unrolled loops.
+ */
+#define ALIGN_BUFSIZE 80
+#define ALIGN_MAX 8
+
+static unsigned char align_src[ALIGN_BUFSIZE + ALIGN_MAX];
+static unsigned char align_dst[ALIGN_BUFSIZE + 2 * ALIGN_MAX];
+
+static unsigned char align_pattern(int i)
+{
+	return (unsigned char)(i * 13 + 1);
+}
+
+/**
+ *
+ * @brief Test memory copy and set functions at every alignment
+ *
+ */
+
+void test_memcpy_memset_align(void)
+{
+	int so, doff, n, i;
+
+	for (i = 0; i < sizeof(align_src); i++) {
+		align_src[i] = align_pattern(i);
+	}
+
+	for (so = 0; so < ALIGN_MAX; so++) {
+		for (doff = 0; doff < ALIGN_MAX; doff++) {
+			for (n = 0; n <= ALIGN_BUFSIZE; n += 7) {
+				memset(align_dst, 0xee, sizeof(align_dst));
+				memcpy(align_dst + doff, align_src + so, n);
+
+				for (i = 0; i < sizeof(align_dst); i++) {
+					unsigned char expected = 0xee;
+
+					if (i >= doff && i < doff + n) {
+						expected =
+						align_pattern(so + i - doff);
+					}
+					zassert_equal(align_dst[i], expected,
+						      "memcpy %d %d %d",
+						      so, doff, n);
+				}
+
+				memset(align_dst + doff, 0x5a, n);
+				for (i = doff; i < doff + n; i++) {
+					zassert_equal(align_dst[i], 0x5a,
+						      "memset %d %d", doff, n);
+				}
+				zassert_equal(align_dst[doff + n], 0xee,
+					      "memset overflow %d %d", doff, n);
+			}
+		}
+	}
+}
+
+/**
+ *
+ * @brief Test string functions at every alignment
+ *
+ */
+
+void test_str_align(void)
+{
+	char *s1 = (char *)align_src;
+	char *s2;
+	int so, doff, len, i;
+
+	for (so = 0; so < ALIGN_MAX; so++) {
+		for (len = 0; len < ALIGN_BUFSIZE - ALIGN_MAX; len += 5) {
+			s1 = (char *)align_src + so;
+			for (i = 0; i < len; i++) {
+				s1[i] = 'a' + i % 3;
+			}
+			s1[len] = '\0';
+
+			zassert_equal(strlen(s1), len, "strlen %d %d", so, len);
+
+			zassert_equal(strchr(s1, '\0'), s1 + len, NULL);
+			zassert_equal(strchr(s1, 'z'), NULL, NULL);
+			if (len > 2) {
+				zassert_equal(strchr(s1, 'c'), s1 + 2, NULL);
+			}
+
+			for (doff = 0; doff < ALIGN_MAX; doff++) {
+				s2 = (char *)align_dst + doff;
+				strcpy(s2, s1);
+				zassert_equal(strcmp(s1, s2), 0, NULL);
+
+				if (len) {
+					s2[len - 1] = 'd';
+					zassert_true(strcmp(s1, s2) < 0, NULL);
+					s2[len - 1] = '\0';
+					zassert_true(strcmp(s1, s2) > 0, NULL);
+				}
+			}
+		}
+	}
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_c_lib,
@@ -267,7 +370,9 @@ void test_main(void)
 			 ztest_unit_test(test_strncpy),
 			 ztest_unit_test(test_memset),
 			 ztest_unit_test(test_strlen),
-			 ztest_unit_test(test_strcmp)
+			 ztest_unit_test(test_strcmp),
+			 ztest_unit_test(test_memcpy_memset_align),
+			 ztest_unit_test(test_str_align)
 			 );
 	ztest_run_test_suite(test_c_lib);
 }
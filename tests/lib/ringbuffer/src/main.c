@@ -227,6 +227,13 @@ void test_ringbuffer_size_put_get_thread_isr(void)
 	irq_offload(tringbuf_get, (void *)2);
 }
 
+extern void test_byte_ring_init(void);
+extern void test_byte_ring_put_get(void);
+extern void test_byte_ring_full(void);
+extern void test_byte_ring_claim_peek(void);
+extern void test_byte_ring_mpsc_commit_order(void);
+extern void test_byte_ring_mpsc_threads(void);
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -239,6 +246,12 @@ void test_main(void)
 			 ztest_unit_test(test_ringbuffer_put_get_thread_isr),
 			 ztest_unit_test(test_ringbuffer_pow2_put_get_thread_isr),
 			 ztest_unit_test(test_ringbuffer_size_put_get_thread_isr),
-			 ztest_unit_test(test_ring_buffer_main));
+			 ztest_unit_test(test_ring_buffer_main),
+			 ztest_unit_test(test_byte_ring_init),
+			 ztest_unit_test(test_byte_ring_put_get),
+			 ztest_unit_test(test_byte_ring_full),
+			 ztest_unit_test(test_byte_ring_claim_peek),
+			 ztest_unit_test(test_byte_ring_mpsc_commit_order),
+			 ztest_unit_test(test_byte_ring_mpsc_threads));
 	ztest_run_test_suite(test_ringbuffer_api);
 }
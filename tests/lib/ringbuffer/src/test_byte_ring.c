@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+#include <ring_buffer.h>
+
+/**
+ * @addtogroup t_ringbuffer
+ * @{
+ * @defgroup t_byte_ring_api test_byte_ring_api
+ * @brief TestPurpose: verify zephyr byte ring buffer API functionality
+ * - API coverage
+ *   -# SYS_BYTE_RING_DECLARE_POW2
+ *   -# sys_byte_ring_init
+ *   -# sys_byte_ring_put_claim / sys_byte_ring_put_commit
+ *   -# sys_byte_ring_mpsc_put_claim / sys_byte_ring_mpsc_put_commit
+ *   -# sys_byte_ring_peek / sys_byte_ring_consume
+ *   -# sys_byte_ring_put / sys_byte_ring_get / sys_byte_ring_mpsc_put
+ * @}
+ */
+
+#define BYTE_RING_POW 5
+#define BYTE_RING_SIZE (1 << BYTE_RING_POW)
+
+#define THREAD_NUM 3
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define N_MSGS 200
+
+/**TESTPOINT: init via SYS_BYTE_RING_DECLARE_POW2*/
+SYS_BYTE_RING_DECLARE_POW2(byte_ring_pow2, BYTE_RING_POW);
+
+static struct byte_ring ring;
+static u8_t ring_data[BYTE_RING_SIZE];
+
+static K_THREAD_STACK_ARRAY_DEFINE(tstack, THREAD_NUM, STACK_SIZE);
+static struct k_thread tdata[THREAD_NUM];
+
+/* message of the MPSC producers */
+struct msg {
+	u16_t producer;
+	u16_t seq;
+};
+
+static u8_t pattern(int i)
+{
+	return (u8_t)(i * 7 + 3);
+}
+
+/*test cases*/
+void test_byte_ring_init(void)
+{
+	zassert_true(sys_byte_ring_is_empty(&byte_ring_pow2), NULL);
+	zassert_equal(sys_byte_ring_space_get(&byte_ring_pow2),
+		      BYTE_RING_SIZE, NULL);
+
+	/**TESTPOINT: init via sys_byte_ring_init*/
+	sys_byte_ring_init(&ring, BYTE_RING_SIZE, ring_data);
+	zassert_true(sys_byte_ring_is_empty(&ring), NULL);
+	zassert_equal(sys_byte_ring_space_get(&ring), BYTE_RING_SIZE, NULL);
+}
+
+void test_byte_ring_put_get(void)
+{
+	u8_t tx[BYTE_RING_SIZE], rx[BYTE_RING_SIZE];
+	int i, len, sent = 0, received = 0;
+
+	sys_byte_ring_init(&ring, BYTE_RING_SIZE, ring_data);
+
+	/* odd lengths, so that data wraps at every possible index */
+	for (len = 1; len < BYTE_RING_SIZE; len += 2) {
+		for (i = 0; i < len; i++) {
+			tx[i] = pattern(sent + i);
+		}
+
+		/**TESTPOINT: byte ring put*/
+		zassert_equal(sys_byte_ring_put(&ring, tx, len), len, NULL);
+		zassert_equal(sys_byte_ring_used_get(&ring), len, NULL);
+		sent += len;
+
+		/**TESTPOINT: byte ring get*/
+		zassert_equal(sys_byte_ring_get(&ring, rx, sizeof(rx)), len,
+			      NULL);
+		for (i = 0; i < len; i++) {
+			zassert_equal(rx[i], pattern(received + i), NULL);
+		}
+		received += len;
+
+		zassert_true(sys_byte_ring_is_empty(&ring), NULL);
+	}
+}
+
+void test_byte_ring_full(void)
+{
+	u8_t tx[BYTE_RING_SIZE + 4] = { 0 };
+	u8_t rx[BYTE_RING_SIZE];
+
+	sys_byte_ring_init(&ring, BYTE_RING_SIZE, ring_data);
+
+	/**TESTPOINT: only the free space is written*/
+	zassert_equal(sys_byte_ring_put(&ring, tx, sizeof(tx)),
+		      BYTE_RING_SIZE, NULL);
+	zassert_equal(sys_byte_ring_space_get(&ring), 0, NULL);
+	zassert_equal(sys_byte_ring_put(&ring, tx, 1), 0, NULL);
+
+	/**TESTPOINT: committing or consuming too much fails*/
+	zassert_equal(sys_byte_ring_put_commit(&ring, 1), -EINVAL, NULL);
+	zassert_equal(sys_byte_ring_consume(&ring, BYTE_RING_SIZE + 1),
+		      -EINVAL, NULL);
+
+	zassert_equal(sys_byte_ring_get(&ring, rx, sizeof(rx)),
+		      BYTE_RING_SIZE, NULL);
+	zassert_equal(sys_byte_ring_get(&ring, rx, sizeof(rx)), 0, NULL);
+}
+
+void test_byte_ring_claim_peek(void)
+{
+	u8_t *data;
+	u32_t n;
+
+	sys_byte_ring_init(&ring, BYTE_RING_SIZE, ring_data);
+
+	/* move the indexes close to the end of the buffer */
+	zassert_equal(sys_byte_ring_put_claim(&ring, &data, BYTE_RING_SIZE),
+		      BYTE_RING_SIZE, NULL);
+	zassert_equal(sys_byte_ring_put_commit(&ring, BYTE_RING_SIZE - 4), 0,
+		      NULL);
+	zassert_equal(sys_byte_ring_consume(&ring, BYTE_RING_SIZE - 4), 0,
+		      NULL);
+
+	/**TESTPOINT: claimed space stops at the end of the buffer*/
+	n = sys_byte_ring_put_claim(&ring, &data, 8);
+	zassert_equal(n, 4, NULL);
+	zassert_equal(data, &ring_data[BYTE_RING_SIZE - 4], NULL);
+	memset(data, 0xaa, n);
+
+	/**TESTPOINT: claimed space is not seen before being committed*/
+	zassert_equal(sys_byte_ring_peek(&ring, &data, 8), 0, NULL);
+	zassert_equal(sys_byte_ring_put_commit(&ring, n), 0, NULL);
+
+	n = sys_byte_ring_put_claim(&ring, &data, 8);
+	zassert_equal(n, 8, NULL);
+	zassert_equal(data, &ring_data[0], NULL);
+	memset(data, 0xbb, n);
+	zassert_equal(sys_byte_ring_put_commit(&ring, n), 0, NULL);
+
+	/**TESTPOINT: peeked bytes stop at the end of the buffer*/
+	n = sys_byte_ring_peek(&ring, &data, 16);
+	zassert_equal(n, 4, NULL);
+	zassert_equal(data[0], 0xaa, NULL);
+
+	/**TESTPOINT: peeking does not consume*/
+	zassert_equal(sys_byte_ring_peek(&ring, &data, 16), 4, NULL);
+	zassert_equal(sys_byte_ring_consume(&ring, n), 0, NULL);
+
+	n = sys_byte_ring_peek(&ring, &data, 16);
+	zassert_equal(n, 8, NULL);
+	zassert_equal(data[0], 0xbb, NULL);
+	zassert_equal(sys_byte_ring_consume(&ring, n), 0, NULL);
+	zassert_true(sys_byte_ring_is_empty(&ring), NULL);
+}
+
+static void tbyte_ring_mpsc_put_isr(void *p)
+{
+	struct msg msg = { .producer = 1, .seq = 0 };
+
+	/**TESTPOINT: byte ring MPSC put from ISR*/
+	zassert_equal(sys_byte_ring_mpsc_put(&ring, (u8_t *)&msg,
+					     sizeof(msg)), sizeof(msg), NULL);
+}
+
+void test_byte_ring_mpsc_commit_order(void)
+{
+	struct msg msg;
+	u8_t *data;
+
+	sys_byte_ring_init(&ring, BYTE_RING_SIZE, ring_data);
+
+	zassert_equal(sys_byte_ring_mpsc_put_claim(&ring, &data, sizeof(msg)),
+		      sizeof(msg), NULL);
+
+	/* another producer commits while the first one writes */
+	irq_offload(tbyte_ring_mpsc_put_isr, NULL);
+
+	/**TESTPOINT: no byte is seen until all claims are committed*/
+	zassert_true(sys_byte_ring_is_empty(&ring), NULL);
+	zassert_equal(sys_byte_ring_space_get(&ring),
+		      BYTE_RING_SIZE - 2 * sizeof(msg), NULL);
+
+	msg.producer = 0;
+	msg.seq = 0;
+	memcpy(data, &msg, sizeof(msg));
+	sys_byte_ring_mpsc_put_commit(&ring);
+
+	zassert_equal(sys_byte_ring_used_get(&ring), 2 * sizeof(msg), NULL);
+
+	zassert_equal(sys_byte_ring_get(&ring, (u8_t *)&msg, sizeof(msg)),
+		      sizeof(msg), NULL);
+	zassert_equal(msg.producer, 0, NULL);
+	zassert_equal(sys_byte_ring_get(&ring, (u8_t *)&msg, sizeof(msg)),
+		      sizeof(msg), NULL);
+	zassert_equal(msg.producer, 1, NULL);
+}
+
+static void tbyte_ring_producer(void *p1, void *p2, void *p3)
+{
+	struct msg msg = { .producer = (uintptr_t)p1 };
+	u8_t *data;
+
+	for (msg.seq = 0; msg.seq < N_MSGS; msg.seq++) {
+		/* messages never wrap, as the buffer holds whole messages */
+		while (!sys_byte_ring_mpsc_put_claim(&ring, &data,
+						     sizeof(msg))) {
+			k_yield();
+		}
+
+		memcpy(data, &msg, sizeof(msg));
+
+		/* let other producers claim before this one commits */
+		if (msg.seq & 1) {
+			k_yield();
+		}
+
+		sys_byte_ring_mpsc_put_commit(&ring);
+	}
+}
+
+void test_byte_ring_mpsc_threads(void)
+{
+	u16_t next_seq[THREAD_NUM] = { 0 };
+	k_tid_t tid[THREAD_NUM];
+	struct msg msg;
+	int received = 0;
+	int prio;
+
+	sys_byte_ring_init(&ring, BYTE_RING_SIZE, ring_data);
+
+	/* producers and consumer yield to each other */
+	prio = k_thread_priority_get(k_current_get());
+
+	for (int i = 0; i < THREAD_NUM; i++) {
+		tid[i] = k_thread_create(&tdata[i], tstack[i], STACK_SIZE,
+					 tbyte_ring_producer,
+					 (void *)(uintptr_t)i, NULL, NULL,
+					 prio, 0, 0);
+	}
+
+	/**TESTPOINT: messages of each producer come whole and in order*/
+	while (received < THREAD_NUM * N_MSGS) {
+		if (!sys_byte_ring_get(&ring, (u8_t *)&msg, sizeof(msg))) {
+			k_yield();
+			continue;
+		}
+
+		zassert_true(msg.producer < THREAD_NUM, NULL);
+		zassert_equal(msg.seq, next_seq[msg.producer], NULL);
+		next_seq[msg.producer]++;
+		received++;
+	}
+
+	zassert_true(sys_byte_ring_is_empty(&ring), NULL);
+
+	for (int i = 0; i < THREAD_NUM; i++) {
+		k_thread_abort(tid[i]);
+	}
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2018 Linaro Limited
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest_assert.h>
+
+#include <net/socket.h>
+
+#define TEST_STR_SMALL "test"
+
+#define PORT1 4242
+#define PORT2 4243
+#define TCP_PORT 4244
+
+#define WAIT_TIMEOUT 100
+
+#define TCP_TEARDOWN_TIMEOUT K_SECONDS(1)
+
+static void prepare_addr(struct sockaddr_in *addr, u16_t port)
+{
+	int rv;
+
+	addr->sin_family = AF_INET;
+	addr->sin_port = htons(port);
+	rv = inet_pton(AF_INET, CONFIG_NET_APP_MY_IPV4_ADDR, &addr->sin_addr);
+	zassert_equal(rv, 1, "inet_pton failed");
+}
+
+static int prepare_udp_sock(u16_t port, struct sockaddr_in *addr)
+{
+	int sock, rv;
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(sock >= 0, "socket open failed");
+
+	prepare_addr(addr, port);
+	rv = bind(sock, (struct sockaddr *)addr, sizeof(*addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	return sock;
+}
+
+static void epoll_add(int epfd, int sock, u32_t events)
+{
+	struct epoll_event event = { .events = events, .data.fd = sock };
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_ADD, sock, &event), 0,
+		      "epoll_ctl add failed");
+}
+
+static void check_ready(int epfd, int sock, u32_t events)
+{
+	struct epoll_event ready[4];
+	int n;
+
+	n = epoll_wait(epfd, ready, ARRAY_SIZE(ready), WAIT_TIMEOUT);
+	zassert_equal(n, 1, "unexpected number of sockets ready");
+	zassert_equal(ready[0].data.fd, sock, "unexpected socket ready");
+	zassert_equal(ready[0].events, events, "unexpected events");
+}
+
+static void check_none_ready(int epfd)
+{
+	struct epoll_event ready[4];
+
+	zassert_equal(epoll_wait(epfd, ready, ARRAY_SIZE(ready), 0), 0,
+		      "unexpected socket ready");
+}
+
+void test_epoll_udp(void)
+{
+	int epfd, sock1, sock2, client;
+	struct sockaddr_in addr1, addr2;
+	struct epoll_event event;
+	char buf[10];
+	int len;
+
+	epfd = epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed");
+
+	sock1 = prepare_udp_sock(PORT1, &addr1);
+	sock2 = prepare_udp_sock(PORT2, &addr2);
+	client = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(client >= 0, "socket open failed");
+
+	epoll_add(epfd, sock1, EPOLLIN);
+	epoll_add(epfd, sock2, EPOLLIN);
+
+	event.events = EPOLLIN;
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_ADD, sock1, &event), -1,
+		      "socket added twice");
+	zassert_equal(errno, EEXIST, "unexpected errno");
+
+	check_none_ready(epfd);
+
+	len = sendto(client, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0,
+		     (struct sockaddr *)&addr2, sizeof(addr2));
+	zassert_equal(len, strlen(TEST_STR_SMALL), "sendto failed");
+
+	/**TESTPOINT: only the socket with data is reported, for as long
+	 * as it has data
+	 */
+	check_ready(epfd, sock2, EPOLLIN);
+	check_ready(epfd, sock2, EPOLLIN);
+
+	len = recv(sock2, buf, sizeof(buf), 0);
+	zassert_equal(len, strlen(TEST_STR_SMALL), "recv failed");
+
+	check_none_ready(epfd);
+
+	/**TESTPOINT: the events are changed */
+	event.events = EPOLLIN | EPOLLOUT;
+	event.data.fd = sock1;
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_MOD, sock1, &event), 0,
+		      "epoll_ctl mod failed");
+	check_ready(epfd, sock1, EPOLLOUT);
+
+	/**TESTPOINT: the socket is no longer reported once removed */
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_DEL, sock1, NULL), 0,
+		      "epoll_ctl del failed");
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_DEL, sock1, NULL), -1,
+		      "socket removed twice");
+	zassert_equal(errno, ENOENT, "unexpected errno");
+	check_none_ready(epfd);
+
+	/* sock2 is closed while registered */
+	zassert_equal(close(sock2), 0, "close failed");
+	zassert_equal(close(sock1), 0, "close failed");
+	zassert_equal(close(client), 0, "close failed");
+	zassert_equal(close(epfd), 0, "close failed");
+}
+
+void test_epoll_tcp(void)
+{
+	int epfd, s_sock, c_sock, new_sock;
+	struct sockaddr_in addr;
+	char buf[10];
+	int len;
+
+	epfd = epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed");
+
+	s_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	c_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(s_sock >= 0 && c_sock >= 0, "socket open failed");
+
+	prepare_addr(&addr, TCP_PORT);
+	zassert_equal(bind(s_sock, (struct sockaddr *)&addr, sizeof(addr)), 0,
+		      "bind failed");
+	zassert_equal(listen(s_sock, 1), 0, "listen failed");
+
+	epoll_add(epfd, s_sock, EPOLLIN);
+	check_none_ready(epfd);
+
+	/**TESTPOINT: a listening socket is ready on a new connection */
+	zassert_equal(connect(c_sock, (struct sockaddr *)&addr, sizeof(addr)),
+		      0, "connect failed");
+	check_ready(epfd, s_sock, EPOLLIN);
+
+	new_sock = accept(s_sock, NULL, NULL);
+	zassert_true(new_sock >= 0, "accept failed");
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_DEL, s_sock, NULL), 0,
+		      "epoll_ctl del failed");
+
+	epoll_add(epfd, new_sock, EPOLLIN);
+
+	len = send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+	zassert_equal(len, strlen(TEST_STR_SMALL), "send failed");
+	check_ready(epfd, new_sock, EPOLLIN);
+
+	len = recv(new_sock, buf, sizeof(buf), 0);
+	zassert_equal(len, strlen(TEST_STR_SMALL), "recv failed");
+	check_none_ready(epfd);
+
+	/**TESTPOINT: the hang-up of the peer is reported */
+	zassert_equal(close(c_sock), 0, "close failed");
+	check_ready(epfd, new_sock, EPOLLIN | EPOLLHUP);
+	zassert_equal(recv(new_sock, buf, sizeof(buf), 0), 0,
+		      "no end of file");
+	check_ready(epfd, new_sock, EPOLLIN | EPOLLHUP);
+
+	zassert_equal(close(new_sock), 0, "close failed");
+	zassert_equal(close(s_sock), 0, "close failed");
+	zassert_equal(close(epfd), 0, "close failed");
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(socket_epoll,
+			 ztest_unit_test(test_epoll_udp),
+			 ztest_unit_test(test_epoll_tcp));
+
+	ztest_run_test_suite(socket_epoll);
+}
@@ -6,6 +6,10 @@
 
 #include <ztest_assert.h>
 #include <net/socket.h>
+#include <net/buf.h>
+#include <net/net_context.h>
+
+#include "tcp_internal.h"
 
 #define TEST_STR_SMALL "test"
 
@@ -16,6 +20,8 @@
 
 #define TCP_TEARDOWN_TIMEOUT K_SECONDS(1)
 
+#define ZC_LARGE_FRAGS 5
+
 static void prepare_sock_v4(const char *addr,
 			    u16_t port,
 			    int *sock,
@@ -390,6 +396,199 @@ void test_v6_sendto_recvfrom_null_dest(void)
 	k_sleep(TCP_TEARDOWN_TIMEOUT);
 }
 
+void test_v4_msg_zc(void)
+{
+	/* Test recvmsg()/sendmsg() and zero-copy send and receive on a
+	 * ipv4 stream socket.
+	 */
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	char buf1[2], buf2[10];
+	struct iovec tx_iov[] = {
+		{ .iov_base = "te", .iov_len = 2 },
+		{ .iov_base = "st", .iov_len = 2 },
+	};
+	struct iovec rx_iov[] = {
+		{ .iov_base = buf1, .iov_len = sizeof(buf1) },
+		{ .iov_base = buf2, .iov_len = sizeof(buf2) },
+	};
+	struct msghdr msg = { 0 };
+	struct net_context *ctx;
+	struct net_buf *frags;
+	u8_t rx_buf[64];
+	size_t total = 0;
+	u32_t recv_wnd;
+	ssize_t len;
+	int i, j;
+
+	prepare_sock_v4(CONFIG_NET_APP_MY_IPV4_ADDR,
+			ANY_PORT,
+			&c_sock,
+			&c_saddr);
+
+	prepare_sock_v4(CONFIG_NET_APP_MY_IPV4_ADDR,
+			SERVER_PORT,
+			&s_sock,
+			&s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, NULL, NULL);
+
+	msg.msg_iov = tx_iov;
+	msg.msg_iovlen = ARRAY_SIZE(tx_iov);
+	len = sendmsg(c_sock, &msg, 0);
+	zassert_equal(len, strlen(TEST_STR_SMALL), "sendmsg failed");
+
+	/* The stream fills the buffers in order */
+	msg.msg_iov = rx_iov;
+	msg.msg_iovlen = ARRAY_SIZE(rx_iov);
+	len = recvmsg(new_sock, &msg, 0);
+	zassert_equal(len, strlen(TEST_STR_SMALL), "recvmsg failed");
+	zassert_equal(memcmp(buf1, "te", 2), 0, "unexpected data");
+	zassert_equal(memcmp(buf2, "st", 2), 0, "unexpected data");
+
+	frags = zsock_alloc_send_buf(c_sock, 0);
+	zassert_not_null(frags, "cannot allocate send buffer");
+	net_buf_add_mem(frags, TEST_STR_SMALL, strlen(TEST_STR_SMALL));
+
+	len = zsock_sendto_zc(c_sock, frags, 0, NULL, 0);
+	zassert_equal(len, strlen(TEST_STR_SMALL), "zero-copy send failed");
+
+	len = zsock_recv_zc(new_sock, &frags, 0, NULL, NULL);
+	zassert_equal(len, strlen(TEST_STR_SMALL), "zero-copy recv failed");
+	zassert_equal(frags->len, len, "unexpected fragments");
+	zassert_equal(memcmp(frags->data, TEST_STR_SMALL, len), 0,
+		      "unexpected data");
+
+	/* The window is reopened by the length received, even when the
+	 * fragments were consumed in between.
+	 */
+	ctx = INT_TO_POINTER(new_sock);
+	recv_wnd = net_tcp_get_recv_wnd(ctx->tcp);
+	net_buf_pull(frags, len);
+
+	zsock_recv_zc_release(new_sock, frags);
+	zassert_equal(net_tcp_get_recv_wnd(ctx->tcp), recv_wnd + len,
+		      "receive window not reopened");
+
+	/* A chain longer than a segment is sent in several packets */
+	frags = NULL;
+	for (i = 0; i < ZC_LARGE_FRAGS; i++) {
+		struct net_buf *frag = zsock_alloc_send_buf(c_sock, 0);
+
+		zassert_not_null(frag, "cannot allocate send buffer");
+		while (net_buf_tailroom(frag)) {
+			net_buf_add_u8(frag, total++);
+		}
+
+		frags = frags ? net_buf_frag_add(frags, frag) : frag;
+	}
+
+	ctx = INT_TO_POINTER(c_sock);
+	zassert_true(total > ctx->tcp->send_mss,
+		     "chain not larger than a segment");
+
+	len = zsock_sendto_zc(c_sock, frags, 0, NULL, 0);
+	zassert_equal(len, total, "zero-copy send failed");
+
+	for (i = 0; i < total; i += len) {
+		len = recv(new_sock, rx_buf, sizeof(rx_buf), 0);
+		zassert_true(len > 0, "recv failed");
+
+		for (j = 0; j < len; j++) {
+			zassert_equal(rx_buf[j], (u8_t)(i + j),
+				      "unexpected data");
+		}
+	}
+
+	zassert_equal(i, total, "unexpected length");
+
+	test_close(new_sock);
+	test_close(c_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+void test_v4_sockopt(void)
+{
+	/* Test the TCP_NODELAY and TCP_CORK options on a ipv4 stream
+	 * socket, and the coalescing of the data written while corked.
+	 */
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	int optval, on = 1, off = 0;
+	socklen_t optlen = sizeof(optval);
+	char rx_buf[30] = {0};
+	ssize_t len;
+
+	prepare_sock_v4(CONFIG_NET_APP_MY_IPV4_ADDR,
+			ANY_PORT,
+			&c_sock,
+			&c_saddr);
+
+	prepare_sock_v4(CONFIG_NET_APP_MY_IPV4_ADDR,
+			SERVER_PORT,
+			&s_sock,
+			&s_saddr);
+
+	zassert_equal(getsockopt(c_sock, IPPROTO_TCP, TCP_NODELAY, &optval,
+				 &optlen), 0, "getsockopt failed");
+	zassert_equal(optval, 0, "TCP_NODELAY set by default");
+	zassert_equal(optlen, sizeof(optval), "wrong optlen");
+
+	zassert_equal(setsockopt(c_sock, IPPROTO_TCP, TCP_NODELAY, &on,
+				 sizeof(on)), 0, "setsockopt failed");
+	zassert_equal(getsockopt(c_sock, IPPROTO_TCP, TCP_NODELAY, &optval,
+				 &optlen), 0, "getsockopt failed");
+	zassert_equal(optval, 1, "TCP_NODELAY not set");
+
+	zassert_equal(setsockopt(c_sock, IPPROTO_TCP, TCP_CORK, &on,
+				 sizeof(on)), 0, "setsockopt failed");
+	zassert_equal(getsockopt(c_sock, IPPROTO_TCP, TCP_CORK, &optval,
+				 &optlen), 0, "getsockopt failed");
+	zassert_equal(optval, 1, "TCP_CORK not set");
+
+	zassert_equal(setsockopt(c_sock, IPPROTO_UDP, TCP_NODELAY, &on,
+				 sizeof(on)), -1, "setsockopt succeeded");
+	zassert_equal(errno, ENOPROTOOPT, "unexpected errno");
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, NULL, NULL);
+
+	/* The small writes are held while corked */
+	test_send(c_sock, "te", 2, 0);
+	test_send(c_sock, "st", 2, 0);
+
+	len = recv(new_sock, rx_buf, sizeof(rx_buf), MSG_DONTWAIT);
+	zassert_equal(len, -1, "data sent while corked");
+	zassert_equal(errno, EAGAIN, "unexpected errno");
+
+	zassert_equal(setsockopt(c_sock, IPPROTO_TCP, TCP_CORK, &off,
+				 sizeof(off)), 0, "setsockopt failed");
+
+	/* And sent in one segment once uncorked */
+	test_recv(new_sock, 0);
+
+	test_close(new_sock);
+	test_close(c_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(socket_tcp,
@@ -398,7 +597,9 @@ void test_main(void)
 			 ztest_unit_test(test_v4_sendto_recvfrom),
 			 ztest_unit_test(test_v6_sendto_recvfrom),
 			 ztest_unit_test(test_v4_sendto_recvfrom_null_dest),
-			 ztest_unit_test(test_v6_sendto_recvfrom_null_dest));
+			 ztest_unit_test(test_v6_sendto_recvfrom_null_dest),
+			 ztest_unit_test(test_v4_msg_zc),
+			 ztest_unit_test(test_v4_sockopt));
 
 	ztest_run_test_suite(socket_tcp);
 }
@@ -8,6 +8,7 @@
 #include <ztest_assert.h>
 
 #include <net/socket.h>
+#include <net/buf.h>
 
 #define BUF_AND_SIZE(buf) buf, sizeof(buf) - 1
 #define STRLEN(buf) (sizeof(buf) - 1)
@@ -322,6 +323,130 @@ void test_send_recv_2_sock(void)
 	zassert_equal(rv, 0, "close failed");
 }
 
+static void prepare_2_sock(int *sock1, int *sock2, u16_t port)
+{
+	struct sockaddr_in bind_addr, conn_addr;
+	int rv;
+
+	*sock1 = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	*sock2 = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(*sock1 >= 0, "cannot create sock1");
+	zassert_true(*sock2 >= 0, "cannot create sock2");
+
+	bind_addr.sin_family = AF_INET;
+	bind_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	bind_addr.sin_port = htons(port);
+	rv = bind(*sock1, (struct sockaddr *)&bind_addr, sizeof(bind_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	conn_addr.sin_family = AF_INET;
+	conn_addr.sin_addr.s_addr = htonl(0xc0000201);
+	conn_addr.sin_port = htons(port);
+	rv = connect(*sock2, (struct sockaddr *)&conn_addr, sizeof(conn_addr));
+	zassert_equal(rv, 0, "connect failed");
+}
+
+void test_sendmsg_recvmsg(void)
+{
+	int sock1, sock2;
+	char buf1[3], buf2[3];
+	struct sockaddr_in addr;
+	struct iovec tx_iov[] = {
+		{ .iov_base = "te", .iov_len = 2 },
+		{ .iov_base = "st", .iov_len = 2 },
+	};
+	struct iovec rx_iov[] = {
+		{ .iov_base = buf1, .iov_len = sizeof(buf1) },
+		{ .iov_base = buf2, .iov_len = sizeof(buf2) },
+	};
+	struct msghdr msg = { 0 };
+	int len, rv;
+
+	prepare_2_sock(&sock1, &sock2, 55556);
+
+	msg.msg_iov = tx_iov;
+	msg.msg_iovlen = ARRAY_SIZE(tx_iov);
+	len = sendmsg(sock2, &msg, 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid sendmsg len");
+
+	/* The datagram is scattered in both buffers */
+	msg.msg_name = &addr;
+	msg.msg_namelen = sizeof(addr);
+	msg.msg_iov = rx_iov;
+	msg.msg_iovlen = ARRAY_SIZE(rx_iov);
+	len = recvmsg(sock1, &msg, MSG_PEEK);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recvmsg len");
+	zassert_equal(memcmp(buf1, "tes", 3), 0, "invalid recvmsg data");
+	zassert_equal(buf2[0], 't', "invalid recvmsg data");
+	zassert_equal(msg.msg_flags, 0, "unexpected recvmsg flags");
+	zassert_equal(msg.msg_namelen, sizeof(addr), "invalid addrlen");
+	zassert_equal(addr.sin_family, AF_INET, "invalid address family");
+
+	/* What does not fit in the buffers is discarded */
+	msg.msg_iovlen = 1;
+	len = recvmsg(sock1, &msg, 0);
+	zassert_equal(len, sizeof(buf1), "invalid recvmsg len");
+	zassert_equal(msg.msg_flags, MSG_TRUNC, "datagram not truncated");
+
+	rv = close(sock1);
+	zassert_equal(rv, 0, "close failed");
+
+	rv = close(sock2);
+	zassert_equal(rv, 0, "close failed");
+}
+
+void test_send_recv_zc(void)
+{
+	int sock1, sock2;
+	struct net_buf *frags, *frag;
+	struct sockaddr_in addr;
+	socklen_t addrlen = sizeof(addr);
+	char buf[10];
+	int len, rv;
+
+	prepare_2_sock(&sock1, &sock2, 55557);
+
+	frags = zsock_alloc_send_buf(sock2, 0);
+	zassert_not_null(frags, "cannot allocate send buffer");
+	net_buf_add_mem(frags, "te", 2);
+
+	frag = zsock_alloc_send_buf(sock2, 0);
+	zassert_not_null(frag, "cannot allocate send buffer");
+	net_buf_add_mem(frag, "st", 2);
+	net_buf_frag_add(frags, frag);
+
+	len = zsock_sendto_zc(sock2, frags, 0, NULL, 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid zero-copy send");
+
+	len = zsock_recv_zc(sock1, &frags, MSG_PEEK, NULL, NULL);
+	zassert_equal(len, -1, "zero-copy peek not rejected");
+	zassert_equal(errno, EINVAL, "unexpected errno");
+
+	len = zsock_recv_zc(sock1, &frags, 0, (struct sockaddr *)&addr,
+			    &addrlen);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid zero-copy recv");
+	zassert_equal(net_buf_frags_len(frags), len, "invalid fragments");
+	zassert_equal(addrlen, sizeof(addr), "invalid addrlen");
+
+	/**TESTPOINT: the fragments hold the payload only */
+	len = 0;
+	for (frag = frags; frag; frag = frag->frags) {
+		zassert_true(len + frag->len <= sizeof(buf), "data too long");
+		memcpy(buf + len, frag->data, frag->len);
+		len += frag->len;
+	}
+	zassert_equal(memcmp(buf, TEST_STR_SMALL, len), 0,
+		      "invalid zero-copy data");
+
+	zsock_recv_zc_release(sock1, frags);
+
+	rv = close(sock1);
+	zassert_equal(rv, 0, "close failed");
+
+	rv = close(sock2);
+	zassert_equal(rv, 0, "close failed");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(socket_udp,
@@ -329,7 +454,9 @@ void test_main(void)
 			 ztest_unit_test(test_v4_sendto_recvfrom),
 			 ztest_unit_test(test_v6_sendto_recvfrom),
 			 ztest_unit_test(test_v4_bind_sendto),
-			 ztest_unit_test(test_v6_bind_sendto));
+			 ztest_unit_test(test_v6_bind_sendto),
+			 ztest_unit_test(test_sendmsg_recvmsg),
+			 ztest_unit_test(test_send_recv_zc));
 
 	ztest_run_test_suite(socket_udp);
 }
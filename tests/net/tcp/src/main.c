@@ -130,6 +130,314 @@ static void v6_send_syn_ack(struct net_if *iface, struct net_pkt *req)
 	k_sem_give(&wait_connect);
 }
 
+/* A connection to a peer emulated by the test: the segments sent to the
+ * peer are recorded, and the test injects the segments of the peer.
+ */
+#define CONN_PEER_PORT 4200
+#define CONN_PEER_ISN 1000
+#define CONN_MSS 80
+#define CONN_WND 4096
+#define CONN_SEGMENTS 16
+#define CONN_WAIT K_MSEC(10)
+
+struct conn_segment {
+	u8_t flags;
+	u32_t seq;
+	u32_t ack;
+	u16_t len;
+	struct net_tcp_options opts;
+};
+
+static struct in_addr conn_peer_inaddr = { { { 192, 0, 2, 99 } } };
+static struct net_context *conn_ctx;
+static u16_t conn_port = 4100;
+
+/* Next sequence number of the data sent by the stack and by the peer */
+static u32_t conn_local_seq;
+static u32_t conn_peer_seq;
+
+static struct conn_segment conn_segs[CONN_SEGMENTS];
+static int conn_seg_count;
+
+static u32_t conn_sent_len;
+static u32_t conn_rcvd_len;
+static bool conn_rcvd_bad;
+
+static const u8_t conn_syn_opts[] = {
+	NET_TCP_MSS_OPT, NET_TCP_MSS_SIZE, 0, CONN_MSS,
+	NET_TCP_NOP_OPT, NET_TCP_NOP_OPT,
+	NET_TCP_SACK_PERM_OPT, NET_TCP_SACK_PERM_SIZE,
+};
+
+static u8_t conn_pattern(u32_t offset)
+{
+	return offset % 251;
+}
+
+static void conn_record(struct net_pkt *pkt)
+{
+	struct net_tcp_hdr hdr, *tcp_hdr;
+	struct conn_segment *seg;
+	int optlen;
+
+	tcp_hdr = net_tcp_get_hdr(pkt, &hdr);
+	if (!tcp_hdr || conn_seg_count == CONN_SEGMENTS) {
+		return;
+	}
+
+	seg = &conn_segs[conn_seg_count++];
+	memset(seg, 0, sizeof(*seg));
+
+	seg->flags = NET_TCP_FLAGS(tcp_hdr);
+	seg->seq = sys_get_be32(tcp_hdr->seq);
+	seg->ack = sys_get_be32(tcp_hdr->ack);
+	seg->len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+		   NET_TCP_HDR_LEN(tcp_hdr);
+
+	optlen = NET_TCP_HDR_LEN(tcp_hdr) - sizeof(struct net_tcp_hdr);
+	if (optlen > 0) {
+		net_tcp_parse_opts(pkt, optlen, &seg->opts);
+	}
+}
+
+static struct conn_segment *conn_last(void)
+{
+	return conn_seg_count ? &conn_segs[conn_seg_count - 1] : NULL;
+}
+
+static int conn_data_segs(void)
+{
+	int i, count = 0;
+
+	for (i = 0; i < conn_seg_count; i++) {
+		if (conn_segs[i].len) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+static void conn_wait(void)
+{
+	k_sleep(CONN_WAIT);
+}
+
+/* Inject a segment of the peer, carrying len bytes of data */
+static void conn_inject(u8_t flags, u32_t seq, u32_t ack,
+			const u8_t *opts, u8_t optlen, u16_t len)
+{
+	struct net_ipv4_hdr ipv4 = { 0 };
+	struct net_tcp_hdr tcp_hdr = { 0 };
+	u8_t data[CONN_MSS];
+	struct net_pkt *pkt;
+	u16_t i;
+
+	pkt = net_pkt_get_reserve_rx(0, K_FOREVER);
+
+	ipv4.vhl = 0x45;
+	ipv4.ttl = 64;
+	ipv4.proto = IPPROTO_TCP;
+	sys_put_be16(sizeof(ipv4) + sizeof(tcp_hdr) + optlen + len, ipv4.len);
+	net_ipaddr_copy(&ipv4.src, &conn_peer_inaddr);
+	net_ipaddr_copy(&ipv4.dst, &my_v4_inaddr);
+
+	tcp_hdr.src_port = htons(CONN_PEER_PORT);
+	tcp_hdr.dst_port = htons(conn_port);
+	sys_put_be32(seq, tcp_hdr.seq);
+	sys_put_be32(ack, tcp_hdr.ack);
+	tcp_hdr.offset = ((sizeof(tcp_hdr) + optlen) / 4) << 4;
+	tcp_hdr.flags = flags;
+	sys_put_be16(CONN_WND, tcp_hdr.wnd);
+
+	for (i = 0; i < len; i++) {
+		data[i] = conn_pattern(seq - CONN_PEER_ISN - 1 + i);
+	}
+
+	net_pkt_append_all(pkt, sizeof(ipv4), (u8_t *)&ipv4, K_FOREVER);
+	net_pkt_append_all(pkt, sizeof(tcp_hdr), (u8_t *)&tcp_hdr, K_FOREVER);
+	net_pkt_append_all(pkt, optlen, (u8_t *)opts, K_FOREVER);
+	net_pkt_append_all(pkt, len, data, K_FOREVER);
+
+	if (net_recv_data(net_if_get_default(), pkt) < 0) {
+		net_pkt_unref(pkt);
+	}
+}
+
+/* SACK option reporting count blocks, given as start and end pairs */
+static u8_t conn_sack_opt(u8_t *opts, const u32_t *edges, int count)
+{
+	int i;
+
+	opts[0] = NET_TCP_NOP_OPT;
+	opts[1] = NET_TCP_NOP_OPT;
+	opts[2] = NET_TCP_SACK_OPT;
+	opts[3] = 2 + count * NET_TCP_SACK_BLOCK_SIZE;
+
+	for (i = 0; i < 2 * count; i++) {
+		sys_put_be32(edges[i], opts + 4 + i * sizeof(u32_t));
+	}
+
+	return 4 + count * NET_TCP_SACK_BLOCK_SIZE;
+}
+
+static void conn_recv_cb(struct net_context *context, struct net_pkt *pkt,
+			 int status, void *user_data)
+{
+	u8_t data[CONN_MSS];
+	u16_t len, i;
+
+	if (!pkt) {
+		return;
+	}
+
+	len = min(net_pkt_appdatalen(pkt), sizeof(data));
+	net_frag_linearize(data, sizeof(data), pkt,
+			   net_pkt_get_len(pkt) - net_pkt_appdatalen(pkt), len);
+
+	for (i = 0; i < len; i++) {
+		if (data[i] != conn_pattern(conn_rcvd_len + i)) {
+			conn_rcvd_bad = true;
+		}
+	}
+
+	conn_rcvd_len += net_pkt_appdatalen(pkt);
+
+	net_pkt_unref(pkt);
+}
+
+/* Connect to the peer, which answers with an MSS of mss and SACK */
+static bool conn_open_mss(u16_t mss)
+{
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+		.sin_addr = my_v4_inaddr,
+	};
+	struct sockaddr_in peer = {
+		.sin_family = AF_INET,
+		.sin_port = htons(CONN_PEER_PORT),
+		.sin_addr = conn_peer_inaddr,
+	};
+	u8_t opts[sizeof(conn_syn_opts)];
+	struct conn_segment *seg;
+	int ret;
+
+	conn_port++;
+	conn_seg_count = 0;
+	conn_sent_len = 0;
+	conn_rcvd_len = 0;
+	conn_rcvd_bad = false;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &conn_ctx);
+	if (ret) {
+		TC_ERROR("Context get failed (%d)\n", ret);
+		return false;
+	}
+
+	local.sin_port = htons(conn_port);
+
+	ret = net_context_bind(conn_ctx, (struct sockaddr *)&local,
+			       sizeof(local));
+	if (!ret) {
+		ret = net_context_connect(conn_ctx, (struct sockaddr *)&peer,
+					  sizeof(peer), NULL, K_NO_WAIT, NULL);
+	}
+
+	if (ret) {
+		TC_ERROR("Cannot connect (%d)\n", ret);
+		net_context_put(conn_ctx);
+		return false;
+	}
+
+	conn_wait();
+
+	seg = conn_last();
+	if (!seg || seg->flags != NET_TCP_SYN) {
+		TC_ERROR("SYN not sent\n");
+		net_context_put(conn_ctx);
+		return false;
+	}
+
+	conn_local_seq = seg->seq + 1;
+	conn_peer_seq = CONN_PEER_ISN + 1;
+
+	memcpy(opts, conn_syn_opts, sizeof(opts));
+	sys_put_be16(mss, opts + 2);
+
+	conn_inject(NET_TCP_SYN | NET_TCP_ACK, CONN_PEER_ISN, conn_local_seq,
+		    opts, sizeof(opts), 0);
+	conn_wait();
+
+	if (net_tcp_get_state(conn_ctx->tcp) != NET_TCP_ESTABLISHED) {
+		TC_ERROR("Connection not established\n");
+		net_context_put(conn_ctx);
+		return false;
+	}
+
+	net_context_recv(conn_ctx, conn_recv_cb, K_NO_WAIT, NULL);
+
+	conn_seg_count = 0;
+
+	return true;
+}
+
+static bool conn_open(void)
+{
+	return conn_open_mss(CONN_MSS);
+}
+
+static bool conn_send(u16_t len)
+{
+	u8_t data[CONN_MSS];
+	struct net_pkt *pkt;
+	u16_t i, off, count;
+	bool ok = true;
+
+	pkt = net_pkt_get_tx(conn_ctx, K_FOREVER);
+
+	for (off = 0; ok && off < len; off += count) {
+		count = min(len - off, sizeof(data));
+
+		for (i = 0; i < count; i++) {
+			data[i] = conn_pattern(conn_sent_len + off + i);
+		}
+
+		ok = net_pkt_append_all(pkt, count, data, K_FOREVER);
+	}
+
+	if (!ok || net_context_send(pkt, NULL, K_NO_WAIT, NULL, NULL) < 0) {
+		TC_ERROR("Cannot send %u bytes\n", len);
+		net_pkt_unref(pkt);
+		return false;
+	}
+
+	conn_sent_len += len;
+
+	return true;
+}
+
+/* The peer resets the connection */
+static bool conn_reset(void)
+{
+	conn_inject(NET_TCP_RST, conn_peer_seq, 0, NULL, 0, 0);
+	conn_wait();
+
+	if (conn_rcvd_bad) {
+		TC_ERROR("Data received out of order\n");
+		return false;
+	}
+
+	return true;
+}
+
+static bool conn_close(void)
+{
+	net_context_put(conn_ctx);
+	conn_wait();
+
+	return conn_reset();
+}
+
 static int send_status = -EINVAL;
 
 static int tester_send(struct net_if *iface, struct net_pkt *pkt)
@@ -138,6 +446,12 @@ static int tester_send(struct net_if *iface, struct net_pkt *pkt)
 		DBG("No data to send!\n");
 		return -ENODATA;
 	}
+
+	if (net_pkt_family(pkt) == AF_INET &&
+	    net_ipv4_addr_cmp(&NET_IPV4_HDR(pkt)->dst, &conn_peer_inaddr)) {
+		conn_record(pkt);
+	}
+
 	if (syn_v6_sent && net_pkt_family(pkt) == AF_INET6) {
 		DBG("v6 SYN was sent successfully\n");
 		syn_v6_sent = false;
@@ -1201,6 +1515,96 @@ static bool test_create_v4_fin_packet(void)
 	return true;
 }
 
+static bool test_v4_options(void)
+{
+	struct net_tcp *tcp = v4_ctx->tcp;
+	struct net_tcp_options opts = { 0 };
+	struct net_pkt *pkt = NULL;
+	struct net_tcp_hdr hdr, *tcp_hdr;
+	u8_t options[] = {
+		NET_TCP_MSS_OPT, NET_TCP_MSS_SIZE, 0x05, 0xb4,
+		NET_TCP_WINDOW_SCALE_OPT, NET_TCP_WINDOW_SCALE_SIZE, 7,
+		NET_TCP_SACK_PERM_OPT, NET_TCP_SACK_PERM_SIZE,
+		NET_TCP_TIMESTAMP_OPT, NET_TCP_TIMESTAMP_SIZE,
+		0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x20, 0x00,
+		NET_TCP_NOP_OPT, NET_TCP_NOP_OPT,
+		NET_TCP_SACK_OPT, 2 + 2 * NET_TCP_SACK_BLOCK_SIZE,
+		0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00,
+		0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x04, 0x00,
+		NET_TCP_END_OPT,
+	};
+	int ret;
+
+	ret = net_tcp_prepare_segment(tcp, NET_TCP_SYN, options,
+				      sizeof(options), NULL,
+				      (struct sockaddr *)&peer_v4_addr, &pkt);
+	if (ret) {
+		DBG("Prepare segment failed (%d)\n", ret);
+		return false;
+	}
+
+	ret = net_tcp_parse_opts(pkt, sizeof(options), &opts);
+	net_pkt_unref(pkt);
+
+	if (ret < 0) {
+		DBG("Parsing options failed (%d)\n", ret);
+		return false;
+	}
+
+	if (opts.mss != 1460 || opts.wscale != 7 ||
+	    opts.flags != (NET_TCP_WSCALE | NET_TCP_SACK_OK | NET_TCP_TS_OK)) {
+		DBG("Invalid options mss %u wscale %u flags 0x%x\n",
+		    opts.mss, opts.wscale, opts.flags);
+		return false;
+	}
+
+	if (opts.tsval != 0x1000 || opts.tsecr != 0x2000) {
+		DBG("Invalid timestamps %u %u\n", opts.tsval, opts.tsecr);
+		return false;
+	}
+
+	if (opts.sack_count != 2 ||
+	    opts.sack[0].start != 0x100 || opts.sack[0].end != 0x200 ||
+	    opts.sack[1].start != 0x300 || opts.sack[1].end != 0x400) {
+		DBG("Invalid SACK blocks (%u)\n", opts.sack_count);
+		return false;
+	}
+
+	/* Once negotiated, the timestamps are sent in every segment */
+	tcp->flags |= NET_TCP_TS_OK;
+	tcp->ts_recent = 0x1234;
+	pkt = NULL;
+
+	ret = net_tcp_prepare_segment(tcp, NET_TCP_ACK, NULL, 0, NULL,
+				      (struct sockaddr *)&peer_v4_addr, &pkt);
+	tcp->flags &= ~NET_TCP_TS_OK;
+
+	if (ret) {
+		DBG("Prepare segment failed (%d)\n", ret);
+		return false;
+	}
+
+	tcp_hdr = net_tcp_get_hdr(pkt, &hdr);
+	if (!tcp_hdr || NET_TCP_HDR_LEN(tcp_hdr) !=
+	    sizeof(struct net_tcp_hdr) + 12) {
+		DBG("Timestamps option not added\n");
+		net_pkt_unref(pkt);
+		return false;
+	}
+
+	memset(&opts, 0, sizeof(opts));
+	ret = net_tcp_parse_opts(pkt, 12, &opts);
+	net_pkt_unref(pkt);
+
+	if (ret < 0 || !(opts.flags & NET_TCP_TS_OK) ||
+	    opts.tsecr != 0x1234) {
+		DBG("Invalid timestamps option\n");
+		return false;
+	}
+
+	return true;
+}
+
 static bool test_v6_seq_check(void)
 {
 	struct net_tcp *tcp = v6_ctx->tcp;
@@ -1658,6 +2062,579 @@ static bool test_init_tcp_connect(void)
 }
 #endif
 
+static void conn_accept_cb(struct net_context *new_context,
+			   struct sockaddr *addr, socklen_t addrlen,
+			   int error, void *user_data)
+{
+	DBG("error %d\n", error);
+}
+
+static bool test_v4_syn_ack_opts(void)
+{
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+		.sin_addr = my_v4_inaddr,
+	};
+	struct net_context *ctx;
+	struct conn_segment *seg;
+	bool ok = true;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK)) {
+		return true;
+	}
+
+	conn_port++;
+	conn_seg_count = 0;
+	local.sin_port = htons(conn_port);
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	if (ret) {
+		TC_ERROR("Context get failed (%d)\n", ret);
+		return false;
+	}
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&local, sizeof(local));
+	if (!ret) {
+		ret = net_context_listen(ctx, 0);
+	}
+
+	if (!ret) {
+		ret = net_context_accept(ctx, conn_accept_cb, K_NO_WAIT, NULL);
+	}
+
+	if (ret) {
+		TC_ERROR("Cannot listen (%d)\n", ret);
+		net_context_put(ctx);
+		return false;
+	}
+
+	/* The SYN-ACK only carries the options of the SYN, SACK here */
+	conn_inject(NET_TCP_SYN, CONN_PEER_ISN, 0, conn_syn_opts,
+		    sizeof(conn_syn_opts), 0);
+	conn_wait();
+
+	seg = conn_last();
+	if (!seg || seg->flags != (NET_TCP_SYN | NET_TCP_ACK) ||
+	    seg->ack != CONN_PEER_ISN + 1) {
+		TC_ERROR("SYN-ACK not sent\n");
+		ok = false;
+	} else if (seg->opts.mss == 0 ||
+		   seg->opts.flags != NET_TCP_SACK_OK) {
+		TC_ERROR("Invalid SYN-ACK options 0x%x\n", seg->opts.flags);
+		ok = false;
+	}
+
+	/* The options are negotiated by the connection, not the listener */
+	if (ctx->tcp->flags & (NET_TCP_WSCALE | NET_TCP_SACK_OK |
+			       NET_TCP_TS_OK)) {
+		TC_ERROR("Options applied to the listener\n");
+		ok = false;
+	}
+
+	conn_inject(NET_TCP_RST, CONN_PEER_ISN + 1, 0, NULL, 0, 0);
+	conn_wait();
+
+	net_context_put(ctx);
+
+	return ok;
+}
+
+static bool test_v4_ooo_queue(void)
+{
+	struct conn_segment *seg;
+	struct net_tcp *tcp;
+	u32_t seq;
+	bool ok = false;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK)) {
+		return true;
+	}
+
+	if (!conn_open()) {
+		return false;
+	}
+
+	tcp = conn_ctx->tcp;
+	seq = conn_peer_seq;
+
+	/* The second segment is queued and reported in a SACK block */
+	conn_inject(NET_TCP_PSH | NET_TCP_ACK, seq + CONN_MSS, conn_local_seq,
+		    NULL, 0, CONN_MSS);
+	conn_wait();
+
+	seg = conn_last();
+	if (conn_rcvd_len || tcp->ooo_count != 1 || !seg || seg->ack != seq ||
+	    seg->opts.sack_count != 1 ||
+	    seg->opts.sack[0].start != seq + CONN_MSS ||
+	    seg->opts.sack[0].end != seq + 2 * CONN_MSS) {
+		TC_ERROR("Segment not queued out of order\n");
+		goto out;
+	}
+
+	/* The block of the last segment received comes first */
+	conn_inject(NET_TCP_PSH | NET_TCP_ACK, seq + 3 * CONN_MSS,
+		    conn_local_seq, NULL, 0, CONN_MSS);
+	conn_wait();
+
+	seg = conn_last();
+	if (tcp->ooo_count != 2 || seg->ack != seq ||
+	    seg->opts.sack_count != 2 ||
+	    seg->opts.sack[0].start != seq + 3 * CONN_MSS ||
+	    seg->opts.sack[1].start != seq + CONN_MSS) {
+		TC_ERROR("Invalid SACK blocks\n");
+		goto out;
+	}
+
+	/* Filling the first hole delivers the segment queued after it */
+	conn_inject(NET_TCP_PSH | NET_TCP_ACK, seq, conn_local_seq,
+		    NULL, 0, CONN_MSS);
+	conn_wait();
+
+	seg = conn_last();
+	if (conn_rcvd_len != 2 * CONN_MSS || tcp->ooo_count != 1 ||
+	    seg->ack != seq + 2 * CONN_MSS || seg->opts.sack_count != 1 ||
+	    seg->opts.sack[0].start != seq + 3 * CONN_MSS) {
+		TC_ERROR("Queued segment not delivered (%u bytes)\n",
+			 conn_rcvd_len);
+		goto out;
+	}
+
+	conn_inject(NET_TCP_PSH | NET_TCP_ACK, seq + 2 * CONN_MSS,
+		    conn_local_seq, NULL, 0, CONN_MSS);
+	conn_wait();
+
+	seg = conn_last();
+	if (conn_rcvd_len != 4 * CONN_MSS || tcp->ooo_count ||
+	    seg->ack != seq + 4 * CONN_MSS || seg->opts.sack_count) {
+		TC_ERROR("Queued segment not delivered (%u bytes)\n",
+			 conn_rcvd_len);
+		goto out;
+	}
+
+	ok = true;
+
+out:
+	conn_peer_seq = tcp->send_ack;
+
+	return conn_close() && ok;
+}
+
+static bool test_v4_sack_recovery(void)
+{
+	u8_t opts[4 + 2 * NET_TCP_SACK_BLOCK_SIZE];
+	struct conn_segment *seg;
+	struct net_tcp *tcp;
+	u32_t s, edges[4];
+	u8_t optlen;
+	bool ok = false;
+	int i;
+
+	/* The windows checked are the ones of NewReno */
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK) ||
+	    !IS_ENABLED(CONFIG_NET_TCP_CC_NEWRENO)) {
+		return true;
+	}
+
+	if (!conn_open()) {
+		return false;
+	}
+
+	tcp = conn_ctx->tcp;
+	s = conn_local_seq;
+
+	if (tcp->cwnd != 4 * CONN_MSS) {
+		TC_ERROR("Invalid initial window %u\n", tcp->cwnd);
+		goto out;
+	}
+
+	for (i = 0; i < 4; i++) {
+		if (!conn_send(CONN_MSS)) {
+			goto out;
+		}
+	}
+
+	conn_wait();
+
+	if (conn_data_segs() != 4) {
+		TC_ERROR("%d segments sent\n", conn_data_segs());
+		goto out;
+	}
+
+	/* Slow start, the window grows by a segment per ACK */
+	conn_inject(NET_TCP_ACK, conn_peer_seq, s + CONN_MSS, NULL, 0, 0);
+	conn_wait();
+
+	if (tcp->cwnd != 5 * CONN_MSS) {
+		TC_ERROR("Window not opened (%u)\n", tcp->cwnd);
+		goto out;
+	}
+
+	for (i = 0; i < 2; i++) {
+		if (!conn_send(CONN_MSS)) {
+			goto out;
+		}
+	}
+
+	conn_wait();
+
+	if (conn_data_segs() != 6) {
+		TC_ERROR("%d segments sent\n", conn_data_segs());
+		goto out;
+	}
+
+	/* The second and fourth segments are lost, the duplicate ACKs
+	 * report the others.
+	 */
+	edges[0] = s + 2 * CONN_MSS;
+	edges[1] = s + 3 * CONN_MSS;
+	optlen = conn_sack_opt(opts, edges, 1);
+	conn_inject(NET_TCP_ACK, conn_peer_seq, s + CONN_MSS, opts, optlen, 0);
+	conn_wait();
+
+	edges[0] = s + 4 * CONN_MSS;
+	edges[1] = s + 5 * CONN_MSS;
+	edges[2] = s + 2 * CONN_MSS;
+	edges[3] = s + 3 * CONN_MSS;
+	optlen = conn_sack_opt(opts, edges, 2);
+	conn_inject(NET_TCP_ACK, conn_peer_seq, s + CONN_MSS, opts, optlen, 0);
+	conn_wait();
+
+	if (conn_data_segs() != 6) {
+		TC_ERROR("Retransmitted before 3 duplicate ACKs\n");
+		goto out;
+	}
+
+	/* The third duplicate ACK triggers a fast retransmit */
+	edges[1] = s + 6 * CONN_MSS;
+	optlen = conn_sack_opt(opts, edges, 2);
+	conn_inject(NET_TCP_ACK, conn_peer_seq, s + CONN_MSS, opts, optlen, 0);
+	conn_wait();
+
+	seg = conn_last();
+	if (conn_data_segs() != 7 || seg->seq != s + CONN_MSS ||
+	    !(tcp->flags & NET_TCP_IN_RECOVERY) ||
+	    tcp->ssthresh != 2 * CONN_MSS) {
+		TC_ERROR("No fast retransmit (ssthresh %u)\n", tcp->ssthresh);
+		goto out;
+	}
+
+	/* The next one retransmits the following hole */
+	conn_inject(NET_TCP_ACK, conn_peer_seq, s + CONN_MSS, opts, optlen, 0);
+	conn_wait();
+
+	seg = conn_last();
+	if (conn_data_segs() != 8 || seg->seq != s + 3 * CONN_MSS) {
+		TC_ERROR("Hole not retransmitted\n");
+		goto out;
+	}
+
+	/* Once all the data is acked, the window is reduced */
+	conn_inject(NET_TCP_ACK, conn_peer_seq, s + 6 * CONN_MSS, NULL, 0, 0);
+	conn_wait();
+
+	if ((tcp->flags & NET_TCP_IN_RECOVERY) ||
+	    tcp->cwnd != 2 * CONN_MSS) {
+		TC_ERROR("Window not reduced (%u)\n", tcp->cwnd);
+		goto out;
+	}
+
+	ok = true;
+
+out:
+	return conn_close() && ok;
+}
+
+static bool test_v4_nagle(void)
+{
+	struct conn_segment *seg;
+	struct net_tcp *tcp;
+	u32_t s;
+	bool ok = false;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_NAGLE)) {
+		return true;
+	}
+
+	if (!conn_open()) {
+		return false;
+	}
+
+	tcp = conn_ctx->tcp;
+	s = conn_local_seq;
+
+	/* A small segment is sent with no data unacked */
+	conn_send(10);
+	conn_wait();
+
+	if (conn_data_segs() != 1) {
+		TC_ERROR("Small segment not sent\n");
+		goto out;
+	}
+
+	/* The next ones wait for the ACK, gathered in a segment */
+	conn_send(10);
+	conn_send(10);
+	conn_wait();
+
+	if (conn_data_segs() != 1 || !tcp->pending_pkt ||
+	    net_pkt_get_len(tcp->pending_pkt) != 20) {
+		TC_ERROR("Small segment sent with data unacked\n");
+		goto out;
+	}
+
+	conn_inject(NET_TCP_ACK, conn_peer_seq, s + 10, NULL, 0, 0);
+	conn_wait();
+
+	seg = conn_last();
+	if (conn_data_segs() != 2 || tcp->pending_pkt ||
+	    seg->seq != s + 10 || seg->len != 20) {
+		TC_ERROR("Data held not sent on ACK\n");
+		goto out;
+	}
+
+	/* The data held is completed to a full segment, the rest waits */
+	conn_send(50);
+	conn_send(50);
+	conn_wait();
+
+	seg = conn_last();
+	if (conn_data_segs() != 3 || seg->seq != s + 30 ||
+	    seg->len != CONN_MSS || !tcp->pending_pkt ||
+	    net_pkt_get_len(tcp->pending_pkt) != 100 - CONN_MSS) {
+		TC_ERROR("Data held not sent in a full segment\n");
+		goto out;
+	}
+
+	conn_inject(NET_TCP_ACK, conn_peer_seq, s + 30 + CONN_MSS,
+		    NULL, 0, 0);
+	conn_wait();
+
+	seg = conn_last();
+	if (conn_data_segs() != 4 || seg->seq != s + 30 + CONN_MSS ||
+	    seg->len != 100 - CONN_MSS) {
+		TC_ERROR("Data held not sent on ACK\n");
+		goto out;
+	}
+
+	ok = true;
+
+out:
+	return conn_close() && ok;
+}
+
+static bool test_v4_nagle_mtu(void)
+{
+	struct net_if *iface = net_if_get_default();
+	u16_t mtu = net_if_get_mtu(iface);
+	struct conn_segment *seg;
+	struct net_pkt *pkt;
+	u16_t room;
+	u32_t s;
+	bool ok = false;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_NAGLE)) {
+		return true;
+	}
+
+	/* Both ends take an MSS from the MTU, from which a packet has
+	 * room for less data as it reserves space for the options.
+	 */
+	net_if_set_mtu(iface, NET_IPV4_MTU);
+
+	if (!conn_open_mss(NET_IPV4_MTU - NET_IPV4TCPH_LEN)) {
+		net_if_set_mtu(iface, mtu);
+		return false;
+	}
+
+	s = conn_local_seq;
+
+	pkt = net_pkt_get_tx(conn_ctx, K_FOREVER);
+	room = net_pkt_append_room(pkt);
+	net_pkt_unref(pkt);
+
+	if (room >= NET_IPV4_MTU - NET_IPV4TCPH_LEN) {
+		TC_ERROR("Packet room not limited by the MTU (%u)\n", room);
+		goto out;
+	}
+
+	conn_send(10);
+	conn_wait();
+
+	/* A packet filled up is a full segment, even with data unacked */
+	conn_send(room);
+	conn_wait();
+
+	seg = conn_last();
+	if (conn_data_segs() != 2 || conn_ctx->tcp->pending_pkt ||
+	    seg->seq != s + 10 || seg->len != room) {
+		TC_ERROR("Full packet held\n");
+		goto out;
+	}
+
+	/* The data held is completed to a full packet, the rest waits */
+	conn_send(10);
+	conn_send(room);
+	conn_wait();
+
+	seg = conn_last();
+	if (conn_data_segs() != 3 || seg->seq != s + 10 + room ||
+	    seg->len != room || !conn_ctx->tcp->pending_pkt ||
+	    net_pkt_get_len(conn_ctx->tcp->pending_pkt) != 10) {
+		TC_ERROR("Data held not sent in a full packet\n");
+		goto out;
+	}
+
+	ok = true;
+
+out:
+	ok = conn_close() && ok;
+	net_if_set_mtu(iface, mtu);
+
+	return ok;
+}
+
+static bool test_v4_delayed_ack(void)
+{
+	struct conn_segment *seg;
+	u32_t seq;
+	bool ok = false;
+
+	if (!CONFIG_NET_TCP_ACK_DELAY) {
+		return true;
+	}
+
+	if (!conn_open()) {
+		return false;
+	}
+
+	seq = conn_peer_seq;
+
+	/* The ACK of a segment is delayed */
+	conn_inject(NET_TCP_PSH | NET_TCP_ACK, seq, conn_local_seq,
+		    NULL, 0, 10);
+	conn_wait();
+
+	if (conn_seg_count) {
+		TC_ERROR("ACK not delayed\n");
+		goto out;
+	}
+
+	k_sleep(CONFIG_NET_TCP_ACK_DELAY);
+
+	seg = conn_last();
+	if (conn_seg_count != 1 || seg->ack != seq + 10) {
+		TC_ERROR("Delayed ACK not sent\n");
+		goto out;
+	}
+
+	/* The second segment is acked at once */
+	conn_inject(NET_TCP_PSH | NET_TCP_ACK, seq + 10, conn_local_seq,
+		    NULL, 0, 10);
+	conn_wait();
+
+	if (conn_seg_count != 1) {
+		TC_ERROR("ACK not delayed\n");
+		goto out;
+	}
+
+	conn_inject(NET_TCP_PSH | NET_TCP_ACK, seq + 20, conn_local_seq,
+		    NULL, 0, 10);
+	conn_wait();
+
+	seg = conn_last();
+	if (conn_seg_count != 2 || seg->ack != seq + 30) {
+		TC_ERROR("ACK not sent after %d segments\n",
+			 CONFIG_NET_TCP_ACK_SEGMENTS);
+		goto out;
+	}
+
+	/* The data sent carries the ACK, no other ACK follows */
+	conn_send(10);
+	conn_send(10);
+	conn_wait();
+
+	conn_inject(NET_TCP_PSH | NET_TCP_ACK, seq + 30, conn_local_seq + 10,
+		    NULL, 0, 10);
+	k_sleep(CONFIG_NET_TCP_ACK_DELAY + CONN_WAIT);
+
+	seg = conn_last();
+	if (conn_seg_count != 4 || seg->len != 10 || seg->ack != seq + 40) {
+		TC_ERROR("ACK sent after the data (%d segments)\n",
+			 conn_seg_count);
+		goto out;
+	}
+
+	/* Nor is the segment counted, the ACK of the next one is delayed */
+	conn_inject(NET_TCP_PSH | NET_TCP_ACK, seq + 40, conn_local_seq + 20,
+		    NULL, 0, 10);
+	conn_wait();
+
+	if (conn_seg_count != 4) {
+		TC_ERROR("ACK not delayed\n");
+		goto out;
+	}
+
+	ok = true;
+
+out:
+	conn_peer_seq = conn_ctx->tcp->send_ack;
+
+	return conn_close() && ok;
+}
+
+static bool test_v4_close_held(void)
+{
+	struct conn_segment *seg;
+	u32_t s;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_NAGLE)) {
+		return true;
+	}
+
+	if (!conn_open()) {
+		return false;
+	}
+
+	s = conn_local_seq;
+
+	conn_send(CONN_MSS);
+	conn_send(10);
+	conn_wait();
+
+	if (conn_data_segs() != 1 || !conn_ctx->tcp->pending_pkt) {
+		TC_ERROR("Data not held\n");
+		conn_close();
+		return false;
+	}
+
+	/* The data held is sent on close, followed by the FIN */
+	net_context_put(conn_ctx);
+	conn_wait();
+
+	if (conn_seg_count != 3) {
+		TC_ERROR("%d segments sent\n", conn_seg_count);
+		conn_reset();
+		return false;
+	}
+
+	seg = &conn_segs[1];
+	if (seg->seq != s + CONN_MSS || seg->len != 10) {
+		TC_ERROR("Data held not sent\n");
+		conn_reset();
+		return false;
+	}
+
+	seg = &conn_segs[2];
+	if (!(seg->flags & NET_TCP_FIN) || seg->seq != s + CONN_MSS + 10) {
+		TC_ERROR("FIN not sent after the data\n");
+		conn_reset();
+		return false;
+	}
+
+	return conn_reset();
+}
+
 static bool test_init(void)
 {
 	struct net_if_addr *ifaddr;
@@ -1734,6 +2711,14 @@ static const struct {
 	{ "test IPv4 TCP fin packet creation", test_create_v4_fin_packet },
 	{ "test IPv6 TCP seq check", test_v6_seq_check },
 	{ "test IPv4 TCP seq check", test_v4_seq_check },
+	{ "test IPv4 TCP options", test_v4_options },
+	{ "test IPv4 TCP SYN-ACK options", test_v4_syn_ack_opts },
+	{ "test IPv4 TCP out of order queue", test_v4_ooo_queue },
+	{ "test IPv4 TCP SACK recovery", test_v4_sack_recovery },
+	{ "test IPv4 TCP Nagle", test_v4_nagle },
+	{ "test IPv4 TCP Nagle with the MTU", test_v4_nagle_mtu },
+	{ "test IPv4 TCP delayed ACK", test_v4_delayed_ack },
+	{ "test IPv4 TCP close with data held", test_v4_close_held },
 	{ "test TCP seq validity", test_tcp_seq_validity },
 	{ "test TCP reply context init", test_init_tcp_reply_context },
 	{ "test TCP accept init", test_init_tcp_accept },
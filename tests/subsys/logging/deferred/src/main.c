@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define SYS_LOG_DOMAIN "deferred"
+
+#include <ztest.h>
+#include <irq_offload.h>
+#include <logging/sys_log.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_LINES 64
+#define LINE_SIZE 96
+
+/* enough messages to overflow the log buffer */
+#define N_FLOOD 100
+
+static char lines[MAX_LINES][LINE_SIZE];
+static int n_lines;
+
+static void log_hook(const char *fmt, ...)
+{
+	va_list args;
+
+	zassert_false(k_is_in_isr(), "message output in ISR");
+
+	if (n_lines < MAX_LINES) {
+		va_start(args, fmt);
+		vsnprintf(lines[n_lines++], LINE_SIZE, fmt, args);
+		va_end(args);
+	}
+}
+
+/* Let the logging thread output the pending messages */
+static void log_sync(void)
+{
+	k_sleep(100);
+}
+
+static void log_reset(void)
+{
+	log_sync();
+	n_lines = 0;
+}
+
+static void check_line(int i, const char *text)
+{
+	zassert_true(i < n_lines, "line %d missing", i);
+	zassert_not_null(strstr(lines[i], text), "line %d is %s", i,
+			 lines[i]);
+}
+
+static void isr_log(void *arg)
+{
+	SYS_LOG_WRN("from ISR %p", arg);
+}
+
+/**
+ * @brief Test that messages are output later on, in order
+ */
+void test_deferred_output(void)
+{
+	log_reset();
+
+	SYS_LOG_ERR("error %d", 1);
+	SYS_LOG_WRN("warning %s", "two");
+	SYS_LOG_INF("info %x %c", 0x3, '!');
+	SYS_LOG_DBG("no arguments");
+
+	/**TESTPOINT: nothing is output in the caller's context*/
+	zassert_equal(n_lines, 0, NULL);
+
+	log_sync();
+
+	zassert_equal(n_lines, 4, NULL);
+	check_line(0, "[deferred] [ERR] test_deferred_output: error 1");
+	check_line(1, "[deferred] [WRN] test_deferred_output: warning two");
+	check_line(2, "[INF] test_deferred_output: info 3 !");
+	check_line(3, "[DBG] test_deferred_output: no arguments");
+}
+
+/**
+ * @brief Test messages logged from an ISR
+ */
+void test_deferred_isr(void)
+{
+	log_reset();
+
+	irq_offload(isr_log, (void *)0x1234);
+	log_sync();
+
+	check_line(0, "[WRN] isr_log: from ISR 0x");
+	check_line(0, "1234");
+}
+
+/**
+ * @brief Test the runtime log level
+ *
+ * @see sys_log_runtime_level_set()
+ */
+void test_deferred_runtime_level(void)
+{
+	log_reset();
+
+	sys_log_runtime_level_set(SYS_LOG_LEVEL_WARNING);
+	SYS_LOG_INF("filtered out");
+	SYS_LOG_DBG("filtered out");
+	SYS_LOG_WRN("passed");
+	sys_log_runtime_level_set(SYS_LOG_LEVEL_DEBUG);
+	log_sync();
+
+	/**TESTPOINT: messages above the runtime level are discarded*/
+	zassert_equal(n_lines, 1, NULL);
+	check_line(0, "passed");
+}
+
+/**
+ * @brief Test that all messages go through while the buffer wraps
+ */
+void test_deferred_wrap(void)
+{
+	int seq = 0;
+
+	for (int round = 0; round < 10; round++) {
+		log_reset();
+
+		for (int i = 0; i < 7; i++) {
+			SYS_LOG_INF("seq %d", seq + i);
+		}
+		log_sync();
+
+		/**TESTPOINT: no message lost or reordered*/
+		zassert_equal(n_lines, 7, NULL);
+		for (int i = 0; i < 7; i++) {
+			char text[16];
+
+			snprintf(text, sizeof(text), "seq %d\n", seq++);
+			check_line(i, text);
+		}
+	}
+}
+
+/**
+ * @brief Test that messages are dropped and counted when overloaded
+ *
+ * @see sys_log_dropped_get()
+ */
+void test_deferred_drop(void)
+{
+	u32_t dropped = sys_log_dropped_get();
+	int i;
+
+	log_reset();
+
+	for (i = 0; i < N_FLOOD; i++) {
+		SYS_LOG_INF("flood %d", i);
+	}
+	log_sync();
+
+	/**TESTPOINT: every message is either output or dropped*/
+	dropped = sys_log_dropped_get() - dropped;
+	zassert_true(dropped > 0, "no message dropped");
+	zassert_equal(n_lines, N_FLOOD - dropped + 1, NULL);
+
+	/**TESTPOINT: the first messages made it, then drops are reported*/
+	check_line(0, "flood 0\n");
+	check_line(n_lines - 1, "log messages dropped");
+}
+
+void test_main(void)
+{
+	syslog_hook_install(log_hook);
+
+	ztest_test_suite(deferred_log,
+			 ztest_unit_test(test_deferred_output),
+			 ztest_unit_test(test_deferred_isr),
+			 ztest_unit_test(test_deferred_runtime_level),
+			 ztest_unit_test(test_deferred_wrap),
+			 ztest_unit_test(test_deferred_drop));
+	ztest_run_test_suite(deferred_log);
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2018 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <tracing.h>
+
+#define EVENT_SIZE sizeof(struct sys_trace_event)
+
+/* time for the tracing thread to output the recorded events */
+#define FLUSH_TIME (CONFIG_TRACING_FLUSH_INTERVAL * 4)
+
+K_SEM_DEFINE(tsem, 0, 1);
+K_MUTEX_DEFINE(tmutex);
+K_MEM_SLAB_DEFINE(tslab, 16, 2, 4);
+K_TIMER_DEFINE(ttimer, NULL, NULL);
+K_FIFO_DEFINE(tfifo);
+
+/* Stream offset of the first event recorded by a test */
+static u32_t start;
+
+static void trace_start(void)
+{
+	k_sleep(FLUSH_TIME);
+	start = tracing_ram_len;
+}
+
+static struct sys_trace_event *event_find(u32_t *offset, u8_t id,
+					  const void *arg)
+{
+	struct sys_trace_event *ev;
+
+	for (; *offset + EVENT_SIZE <= tracing_ram_len; *offset += EVENT_SIZE) {
+		ev = (struct sys_trace_event *)(tracing_ram_buf + *offset);
+		if (ev->id == id && (!arg || ev->arg == (u32_t)(uintptr_t)arg)) {
+			*offset += EVENT_SIZE;
+			return ev;
+		}
+	}
+
+	return NULL;
+}
+
+/* Check that events @a ids were recorded in order for @a arg */
+static void check_events(const u8_t *ids, int n, const void *arg)
+{
+	u32_t offset = start;
+	struct sys_trace_event *ev;
+	u32_t last = 0;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		ev = event_find(&offset, ids[i], arg);
+		zassert_not_null(ev, "event %d not found", ids[i]);
+		zassert_equal(ev->thread, (u32_t)(uintptr_t)k_current_get(),
+			      "event %d in another thread", ids[i]);
+		zassert_true(i == 0 || (s32_t)(ev->timestamp - last) >= 0,
+			     "events out of order");
+		last = ev->timestamp;
+	}
+}
+
+/**
+ * @brief Test the header of the trace stream
+ */
+void test_trace_header(void)
+{
+	struct sys_trace_header *hdr = (void *)tracing_ram_buf;
+
+	k_sleep(FLUSH_TIME);
+
+	zassert_true(tracing_ram_len >= sizeof(*hdr), "no trace stream");
+	zassert_equal(hdr->magic, SYS_TRACE_MAGIC, NULL);
+	zassert_equal(hdr->version, SYS_TRACE_VERSION, NULL);
+	zassert_equal(hdr->event_size, EVENT_SIZE, NULL);
+	zassert_equal(hdr->cycles_per_sec, sys_clock_hw_cycles_per_sec, NULL);
+	zassert_equal((tracing_ram_len - sizeof(*hdr)) % EVENT_SIZE, 0, NULL);
+}
+
+/**
+ * @brief Test the events of semaphores and mutexes
+ */
+void test_trace_sync(void)
+{
+	static const u8_t sem_ids[] = {
+		SYS_TRACE_ID_SEM_GIVE, SYS_TRACE_ID_SEM_TAKE
+	};
+	static const u8_t mutex_ids[] = {
+		SYS_TRACE_ID_MUTEX_LOCK, SYS_TRACE_ID_MUTEX_UNLOCK
+	};
+
+	trace_start();
+
+	k_sem_give(&tsem);
+	zassert_equal(k_sem_take(&tsem, K_NO_WAIT), 0, NULL);
+	k_mutex_lock(&tmutex, K_FOREVER);
+	k_mutex_unlock(&tmutex);
+
+	k_sleep(FLUSH_TIME);
+
+	check_events(sem_ids, ARRAY_SIZE(sem_ids), &tsem);
+	check_events(mutex_ids, ARRAY_SIZE(mutex_ids), &tmutex);
+}
+
+/**
+ * @brief Test the events of queues and memory allocators
+ */
+void test_trace_data(void)
+{
+	static const u8_t fifo_ids[] = {
+		SYS_TRACE_ID_QUEUE_PUT, SYS_TRACE_ID_QUEUE_GET
+	};
+	static const u8_t slab_ids[] = {
+		SYS_TRACE_ID_MEM_SLAB_ALLOC, SYS_TRACE_ID_MEM_SLAB_FREE
+	};
+	void *block;
+
+	trace_start();
+
+	zassert_equal(k_mem_slab_alloc(&tslab, &block, K_NO_WAIT), 0, NULL);
+	k_fifo_put(&tfifo, block);
+	zassert_equal_ptr(k_fifo_get(&tfifo, K_NO_WAIT), block, NULL);
+	k_mem_slab_free(&tslab, &block);
+
+	k_sleep(FLUSH_TIME);
+
+	check_events(fifo_ids, ARRAY_SIZE(fifo_ids), &tfifo._queue);
+	check_events(slab_ids, ARRAY_SIZE(slab_ids), &tslab);
+}
+
+/**
+ * @brief Test the events of thread switches, interrupts and timers
+ */
+void test_trace_switch(void)
+{
+	struct sys_trace_event *ev;
+	u32_t offset;
+
+	trace_start();
+
+	k_timer_start(&ttimer, 10, 0);
+	k_timer_status_sync(&ttimer);
+
+	k_sleep(FLUSH_TIME);
+
+	offset = start;
+	zassert_not_null(event_find(&offset, SYS_TRACE_ID_THREAD_SWITCHED_OUT,
+				    k_current_get()), NULL);
+	zassert_not_null(event_find(&offset, SYS_TRACE_ID_THREAD_SWITCHED_IN,
+				    k_current_get()), NULL);
+
+	offset = start;
+	ev = event_find(&offset, SYS_TRACE_ID_TIMER_EXPIRY, &ttimer);
+	zassert_not_null(ev, NULL);
+
+	offset = start;
+	zassert_not_null(event_find(&offset, SYS_TRACE_ID_ISR_ENTER, NULL),
+			 NULL);
+	zassert_not_null(event_find(&offset, SYS_TRACE_ID_ISR_EXIT, NULL),
+			 NULL);
+}
+
+/**
+ * @brief Test that events are dropped when the trace buffer is full
+ */
+void test_trace_dropped(void)
+{
+	u32_t dropped = sys_trace_dropped_get();
+	struct sys_trace_event *ev;
+	u32_t offset;
+	int i;
+
+	trace_start();
+
+	/* The tracing thread does not run in the meantime */
+	for (i = 0; i < CONFIG_TRACING_BUFFER_SIZE / EVENT_SIZE + 8; i++) {
+		k_sem_give(&tsem);
+	}
+	k_sem_reset(&tsem);
+
+	zassert_true(sys_trace_dropped_get() - dropped >= 8, NULL);
+
+	k_sleep(FLUSH_TIME);
+
+	offset = start;
+	ev = event_find(&offset, SYS_TRACE_ID_DROPPED, NULL);
+	zassert_not_null(ev, "drops not reported");
+	zassert_equal(ev->arg, sys_trace_dropped_get() - dropped, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(tracing,
+			 ztest_unit_test(test_trace_header),
+			 ztest_unit_test(test_trace_sync),
+			 ztest_unit_test(test_trace_data),
+			 ztest_unit_test(test_trace_switch),
+			 ztest_unit_test(test_trace_dropped));
+	ztest_run_test_suite(tracing);
+}